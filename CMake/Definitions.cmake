@@ -94,6 +94,8 @@ foreach(
   REMAP_KEYBOARD_KEYS
   DEVILUTIONX_DEFAULT_RESAMPLER
   STREAM_ALL_AUDIO_MIN_FILE_SIZE
+  MPQ_SECTOR_CACHE_SIZE
+  SFX_CACHE_SIZE
   DEVILUTIONX_DISPLAY_PIXELFORMAT # SDL2-only
   DEVILUTIONX_DISPLAY_TEXTURE_FORMAT # SDL2-only
   DEVILUTIONX_SCREENSHOT_FORMAT
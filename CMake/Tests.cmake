@@ -22,17 +22,22 @@ set(tests
   drlg_l2_test
   drlg_l3_test
   drlg_l4_test
+  drlg_sweep_test
   effects_test
+  frame_queue_test
   inv_test
   items_test
+  lighting_test
   math_test
   missiles_test
+  msg_test
   multi_logging_test
   pack_test
   player_test
   quests_test
   scrollrt_test
   stores_test
+  table_cache_test
   tile_properties_test
   timedemo_test
   townerdat_test
@@ -52,8 +57,13 @@ set(standalone_tests
   crawl_test
   data_file_test
   file_util_test
+  flow_field_test
   format_int_test
   ini_test
+  light_render_test
+  lightmap_blit_test
+  lru_cache_test
+  lz_codec_test
   palette_blending_test
   parse_int_test
   path_test
@@ -61,21 +71,37 @@ set(standalone_tests
   random_test
   rectangle_test
   sheen_bidi_test
+  stable_pool_test
   static_vector_test
   str_cat_test
+  trace_test
+  translation_catalog_test
   utf8_test
 )
 if(NOT USE_SDL1)
   list(APPEND standalone_tests text_render_integration_test)
 endif()
+if(SUPPORTS_MPQ)
+  list(APPEND standalone_tests clx_cache_test mpq_sector_cache_test)
+endif()
 set(benchmarks
   clx_render_benchmark
   crawl_benchmark
   dun_render_benchmark
+  frame_queue_benchmark
   light_render_benchmark
+  missiles_benchmark
   palette_blending_benchmark
   path_benchmark
+  txtdata_cache_benchmark
+  vision_benchmark
 )
+if(SUPPORTS_MPQ OR NOT NONET)
+  list(APPEND benchmarks compression_benchmark)
+endif()
+if(SUPPORTS_MPQ)
+  list(APPEND benchmarks clx_cache_benchmark)
+endif()
 
 include(test/Fixtures.cmake)
 
@@ -130,22 +156,43 @@ target_link_dependencies(clx_render_benchmark
   libdevilutionx_log
   libdevilutionx_surface
 )
+if(SUPPORTS_MPQ OR NOT NONET)
+  target_link_dependencies(compression_benchmark PRIVATE libdevilutionx_lz_codec libdevilutionx_pkware_encrypt)
+endif()
 target_link_dependencies(crawl_test PRIVATE libdevilutionx_crawl)
 target_link_dependencies(crawl_benchmark PRIVATE libdevilutionx_crawl)
 target_link_dependencies(data_file_test PRIVATE libdevilutionx_txtdata app_fatal_for_testing language_for_testing)
 target_link_dependencies(dun_render_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(frame_queue_benchmark PRIVATE libdevilutionx_so)
 target_link_dependencies(file_util_test PRIVATE libdevilutionx_file_util app_fatal_for_testing)
+target_link_dependencies(flow_field_test PRIVATE libdevilutionx_pathfinding libdevilutionx_direction app_fatal_for_testing)
 target_link_dependencies(format_int_test PRIVATE libdevilutionx_format_int language_for_testing)
 target_link_dependencies(ini_test PRIVATE libdevilutionx_ini app_fatal_for_testing)
+target_link_dependencies(light_render_test PRIVATE libdevilutionx_light_render)
+target_link_dependencies(lightmap_blit_test PRIVATE libdevilutionx_lightmap_blit app_fatal_for_testing)
+target_link_dependencies(lz_codec_test PRIVATE libdevilutionx_lz_codec)
 target_link_dependencies(light_render_benchmark PRIVATE libdevilutionx_light_render DevilutionX::SDL libdevilutionx_surface libdevilutionx_paths app_fatal_for_testing)
-target_link_dependencies(palette_blending_test PRIVATE libdevilutionx_palette_blending DevilutionX::SDL libdevilutionx_strings GTest::gmock app_fatal_for_testing)
+target_link_dependencies(missiles_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(palette_blending_test PRIVATE libdevilutionx_palette_blending DevilutionX::SDL libdevilutionx_file_util libdevilutionx_strings GTest::gmock app_fatal_for_testing)
 target_link_dependencies(palette_blending_benchmark
   PRIVATE
   DevilutionX::SDL
+  libdevilutionx_file_util
   libdevilutionx_palette_blending
   libdevilutionx_palette_kd_tree
   app_fatal_for_testing
 )
+if(SUPPORTS_MPQ)
+  target_link_dependencies(clx_cache_test PRIVATE libdevilutionx_clx_cache libdevilutionx_file_util app_fatal_for_testing)
+  target_link_dependencies(clx_cache_benchmark
+    PRIVATE
+    libdevilutionx_clx_cache
+    libdevilutionx_cl2_to_clx
+    libdevilutionx_file_util
+    app_fatal_for_testing
+  )
+  target_link_dependencies(mpq_sector_cache_test PRIVATE libdevilutionx_mpq_sector_cache app_fatal_for_testing)
+endif()
 target_link_dependencies(parse_int_test PRIVATE libdevilutionx_parse_int)
 target_link_dependencies(path_test PRIVATE libdevilutionx_pathfinding libdevilutionx_direction app_fatal_for_testing)
 target_link_dependencies(vision_test PRIVATE libdevilutionx_vision)
@@ -153,6 +200,10 @@ target_link_dependencies(path_benchmark PRIVATE libdevilutionx_pathfinding app_f
 target_link_dependencies(random_test PRIVATE libdevilutionx_random)
 target_link_dependencies(static_vector_test PRIVATE libdevilutionx_random app_fatal_for_testing)
 target_link_dependencies(str_cat_test PRIVATE libdevilutionx_strings)
+target_link_dependencies(trace_test PRIVATE libdevilutionx_trace libdevilutionx_paths app_fatal_for_testing)
+target_link_dependencies(translation_catalog_test PRIVATE libdevilutionx_translation_catalog)
+target_link_dependencies(txtdata_cache_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(vision_benchmark PRIVATE libdevilutionx_so)
 if(DEVILUTIONX_SCREENSHOT_FORMAT STREQUAL DEVILUTIONX_SCREENSHOT_FORMAT_PNG AND NOT USE_SDL1)
   target_link_dependencies(text_render_integration_test
     PRIVATE
@@ -216,3 +267,7 @@ target_link_dependencies(sheen_bidi_test PRIVATE libdevilutionx_sheen_bidi)
 target_link_dependencies(utf8_test PRIVATE libdevilutionx_utf8)
 
 target_include_directories(writehero_test PRIVATE 3rdParty/PicoSHA2)
+
+# Checks that devilutionx-drlg-sweep still builds and that its worker hashes match the fixtures.
+add_dependencies(drlg_sweep_test devilutionx-drlg-sweep)
+target_compile_definitions(drlg_sweep_test PRIVATE DEVILUTIONX_DRLG_SWEEP_PATH="$<TARGET_FILE:devilutionx-drlg-sweep>")
@@ -41,6 +41,7 @@
 #include "levels/trigs.h"
 #include "minitext.h"
 #include "missiles.h"
+#include "monsters/hot_data.hpp"
 #include "panels/spell_icons.hpp"
 #include "panels/spell_list.hpp"
 #include "panels/ui_panels.hpp"
@@ -251,21 +252,23 @@ bool HasRangedSpell()
 	    && !GetSpellData(spl).isAllowedInTown();
 }
 
-bool CanTargetMonster(const Monster &monster)
+/**
+ * @brief Checks whether the player can target a monster, from MonstersHot so that the Monster isn't touched
+ */
+bool CanTargetMonster(size_t monsterId)
 {
-	if ((monster.flags & MFLAG_HIDDEN) != 0)
+	if ((MonstersHot.flags[monsterId] & MFLAG_HIDDEN) != 0)
 		return false;
-	if (monster.isPlayerMinion())
+	if (MonstersHot.isPlayerMinion(monsterId))
 		return false;
-	if (monster.hasNoLife()) // dead
+	if (MonstersHot.hasNoLife(monsterId)) // dead
 		return false;
 
-	if (!IsTileLit(monster.position.tile)) // not visible
+	const WorldTilePosition tile = MonstersHot.tile[monsterId];
+	if (!IsTileLit(tile)) // not visible
 		return false;
 
-	const int mx = monster.position.tile.x;
-	const int my = monster.position.tile.y;
-	return dMonster[mx][my] != 0;
+	return dMonster[tile.x][tile.y] != 0;
 }
 
 void FindRangedTarget()
@@ -276,16 +279,15 @@ void FindRangedTarget()
 
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
 		const int mi = ActiveMonsters[i];
-		const Monster &monster = Monsters[mi];
-
-		if (!CanTargetMonster(monster))
+		if (!CanTargetMonster(mi))
 			continue;
 
-		const bool newCanTalk = CanTalkToMonst(monster);
+		const bool newCanTalk = CanTalkToMonst(Monsters[mi]);
 		if (pcursmonst != -1 && !canTalk && newCanTalk)
 			continue;
-		const int newDdistance = GetDistanceRanged(monster.position.future);
-		const int newRotations = GetRotaryDistance(monster.position.future);
+		const WorldTilePosition future = MonstersHot.future[mi];
+		const int newDdistance = GetDistanceRanged(future);
+		const int newRotations = GetRotaryDistance(future);
 		if (pcursmonst != -1 && canTalk == newCanTalk) {
 			if (distance < newDdistance)
 				continue;
@@ -342,9 +344,8 @@ void FindMeleeTarget()
 
 				if (dMonster[dx][dy] != 0) {
 					const int mi = std::abs(dMonster[dx][dy]) - 1;
-					const Monster &monster = Monsters[mi];
-					if (CanTargetMonster(monster)) {
-						const bool newCanTalk = CanTalkToMonst(monster);
+					if (CanTargetMonster(mi)) {
+						const bool newCanTalk = CanTalkToMonst(Monsters[mi]);
 						if (pcursmonst != -1 && !canTalk && newCanTalk)
 							continue;
 						const int newRotations = GetRotaryDistance({ dx, dy });
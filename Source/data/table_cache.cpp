@@ -0,0 +1,103 @@
+#include "data/table_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr char Magic[4] = { 'D', 'X', 'T', 'C' };
+
+std::string ModList;
+bool CacheEnabled = true;
+
+/** 64-bit FNV-1a */
+uint64_t Hash(uint64_t hash, std::span<const std::byte> data)
+{
+	for (const std::byte b : data) {
+		hash ^= static_cast<uint8_t>(b);
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+uint64_t Hash(uint64_t hash, std::string_view str)
+{
+	hash = Hash(hash, std::as_bytes(std::span(str.data(), str.size())));
+	// Terminate every string, so that moving a character from one string to the next changes the hash.
+	const std::byte terminator { 0 };
+	return Hash(hash, std::span(&terminator, 1));
+}
+
+std::string GetCachePath(std::string_view filename)
+{
+	std::string path = StrCat(paths::PrefPath(), "cache" DIRECTORY_SEPARATOR_STR "txtdata" DIRECTORY_SEPARATOR_STR);
+	for (const char c : filename) {
+		path += (c == '\\' || c == '/') ? '_' : c;
+	}
+	path += ".bin";
+	return path;
+}
+
+} // namespace
+
+void SetTableCacheEnabled(bool enabled)
+{
+	CacheEnabled = enabled;
+}
+
+void SetTableCacheModList(std::span<const std::string_view> modNames)
+{
+	ModList.clear();
+	for (const std::string_view modName : modNames) {
+		StrAppend(ModList, modName, "\n");
+	}
+}
+
+uint64_t GetTableCacheKey(std::string_view filename, const DataFile &dataFile, uint64_t parentKey)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	hash = Hash(hash, std::as_bytes(std::span(&TableCacheVersion, 1)));
+	hash = Hash(hash, std::as_bytes(std::span(&parentKey, 1)));
+	hash = Hash(hash, filename);
+	hash = Hash(hash, ModList);
+	return Hash(hash, std::as_bytes(std::span(dataFile.data(), dataFile.size())));
+}
+
+std::optional<std::vector<std::byte>> LoadTableCache(std::string_view filename, uint64_t key)
+{
+	if (!CacheEnabled)
+		return std::nullopt;
+
+	std::vector<std::byte> data;
+	const bool loaded = ReadCacheFile(GetCachePath(filename).c_str(), Magic, TableCacheVersion, key, [&data](size_t size) {
+		data.resize(size);
+		return data.data();
+	});
+	if (!loaded)
+		return std::nullopt;
+	return data;
+}
+
+void StoreTableCache(std::string_view filename, uint64_t key, std::span<const std::byte> data)
+{
+	if (!CacheEnabled)
+		return;
+
+	const std::string path = GetCachePath(filename);
+	if (!WriteCacheFile(path.c_str(), Magic, TableCacheVersion, key, { data }))
+		LogVerbose("Unable to write table cache {}", path);
+}
+
+} // namespace devilution
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "data/file.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Version of the layout of all cached tables, bump it whenever a table changes what it writes to the cache.
+ *
+ * Only the item tables, monstdat and objdat are cached. Their records have many enum and flag columns that are slow
+ * to parse. unique_monstdat is left out because it refers to speeches by ID, and the text table isn't part of its
+ * key. The text and sound effect tables are mostly one string per record, which the cache would only copy again,
+ * and the remaining tables have a few dozen records each.
+ */
+constexpr uint32_t TableCacheVersion = 3;
+
+/**
+ * @brief Serializes a parsed table for the cache.
+ */
+class TableCacheWriter {
+public:
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	void write(const T &value)
+	{
+		const size_t pos = data_.size();
+		data_.resize(pos + sizeof(value));
+		std::memcpy(&data_[pos], &value, sizeof(value));
+	}
+
+	void write(std::string_view value)
+	{
+		write(static_cast<uint32_t>(value.size()));
+		const size_t pos = data_.size();
+		data_.resize(pos + value.size());
+		std::memcpy(&data_[pos], value.data(), value.size());
+	}
+
+	[[nodiscard]] std::span<const std::byte> data() const
+	{
+		return data_;
+	}
+
+private:
+	std::vector<std::byte> data_;
+};
+
+/**
+ * @brief Reads back what a TableCacheWriter wrote.
+ *
+ * All reads fail once the data runs out, so a caller only needs to check the last one.
+ */
+class TableCacheReader {
+public:
+	explicit TableCacheReader(std::span<const std::byte> data)
+	    : data_(data)
+	{
+	}
+
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	bool read(T &value)
+	{
+		if (failed_ || data_.size() - pos_ < sizeof(value))
+			return fail();
+		std::memcpy(&value, &data_[pos_], sizeof(value));
+		pos_ += sizeof(value);
+		return true;
+	}
+
+	bool read(std::string &value)
+	{
+		uint32_t size;
+		if (!read(size) || data_.size() - pos_ < size)
+			return fail();
+		value.assign(reinterpret_cast<const char *>(&data_[pos_]), size);
+		pos_ += size;
+		return true;
+	}
+
+	/**
+	 * @brief Returns true if everything so far was read successfully.
+	 */
+	[[nodiscard]] bool ok() const
+	{
+		return !failed_;
+	}
+
+	/**
+	 * @brief Returns true if everything so far was read successfully and nothing is left.
+	 */
+	[[nodiscard]] bool done() const
+	{
+		return !failed_ && pos_ == data_.size();
+	}
+
+	[[nodiscard]] size_t remaining() const
+	{
+		return data_.size() - pos_;
+	}
+
+private:
+	bool fail()
+	{
+		failed_ = true;
+		return false;
+	}
+
+	std::span<const std::byte> data_;
+	size_t pos_ = 0;
+	bool failed_ = false;
+};
+
+/**
+ * @brief Turns the cache on or off. While it is off, every table is parsed and nothing is written to the cache.
+ */
+void SetTableCacheEnabled(bool enabled);
+
+/**
+ * @brief Sets the active mods in load order, which are part of every cache key.
+ */
+void SetTableCacheModList(std::span<const std::string_view> modNames);
+
+/**
+ * @brief Computes the key a cached table is valid for, from the contents of its source file and the active mods.
+ *
+ * @param parentKey The key of the table that the IDs in this one are looked up in, if any.
+ */
+uint64_t GetTableCacheKey(std::string_view filename, const DataFile &dataFile, uint64_t parentKey = 0);
+
+/**
+ * @brief Returns the cached table for the file, if there is one for this key.
+ */
+std::optional<std::vector<std::byte>> LoadTableCache(std::string_view filename, uint64_t key);
+
+/**
+ * @brief Replaces the cached table for the file. Failures are logged and otherwise ignored.
+ */
+void StoreTableCache(std::string_view filename, uint64_t key, std::span<const std::byte> data);
+
+/**
+ * @brief Writes the records of a table, with the fields listed by the `VisitCachedFields` overload for the record type.
+ */
+template <typename T>
+void WriteCachedRecords(TableCacheWriter &writer, std::vector<T> &records)
+{
+	writer.write(static_cast<uint32_t>(records.size()));
+	for (T &record : records) {
+		VisitCachedFields(record, [&writer](const auto &field) { writer.write(field); });
+	}
+}
+
+template <typename T>
+bool ReadCachedRecords(TableCacheReader &reader, std::vector<T> &records)
+{
+	uint32_t count;
+	// Every record takes up at least a byte, which keeps a damaged count from allocating a huge table.
+	if (!reader.read(count) || count > reader.remaining())
+		return false;
+	records.resize(count);
+	for (T &record : records) {
+		VisitCachedFields(record, [&reader](auto &field) { reader.read(field); });
+	}
+	return reader.ok();
+}
+
+/**
+ * @brief Reads a table that has no data besides its records from the cache.
+ */
+template <typename T>
+bool LoadTableFromCache(std::string_view filename, uint64_t cacheKey, std::vector<T> &records)
+{
+	const std::optional<std::vector<std::byte>> cache = LoadTableCache(filename, cacheKey);
+	if (!cache)
+		return false;
+	TableCacheReader reader { *cache };
+	return ReadCachedRecords(reader, records) && reader.done();
+}
+
+template <typename T>
+void StoreTableInCache(std::string_view filename, uint64_t cacheKey, std::vector<T> &records)
+{
+	TableCacheWriter writer;
+	WriteCachedRecords(writer, records);
+	StoreTableCache(filename, cacheKey, writer.data());
+}
+
+} // namespace devilution
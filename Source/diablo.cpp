@@ -52,6 +52,7 @@
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/render_workers.hpp"
 #include "engine/sound.h"
 #include "game_mode.hpp"
 #include "gamemenu.h"
@@ -77,6 +78,8 @@
 #include "menu.h"
 #include "minitext.h"
 #include "missiles.h"
+#include "monsters/path_service.hpp"
+#include "monsters/sprite_loader.hpp"
 #include "movie.h"
 #include "multi.h"
 #include "nthread.h"
@@ -109,6 +112,7 @@
 #include "utils/display.h"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/parse_int.hpp"
 #include "utils/paths.h"
 #include "utils/screen_reader.hpp"
@@ -116,6 +120,7 @@
 #include "utils/sdl_thread.h"
 #include "utils/status_macros.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/trace.hpp"
 #include "utils/utf8.hpp"
 
 #ifndef USE_SDL1
@@ -123,6 +128,12 @@
 #include "controls/touch/renderers.h"
 #endif
 
+#ifndef UNPACKED_MPQS
+#include "mpq/mpq_sector_cache.hpp"
+#include "utils/clx_cache.hpp"
+#include "utils/file_util.h"
+#endif
+
 #ifdef __vita__
 #include "platform/vita/touch.h"
 #endif
@@ -177,6 +188,39 @@ bool was_archives_init = false;
 bool was_window_init = false;
 bool was_ui_init = false;
 
+/** Names of the game logic steps in the trace, indexed by GameLogicStep */
+constexpr const char *GameLogicStepTraceNames[] = {
+	"None",
+	"ProcessPlayers",
+	"ProcessMonsters",
+	"ProcessObjects",
+	"ProcessMissiles",
+	"ProcessItems",
+	"ProcessTowners",
+	"ProcessItemsTown",
+	"ProcessMissilesTown",
+	"ProcessLighting",
+};
+/** When the current game logic step started, for the trace */
+uint64_t GameLogicStepStart;
+
+std::string GetTracePath()
+{
+	return paths::PrefPath() + "trace.json";
+}
+
+void SaveTrace()
+{
+	if (!IsTracingEnabled())
+		return;
+	const std::string path = GetTracePath();
+	if (WriteTrace(path.c_str())) {
+		EventPlrMsg(fmt::format(fmt::runtime(_("Trace saved to {:s}")), path), UiFlags::ColorWhite);
+	} else {
+		EventPlrMsg(fmt::format(fmt::runtime(_("Failed to save trace to {:s}")), path), UiFlags::ColorRed);
+	}
+}
+
 void StartGame(interface_mode uMsg)
 {
 	CalcViewportGeometry();
@@ -216,6 +260,7 @@ void FreeGame()
 	FreeDebugGFX();
 #endif
 	FreeGameMem();
+	ClearPrefetchedMonsterSprites();
 	stream_stop();
 	music_stop();
 }
@@ -940,7 +985,9 @@ void RunGameLoop(interface_mode uMsg)
 			continue;
 		}
 
+		demo::NotifyNetworkDeltaBegin();
 		ProcessGameMessagePackets();
+		demo::NotifyNetworkDeltaEnd();
 		if (game_loop(gbGameLoopStartup))
 			diablo_color_cyc_logic();
 		gbGameLoopStartup = false;
@@ -1024,6 +1071,7 @@ extern "C" void SdlLogToFile(void *userdata, int /*category*/, SDL_LogPriority p
 	PrintHelpOption("-n", _(/* TRANSLATORS: Commandline Option */ "Skip startup videos"));
 	PrintHelpOption("-f", _(/* TRANSLATORS: Commandline Option */ "Display frames per second"));
 	PrintHelpOption("--verbose", _(/* TRANSLATORS: Commandline Option */ "Enable verbose logging"));
+	PrintHelpOption("--trace", _(/* TRANSLATORS: Commandline Option */ "Record timings of the game loop, saved to trace.json on exit"));
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	PrintHelpOption("--log-to-file <path>", _(/* TRANSLATORS: Commandline Option */ "Log to a file instead of stderr"));
 #endif
@@ -1031,6 +1079,7 @@ extern "C" void SdlLogToFile(void *userdata, int /*category*/, SDL_LogPriority p
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
 	PrintHelpOption("--timedemo", _(/* TRANSLATORS: Commandline Option */ "Disable all frame limiting during demo playback"));
+	PrintHelpOption("--headless", _(/* TRANSLATORS: Commandline Option */ "Replay a timedemo without rendering and report game logic timings"));
 #endif
 	printNewlineInConsole();
 	printInConsole(_(/* TRANSLATORS: Commandline Option */ "Game selection:"));
@@ -1073,6 +1122,7 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 #ifndef DISABLE_DEMOMODE
 	bool timedemo = false;
+	bool headless = false;
 	int demoNumber = -1;
 	int recordNumber = -1;
 	bool createDemoReference = false;
@@ -1126,6 +1176,8 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "--timedemo") {
 			timedemo = true;
+		} else if (arg == "--headless") {
+			headless = true;
 		} else if (arg == "--record") {
 			if (i + 1 == argc) {
 				PrintFlagRequiresArgument("--record");
@@ -1140,7 +1192,7 @@ void DiabloParseFlags(int argc, char **argv)
 		} else if (arg == "--create-reference") {
 			createDemoReference = true;
 #else
-		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--record" || arg == "--create-reference") {
+		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--headless" || arg == "--record" || arg == "--create-reference") {
 			printInConsole("Binary compiled without demo mode support.");
 			printNewlineInConsole();
 			diablo_quit(1);
@@ -1149,6 +1201,8 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "-f") {
 			EnableFrameCount();
+		} else if (arg == "--trace") {
+			EnableTracing();
 		} else if (arg == "--spawn") {
 			forceSpawn = true;
 		} else if (arg == "--diablo") {
@@ -1200,8 +1254,12 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 
 #ifndef DISABLE_DEMOMODE
+	if (headless && demoNumber == -1) {
+		PrintFlagMessage("--headless", " requires --demo");
+		diablo_quit(64);
+	}
 	if (demoNumber != -1)
-		demo::InitPlayBack(demoNumber, timedemo);
+		demo::InitPlayBack(demoNumber, timedemo, headless);
 	if (recordNumber != -1)
 		demo::InitRecording(recordNumber, createDemoReference);
 #endif
@@ -1256,6 +1314,10 @@ void ApplicationInit()
 
 void DiabloInit()
 {
+#ifndef UNPACKED_MPQS
+	SetClxCacheDir(StrCat(paths::PrefPath(), "cache" DIRECTORY_SEPARATOR_STR "clx" DIRECTORY_SEPARATOR_STR));
+#endif
+
 	if (forceSpawn || *GetOptions().GameMode.shareware)
 		gbIsSpawn = true;
 
@@ -1350,8 +1412,13 @@ void DiabloDeinit()
 	snd_deinit();
 	if (was_ui_init)
 		UiDestroy();
+	ShutdownMonsterSpriteLoader();
 	if (was_archives_init)
 		init_cleanup();
+	pfile_shutdown_save_thread();
+	ShutdownRenderWorkers();
+	if (IsTracingEnabled() && !WriteTrace(GetTracePath().c_str()))
+		LogError("Failed to save trace to {}", GetTracePath());
 	if (was_window_init)
 		dx_cleanup(); // Cleanup SDL surfaces stuff, so we have to do it before SDL_Quit().
 	UnloadFonts();
@@ -1522,38 +1589,52 @@ void UpdateMonsterLights()
 	}
 }
 
+void SetGameLogicStep(GameLogicStep step)
+{
+	if (IsTracingEnabled()) {
+		const uint64_t now = GetTraceTimestamp();
+		if (gGameLogicStep != GameLogicStep::None)
+			RecordTraceZone(GameLogicStepTraceNames[static_cast<size_t>(gGameLogicStep)], GameLogicStepStart, now);
+		GameLogicStepStart = now;
+	}
+	gGameLogicStep = step;
+	demo::NotifyGameLogicStep(step);
+}
+
 void GameLogic()
 {
+	const TraceZone traceZone("GameLogic");
 	if (!ProcessInput()) {
 		return;
 	}
 	if (gbProcessPlayers) {
-		gGameLogicStep = GameLogicStep::ProcessPlayers;
+		SetGameLogicStep(GameLogicStep::ProcessPlayers);
 		ProcessPlayers();
 	}
 	if (leveltype != DTYPE_TOWN) {
-		gGameLogicStep = GameLogicStep::ProcessMonsters;
+		SetGameLogicStep(GameLogicStep::ProcessMonsters);
 #ifdef _DEBUG
 		if (!DebugInvisible)
 #endif
 			ProcessMonsters();
-		gGameLogicStep = GameLogicStep::ProcessObjects;
+		SetGameLogicStep(GameLogicStep::ProcessObjects);
 		ProcessObjects();
-		gGameLogicStep = GameLogicStep::ProcessMissiles;
+		SetGameLogicStep(GameLogicStep::ProcessMissiles);
 		ProcessMissiles();
-		gGameLogicStep = GameLogicStep::ProcessItems;
+		SetGameLogicStep(GameLogicStep::ProcessItems);
 		ProcessItems();
+		SetGameLogicStep(GameLogicStep::ProcessLighting);
 		ProcessLightList();
 		ProcessVisionList();
 	} else {
-		gGameLogicStep = GameLogicStep::ProcessTowners;
+		SetGameLogicStep(GameLogicStep::ProcessTowners);
 		ProcessTowners();
-		gGameLogicStep = GameLogicStep::ProcessItemsTown;
+		SetGameLogicStep(GameLogicStep::ProcessItemsTown);
 		ProcessItems();
-		gGameLogicStep = GameLogicStep::ProcessMissilesTown;
+		SetGameLogicStep(GameLogicStep::ProcessMissilesTown);
 		ProcessMissiles();
 	}
-	gGameLogicStep = GameLogicStep::None;
+	SetGameLogicStep(GameLogicStep::None);
 
 #ifdef _DEBUG
 	if (DebugScrollViewEnabled && (SDL_GetModState() & SDL_KMOD_SHIFT) != 0) {
@@ -1563,6 +1644,7 @@ void GameLogic()
 
 	sound_update();
 	CheckTriggers();
+	PrefetchTriggerLevels();
 	CheckQuests();
 	RedrawViewport();
 	pfile_update(false);
@@ -2087,6 +2169,13 @@ void InitKeymapActions()
 	    SDLK_PRINTSCREEN,
 	    nullptr,
 	    CaptureScreen);
+	options.Keymapper.AddAction(
+	    "SaveTrace",
+	    N_("Save trace"),
+	    N_("Saves the timings recorded with --trace."),
+	    SDLK_UNKNOWN,
+	    nullptr,
+	    SaveTrace);
 	options.Keymapper.AddAction(
 	    "GameInfo",
 	    N_("Game info"),
@@ -2779,6 +2868,12 @@ int DiabloMain(int argc, char **argv)
 	if (!demo::IsRunning()) SaveOptions();
 
 	DiabloSplash();
+	if (demo::IsHeadless()) {
+		// Everything is initialized; from here on only the game logic runs.
+		HeadlessMode = true;
+		gbMusicOn = false;
+		gbSoundOn = false;
+	}
 	mainmenu_loop();
 	DiabloDeinit();
 
@@ -3174,7 +3269,7 @@ void LoadGameLevelSyncPlayerEntry(lvl_entry lvldir)
 void LoadGameLevelLightVision()
 {
 	if (leveltype != DTYPE_TOWN) {
-		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
+		RestorePreLighting();                                                          // resets the light on entering a level to get rid of incorrect light
 		ChangeLightXY(Players[MyPlayerId].lightId, Players[MyPlayerId].position.tile); // forces player light refresh
 		ProcessLightList();
 		ProcessVisionList();
@@ -3374,6 +3469,7 @@ void LoadGameLevelCalculateCursor()
 
 tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 {
+	const TraceZone traceZone("LoadGameLevel");
 	const _music_id neededTrack = GetLevelMusic(leveltype);
 
 	ClearFloatingNumbers();
@@ -3430,6 +3526,8 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 	SyncPortals();
 	LoadGameLevelSyncPlayerEntry(lvldir);
+	if (IsAnyOf(lvldir, ENTRY_MAIN, ENTRY_PREV, ENTRY_RTNLVL, ENTRY_TWARPDN, ENTRY_TWARPUP))
+		SkipArrivalTriggerPrefetch();
 
 	IncProgress();
 	IncProgress();
@@ -3442,6 +3540,7 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 	UpdateMonsterLights();
 	UnstuckChargers();
+	ResetMonsterPathCache();
 
 	LoadGameLevelLightVision();
 
@@ -3454,6 +3553,11 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 #endif
 	LoadGameLevelStartMusic(neededTrack);
 
+#ifndef UNPACKED_MPQS
+	const MpqSectorCacheStats cacheStats = GetMpqSectorCache().stats();
+	LogVerbose("MPQ sector cache: {} hits, {} misses, {} evictions, {} KiB cached", cacheStats.hits, cacheStats.misses, cacheStats.evictions, cacheStats.size / 1024);
+#endif
+
 	CompleteProgress();
 
 	LoadGameLevelCalculateCursor();
@@ -3465,7 +3569,10 @@ bool game_loop(bool bStartup)
 	const uint16_t wait = bStartup ? sgGameInitInfo.nTickRate * 3 : 3;
 
 	for (unsigned i = 0; i < wait; i++) {
-		if (!multi_handle_delta()) {
+		demo::NotifyNetworkDeltaBegin();
+		const bool hasDelta = multi_handle_delta();
+		demo::NotifyNetworkDeltaEnd();
+		if (!hasDelta) {
 			TimeoutCursor(true);
 			return false;
 		}
@@ -54,6 +54,7 @@ enum class GameLogicStep : uint8_t {
 	ProcessTowners,
 	ProcessItemsTown,
 	ProcessMissilesTown,
+	ProcessLighting,
 };
 
 enum class PlayerActionType : uint8_t {
@@ -1,5 +1,7 @@
 #include "dvlnet/frame_queue.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 
 #include "appfat.h"
@@ -20,40 +22,60 @@ PacketError FrameQueueError()
 
 } // namespace
 
+frame_queue::frame_queue()
+    : ring(new unsigned char[capacity])
+{
+}
+
 framesize_t frame_queue::Size() const
 {
-	return current_size;
+	return static_cast<framesize_t>(current_size);
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::Read(framesize_t s)
+void frame_queue::Read(unsigned char *dest, size_t s)
 {
-	if (current_size < s)
-		return tl::make_unexpected(FrameQueueError());
-	buffer_t ret;
-	while (s > 0 && s >= buffer_deque.front().size()) {
-		const auto bufferSize = static_cast<framesize_t>(buffer_deque.front().size());
-		s -= bufferSize;
-		current_size -= bufferSize;
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().end());
-		buffer_deque.pop_front();
-	}
-	if (s > 0) {
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		buffer_deque.front().erase(buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		current_size -= s;
-	}
-	return ret;
+	assert(s <= current_size);
+	const size_t first = std::min(s, capacity - read_pos);
+	std::memcpy(dest, &ring[read_pos], first);
+	std::memcpy(dest + first, &ring[0], s - first);
+	Consume(s);
+}
+
+void frame_queue::Consume(size_t s)
+{
+	current_size -= s;
+	// Start over at the beginning once empty, so that the next write isn't split at the end
+	read_pos = current_size == 0 ? 0 : (read_pos + s) & (capacity - 1);
+}
+
+std::span<unsigned char> frame_queue::WriteBuffer()
+{
+	const size_t writePos = (read_pos + current_size) & (capacity - 1);
+	if (current_size == capacity)
+		return {};
+	if (writePos < read_pos)
+		return { &ring[writePos], read_pos - writePos };
+	return { &ring[writePos], capacity - writePos };
+}
+
+void frame_queue::CommitWrite(size_t s)
+{
+	assert(s <= WriteBuffer().size());
+	current_size += s;
 }
 
-void frame_queue::Write(buffer_t buf)
+tl::expected<void, PacketError> frame_queue::Write(std::span<const unsigned char> buf)
 {
-	current_size += static_cast<framesize_t>(buf.size());
-	buffer_deque.push_back(std::move(buf));
+	if (buf.size() > capacity - current_size)
+		return tl::make_unexpected("Frame queue overflow");
+	while (!buf.empty()) {
+		const std::span<unsigned char> dest = WriteBuffer();
+		const size_t s = std::min(buf.size(), dest.size());
+		std::memcpy(dest.data(), buf.data(), s);
+		CommitWrite(s);
+		buf = buf.subspan(s);
+	}
+	return {};
 }
 
 tl::expected<bool, PacketError> frame_queue::PacketReady()
@@ -61,10 +83,9 @@ tl::expected<bool, PacketError> frame_queue::PacketReady()
 	if (nextsize == 0) {
 		if (Size() < sizeof(framesize_t))
 			return false;
-		tl::expected<buffer_t, PacketError> szbuf = Read(sizeof(framesize_t));
-		if (!szbuf.has_value())
-			return tl::make_unexpected(szbuf.error());
-		nextsize = LoadLE32(szbuf->data());
+		unsigned char szbuf[sizeof(framesize_t)];
+		Read(szbuf, sizeof(szbuf));
+		nextsize = LoadLE32(szbuf);
 		if (nextsize == 0)
 			return tl::make_unexpected(FrameQueueError());
 	}
@@ -77,27 +98,32 @@ uint16_t frame_queue::ReadPacketFlags()
 	return static_cast<uint16_t>(nextsize >> 16);
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::ReadPacket()
+tl::expected<std::span<const unsigned char>, PacketError> frame_queue::ReadPacket()
 {
 	const framesize_t packetSize = nextsize & frame_size_mask;
 	if (nextsize == 0 || Size() < packetSize)
 		return tl::make_unexpected(FrameQueueError());
-	tl::expected<buffer_t, PacketError> ret = Read(packetSize);
 	nextsize = 0;
-	return ret;
+	if (read_pos + packetSize <= capacity) {
+		const std::span<const unsigned char> ret { &ring[read_pos], packetSize };
+		Consume(packetSize);
+		return ret;
+	}
+	wrapped_frame.resize(packetSize);
+	Read(wrapped_frame.data(), packetSize);
+	return wrapped_frame;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(buffer_t packetbuf, uint16_t flags)
+tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(std::span<const unsigned char> packetbuf, uint16_t flags)
 {
 	buffer_t ret;
 	const auto size = static_cast<framesize_t>(packetbuf.size());
 	if (size > max_frame_size)
 		return tl::make_unexpected("Buffer exceeds maximum frame size");
 	static_assert(sizeof(size) == 4, "framesize_t is not 4 bytes");
-	unsigned char sizeBuf[4];
-	WriteLE32(sizeBuf, size | (static_cast<framesize_t>(flags) << 16));
-	ret.insert(ret.end(), sizeBuf, sizeBuf + 4);
-	ret.insert(ret.end(), packetbuf.begin(), packetbuf.end());
+	ret.resize(sizeof(size) + size);
+	WriteLE32(ret.data(), size | (static_cast<framesize_t>(flags) << 16));
+	std::copy(packetbuf.begin(), packetbuf.end(), ret.begin() + sizeof(size));
 	return ret;
 }
 
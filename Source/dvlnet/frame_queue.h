@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <exception>
+#include <memory>
+#include <span>
 #include <vector>
 
 #include <expected.hpp>
@@ -15,26 +17,56 @@ namespace net {
 typedef std::vector<unsigned char> buffer_t;
 typedef uint32_t framesize_t;
 
+/**
+ * @brief Splits a byte stream back into frames.
+ *
+ * Received bytes are kept in a ring buffer that is allocated once, so that reading a
+ * stream doesn't allocate per receive or per frame.
+ */
 class frame_queue {
 public:
 	constexpr static framesize_t frame_size_mask = 0xFFFF;
 	constexpr static framesize_t max_frame_size = 0xFFFF;
+	/** Large enough to always have room left for more data after all complete frames are read. */
+	constexpr static size_t capacity = 0x20000;
 
 private:
-	framesize_t current_size = 0;
-	std::deque<buffer_t> buffer_deque;
+	static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+	static_assert(capacity > max_frame_size + sizeof(framesize_t), "capacity must fit a complete frame");
+
+	std::unique_ptr<unsigned char[]> ring;
+	size_t read_pos = 0;
+	size_t current_size = 0;
 	framesize_t nextsize = 0;
+	/** Holds frames that wrap around the end of the ring buffer, reused between frames. */
+	buffer_t wrapped_frame;
 
 	framesize_t Size() const;
-	tl::expected<buffer_t, PacketError> Read(framesize_t s);
+	void Read(unsigned char *dest, size_t s);
+	void Consume(size_t s);
 
 public:
+	frame_queue();
+
+	/**
+	 * @brief Returns the largest contiguous free area, to receive data into directly.
+	 *
+	 * Call CommitWrite() with the number of bytes that were actually received.
+	 */
+	std::span<unsigned char> WriteBuffer();
+	void CommitWrite(size_t s);
+	tl::expected<void, PacketError> Write(std::span<const unsigned char> buf);
+
 	tl::expected<bool, PacketError> PacketReady();
 	uint16_t ReadPacketFlags();
-	tl::expected<buffer_t, PacketError> ReadPacket();
-	void Write(buffer_t buf);
+	/**
+	 * @brief Reads the next frame without copying it, unless it wraps around the end of the ring buffer.
+	 *
+	 * The returned view is only valid until the queue is read from or written to again.
+	 */
+	tl::expected<std::span<const unsigned char>, PacketError> ReadPacket();
 
-	static tl::expected<buffer_t, PacketError> MakeFrame(buffer_t packetbuf, uint16_t flags = 0);
+	static tl::expected<buffer_t, PacketError> MakeFrame(std::span<const unsigned char> packetbuf, uint16_t flags = 0);
 };
 
 } // namespace net
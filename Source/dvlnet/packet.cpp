@@ -124,9 +124,11 @@ tl::expected<void, PacketError> CheckPacketTypeOneOf(std::initializer_list<packe
 
 } // namespace
 
-const buffer_t &packet::Data()
+std::span<const unsigned char> packet::Data() const
 {
 	assert(have_encrypted || have_decrypted);
+	if (received.data() != nullptr)
+		return received;
 	if (have_encrypted)
 		return encrypted_buffer;
 	return decrypted_buffer;
@@ -202,17 +204,28 @@ tl::expected<leaveinfo_t, PacketError> packet::LeaveInfo()
 tl::expected<void, PacketError> packet_in::Create(buffer_t buf)
 {
 	assert(!have_encrypted && !have_decrypted);
-	if (buf.size() < sizeof(packet_type) + 2 * sizeof(plr_t))
-		return tl::make_unexpected(PacketError());
+	encrypted_buffer = std::move(buf);
+	return UseCleartext();
+}
 
-	decrypted_buffer = std::move(buf);
-	have_decrypted = true;
+tl::expected<void, PacketError> packet_in::Create(std::span<const unsigned char> buf)
+{
+	assert(!have_encrypted && !have_decrypted);
+	received = buf;
+	return UseCleartext();
+}
 
+tl::expected<void, PacketError> packet_in::UseCleartext()
+{
 	// TCP server implementation forwards the original data to clients
 	// so although we are not decrypting anything,
-	// we save a copy in encrypted_buffer anyway
-	encrypted_buffer = decrypted_buffer;
+	// the received data also serves as the encrypted data
 	have_encrypted = true;
+	if (Data().size() < sizeof(packet_type) + 2 * sizeof(plr_t))
+		return tl::make_unexpected(PacketError());
+
+	have_cleartext = true;
+	have_decrypted = true;
 	return {};
 }
 
@@ -221,21 +234,34 @@ tl::expected<void, PacketError> packet_in::Decrypt(buffer_t buf)
 {
 	assert(!have_encrypted && !have_decrypted);
 	encrypted_buffer = std::move(buf);
+	return DecryptData();
+}
+
+tl::expected<void, PacketError> packet_in::Decrypt(std::span<const unsigned char> buf)
+{
+	assert(!have_encrypted && !have_decrypted);
+	received = buf;
+	return DecryptData();
+}
+
+tl::expected<void, PacketError> packet_in::DecryptData()
+{
 	have_encrypted = true;
+	const std::span<const unsigned char> encrypted = Data();
 
-	if (encrypted_buffer.size() < crypto_secretbox_NONCEBYTES
+	if (encrypted.size() < crypto_secretbox_NONCEBYTES
 	        + crypto_secretbox_MACBYTES
 	        + sizeof(packet_type) + 2 * sizeof(plr_t))
 		return tl::make_unexpected(PacketError());
-	auto pktlen = (encrypted_buffer.size()
+	auto pktlen = (encrypted.size()
 	    - crypto_secretbox_NONCEBYTES
 	    - crypto_secretbox_MACBYTES);
 	decrypted_buffer.resize(pktlen);
 	const int status = crypto_secretbox_open_easy(
 	    decrypted_buffer.data(),
-	    encrypted_buffer.data() + crypto_secretbox_NONCEBYTES,
-	    encrypted_buffer.size() - crypto_secretbox_NONCEBYTES,
-	    encrypted_buffer.data(),
+	    encrypted.data() + crypto_secretbox_NONCEBYTES,
+	    encrypted.size() - crypto_secretbox_NONCEBYTES,
+	    encrypted.data(),
 	    key.data());
 	if (status != 0) {
 		auto code = PacketError::ErrorCode::DecryptionFailed;
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
 
@@ -165,12 +166,14 @@ protected:
 	bool have_decrypted = false;
 	buffer_t encrypted_buffer;
 	buffer_t decrypted_buffer;
+	/** Received data that is read in place, used instead of encrypted_buffer if set */
+	std::span<const unsigned char> received;
 
 public:
 	packet(const key_t &k)
 	    : key(k) {};
 
-	const buffer_t &Data();
+	std::span<const unsigned char> Data() const;
 
 	packet_type Type();
 	plr_t Source() const;
@@ -195,10 +198,23 @@ class packet_in : public packet_proc<packet_in> {
 public:
 	using packet_proc<packet_in>::packet_proc;
 	tl::expected<void, PacketError> Create(buffer_t buf);
+	/** @brief Same as Create(buffer_t), but refers to `buf` instead of taking ownership of it. */
+	tl::expected<void, PacketError> Create(std::span<const unsigned char> buf);
 	tl::expected<void, PacketError> process_element(buffer_t &x);
 	template <class T>
 	tl::expected<void, PacketError> process_element(T &x);
 	tl::expected<void, PacketError> Decrypt(buffer_t buf);
+	tl::expected<void, PacketError> Decrypt(std::span<const unsigned char> buf);
+
+private:
+	/** The cleartext is the received data itself, so nothing needs to be decrypted */
+	bool have_cleartext = false;
+	/** Number of cleartext bytes that have been processed */
+	size_t read_offset = 0;
+
+	tl::expected<void, PacketError> UseCleartext();
+	tl::expected<void, PacketError> DecryptData();
+	std::span<const unsigned char> Unread() const;
 };
 
 class packet_out : public packet_proc<packet_out> {
@@ -261,10 +277,17 @@ tl::expected<void, PacketError> packet_proc<P>::process_data()
 	return tl::make_unexpected(PacketTypeError(m_type));
 }
 
+inline std::span<const unsigned char> packet_in::Unread() const
+{
+	const std::span<const unsigned char> cleartext = have_cleartext ? Data() : std::span<const unsigned char>(decrypted_buffer);
+	return cleartext.subspan(read_offset);
+}
+
 inline tl::expected<void, PacketError> packet_in::process_element(buffer_t &x)
 {
-	x.insert(x.begin(), decrypted_buffer.begin(), decrypted_buffer.end());
-	decrypted_buffer.resize(0);
+	const std::span<const unsigned char> unread = Unread();
+	x.assign(unread.begin(), unread.end());
+	read_offset += unread.size();
 	return {};
 }
 
@@ -273,18 +296,18 @@ tl::expected<void, PacketError> packet_in::process_element(T &x)
 {
 	static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Unsupported T");
 	static_assert(sizeof(T) == 4 || sizeof(T) == 2 || sizeof(T) == 1, "Unsupported T");
-	if (decrypted_buffer.size() < sizeof(T)) {
+	const std::span<const unsigned char> unread = Unread();
+	if (unread.size() < sizeof(T)) {
 		return tl::make_unexpected(PacketError());
 	}
 	if (sizeof(T) == 4) {
-		x = static_cast<T>(LoadLE32(decrypted_buffer.data()));
+		x = static_cast<T>(LoadLE32(unread.data()));
 	} else if (sizeof(T) == 2) {
-		x = static_cast<T>(LoadLE16(decrypted_buffer.data()));
+		x = static_cast<T>(LoadLE16(unread.data()));
 	} else if (sizeof(T) == 1) {
-		std::memcpy(&x, decrypted_buffer.data(), sizeof(T));
+		std::memcpy(&x, unread.data(), sizeof(T));
 	}
-	decrypted_buffer.erase(decrypted_buffer.begin(),
-	    decrypted_buffer.begin() + sizeof(T));
+	read_offset += sizeof(T);
 	return {};
 }
 
@@ -470,6 +493,12 @@ public:
 	packet_factory();
 	packet_factory(std::string pw);
 	tl::expected<std::unique_ptr<packet>, PacketError> make_packet(buffer_t buf);
+	/**
+	 * @brief Parses a received packet in place, without allocating.
+	 *
+	 * The packet refers to `buf`, so it must not be used after `buf` changes.
+	 */
+	tl::expected<packet_in, PacketError> parse_packet(std::span<const unsigned char> buf);
 	template <packet_type t, typename... Args>
 	tl::expected<std::unique_ptr<packet>, PacketError> make_packet(Args... args);
 };
@@ -493,6 +522,25 @@ inline tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_p
 	return ret;
 }
 
+inline tl::expected<packet_in, PacketError> packet_factory::parse_packet(std::span<const unsigned char> buf)
+{
+	packet_in ret(key);
+#ifndef PACKET_ENCRYPTION
+	tl::expected<void, PacketError> isCreated = ret.Create(buf);
+#else
+	tl::expected<void, PacketError> isCreated = !secure
+	    ? ret.Create(buf)
+	    : ret.Decrypt(buf);
+#endif
+	if (!isCreated.has_value()) {
+		return tl::make_unexpected(isCreated.error());
+	}
+	if (const tl::expected<void, PacketError> result = ret.process_data(); !result.has_value()) {
+		return tl::make_unexpected(result.error());
+	}
+	return ret;
+}
+
 template <packet_type t, typename... Args>
 tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_packet(Args... args)
 {
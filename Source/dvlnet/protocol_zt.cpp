@@ -141,16 +141,16 @@ tl::expected<bool, PacketError> protocol_zt::peers_ready()
 	    .map([&](bool isOnline) { return isOnline && zerotier_peers_ready(); });
 }
 
-tl::expected<void, PacketError> protocol_zt::send(const endpoint &peer, const buffer_t &data)
+tl::expected<void, PacketError> protocol_zt::send(const endpoint &peer, std::span<const unsigned char> data)
 {
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(data);
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	peer_list[peer].send_queue.push_back(*frame);
+	peer_list[peer].send_queue.push_back(std::move(*frame));
 	return {};
 }
 
-bool protocol_zt::send_oob(const endpoint &peer, const buffer_t &data) const
+bool protocol_zt::send_oob(const endpoint &peer, std::span<const unsigned char> data) const
 {
 	struct sockaddr_in6 in6 {
 	};
@@ -161,7 +161,7 @@ bool protocol_zt::send_oob(const endpoint &peer, const buffer_t &data) const
 	return true;
 }
 
-bool protocol_zt::send_oob_mc(const buffer_t &data) const
+bool protocol_zt::send_oob_mc(std::span<const unsigned char> data) const
 {
 	endpoint mc;
 	std::copy(dvl_multicast_addr, dvl_multicast_addr + 16, mc.addr.begin());
@@ -208,12 +208,14 @@ tl::expected<bool, PacketError> protocol_zt::send_queued_peer(const endpoint &pe
 
 bool protocol_zt::recv_peer(const endpoint &peer)
 {
-	unsigned char buf[PKTBUF_LEN];
 	peer_state &state = peer_list[peer];
 	while (true) {
-		auto len = lwip_recv(state.fd, buf, sizeof(buf), 0);
+		const std::span<unsigned char> buf = state.recv_queue.WriteBuffer();
+		if (buf.empty())
+			return true; // Leave the rest to the next call, once some packets have been read
+		auto len = lwip_recv(state.fd, buf.data(), buf.size(), 0);
 		if (len >= 0) {
-			state.recv_queue.Write(buffer_t(buf, buf + len));
+			state.recv_queue.CommitWrite(len);
 		} else {
 			return errno == EAGAIN || errno == EWOULDBLOCK;
 		}
@@ -309,13 +311,13 @@ bool protocol_zt::recv(endpoint &peer, buffer_t &data)
 		}
 		if (!*ready)
 			continue;
-		tl::expected<buffer_t, PacketError> packet = p.second.recv_queue.ReadPacket();
+		tl::expected<std::span<const unsigned char>, PacketError> packet = p.second.recv_queue.ReadPacket();
 		if (!packet.has_value()) {
 			LogError("Failed reading packet data from peer: {}", packet.error().what());
 			continue;
 		}
 		peer = p.first;
-		data = *packet;
+		data.assign(packet->begin(), packet->end());
 		return true;
 	}
 	return false;
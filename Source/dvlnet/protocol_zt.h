@@ -7,6 +7,7 @@
 #include <deque>
 #include <exception>
 #include <optional>
+#include <span>
 #include <string>
 
 #include <ankerl/unordered_dense.h>
@@ -83,9 +84,9 @@ public:
 	protocol_zt();
 	~protocol_zt();
 	void disconnect(const endpoint &peer);
-	tl::expected<void, PacketError> send(const endpoint &peer, const buffer_t &data);
-	bool send_oob(const endpoint &peer, const buffer_t &data) const;
-	bool send_oob_mc(const buffer_t &data) const;
+	tl::expected<void, PacketError> send(const endpoint &peer, std::span<const unsigned char> data);
+	bool send_oob(const endpoint &peer, std::span<const unsigned char> data) const;
+	bool send_oob_mc(std::span<const unsigned char> data) const;
 	bool recv(endpoint &peer, buffer_t &data);
 	bool get_disconnected(endpoint &peer);
 	tl::expected<bool, PacketError> network_online();
@@ -3,6 +3,7 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <system_error>
 
@@ -158,9 +159,7 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 		RaiseIoHandlerError(packetError);
 		return;
 	}
-	recv_buffer.resize(bytesRead);
-	recv_queue.Write(std::move(recv_buffer));
-	recv_buffer.resize(frame_queue::max_frame_size);
+	recv_queue.CommitWrite(bytesRead);
 	while (true) {
 		tl::expected<bool, PacketError> ready = recv_queue.PacketReady();
 		if (!ready.has_value()) {
@@ -175,8 +174,8 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 		}
 		tl::expected<void, PacketError> result
 		    = recv_queue.ReadPacket()
-		          .and_then([this](buffer_t &&pktData) { return pktfty->make_packet(pktData); })
-		          .and_then([this](std::unique_ptr<packet> &&pkt) { return RecvLocal(*pkt); });
+		          .and_then([this](std::span<const unsigned char> pktData) { return pktfty->parse_packet(pktData); })
+		          .and_then([this](packet_in &&pkt) { return RecvLocal(pkt); });
 		if (!result.has_value()) {
 			RaiseIoHandlerError(result.error());
 			return;
@@ -187,8 +186,9 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 
 void tcp_client::StartReceive()
 {
+	const std::span<unsigned char> recvBuffer = recv_queue.WriteBuffer();
 	sock.async_receive(
-	    asio::buffer(recv_buffer),
+	    asio::buffer(recvBuffer.data(), recvBuffer.size()),
 	    std::bind(&tcp_client::HandleReceive, this, std::placeholders::_1, std::placeholders::_2));
 }
 
@@ -200,13 +200,13 @@ void tcp_client::HandleSend(const asio::error_code &error, size_t /*bytesSent*/)
 
 void tcp_client::HandleTcpErrorCode()
 {
-	tl::expected<buffer_t, PacketError> packet = recv_queue.ReadPacket();
+	tl::expected<std::span<const unsigned char>, PacketError> packet = recv_queue.ReadPacket();
 	if (!packet.has_value()) {
 		RaiseIoHandlerError(packet.error());
 		return;
 	}
 
-	buffer_t pktData = *packet;
+	const std::span<const unsigned char> pktData = *packet;
 	if (pktData.size() != 1) {
 		RaiseIoHandlerError(PacketError());
 		return;
@@ -224,7 +224,7 @@ tl::expected<void, PacketError> tcp_client::send(packet &pkt)
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(*frame);
+	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(std::move(*frame));
 	const asio::mutable_buffer buf = asio::buffer(*framePtr);
 	asio::async_write(sock, buf, [this, frame = std::move(framePtr)](const asio::error_code &error, size_t bytesSent) {
 		HandleSend(error, bytesSent);
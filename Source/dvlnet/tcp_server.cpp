@@ -3,6 +3,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <span>
 #include <utility>
 
 #include <expected.hpp>
@@ -62,8 +63,9 @@ bool tcp_server::Empty()
 
 void tcp_server::StartReceive(const scc &con)
 {
+	const std::span<unsigned char> recvBuffer = con->recv_queue.WriteBuffer();
 	con->socket.async_receive(
-	    asio::buffer(con->recv_buffer),
+	    asio::buffer(recvBuffer.data(), recvBuffer.size()),
 	    std::bind(&tcp_server::HandleReceive, this, con, std::placeholders::_1, std::placeholders::_2));
 }
 
@@ -74,9 +76,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 		DropConnection(con);
 		return;
 	}
-	con->recv_buffer.resize(bytesRead);
-	con->recv_queue.Write(std::move(con->recv_buffer));
-	con->recv_buffer.resize(frame_queue::max_frame_size);
+	con->recv_queue.CommitWrite(bytesRead);
 	while (true) {
 		tl::expected<bool, PacketError> ready = con->recv_queue.PacketReady();
 		if (!ready.has_value()) {
@@ -86,13 +86,13 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 		}
 		if (!*ready)
 			break;
-		tl::expected<buffer_t, PacketError> pktData = con->recv_queue.ReadPacket();
+		tl::expected<std::span<const unsigned char>, PacketError> pktData = con->recv_queue.ReadPacket();
 		if (!pktData.has_value()) {
 			Log("ReadPacket: {}", pktData.error().what());
 			DropConnection(con);
 			return;
 		}
-		tl::expected<std::unique_ptr<packet>, PacketError> pkt = pktfty.make_packet(*pktData);
+		tl::expected<packet_in, PacketError> pkt = pktfty.parse_packet(*pktData);
 		if (!pkt.has_value()) {
 			Log("make_packet: {}", pkt.error().what());
 			if (pkt.error().code() == PacketError::ErrorCode::DecryptionFailed)
@@ -101,7 +101,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 			return;
 		}
 		if (con->plr == PLR_BROADCAST) {
-			tl::expected<void, PacketError> result = HandleReceiveNewPlayer(con, **pkt);
+			tl::expected<void, PacketError> result = HandleReceiveNewPlayer(con, *pkt);
 			if (!result.has_value()) {
 				Log("HandleReceiveNewPlayer: {}", result.error().what());
 				DropConnection(con);
@@ -109,7 +109,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 			}
 		} else {
 			con->timeout = timeout_active;
-			tl::expected<void, PacketError> result = HandleReceivePacket(**pkt);
+			tl::expected<void, PacketError> result = HandleReceivePacket(*pkt);
 			if (!result.has_value()) {
 				Log("Network error: {}", result.error().what());
 				DropConnection(con);
@@ -188,17 +188,16 @@ tl::expected<void, PacketError> tcp_server::StartSend(const scc &con, packet &pk
 
 tl::expected<void, PacketError> tcp_server::StartSend(const scc &con, PacketError::ErrorCode errorCode)
 {
-	buffer_t pktData;
-	pktData.push_back(static_cast<unsigned char>(errorCode));
+	const unsigned char pktData[] = { static_cast<unsigned char>(errorCode) };
 	return StartSend(con, pktData, TcpErrorCodeFlags);
 }
 
-tl::expected<void, PacketError> tcp_server::StartSend(const scc &con, buffer_t pktData, uint16_t flags)
+tl::expected<void, PacketError> tcp_server::StartSend(const scc &con, std::span<const unsigned char> pktData, uint16_t flags)
 {
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pktData, flags);
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(*frame);
+	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(std::move(*frame));
 	const asio::mutable_buffer buf = asio::buffer(*framePtr);
 	asio::async_write(con->socket, buf,
 	    [this, con, frame = std::move(framePtr)](const asio::error_code &ec, size_t bytesSent) {
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <string>
 
 // This header must be included before any 3DS code
@@ -51,7 +52,6 @@ private:
 
 	struct client_connection {
 		frame_queue recv_queue;
-		buffer_t recv_buffer = buffer_t(frame_queue::max_frame_size);
 		plr_t plr = PLR_BROADCAST;
 		asio::ip::tcp::socket socket;
 		asio::steady_timer timer;
@@ -85,7 +85,7 @@ private:
 	tl::expected<void, PacketError> SendPacket(packet &pkt);
 	tl::expected<void, PacketError> StartSend(const scc &con, packet &pkt);
 	tl::expected<void, PacketError> StartSend(const scc &con, PacketError::ErrorCode errorCode);
-	tl::expected<void, PacketError> StartSend(const scc &con, buffer_t pktData, uint16_t flags);
+	tl::expected<void, PacketError> StartSend(const scc &con, std::span<const unsigned char> pktData, uint16_t flags);
 	void HandleSend(const scc &con, const asio::error_code &ec, size_t bytesSent);
 	void StartTimeout(const scc &con);
 	void HandleTimeout(const scc &con, const asio::error_code &ec);
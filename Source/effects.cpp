@@ -5,6 +5,7 @@
  */
 #include "effects.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
@@ -23,6 +24,10 @@
 #include "player.h"
 #include "utils/is_of.hpp"
 
+#ifndef SFX_CACHE_SIZE
+#define SFX_CACHE_SIZE (16 * 1024 * 1024)
+#endif
+
 namespace devilution {
 
 int sfxdelay;
@@ -42,6 +47,62 @@ TSFX *sgpStreamSFX = nullptr;
 /** List of all sounds, except monsters and music */
 std::vector<TSFX> sgSFX;
 
+/**
+ * Effects are loaded the first time they are played and stay loaded until the loaded effects exceed
+ * this many bytes. Streamed effects don't count.
+ */
+size_t SfxCacheBudget = SFX_CACHE_SIZE;
+size_t SfxResidentBytes;
+uint32_t SfxUseCounter;
+uint64_t SfxLoads;
+uint64_t SfxEvictions;
+
+void UnloadSfx(TSFX &sfx)
+{
+	SfxResidentBytes -= sfx.pSnd->DSB.GetDataSize();
+	ReleaseDuplicateSounds(*sfx.pSnd);
+	sfx.pSnd = nullptr;
+}
+
+/**
+ * @brief Unloads the least recently played effects that aren't playing until the loaded ones fit the budget.
+ *
+ * Effects with a copy that is still playing are skipped too, as the copy shares the data and would keep it loaded.
+ */
+void EvictSfx(const TSFX *keep)
+{
+	while (SfxResidentBytes > SfxCacheBudget) {
+		TSFX *leastRecentlyUsed = nullptr;
+		for (TSFX &sfx : sgSFX) {
+			if (&sfx == keep || sfx.pSnd == nullptr || (sfx.bFlags & sfx_STREAM) != 0 || sfx.pSnd->isPlaying()
+			    || IsDuplicateSoundPlaying(*sfx.pSnd))
+				continue;
+			if (leastRecentlyUsed == nullptr || sfx.lastUse < leastRecentlyUsed->lastUse)
+				leastRecentlyUsed = &sfx;
+		}
+		if (leastRecentlyUsed == nullptr)
+			return;
+		UnloadSfx(*leastRecentlyUsed);
+		SfxEvictions++;
+	}
+}
+
+/**
+ * @brief Returns the sound of a non-streamed effect, loading it if needed.
+ */
+TSnd *LoadSfx(TSFX &sfx)
+{
+	assert((sfx.bFlags & sfx_STREAM) == 0);
+	sfx.lastUse = ++SfxUseCounter;
+	if (sfx.pSnd == nullptr) {
+		sfx.pSnd = sound_file_load(sfx.pszName.c_str());
+		SfxResidentBytes += sfx.pSnd->DSB.GetDataSize();
+		SfxLoads++;
+		EvictSfx(&sfx);
+	}
+	return sfx.pSnd.get();
+}
+
 void StreamPlay(TSFX *pSFX, int lVolume, int lPan)
 {
 	assert(pSFX);
@@ -90,16 +151,14 @@ void PlaySfxPriv(TSFX *pSFX, bool loc, Point position)
 		return;
 	}
 
-	if (pSFX->pSnd == nullptr)
-		pSFX->pSnd = sound_file_load(pSFX->pszName.c_str());
-
-	if (pSFX->pSnd == nullptr || !pSFX->pSnd->DSB.IsLoaded())
+	TSnd *pSnd = LoadSfx(*pSFX);
+	if (!pSnd->DSB.IsLoaded())
 		return;
 
 	const auto id = static_cast<SfxID>(pSFX - sgSFX.data());
 	const bool useCuesVolume = (id >= SfxID::AccessibilityWeapon && id <= SfxID::AccessibilityInteract);
 	const int userVolume = useCuesVolume ? *GetOptions().Audio.audioCuesVolume : *GetOptions().Audio.soundVolume;
-	snd_play_snd(pSFX->pSnd.get(), lVolume, lPan, userVolume);
+	snd_play_snd(pSnd, lVolume, lPan, userVolume);
 }
 
 SfxID RndSFX(SfxID psfx)
@@ -177,7 +236,7 @@ void PrivSoundInit(uint8_t bLoadMask)
 			continue;
 		}
 
-		sfx.pSnd = sound_file_load(sfx.pszName.c_str());
+		LoadSfx(sfx);
 	}
 }
 
@@ -256,6 +315,7 @@ void effects_cleanup_sfx(bool fullUnload)
 {
 	sound_stop();
 
+	SfxResidentBytes = 0;
 	if (fullUnload) {
 		sgSFX.clear();
 		return;
@@ -267,44 +327,13 @@ void effects_cleanup_sfx(bool fullUnload)
 
 void sound_init()
 {
-	uint8_t mask = sfx_MISC;
-	if (gbIsMultiplayer) {
-		mask |= (sfx_WARRIOR | sfx_MONK);
-		if (!gbIsSpawn)
-			mask |= (sfx_ROGUE | sfx_SORCERER);
-	} else {
-		switch (MyPlayer->_pClass) {
-		case HeroClass::Warrior:
-		case HeroClass::Barbarian:
-			mask |= sfx_WARRIOR;
-			break;
-		case HeroClass::Rogue:
-		case HeroClass::Bard:
-			mask |= sfx_ROGUE;
-			break;
-		case HeroClass::Sorcerer:
-			mask |= sfx_SORCERER;
-			break;
-		case HeroClass::Monk:
-			mask |= sfx_MONK;
-			break;
-		default:
-			if (static_cast<size_t>(MyPlayer->_pClass) < GetNumPlayerClasses()) {
-				// this is a custom class, so we need to add init sounds, since we can't determine which ones will be used by it
-				mask |= (sfx_WARRIOR | sfx_MONK);
-				if (!gbIsSpawn)
-					mask |= (sfx_ROGUE | sfx_SORCERER);
-			} else {
-				app_fatal("effects:1");
-			}
-		}
-	}
-
-	PrivSoundInit(mask);
+	// Game sounds are loaded the first time they are played.
+	PrivSoundInit(0);
 }
 
 void ui_sound_init()
 {
+	// The few menu sounds are small and played right away, so they are loaded up front.
 	PrivSoundInit(sfx_UI);
 }
 
@@ -315,20 +344,44 @@ void effects_play_sound(SfxID id)
 	}
 
 	TSFX &sfx = sgSFX[static_cast<int16_t>(id)];
-	if (sfx.pSnd != nullptr && !sfx.pSnd->isPlaying()) {
-		snd_play_snd(sfx.pSnd.get(), 0, 0, *GetOptions().Audio.soundVolume);
+	if ((sfx.bFlags & sfx_STREAM) != 0)
+		return;
+	TSnd *pSnd = LoadSfx(sfx);
+	if (!pSnd->isPlaying()) {
+		snd_play_snd(pSnd, 0, 0, *GetOptions().Audio.soundVolume);
 	}
 }
 
 int GetSFXLength(SfxID nSFX)
 {
 	TSFX &sfx = sgSFX[static_cast<int16_t>(nSFX)];
+	if ((sfx.bFlags & sfx_STREAM) == 0)
+		return LoadSfx(sfx)->DSB.GetLength();
 	if (sfx.pSnd == nullptr)
-		sfx.pSnd = sound_file_load(sfx.pszName.c_str(),
-		    /*stream=*/AllowStreaming && (sfx.bFlags & sfx_STREAM) != 0);
+		sfx.pSnd = sound_file_load(sfx.pszName.c_str(), /*stream=*/AllowStreaming);
 	return sfx.pSnd->DSB.GetLength();
 }
 
+SfxCacheStats GetSfxCacheStats()
+{
+	SfxCacheStats stats {};
+	for (const TSFX &sfx : sgSFX) {
+		if (sfx.pSnd != nullptr && (sfx.bFlags & sfx_STREAM) == 0)
+			stats.loaded++;
+	}
+	stats.residentBytes = SfxResidentBytes;
+	stats.budgetBytes = SfxCacheBudget;
+	stats.loads = SfxLoads;
+	stats.evictions = SfxEvictions;
+	return stats;
+}
+
+void SetSfxCacheBudget(size_t bytes)
+{
+	SfxCacheBudget = bytes;
+	EvictSfx(nullptr);
+}
+
 tl::expected<HeroSpeech, std::string> ParseHeroSpeech(std::string_view value)
 {
 	const std::optional<HeroSpeech> enumValueOpt = magic_enum::enum_cast<HeroSpeech>(value);
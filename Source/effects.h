@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -20,6 +21,18 @@ struct TSFX {
 	uint8_t bFlags;
 	std::string pszName;
 	std::unique_ptr<TSnd> pSnd;
+	/** When the effect was last played, to unload the least recently used effects first. */
+	uint32_t lastUse;
+};
+
+struct SfxCacheStats {
+	/** Bytes of sound effect data currently loaded */
+	size_t residentBytes;
+	size_t budgetBytes;
+	/** Number of effects currently loaded */
+	uint32_t loaded;
+	uint64_t loads;
+	uint64_t evictions;
 };
 
 extern int sfxdelay;
@@ -37,6 +50,16 @@ void ui_sound_init();
 void effects_play_sound(SfxID);
 int GetSFXLength(SfxID nSFX);
 
+SfxCacheStats GetSfxCacheStats();
+
+/**
+ * @brief Sets how many bytes of sound effects may stay loaded, unloading the least recently played ones right away.
+ *
+ * The default is set by SFX_CACHE_SIZE. Effects that are playing are never unloaded, so the budget can be exceeded
+ * while many different effects play at once.
+ */
+void SetSfxCacheBudget(size_t bytes);
+
 tl::expected<HeroSpeech, std::string> ParseHeroSpeech(std::string_view value);
 tl::expected<SfxID, std::string> ParseSfxId(std::string_view value);
 
@@ -49,6 +49,8 @@ void sound_init() { }
 void ui_sound_init() { }
 void effects_play_sound(SfxID id) { }
 int GetSFXLength(SfxID nSFX) { return 0; }
+SfxCacheStats GetSfxCacheStats() { return {}; }
+void SetSfxCacheBudget(size_t bytes) { }
 
 tl::expected<HeroSpeech, std::string> ParseHeroSpeech(std::string_view value)
 {
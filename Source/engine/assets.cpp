@@ -246,13 +246,15 @@ AssetHandle OpenIntegralAsset(std::string_view filename, size_t &fileSize, bool
 
 SDL_IOStream *OpenAssetAsSdlRwOps(std::string_view filename, bool threadsafe)
 {
-#ifdef UNPACKED_MPQS
 	AssetRef ref = FindAsset(filename);
 	if (!ref.ok())
 		return nullptr;
+#ifdef UNPACKED_MPQS
 	return SDL_IOFromFile(ref.path, "rb");
 #else
-	return OpenAsset(filename, threadsafe).release();
+	if (ref.archive != nullptr)
+		return SDL_RWops_FromMpqFile(*ref.archive, ref.hashIndex, ref.filename, threadsafe, /*cacheSectors=*/false);
+	return OpenAsset(std::move(ref), threadsafe).release();
 #endif
 }
 
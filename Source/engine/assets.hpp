@@ -284,6 +284,11 @@ AssetHandle OpenIntegralAsset(AssetRef &&ref, bool threadsafe = false);
 AssetHandle OpenIntegralAsset(std::string_view filename, bool threadsafe = false);
 AssetHandle OpenIntegralAsset(std::string_view filename, size_t &fileSize, bool threadsafe = false);
 
+/**
+ * @brief Opens an asset that is streamed, such as music, a streamed sound effect or a video.
+ *
+ * Files in MPQ archives are read without going through the sector cache.
+ */
 SDL_IOStream *OpenAssetAsSdlRwOps(std::string_view filename, bool threadsafe = false);
 
 struct AssetData {
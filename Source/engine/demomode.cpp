@@ -1,9 +1,12 @@
 #include "engine/demomode.h"
 
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <limits>
 #include <optional>
+#include <string_view>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_events.h>
@@ -19,6 +22,7 @@
 
 #include "controls/control_mode.hpp"
 #include "controls/plrctrls.h"
+#include "diablo.h"
 #include "engine/events.hpp"
 #include "game_mode.hpp"
 #include "gmenu.h"
@@ -115,6 +119,7 @@ int DemoNumber = -1;
 std::optional<DemoMsg> CurrentDemoMessage;
 
 bool Timedemo = false;
+bool Headless = false;
 int RecordNumber = -1;
 bool CreateDemoReference = false;
 
@@ -151,6 +156,15 @@ uint32_t DemoModeLastTick = 0;
 int LogicTick = 0;
 uint32_t StartTime = 0;
 
+using SimulationClock = std::chrono::steady_clock;
+
+/** Time spent in each game logic step during a headless timedemo, indexed by `GameLogicStep`. */
+std::array<SimulationClock::duration, static_cast<size_t>(GameLogicStep::ProcessLighting) + 1> StepDurations;
+/** Time spent waiting for and applying network turns during a headless timedemo. */
+SimulationClock::duration NetworkDeltaDuration;
+GameLogicStep CurrentStep = GameLogicStep::None;
+SimulationClock::time_point StepStart;
+
 uint16_t DemoGraphicsWidth = 640;
 uint16_t DemoGraphicsHeight = 480;
 
@@ -589,6 +603,55 @@ std::optional<DemoMsg> ReadDemoMessage()
 	}
 }
 
+SimulationClock::duration TakeStepDuration()
+{
+	const SimulationClock::time_point now = SimulationClock::now();
+	const SimulationClock::duration elapsed = now - StepStart;
+	StepStart = now;
+	return elapsed;
+}
+
+std::string_view GameLogicStepName(GameLogicStep step)
+{
+	switch (step) {
+	case GameLogicStep::None:
+		return "other";
+	case GameLogicStep::ProcessPlayers:
+		return "players";
+	case GameLogicStep::ProcessMonsters:
+		return "monsters";
+	case GameLogicStep::ProcessObjects:
+		return "objects";
+	case GameLogicStep::ProcessMissiles:
+		return "missiles";
+	case GameLogicStep::ProcessItems:
+		return "items";
+	case GameLogicStep::ProcessTowners:
+		return "towners";
+	case GameLogicStep::ProcessItemsTown:
+		return "items (town)";
+	case GameLogicStep::ProcessMissilesTown:
+		return "missiles (town)";
+	case GameLogicStep::ProcessLighting:
+		return "lighting";
+	}
+	return "unknown";
+}
+
+void LogSimulationBreakdown(float seconds)
+{
+	const auto logSection = [seconds](std::string_view name, SimulationClock::duration duration) {
+		const float sectionSeconds = std::chrono::duration<float>(duration).count();
+		Log("  {:<16} {:>9.2f} ms {:>5.1f}%", name, sectionSeconds * 1000.0F, seconds > 0 ? sectionSeconds * 100.0F / seconds : 0.0F);
+	};
+	for (size_t i = 0; i < StepDurations.size(); ++i) {
+		if (StepDurations[i] == SimulationClock::duration::zero())
+			continue;
+		logSection(GameLogicStepName(static_cast<GameLogicStep>(i)), StepDurations[i]);
+	}
+	logSection("network delta", NetworkDeltaDuration);
+}
+
 void WriteDemoMsgHeader(DemoMsg::EventType type)
 {
 	if (type == DemoMsg::Rendering && ProgressToNextGameTick <= 127) {
@@ -603,9 +666,10 @@ void WriteDemoMsgHeader(DemoMsg::EventType type)
 
 namespace demo {
 
-void InitPlayBack(int demoNumber, bool timedemo)
+void InitPlayBack(int demoNumber, bool timedemo, bool headless)
 {
-	Timedemo = timedemo;
+	Timedemo = timedemo || headless;
+	Headless = headless;
 	ControlMode = ControlTypes::KeyboardAndMouse;
 
 	const LoadingStatus status = OpenDemoFile(demoNumber);
@@ -676,6 +740,11 @@ bool IsRecording()
 	return RecordNumber != -1;
 }
 
+bool IsHeadless()
+{
+	return Headless && IsRunning();
+}
+
 bool GetRunGameLoop(bool &drawGame, bool &processInput)
 {
 	if (CurrentDemoMessage == std::nullopt && DemoFile != nullptr)
@@ -935,6 +1004,13 @@ void NotifyGameLoopStart()
 		StartTime = SDL_GetTicks();
 	}
 
+	if (IsHeadless()) {
+		StepDurations = {};
+		NetworkDeltaDuration = {};
+		CurrentStep = GameLogicStep::None;
+		StepStart = SimulationClock::now();
+	}
+
 	if (IsRecording()) {
 		const std::string path = StrCat(paths::PrefPath(), "demo_", RecordNumber, ".dmo");
 		DemoRecording = OpenFile(path.c_str(), "wb");
@@ -961,9 +1037,15 @@ void NotifyGameLoopEnd()
 		CreateDemoReference = false;
 	}
 
-	if (IsRunning() && !HeadlessMode) {
+	if (IsRunning() && (!HeadlessMode || Headless)) {
 		const float seconds = (SDL_GetTicks() - StartTime) / 1000.0F;
-		Log("{} frames, {:.2f} seconds: {:.1f} fps", LogicTick, seconds, LogicTick / seconds);
+		if (Headless) {
+			StepDurations[static_cast<size_t>(CurrentStep)] += TakeStepDuration();
+			Log("{} ticks, {:.2f} seconds: {:.1f} ticks/s", LogicTick, seconds, LogicTick / seconds);
+			LogSimulationBreakdown(seconds);
+		} else {
+			Log("{} frames, {:.2f} seconds: {:.1f} fps", LogicTick, seconds, LogicTick / seconds);
+		}
 		gbRunGameResult = false;
 		gbRunGame = false;
 
@@ -982,6 +1064,28 @@ void NotifyGameLoopEnd()
 	}
 }
 
+void NotifyGameLogicStep(GameLogicStep step)
+{
+	if (!Headless)
+		return;
+	StepDurations[static_cast<size_t>(CurrentStep)] += TakeStepDuration();
+	CurrentStep = step;
+}
+
+void NotifyNetworkDeltaBegin()
+{
+	if (!Headless)
+		return;
+	StepDurations[static_cast<size_t>(CurrentStep)] += TakeStepDuration();
+}
+
+void NotifyNetworkDeltaEnd()
+{
+	if (!Headless)
+		return;
+	NetworkDeltaDuration += TakeStepDuration();
+}
+
 uint32_t SimulateMillisecondsSinceStartup()
 {
 	return LogicTick * 50;
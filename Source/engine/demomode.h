@@ -15,15 +15,21 @@
 
 namespace devilution {
 
+enum class GameLogicStep : uint8_t;
+
 namespace demo {
 
 #ifndef DISABLE_DEMOMODE
-void InitPlayBack(int demoNumber, bool timedemo);
+void InitPlayBack(int demoNumber, bool timedemo, bool headless);
 void InitRecording(int recordNumber, bool createDemoReference);
 void OverrideOptions();
 
 bool IsRunning();
 bool IsRecording();
+/**
+ * @brief Whether the demo is replayed through the game logic only, without rendering or audio.
+ */
+bool IsHeadless();
 
 bool GetRunGameLoop(bool &drawGame, bool &processInput);
 bool FetchMessage(SDL_Event *event, uint16_t *modState);
@@ -33,6 +39,15 @@ void RecordMessage(const SDL_Event &event, uint16_t modState);
 void NotifyGameLoopStart();
 void NotifyGameLoopEnd();
 
+/**
+ * @brief Attributes the time spent since the previous notification to the game logic step that just finished.
+ *
+ * Only measures anything during a headless timedemo.
+ */
+void NotifyGameLogicStep(GameLogicStep step);
+void NotifyNetworkDeltaBegin();
+void NotifyNetworkDeltaEnd();
+
 uint32_t SimulateMillisecondsSinceStartup();
 #else
 inline void OverrideOptions()
@@ -46,6 +61,10 @@ inline bool IsRecording()
 {
 	return false;
 }
+inline bool IsHeadless()
+{
+	return false;
+}
 inline bool GetRunGameLoop(bool &, bool &)
 {
 	return false;
@@ -66,6 +85,15 @@ inline void NotifyGameLoopStart()
 inline void NotifyGameLoopEnd()
 {
 }
+inline void NotifyGameLogicStep(GameLogicStep)
+{
+}
+inline void NotifyNetworkDeltaBegin()
+{
+}
+inline void NotifyNetworkDeltaEnd()
+{
+}
 inline uint32_t SimulateMillisecondsSinceStartup()
 {
 	return 0;
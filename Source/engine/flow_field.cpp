@@ -0,0 +1,141 @@
+/**
+ * @file flow_field.cpp
+ *
+ * Implementation of walkability bitmaps and flow fields.
+ */
+#include "engine/flow_field.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "engine/displacement.hpp"
+#include "engine/path.h"
+#include "engine/point.hpp"
+
+namespace devilution {
+
+WalkabilityGrid::WalkabilityGrid(Size size)
+    : size_(size)
+    , walkable_((static_cast<size_t>(size.width * size.height) + 63) / 64)
+    , notSolid_(walkable_.size())
+{
+}
+
+void WalkabilityGrid::setTile(Point position, bool walkable, bool notSolid)
+{
+	const size_t index = static_cast<size_t>((position.y * size_.width) + position.x);
+	const uint64_t bit = uint64_t { 1 } << (index % 64);
+	if (walkable)
+		walkable_[index / 64] |= bit;
+	else
+		walkable_[index / 64] &= ~bit;
+	if (notSolid)
+		notSolid_[index / 64] |= bit;
+	else
+		notSolid_[index / 64] &= ~bit;
+}
+
+void FlowField::build(const WalkabilityGrid &grid, Point target, size_t maxPathLength)
+{
+	assert(maxPathLength < 100);
+
+	// Nothing further away than maxPathLength steps in any direction can be reached
+	const int radius = static_cast<int>(maxPathLength);
+	target_ = target;
+	origin_ = target - Displacement { radius };
+	extent_ = (2 * radius) + 1;
+	costs_.assign(static_cast<size_t>(extent_ * extent_), Unreachable);
+
+	// Queue entries hold the cost in the upper and the tile index in the lower 16 bits, so that a min-heap on the
+	// whole value pops the cheapest tile first.
+	queue_.clear();
+	const auto push = [this](uint16_t cost, int index) {
+		queue_.push_back((static_cast<uint32_t>(cost) << 16) | static_cast<uint32_t>(index));
+		std::push_heap(queue_.begin(), queue_.end(), std::greater<>());
+	};
+
+	const int targetIndex = (radius * extent_) + radius;
+	costs_[targetIndex] = 0;
+	push(0, targetIndex);
+
+	while (!queue_.empty()) {
+		std::pop_heap(queue_.begin(), queue_.end(), std::greater<>());
+		const uint32_t entry = queue_.back();
+		queue_.pop_back();
+
+		const uint16_t cost = entry >> 16;
+		const int index = static_cast<int>(entry & 0xFFFF);
+		if (cost != costs_[index])
+			continue; // Already reached at a lower cost
+		// Costs are 100 per step plus 1 for diagonal steps, so this is the number of steps to the target
+		if (static_cast<size_t>(cost / PathAxisAlignedStepCost) >= maxPathLength)
+			continue;
+
+		const Point position = origin_ + Displacement { index % extent_, index / extent_ };
+		for (const Displacement step : PathDirs) {
+			// Walking backwards from the target, `previous` is where a step to `position` starts
+			const Point previous = position + step;
+			const Displacement offset = previous - origin_;
+			if (offset.deltaX < 0 || offset.deltaY < 0 || offset.deltaX >= extent_ || offset.deltaY >= extent_)
+				continue;
+			// FindPath steps onto a target that posOk rejects, like an occupied one, without checking corners
+			if (position != target_ && !grid.canStep(previous, position))
+				continue;
+			const int previousIndex = (offset.deltaY * extent_) + offset.deltaX;
+			const uint16_t previousCost = cost + (step.deltaX != 0 && step.deltaY != 0 ? PathDiagonalStepCost : PathAxisAlignedStepCost);
+			if (previousCost >= costs_[previousIndex])
+				continue;
+			costs_[previousIndex] = previousCost;
+			// Walls still get a cost, as paths may start there, but no path leads through them
+			if (grid.isWalkable(previous))
+				push(previousCost, previousIndex);
+		}
+	}
+}
+
+FlowFieldCache::FlowFieldCache(size_t maxPathLength)
+    : maxPathLength_(maxPathLength)
+{
+	assert(maxPathLength <= MaxPathLengthPlayer);
+}
+
+int8_t FlowFieldCache::firstStep(const WalkabilityGrid &grid, tl::function_ref<bool(Point, Point)> canStep, tl::function_ref<bool(Point)> posOk, Point start, Point target)
+{
+	const FlowField *field = nullptr;
+	for (size_t i = 0; i < count_; i++) {
+		if (fields_[i].target() == target) {
+			field = &fields_[i];
+			break;
+		}
+	}
+	if (field != nullptr && field->cost(start) == FlowField::Unreachable)
+		return 0;
+
+	int8_t path[MaxPathLengthPlayer];
+	if (FindPath(canStep, posOk, start, target, path, maxPathLength_) != 0)
+		return path[0];
+
+	if (field == nullptr) {
+		FlowField *slot;
+		if (count_ < Capacity) {
+			slot = &fields_[count_++];
+		} else {
+			slot = &fields_[next_];
+			next_ = (next_ + 1) % Capacity;
+		}
+		slot->build(grid, target, maxPathLength_);
+		builds_++;
+	}
+	return 0;
+}
+
+void FlowFieldCache::clear()
+{
+	count_ = 0;
+	next_ = 0;
+}
+
+} // namespace devilution
@@ -0,0 +1,146 @@
+/**
+ * @file flow_field.hpp
+ *
+ * Walkability bitmaps and flow fields for moving many actors to the same target.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <function_ref.hpp>
+
+#include "engine/displacement.hpp"
+#include "engine/path.h"
+#include "engine/point.hpp"
+#include "engine/size.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Bitmap of the tiles that can be walked on and of the tiles without a solid dungeon piece.
+ *
+ * Positions outside of the grid are neither, same as positions outside of the dungeon.
+ */
+class WalkabilityGrid {
+public:
+	explicit WalkabilityGrid(Size size);
+
+	[[nodiscard]] Size size() const { return size_; }
+
+	void setTile(Point position, bool walkable, bool notSolid);
+
+	[[nodiscard]] bool isWalkable(Point position) const { return test(walkable_, position); }
+	[[nodiscard]] bool isNotSolid(Point position) const { return test(notSolid_, position); }
+
+	/**
+	 * @brief Same as CanStep, checks that a step to a neighbouring tile doesn't cut a solid corner.
+	 */
+	[[nodiscard]] bool canStep(Point startPosition, Point destinationPosition) const
+	{
+		if (startPosition.x == destinationPosition.x || startPosition.y == destinationPosition.y)
+			return true;
+		return isNotSolid({ startPosition.x, destinationPosition.y }) && isNotSolid({ destinationPosition.x, startPosition.y });
+	}
+
+private:
+	[[nodiscard]] bool test(const std::vector<uint64_t> &bits, Point position) const
+	{
+		if (position.x < 0 || position.y < 0 || position.x >= size_.width || position.y >= size_.height)
+			return false;
+		const size_t index = static_cast<size_t>((position.y * size_.width) + position.x);
+		return ((bits[index / 64] >> (index % 64)) & 1) != 0;
+	}
+
+	Size size_;
+	std::vector<uint64_t> walkable_;
+	std::vector<uint64_t> notSolid_;
+};
+
+/**
+ * @brief Walking costs to a single target, shared by everyone heading there.
+ *
+ * Uses the same step costs as FindPath, but only looks at the walkability grid. Things that move around, like other
+ * monsters, can only make paths longer, so a tile the field can't reach the target from has no path for FindPath
+ * either.
+ */
+class FlowField {
+public:
+	static constexpr uint16_t Unreachable = std::numeric_limits<uint16_t>::max();
+
+	/**
+	 * @brief Computes the costs of reaching `target` from all tiles at most `maxPathLength` steps away.
+	 *
+	 * @param maxPathLength Must be less than 100.
+	 */
+	void build(const WalkabilityGrid &grid, Point target, size_t maxPathLength);
+
+	[[nodiscard]] Point target() const { return target_; }
+
+	/**
+	 * @brief Returns the cost of walking from `position` to the target, or Unreachable.
+	 */
+	[[nodiscard]] uint16_t cost(Point position) const
+	{
+		const Displacement offset = position - origin_;
+		if (offset.deltaX < 0 || offset.deltaY < 0 || offset.deltaX >= extent_ || offset.deltaY >= extent_)
+			return Unreachable;
+		return costs_[(offset.deltaY * extent_) + offset.deltaX];
+	}
+
+private:
+	Point target_;
+	Point origin_;
+	int extent_ = 0;
+	std::vector<uint16_t> costs_;
+	std::vector<uint32_t> queue_;
+};
+
+/**
+ * @brief Flow fields to a few targets on one walkability grid, kept until the grid changes.
+ *
+ * A field is only built for a target once a search for it has found no path. Such a search is the most expensive
+ * kind, and the field lets everyone else heading to the same target skip theirs. Targets that can be reached never
+ * get a field, so they cost nothing on top of FindPath.
+ */
+class FlowFieldCache {
+public:
+	/** Number of fields kept, enough for all players and a few golems */
+	static constexpr size_t Capacity = 8;
+
+	/**
+	 * @param maxPathLength Must be less than 100 and at most MaxPathLengthPlayer.
+	 */
+	explicit FlowFieldCache(size_t maxPathLength);
+
+	/**
+	 * @brief Returns the first step of the path FindPath finds from `start` to `target`, or 0 if it finds none.
+	 *
+	 * The result is always FindPath's, including how it breaks ties and walks around tiles rejected by `posOk`. The
+	 * search is only skipped when a field shows there is no path at all.
+	 *
+	 * @param grid Must be the grid of the fields kept so far. Call clear() when it changes.
+	 * @param canStep Must reject at least the steps the walkability grid rejects.
+	 * @param posOk Must reject at least the tiles the walkability grid doesn't mark as walkable.
+	 */
+	[[nodiscard]] int8_t firstStep(const WalkabilityGrid &grid, tl::function_ref<bool(Point, Point)> canStep, tl::function_ref<bool(Point)> posOk, Point start, Point target);
+
+	/** @brief Drops all fields, for when the grid has changed. */
+	void clear();
+
+	/** @brief The number of fields built since the cache was created. */
+	[[nodiscard]] size_t builds() const { return builds_; }
+
+private:
+	size_t maxPathLength_;
+	std::array<FlowField, Capacity> fields_;
+	size_t count_ = 0;
+	/** Field to replace once all of them are taken */
+	size_t next_ = 0;
+	size_t builds_ = 0;
+};
+
+} // namespace devilution
@@ -21,6 +21,7 @@
 #else
 #include "engine/load_file.hpp"
 #include "utils/cel_to_clx.hpp"
+#include "utils/clx_cache.hpp"
 #endif
 
 namespace devilution {
@@ -37,7 +38,9 @@ tl::expected<OwnedClxSpriteListOrSheet, std::string> LoadCelListOrSheetWithStatu
 #ifdef DEBUG_CEL_TO_CL2_SIZE
 	std::cout << path;
 #endif
-	return CelToClx(data.get(), size, widthOrWidths);
+	return ConvertToClxCached(ClxSourceFormat::Cel, data.get(), size, widthOrWidths, [&]() {
+		return CelToClx(data.get(), size, widthOrWidths);
+	});
 #endif
 }
 
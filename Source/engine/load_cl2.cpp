@@ -15,6 +15,7 @@
 #else
 #include "engine/load_file.hpp"
 #include "utils/cl2_to_clx.hpp"
+#include "utils/clx_cache.hpp"
 #endif
 
 namespace devilution {
@@ -28,7 +29,9 @@ tl::expected<OwnedClxSpriteListOrSheet, std::string> LoadCl2ListOrSheetWithStatu
 #else
 	size_t size;
 	ASSIGN_OR_RETURN(std::unique_ptr<uint8_t[]> data, LoadFileInMemWithStatus<uint8_t>(path, &size));
-	return Cl2ToClx(std::move(data), size, widthOrWidths);
+	return ConvertToClxCached(ClxSourceFormat::Cl2, data.get(), size, widthOrWidths, [&]() {
+		return Cl2ToClx(std::move(data), size, widthOrWidths);
+	});
 #endif
 }
 
@@ -151,6 +151,9 @@ struct MultiFileLoader {
 		}
 	};
 
+	/** Whether the files may be read while other threads read from the same archives. */
+	bool threadsafe = false;
+
 	/**
 	 * @param numFiles number of files to read
 	 * @param pathFn a function that returns the path for the given index
@@ -190,7 +193,7 @@ struct MultiFileLoader {
 		for (size_t i = 0, j = 0; i < numFiles; ++i) {
 			if (!filterFn(i))
 				continue;
-			AssetHandle handle = OpenAsset(std::move(files[j]));
+			AssetHandle handle = OpenAsset(std::move(files[j]), threadsafe);
 			if (!handle.ok() || !handle.read(&buf[outOffsets[j]], sizes[j])) {
 				FailedToOpenFileError(paths[j].data(), handle.error());
 			}
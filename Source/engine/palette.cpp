@@ -27,7 +27,9 @@
 #include "hwcursor.hpp"
 #include "options.h"
 #include "utils/display.h"
+#include "utils/file_util.h"
 #include "utils/palette_blending.hpp"
+#include "utils/paths.h"
 #include "utils/sdl_compat.h"
 #include "utils/str_cat.hpp"
 
@@ -170,6 +172,7 @@ void SystemPaletteUpdated(int first, int ncolor)
 void palette_init()
 {
 	LoadBrightness();
+	SetBlendedLookupTableCacheDir(StrCat(paths::PrefPath(), "cache" DIRECTORY_SEPARATOR_STR "palettes" DIRECTORY_SEPARATOR_STR));
 }
 
 void LoadPalette(const char *path)
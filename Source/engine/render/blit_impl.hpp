@@ -6,6 +6,7 @@
 #include <version>
 
 #include "engine/render/light_render.hpp"
+#include "engine/render/lightmap_blit.hpp"
 #include "utils/attributes.h"
 #include "utils/palette_blending.hpp"
 
@@ -78,6 +79,10 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithLightmap(uint8_t *DVL_RES
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
+	if (length >= LightmapBlitMinKernelLength) {
+		BlitLitPixels(dst, src, light, length, lightmap.lightTablesData());
+		return;
+	}
 	std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, dst, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
 		return lightmap.adjustColor(srcColor, lightLevel);
 	});
@@ -158,6 +163,10 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithLightmap(uint8_t *
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
+	if (length >= LightmapBlitMinKernelLength) {
+		BlitLitPixelsBlended(dst, src, light, length, lightmap.lightTablesData());
+		return;
+	}
 
 	if (length < 1024) {
 		uint8_t litSrc[1024];
@@ -6,7 +6,11 @@
 #include "clx_render.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <vector>
 
 #include "engine/point.hpp"
 #include "engine/render/blit_impl.hpp"
@@ -239,12 +243,40 @@ constexpr size_t MaxOutlineSpriteWidth = 253;
 using OutlinePixels = StaticVector<PointOf<uint8_t>, MaxOutlinePixels>;
 using OutlineRowSolidRuns = StaticVector<std::pair<uint8_t, uint8_t>, (MaxOutlineSpriteWidth / 2) + 1>;
 
-struct OutlinePixelsCacheEntry {
-	OutlinePixels outlinePixels;
-	const void *spriteData = nullptr;
+/** Number of sprite outlines remembered per thread, enough for every outlined monster, player, item and object on screen. */
+constexpr size_t OutlinePixelsCacheCapacity = 64;
+
+// The size of the sprite is part of the key, so that a sprite loaded where a freed one used to be
+// is unlikely to match even if `ClearClxDrawCache` was missed.
+struct OutlinePixelsCacheKey {
+	const void *spriteData;
+	uint32_t spriteDataSize;
+	uint16_t width;
+	uint16_t height;
 	bool skipColorIndexZero;
+
+	bool operator==(const OutlinePixelsCacheKey &other) const = default;
+};
+
+struct OutlinePixelsCacheKeyHash {
+	size_t operator()(const OutlinePixelsCacheKey &key) const
+	{
+		return std::hash<const void *> {}(key.spriteData) ^ (static_cast<size_t>(key.spriteDataSize) << 1) ^ static_cast<size_t>(key.skipColorIndexZero);
+	}
+};
+
+struct OutlinePixelsCacheState {
+	LruCache<OutlinePixelsCacheKey, std::vector<PointOf<uint8_t>>, OutlinePixelsCacheKeyHash> outlines { OutlinePixelsCacheCapacity };
+	/** Scratch buffer for computing an outline before it is copied into the cache. */
+	OutlinePixels scratch;
+	uint32_t generation = 0;
 };
-OutlinePixelsCacheEntry OutlinePixelsCache;
+
+// Outlines can be drawn from several render threads at once (see ParallelRender),
+// so each thread keeps its own cache. `ClearClxDrawCache` invalidates all of them
+// by bumping the generation.
+thread_local OutlinePixelsCacheState OutlinePixelsCache;
+std::atomic<uint32_t> OutlinePixelsCacheGeneration { 1 };
 
 void PopulateOutlinePixelsForRow(
     const OutlineRowSolidRuns &runs,
@@ -390,31 +422,36 @@ void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-f
 }
 
 template <bool SkipColorIndexZero>
-void UpdateOutlinePixelsCache(ClxSprite sprite)
+const std::vector<PointOf<uint8_t>> &GetCachedOutlinePixels(ClxSprite sprite)
 {
-	if (OutlinePixelsCache.spriteData == sprite.pixelData()
-	    && OutlinePixelsCache.skipColorIndexZero == SkipColorIndexZero) {
-		return;
+	OutlinePixelsCacheState &cache = OutlinePixelsCache;
+	const uint32_t generation = OutlinePixelsCacheGeneration.load(std::memory_order_relaxed);
+	if (cache.generation != generation) {
+		cache.outlines.clear();
+		cache.generation = generation;
 	}
-	OutlinePixelsCache.skipColorIndexZero = SkipColorIndexZero;
-	OutlinePixelsCache.spriteData = sprite.pixelData();
-	OutlinePixelsCache.outlinePixels.clear();
-	GetOutline<SkipColorIndexZero>(sprite, OutlinePixelsCache.outlinePixels);
+	const OutlinePixelsCacheKey key { sprite.pixelData(), sprite.pixelDataSize(), sprite.width(), sprite.height(), SkipColorIndexZero };
+	if (const std::vector<PointOf<uint8_t>> *cached = cache.outlines.find(key); cached != nullptr)
+		return *cached;
+
+	cache.scratch.clear();
+	GetOutline<SkipColorIndexZero>(sprite, cache.scratch);
+	return *cache.outlines.insert(key, std::vector<PointOf<uint8_t>>(cache.scratch.begin(), cache.scratch.end()));
 }
 
 template <bool SkipColorIndexZero>
 void RenderClxOutline(const Surface &out, Point position, ClxSprite sprite, uint8_t color)
 {
-	UpdateOutlinePixelsCache<SkipColorIndexZero>(sprite);
+	const std::vector<PointOf<uint8_t>> &outlinePixels = GetCachedOutlinePixels<SkipColorIndexZero>(sprite);
 	--position.x;
 	position.y -= sprite.height();
 	if (position.x >= 0 && position.x + sprite.width() + 2 < out.w()
 	    && position.y >= 0 && position.y + sprite.height() + 2 < out.h()) {
-		for (const auto &[x, y] : OutlinePixelsCache.outlinePixels) {
+		for (const auto &[x, y] : outlinePixels) {
 			*out.at(position.x + x, position.y + y) = color;
 		}
 	} else {
-		for (const auto &[x, y] : OutlinePixelsCache.outlinePixels) {
+		for (const auto &[x, y] : outlinePixels) {
 			out.SetPixel(Point(position.x + x, position.y + y), color);
 		}
 	}
@@ -621,7 +658,12 @@ void ClxDrawOutlineSkipColorZero(const Surface &out, uint8_t col, Point position
 
 void ClearClxDrawCache()
 {
-	OutlinePixelsCache.spriteData = nullptr;
+	OutlinePixelsCacheGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+LruCacheStats GetClxOutlineCacheStats()
+{
+	return OutlinePixelsCache.outlines.stats();
 }
 
 } // namespace devilution
@@ -16,6 +16,7 @@
 #include "engine/point.hpp"
 #include "engine/render/light_render.hpp"
 #include "engine/surface.hpp"
+#include "utils/lru_cache.hpp"
 
 namespace devilution {
 
@@ -124,6 +125,11 @@ std::pair<int, int> ClxMeasureSolidHorizontalBounds(ClxSprite clx);
  */
 void ClearClxDrawCache();
 
+/**
+ * @brief Returns the hit rate and size of the outline cache of the calling thread.
+ */
+LruCacheStats GetClxOutlineCacheStats();
+
 #ifdef DEBUG_CLX
 std::string ClxDescribe(ClxSprite clx);
 #endif
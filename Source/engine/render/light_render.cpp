@@ -579,4 +579,12 @@ Lightmap Lightmap::bleedUp(bool perPixelLighting, const Lightmap &source, Point
 	    source.lightTables, source.fullyLitLightTable_, source.fullyDarkLightTable_);
 }
 
+Lightmap Lightmap::subregionY(int y) const
+{
+	const size_t lightmapOffset = std::min(static_cast<size_t>(y) * lightmapPitch, lightmapBuffer.size());
+	return Lightmap(outBuffer + (static_cast<ptrdiff_t>(y) * outPitch), outPitch,
+	    lightmapBuffer.subspan(lightmapOffset), lightmapPitch,
+	    lightTables, fullyLitLightTable_, fullyDarkLightTable_);
+}
+
 } // namespace devilution
@@ -46,6 +46,9 @@ public:
 		return lightmapBuffer.data() + row * lightmapPitch + rowOffset;
 	}
 
+	/** @brief All of the light tables, one after the other. */
+	[[nodiscard]] const uint8_t *lightTablesData() const { return lightTables[0].data(); }
+
 	[[nodiscard]] bool isFullyLitLightTable(const uint8_t *lightTable) const { return lightTable == fullyLitLightTable_; }
 	[[nodiscard]] bool isFullyDarkLightTable(const uint8_t *lightTable) const { return lightTable == fullyDarkLightTable_; }
 
@@ -59,6 +62,14 @@ public:
 
 	static Lightmap bleedUp(bool perPixelLighting, const Lightmap &source, Point targetBufferPosition, std::span<uint8_t> lightmapBuffer);
 
+	/**
+	 * @brief Returns the lightmap for the part of the output buffer starting at row `y`,
+	 * e.g. for rendering into `out.subregionY(y, h)`.
+	 *
+	 * The slice keeps all of the lightmap rows below `y` so that "bleed up" behaves the same as with the full lightmap.
+	 */
+	[[nodiscard]] Lightmap subregionY(int y) const;
+
 private:
 	const uint8_t *outBuffer;
 	const uint16_t outPitch;
@@ -0,0 +1,299 @@
+#include "engine/render/lightmap_blit.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "engine/lighting_defs.hpp"
+#include "utils/attributes.h"
+#include "utils/palette_blending.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DEVILUTIONX_LIGHTMAP_BLIT_AVX2 1
+#include <immintrin.h>
+#else
+#define DEVILUTIONX_LIGHTMAP_BLIT_AVX2 0
+#endif
+
+// The table lookup instructions for more than 16 entries are only available on AArch64.
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define DEVILUTIONX_LIGHTMAP_BLIT_NEON 1
+#include <arm_neon.h>
+#else
+#define DEVILUTIONX_LIGHTMAP_BLIT_NEON 0
+#endif
+
+namespace devilution {
+
+namespace {
+
+constexpr int LightTablesSize = static_cast<int>(NumLightingLevels * LightTableSize);
+constexpr int BlendTableSize = 256 * 256;
+
+using BlitLitPixelsFn = void (*)(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables);
+
+DVL_ALWAYS_INLINE uint8_t LightPixel(uint8_t color, uint8_t lightLevel, const uint8_t *DVL_RESTRICT lightTables)
+{
+	return lightTables[(lightLevel * LightTableSize) + color];
+}
+
+void BlitLitPixelsScalar(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	for (unsigned i = 0; i < length; ++i) {
+		dst[i] = LightPixel(src[i], light[i], lightTables);
+	}
+}
+
+void BlitLitPixelsBlendedScalar(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	for (unsigned i = 0; i < length; ++i) {
+		dst[i] = paletteTransparencyLookup[dst[i]][LightPixel(src[i], light[i], lightTables)];
+	}
+}
+
+#if DEVILUTIONX_LIGHTMAP_BLIT_AVX2
+#define DVL_TARGET_AVX2 __attribute__((target("avx2")))
+
+/** @brief Combines two bytes per lane into `hi * 256 + lo` for 16 lanes. */
+DVL_TARGET_AVX2 DVL_ALWAYS_INLINE void MakeIndicesAvx2(__m128i hi, __m128i lo, __m256i &first, __m256i &second)
+{
+	first = _mm256_add_epi32(_mm256_slli_epi32(_mm256_cvtepu8_epi32(hi), 8), _mm256_cvtepu8_epi32(lo));
+	second = _mm256_add_epi32(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)), 8), _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+}
+
+/**
+ * @brief Looks up 16 bytes from `table`.
+ *
+ * The gather instructions load 4 bytes per lane, so lanes within 3 bytes of the end
+ * of the table are masked out of the gather and looked up separately.
+ */
+template <int TableSize>
+DVL_TARGET_AVX2 DVL_ALWAYS_INLINE __m128i GatherBytesAvx2(const uint8_t *DVL_RESTRICT table, __m256i first, __m256i second)
+{
+	const __m256i limit = _mm256_set1_epi32(TableSize - 3);
+	const __m256i firstInBounds = _mm256_cmpgt_epi32(limit, first);
+	const __m256i secondInBounds = _mm256_cmpgt_epi32(limit, second);
+	const auto *base = reinterpret_cast<const int *>(table);
+	const __m256i byteMask = _mm256_set1_epi32(0xFF);
+	const __m256i firstValues = _mm256_and_si256(_mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, first, firstInBounds, 1), byteMask);
+	const __m256i secondValues = _mm256_and_si256(_mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, second, secondInBounds, 1), byteMask);
+
+	// packus works within 128-bit lanes, so restore the order of the 64-bit blocks before narrowing to bytes.
+	const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(firstValues, secondValues), 0xD8);
+	__m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+
+	const auto inBoundsMask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(firstInBounds)))
+	    | (static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(secondInBounds))) << 8);
+	if (DVL_PREDICT_FALSE(inBoundsMask != 0xFFFF)) {
+		alignas(32) int32_t indices[16];
+		alignas(16) uint8_t values[16];
+		_mm256_store_si256(reinterpret_cast<__m256i *>(indices), first);
+		_mm256_store_si256(reinterpret_cast<__m256i *>(indices + 8), second);
+		_mm_store_si128(reinterpret_cast<__m128i *>(values), bytes);
+		for (unsigned i = 0; i < 16; ++i) {
+			if ((inBoundsMask & (1U << i)) == 0)
+				values[i] = table[indices[i]];
+		}
+		bytes = _mm_load_si128(reinterpret_cast<const __m128i *>(values));
+	}
+	return bytes;
+}
+
+DVL_TARGET_AVX2 DVL_ALWAYS_INLINE __m128i LightPixelsAvx2(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, const uint8_t *DVL_RESTRICT lightTables)
+{
+	__m256i first;
+	__m256i second;
+	MakeIndicesAvx2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(light)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), first, second);
+	return GatherBytesAvx2<LightTablesSize>(lightTables, first, second);
+}
+
+DVL_TARGET_AVX2 void BlitLitPixelsAvx2(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	unsigned i = 0;
+	for (; i + 16 <= length; i += 16) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), LightPixelsAvx2(src + i, light + i, lightTables));
+	}
+	BlitLitPixelsScalar(dst + i, src + i, light + i, length - i, lightTables);
+}
+
+DVL_TARGET_AVX2 void BlitLitPixelsBlendedAvx2(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	unsigned i = 0;
+	for (; i + 16 <= length; i += 16) {
+		const __m128i lit = LightPixelsAvx2(src + i, light + i, lightTables);
+		__m256i first;
+		__m256i second;
+		MakeIndicesAvx2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i)), lit, first, second);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), GatherBytesAvx2<BlendTableSize>(&paletteTransparencyLookup[0][0], first, second));
+	}
+	BlitLitPixelsBlendedScalar(dst + i, src + i, light + i, length - i, lightTables);
+}
+#endif // DEVILUTIONX_LIGHTMAP_BLIT_AVX2
+
+#if DEVILUTIONX_LIGHTMAP_BLIT_NEON
+/**
+ * Each light level present in a block of 16 pixels costs a full 256-byte table lookup,
+ * so blocks spanning more levels than this are lit with the scalar loop instead.
+ * Light levels change slowly across the screen, so most blocks only span one or two.
+ */
+constexpr uint8_t NeonMaxLightLevelSpan = 4;
+
+/** @brief Looks up 16 bytes in a 256-byte table. */
+DVL_ALWAYS_INLINE uint8x16_t LookupNeon(const uint8_t *DVL_RESTRICT table, uint8x16_t indices)
+{
+	const uint8x16_t offset = vdupq_n_u8(64);
+	uint8x16x4_t quarter = { { vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48) } };
+	uint8x16_t result = vqtbl4q_u8(quarter, indices);
+	for (int i = 1; i < 4; ++i) {
+		table += 64;
+		indices = vsubq_u8(indices, offset);
+		quarter = { { vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48) } };
+		// Indices outside of [0, 64) keep the value from the previous quarter.
+		result = vqtbx4q_u8(result, quarter, indices);
+	}
+	return result;
+}
+
+/** @return false if the block spans too many light levels */
+DVL_ALWAYS_INLINE bool LightPixelsNeon(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, const uint8_t *DVL_RESTRICT lightTables, uint8x16_t &result)
+{
+	const uint8x16_t levels = vld1q_u8(light);
+	const uint8_t minLevel = vminvq_u8(levels);
+	const uint8_t maxLevel = vmaxvq_u8(levels);
+	if (maxLevel - minLevel >= NeonMaxLightLevelSpan)
+		return false;
+
+	const uint8x16_t colors = vld1q_u8(src);
+	result = LookupNeon(lightTables + (minLevel * LightTableSize), colors);
+	for (unsigned level = minLevel + 1; level <= maxLevel; ++level) {
+		const uint8x16_t lit = LookupNeon(lightTables + (level * LightTableSize), colors);
+		result = vbslq_u8(vceqq_u8(levels, vdupq_n_u8(static_cast<uint8_t>(level))), lit, result);
+	}
+	return true;
+}
+
+void BlitLitPixelsNeon(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	unsigned i = 0;
+	for (; i + 16 <= length; i += 16) {
+		uint8x16_t lit;
+		if (LightPixelsNeon(src + i, light + i, lightTables, lit)) {
+			vst1q_u8(dst + i, lit);
+		} else {
+			BlitLitPixelsScalar(dst + i, src + i, light + i, 16, lightTables);
+		}
+	}
+	BlitLitPixelsScalar(dst + i, src + i, light + i, length - i, lightTables);
+}
+
+void BlitLitPixelsBlendedNeon(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	unsigned i = 0;
+	for (; i + 16 <= length; i += 16) {
+		uint8x16_t lit;
+		if (!LightPixelsNeon(src + i, light + i, lightTables, lit)) {
+			BlitLitPixelsBlendedScalar(dst + i, src + i, light + i, 16, lightTables);
+			continue;
+		}
+		// There is no byte gather on NEON and the blend table is far too large for table lookups.
+		uint8_t litColors[16];
+		vst1q_u8(litColors, lit);
+		for (unsigned j = 0; j < 16; ++j) {
+			dst[i + j] = paletteTransparencyLookup[dst[i + j]][litColors[j]];
+		}
+	}
+	BlitLitPixelsBlendedScalar(dst + i, src + i, light + i, length - i, lightTables);
+}
+#endif // DEVILUTIONX_LIGHTMAP_BLIT_NEON
+
+struct LightmapBlitKernels {
+	LightmapBlitIsa isa;
+	BlitLitPixelsFn blitLitPixels;
+	BlitLitPixelsFn blitLitPixelsBlended;
+};
+
+LightmapBlitKernels GetKernels(LightmapBlitIsa isa)
+{
+	switch (isa) {
+#if DEVILUTIONX_LIGHTMAP_BLIT_AVX2
+	case LightmapBlitIsa::AVX2:
+		return { isa, BlitLitPixelsAvx2, BlitLitPixelsBlendedAvx2 };
+#endif
+#if DEVILUTIONX_LIGHTMAP_BLIT_NEON
+	case LightmapBlitIsa::NEON:
+		return { isa, BlitLitPixelsNeon, BlitLitPixelsBlendedNeon };
+#endif
+	default:
+		return { LightmapBlitIsa::Scalar, BlitLitPixelsScalar, BlitLitPixelsBlendedScalar };
+	}
+}
+
+LightmapBlitKernels SelectBestKernels()
+{
+	for (const LightmapBlitIsa isa : { LightmapBlitIsa::AVX2, LightmapBlitIsa::NEON }) {
+		if (IsLightmapBlitIsaSupported(isa))
+			return GetKernels(isa);
+	}
+	return GetKernels(LightmapBlitIsa::Scalar);
+}
+
+LightmapBlitKernels Kernels = SelectBestKernels();
+
+} // namespace
+
+void BlitLitPixels(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	Kernels.blitLitPixels(dst, src, light, length, lightTables);
+}
+
+void BlitLitPixelsBlended(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables)
+{
+	Kernels.blitLitPixelsBlended(dst, src, light, length, lightTables);
+}
+
+bool IsLightmapBlitIsaSupported(LightmapBlitIsa isa)
+{
+	switch (isa) {
+	case LightmapBlitIsa::Scalar:
+		return true;
+	case LightmapBlitIsa::AVX2:
+#if DEVILUTIONX_LIGHTMAP_BLIT_AVX2
+		// May be called from static initializers, before the CPU features are otherwise known.
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	case LightmapBlitIsa::NEON:
+		return DEVILUTIONX_LIGHTMAP_BLIT_NEON != 0;
+	}
+	return false;
+}
+
+bool SetLightmapBlitIsa(LightmapBlitIsa isa)
+{
+	if (!IsLightmapBlitIsaSupported(isa))
+		return false;
+	Kernels = GetKernels(isa);
+	return true;
+}
+
+LightmapBlitIsa GetLightmapBlitIsa()
+{
+	return Kernels.isa;
+}
+
+std::string_view LightmapBlitIsaToString(LightmapBlitIsa isa)
+{
+	switch (isa) {
+	case LightmapBlitIsa::Scalar:
+		return "Scalar";
+	case LightmapBlitIsa::AVX2:
+		return "AVX2";
+	case LightmapBlitIsa::NEON:
+		return "NEON";
+	}
+	return "";
+}
+
+} // namespace devilution
@@ -0,0 +1,52 @@
+/**
+ * @file lightmap_blit.hpp
+ *
+ * Line kernels for per-pixel lighting, with SIMD implementations selected at runtime.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "utils/attributes.h"
+
+namespace devilution {
+
+enum class LightmapBlitIsa : uint8_t {
+	Scalar,
+	AVX2,
+	NEON,
+};
+
+/** @brief Lines shorter than this are cheaper to light inline than through the kernels. */
+constexpr unsigned LightmapBlitMinKernelLength = 16;
+
+/**
+ * @brief Lights a line of pixels: `dst[i] = lightTables[light[i] * LightTableSize + src[i]]`.
+ * @param lightTables `NumLightingLevels` consecutive light tables
+ */
+void BlitLitPixels(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables);
+
+/**
+ * @brief Lights a line of pixels and blends them with the destination:
+ * `dst[i] = paletteTransparencyLookup[dst[i]][lightTables[light[i] * LightTableSize + src[i]]]`.
+ * @param lightTables `NumLightingLevels` consecutive light tables
+ */
+void BlitLitPixelsBlended(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, const uint8_t *DVL_RESTRICT lightTables);
+
+[[nodiscard]] bool IsLightmapBlitIsaSupported(LightmapBlitIsa isa);
+
+/**
+ * @brief Selects the kernels used by BlitLitPixels and BlitLitPixelsBlended.
+ *
+ * The best supported instruction set is selected on startup, this is meant for tests and benchmarks.
+ * Must not be called while rendering.
+ * @return false if the instruction set is not supported by this build or CPU
+ */
+bool SetLightmapBlitIsa(LightmapBlitIsa isa);
+
+[[nodiscard]] LightmapBlitIsa GetLightmapBlitIsa();
+
+[[nodiscard]] std::string_view LightmapBlitIsaToString(LightmapBlitIsa isa);
+
+} // namespace devilution
@@ -0,0 +1,156 @@
+#include "engine/render/render_workers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_cpuinfo.h>
+#else
+#include <SDL.h>
+#endif
+
+#include <function_ref.hpp>
+
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+/** Upper bound for the number of threads rendering at once, including the main thread. */
+constexpr size_t MaxRenderConcurrency = 8;
+
+size_t DetectConcurrency()
+{
+#if defined(__DJGPP__) || defined(__EMSCRIPTEN__) || defined(USE_SDL1)
+	return 1;
+#else
+#ifdef USE_SDL3
+	const int cpuCount = SDL_GetNumLogicalCPUCores();
+#else
+	const int cpuCount = SDL_GetCPUCount();
+#endif
+	return std::clamp<size_t>(static_cast<size_t>(std::max(cpuCount, 1)), 1, MaxRenderConcurrency);
+#endif
+}
+
+class RenderWorkerPool {
+public:
+	explicit RenderWorkerPool(size_t numWorkers)
+	{
+		workers_.reserve(numWorkers);
+		for (size_t i = 0; i < numWorkers; ++i) {
+			workers_.emplace_back(WorkerMain, this);
+		}
+	}
+
+	~RenderWorkerPool()
+	{
+		quit_ = true;
+		for (size_t i = 0; i < workers_.size(); ++i) {
+			jobReady_.post();
+		}
+		for (SdlThread &worker : workers_) {
+			worker.join();
+		}
+	}
+
+	RenderWorkerPool(const RenderWorkerPool &) = delete;
+	RenderWorkerPool &operator=(const RenderWorkerPool &) = delete;
+
+	[[nodiscard]] size_t concurrency() const
+	{
+		return workers_.size() + 1;
+	}
+
+	void run(size_t count, tl::function_ref<void(size_t)> job)
+	{
+		job_ = &job;
+		count_ = count;
+		nextIndex_.store(1, std::memory_order_relaxed);
+
+		// Only wake up as many workers as there are indices left for them.
+		const size_t numWorkers = std::min(workers_.size(), count - 1);
+		for (size_t i = 0; i < numWorkers; ++i) {
+			jobReady_.post();
+		}
+
+		job(0);
+		processJobs();
+
+		for (size_t i = 0; i < numWorkers; ++i) {
+			jobDone_.wait();
+		}
+		job_ = nullptr;
+	}
+
+private:
+	static int SDLCALL WorkerMain(void *data)
+	{
+		auto &pool = *static_cast<RenderWorkerPool *>(data);
+		while (true) {
+			pool.jobReady_.wait();
+			if (pool.quit_)
+				return 0;
+			pool.processJobs();
+			pool.jobDone_.post();
+		}
+	}
+
+	void processJobs()
+	{
+		for (size_t i = nextIndex_.fetch_add(1, std::memory_order_relaxed); i < count_; i = nextIndex_.fetch_add(1, std::memory_order_relaxed)) {
+			(*job_)(i);
+		}
+	}
+
+	std::vector<SdlThread> workers_;
+	SdlSemaphore jobReady_;
+	SdlSemaphore jobDone_;
+	bool quit_ = false;
+
+	// The fields below are published to the workers by `jobReady_` and handed back by `jobDone_`.
+	const tl::function_ref<void(size_t)> *job_ = nullptr;
+	size_t count_ = 0;
+	std::atomic<size_t> nextIndex_ { 0 };
+};
+
+size_t Concurrency;
+std::unique_ptr<RenderWorkerPool> Pool;
+
+} // namespace
+
+size_t RenderConcurrency()
+{
+	if (Concurrency == 0) {
+		Concurrency = DetectConcurrency();
+		if (Concurrency > 1)
+			Pool = std::make_unique<RenderWorkerPool>(Concurrency - 1);
+	}
+	return Concurrency;
+}
+
+void ParallelRender(size_t count, tl::function_ref<void(size_t)> job)
+{
+	if (count == 0)
+		return;
+	if (count == 1 || RenderConcurrency() == 1) {
+		for (size_t i = 0; i < count; ++i) {
+			job(i);
+		}
+		return;
+	}
+	Pool->run(count, job);
+}
+
+void ShutdownRenderWorkers()
+{
+	Pool = nullptr;
+	Concurrency = 0;
+}
+
+} // namespace devilution
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+#include <function_ref.hpp>
+
+namespace devilution {
+
+/**
+ * @brief Number of threads that take part in ParallelRender, including the calling thread.
+ *
+ * Starts the worker threads on first use.
+ */
+[[nodiscard]] size_t RenderConcurrency();
+
+/**
+ * @brief Calls `job` for every index in `[0, count)`, spreading the calls over the render worker threads.
+ *
+ * The calling thread takes part in the work and always runs index 0 itself,
+ * so anything that must happen on the main thread can be tied to that index.
+ * Returns once all calls have completed.
+ */
+void ParallelRender(size_t count, tl::function_ref<void(size_t)> job);
+
+/**
+ * @brief Stops and joins the render worker threads.
+ */
+void ShutdownRenderWorkers();
+
+} // namespace devilution
@@ -5,6 +5,7 @@
  */
 #include "engine/render/scrollrt.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -34,6 +35,7 @@
 #include "engine/render/clx_render.hpp"
 #include "engine/render/dun_render.hpp"
 #include "engine/render/light_render.hpp"
+#include "engine/render/render_workers.hpp"
 #include "engine/render/text_render.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
@@ -51,6 +53,7 @@
 #include "lua/lua_event.hpp"
 #include "minitext.h"
 #include "missiles.h"
+#include "monsters/hot_data.hpp"
 #include "nthread.h"
 #include "options.h"
 #include "panels/charpanel.hpp"
@@ -73,6 +76,7 @@
 #include "utils/log.hpp"
 #include "utils/sdl_compat.h"
 #include "utils/str_cat.hpp"
+#include "utils/trace.hpp"
 
 #ifndef USE_SDL1
 #include "controls/touch/renderers.h"
@@ -500,11 +504,8 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
  */
 void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
-	dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
-
 	for (const Player &player : Players) {
 		if (player.plractive && player.hasNoLife() && player.isOnActiveLevel() && player.position.tile == tilePosition) {
-			dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
 			const Point playerRenderPosition { targetBufferPosition };
 			DrawPlayer(out, player, tilePosition, playerRenderPosition, lightTableIndex);
 		}
@@ -535,7 +536,7 @@ void DrawObject(const Surface &out, const Object &objectToDraw, Point tilePositi
 	}
 }
 
-static void DrawDungeon(const Surface & /*out*/, const Lightmap & /*lightmap*/, Point /*tilePosition*/, Point /*targetBufferPosition*/);
+static void DrawDungeon(const Surface & /*out*/, const Lightmap & /*lightmap*/, Point /*tilePosition*/, Point /*targetBufferPosition*/, int /*bandY*/);
 
 /**
  * @brief Render a cell
@@ -707,9 +708,9 @@ void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosit
  * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
- * @param pre Is the sprite in the background
+ * @param queueLabel Add the item to the label queue
  */
-void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition, int lightTableIndex)
+void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition, int lightTableIndex, bool queueLabel)
 {
 	const Item &item = Items[itemIndex];
 	const ClxSprite sprite = item.AnimInfo.currentSprite();
@@ -718,7 +719,7 @@ void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition,
 		ClxDrawOutlineSkipColorZero(out, GetOutlineColor(item, false), position, sprite);
 	}
 	ClxDrawLight(out, position, sprite, lightTableIndex);
-	if (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK)
+	if (queueLabel && (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK))
 		AddItemToLabelQueue(itemIndex, position);
 }
 
@@ -754,10 +755,10 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		return;
 	}
 
-	const auto &monster = Monsters[mi];
-	if ((monster.flags & MFLAG_HIDDEN) != 0) {
+	if ((MonstersHot.flags[mi] & MFLAG_HIDDEN) != 0) {
 		return;
 	}
+	const auto &monster = Monsters[mi];
 
 	const ClxSprite sprite = monster.animInfo.currentSprite();
 	const Displacement offset = monster.getRenderingOffset(sprite);
@@ -775,10 +776,13 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
  * @param lightmap Per-pixel light buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
+ * @param bandY Offset of the target buffer within the view
  */
-void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
+void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int bandY)
 {
 	assert(InDungeonBounds(tilePosition));
+	// Item labels are only queued by the main thread, which renders the top band
+	const bool queueLabels = bandY == 0;
 	const int lightTableIndex = dLight[tilePosition.x][tilePosition.y];
 
 	DrawCell(out, lightmap, tilePosition, targetBufferPosition, lightTableIndex);
@@ -816,7 +820,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
 	}
 	if (bItem > 0 && !Items[bItem - 1]._iPostDraw) {
-		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
+		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex, queueLabels);
 	}
 
 	if (TileContainsDeadPlayer(tilePosition)) {
@@ -902,7 +906,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
 	}
 	if (bItem > 0 && Items[bItem - 1]._iPostDraw) {
-		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
+		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex, queueLabels);
 	}
 
 	if (leveltype != DTYPE_TOWN) {
@@ -933,7 +937,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		// Tree leaves should always cover player when entering or leaving the tile,
 		// So delay the rendering until after the next row is being drawn.
 		// This could probably have been better solved by sprites in screen space.
-		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y > TILE_HEIGHT) {
+		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y + bandY > TILE_HEIGHT) {
 			const int8_t bArch = dSpecial[tilePosition.x - 1][tilePosition.y - 1] - 1;
 			if (bArch >= 0)
 				ClxDraw(out, targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, (*pSpecialCels)[bArch]);
@@ -941,6 +945,45 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 	}
 }
 
+/**
+ * @brief Clear stale dead player flags from the tiles in view
+ *
+ * This is done ahead of rendering since the tiles are drawn by several threads at once.
+ * @param tilePosition dPiece coordinates
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+void RefreshDeadPlayerFlags(Point tilePosition, int rows, int columns)
+{
+	// Cover the same tiles as DrawTileContent
+	rows += MicroTileLen;
+
+	for (int i = 0; i < rows; i++) {
+		for (int j = 0; j < columns; j++, tilePosition += Direction::East) {
+			if (!TileContainsDeadPlayer(tilePosition))
+				continue;
+			dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
+			for (const Player &player : Players) {
+				if (player.plractive && player.hasNoLife() && player.isOnActiveLevel() && player.position.tile == tilePosition) {
+					dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
+					break;
+				}
+			}
+		}
+		// Return to start of row
+		tilePosition += Displacement(Direction::West) * columns;
+
+		// Jump to next row
+		if ((i & 1) != 0) {
+			tilePosition.x++;
+			columns--;
+		} else {
+			tilePosition.y++;
+			columns++;
+		}
+	}
+}
+
 /**
  * @brief Render a row of tiles
  * @param out Buffer to render to
@@ -986,14 +1029,16 @@ void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition,
  * @param targetBufferPosition Buffer coordinates
  * @param rows Number of rows
  * @param columns Tile in a row
+ * @param bandY Offset of the target buffer within the view
  */
-void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns, int bandY)
 {
 	// Keep evaluating until MicroTiles can't affect screen
 	rows += MicroTileLen;
 
 #ifdef _DEBUG
-	DebugCoordsMap.reserve(rows * columns);
+	if (bandY == 0)
+		DebugCoordsMap.reserve(rows * columns);
 #endif
 
 	for (int i = 0; i < rows; i++) {
@@ -1002,7 +1047,8 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 			if (InDungeonBounds(tilePosition)) {
 				bool skipNext = false;
 #ifdef _DEBUG
-				DebugCoordsMap[tilePosition.x + (tilePosition.y * MAXDUNX)] = targetBufferPosition;
+				if (bandY == 0)
+					DebugCoordsMap[tilePosition.x + (tilePosition.y * MAXDUNX)] = targetBufferPosition;
 #endif
 				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
 					// Render objects behind walls first to prevent sprites, that are moving
@@ -1011,13 +1057,13 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 					// sprite screen position rather than tile position.
 					if (IsWall(tilePosition) && (IsWall(tilePosition + Displacement { 1, 0 }) || (tilePosition.x > 0 && IsWall(tilePosition + Displacement { -1, 0 })))) { // Part of a wall aligned on the x-axis
 						if (IsTileNotSolid(tilePosition + Displacement { 1, -1 }) && IsTileNotSolid(tilePosition + Displacement { 0, -1 })) {                              // Has walkable area behind it
-							DrawDungeon(out, lightmap, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
+							DrawDungeon(out, lightmap, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y }, bandY);
 							skipNext = true;
 						}
 					}
 				}
 				if (!skip) {
-					DrawDungeon(out, lightmap, tilePosition, targetBufferPosition);
+					DrawDungeon(out, lightmap, tilePosition, targetBufferPosition, bandY);
 				}
 				skip = skipNext;
 			}
@@ -1113,6 +1159,27 @@ void DrawOOB(const Surface &out, const Lightmap &lightmap, Point tilePosition, P
 	}
 }
 
+/**
+ * @brief Number of horizontal bands to split the view into, one per render thread.
+ */
+size_t GetRenderBandCount(const Surface &out)
+{
+#ifdef DUN_RENDER_STATS
+	// The render stats are not thread-safe
+	return 1;
+#else
+#ifdef _DEBUG
+	// The path indices are drawn with the text renderer, which is not thread-safe
+	if (DebugPath)
+		return 1;
+#endif
+	// Below this, the bands mostly walk over tiles that end up clipped
+	constexpr int MinBandHeight = TILE_HEIGHT * 2;
+	const size_t maxBands = static_cast<size_t>(std::max(out.h() / MinBandHeight, 1));
+	return std::min(RenderConcurrency(), maxBands);
+#endif
+}
+
 /**
  * @brief Scale up the top left part of the buffer 2x.
  */
@@ -1226,6 +1293,7 @@ void CalcFirstTilePosition(Point &position, Displacement &offset)
  */
 void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 {
+	const TraceZone traceZone("DrawGame");
 	// Limit rendering to the view area
 	const Surface &out = !*GetOptions().Graphics.zoom
 	    ? fullOut.subregionY(0, gnViewportHeight)
@@ -1271,14 +1339,27 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 	DunRenderStats.clear();
 #endif
 
-	Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
+	const Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
 	    gnScreenWidth, gnViewportHeight, rows, columns,
 	    out.at(0, 0), out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
 	    dLight, MicroTileLen);
 
-	DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawOOB(out, lightmap, position, Point {} + offset, rows, columns);
+	RefreshDeadPlayerFlags(position, rows, columns);
+
+	// Each band walks all of the tiles but only draws the pixels within its own rows,
+	// so the result is the same as drawing the whole view at once.
+	const size_t bandCount = GetRenderBandCount(out);
+	const int bandHeight = (out.h() + static_cast<int>(bandCount) - 1) / static_cast<int>(bandCount);
+	ParallelRender(bandCount, [&](size_t band) {
+		const int y = static_cast<int>(band) * bandHeight;
+		const Surface bandOut = out.subregionY(y, std::min(bandHeight, out.h() - y));
+		const Lightmap bandLightmap = lightmap.subregionY(y);
+		const Point targetBufferPosition = Point {} + offset - Displacement { 0, y };
+
+		DrawFloor(bandOut, bandLightmap, position, targetBufferPosition, rows, columns);
+		DrawTileContent(bandOut, bandLightmap, position, targetBufferPosition, rows, columns, y);
+		DrawOOB(bandOut, bandLightmap, position, targetBufferPosition, rows, columns);
+	});
 
 	if (*GetOptions().Graphics.zoom) {
 		Zoom(fullOut.subregionY(0, gnViewportHeight));
@@ -1834,6 +1915,7 @@ void DrawAndBlit()
 	if (!gbRunGame || HeadlessMode) {
 		return;
 	}
+	const TraceZone traceZone("DrawAndBlit");
 
 	int hgt = 0;
 	bool drawHealth = IsRedrawComponent(PanelDrawComponent::Health);
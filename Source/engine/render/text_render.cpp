@@ -10,9 +10,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <fmt/core.h>
@@ -35,6 +38,7 @@
 #include "utils/is_of.hpp"
 #include "utils/language.h"
 #include "utils/log.hpp"
+#include "utils/lru_cache.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/utf8.hpp"
 
@@ -186,12 +190,17 @@ uint32_t GetFontId(GameFontTables size, uint16_t row)
 	return (size << 16) | row;
 }
 
-FontStack LoadFont(GameFontTables size, text_color color, uint16_t row)
+void LoadColorTranslation(text_color color)
 {
 	if (ColorTranslations[color] != nullptr && !ColorTranslationsData[color]) {
 		ColorTranslationsData[color].emplace();
 		LoadFileInMem(ColorTranslations[color], *ColorTranslationsData[color]);
 	}
+}
+
+FontStack LoadFont(GameFontTables size, text_color color, uint16_t row)
+{
+	LoadColorTranslation(color);
 
 	const uint32_t fontId = GetFontId(size, row);
 	auto hotFont = Fonts.find(fontId);
@@ -267,6 +276,110 @@ private:
 	uint32_t currentUnicodeRow_ = 0;
 };
 
+/** A decoded codepoint together with the glyph that represents it. */
+struct ShapedGlyph {
+	/** The glyph, none for zero-width spaces. */
+	OptionalClxSprite sprite;
+	/** The codepoint, '?' if there is no font for it. */
+	char32_t codepoint;
+	uint32_t byteOffset;
+	uint8_t byteLength;
+
+	[[nodiscard]] int width() const
+	{
+		return sprite ? sprite->width() : 0;
+	}
+};
+
+/** The glyphs of a text in a font size, up to the first invalid UTF-8 sequence. */
+struct ShapedText {
+	std::string text;
+	GameFontTables size;
+	std::vector<ShapedGlyph> glyphs;
+};
+
+struct WrappedText {
+	std::string text;
+	GameFontTables size;
+	int spacing;
+	unsigned width;
+	std::string wrapped;
+};
+
+/** Glyph runs of recently drawn or measured texts, keyed by HashText. */
+LruCache<uint64_t, ShapedText> ShapedTexts { 1024 };
+/** Recent results of WordWrapString, keyed by HashText. */
+LruCache<uint64_t, WrappedText> WrappedTexts { 256 };
+
+uint64_t HashText(std::string_view text, GameFontTables size, int spacing = 0, unsigned width = 0)
+{
+	uint64_t hash = ankerl::unordered_dense::hash<std::string_view> {}(text);
+	for (const uint64_t value : { static_cast<uint64_t>(size), static_cast<uint64_t>(static_cast<uint32_t>(spacing)), static_cast<uint64_t>(width) }) {
+		hash = (hash ^ value) * 0x9E3779B97F4A7C15ULL;
+	}
+	return hash;
+}
+
+/**
+ * @brief Decodes the text and looks up its glyphs, or returns the cached result of doing so.
+ *
+ * The returned glyphs stay valid until the next call, as that may evict them.
+ */
+std::span<const ShapedGlyph> ShapeText(std::string_view text, GameFontTables size)
+{
+	const uint64_t key = HashText(text, size);
+	if (const ShapedText *cached = ShapedTexts.find(key); cached != nullptr && cached->size == size && cached->text == text)
+		return cached->glyphs;
+
+	ShapedText shaped { std::string(text), size, {} };
+	shaped.glyphs.reserve(text.size());
+	CurrentFont currentFont;
+	std::string_view remaining = text;
+	size_t cpLen;
+	for (char32_t next; !remaining.empty() && (next = DecodeFirstUtf8CodePoint(remaining, &cpLen)) != Utf8DecodeError; remaining.remove_prefix(cpLen)) {
+		const auto byteOffset = static_cast<uint32_t>(text.size() - remaining.size());
+		if (next == ZWSP) {
+			shaped.glyphs.push_back(ShapedGlyph { std::nullopt, next, byteOffset, static_cast<uint8_t>(cpLen) });
+			continue;
+		}
+
+		if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
+			next = U'?';
+			if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
+				app_fatal("Missing fonts");
+			}
+		}
+		shaped.glyphs.push_back(ShapedGlyph { currentFont.glyph(next & 0xFF), next, byteOffset, static_cast<uint8_t>(cpLen) });
+	}
+
+	return ShapedTexts.insert(key, std::move(shaped))->glyphs;
+}
+
+/** @brief Returns the offset of the byte after the last glyph. */
+size_t GetShapedTextEnd(std::span<const ShapedGlyph> glyphs)
+{
+	return glyphs.empty() ? 0 : glyphs.back().byteOffset + glyphs.back().byteLength;
+}
+
+/** @brief Same as GetLineWidth, for already shaped text. */
+int GetShapedLineWidth(std::span<const ShapedGlyph> glyphs, int spacing, int *charactersInLine = nullptr)
+{
+	int lineWidth = 0;
+	uint32_t codepoints = 0;
+	for (const ShapedGlyph &glyph : glyphs) {
+		if (glyph.codepoint == ZWSP)
+			continue;
+		if (glyph.codepoint == U'\n')
+			break;
+		lineWidth += glyph.width() + spacing;
+		++codepoints;
+	}
+	if (charactersInLine != nullptr)
+		*charactersInLine = codepoints;
+
+	return lineWidth != 0 ? (lineWidth - spacing) : 0;
+}
+
 void DrawFont(const Surface &out, Point position, ClxSprite glyph, text_color color, bool outline)
 {
 	if (outline) {
@@ -439,7 +552,7 @@ int GetLineStartX(UiFlags flags, const Rectangle &rect, int lineWidth)
 
 void DrawLine(
     const Surface &out,
-    std::string_view text,
+    std::span<const ShapedGlyph> glyphs,
     Point characterPosition,
     Rectangle rect,
     UiFlags flags,
@@ -448,17 +561,12 @@ void DrawLine(
     text_color color,
     bool outline,
     const TextRenderOptions &opts,
-    size_t lineStartPos,
+    size_t lineEndPos,
     int totalWidth)
 {
-	CurrentFont currentFont;
-
-	size_t currentPos = 0;
-
-	const auto maybeDrawCursor = [&]() {
-		const auto byteIndex = static_cast<int>(lineStartPos + currentPos);
+	const auto maybeDrawCursor = [&](size_t byteIndex) {
 		Point position = characterPosition;
-		if (opts.cursorPosition == byteIndex) {
+		if (opts.cursorPosition == static_cast<int>(byteIndex)) {
 			if (GetAnimationFrame(2, 500) != 0 || opts.cursorStatic) {
 				FontStack baseFont = LoadFont(size, color, 0);
 				if (baseFont.has_value()) {
@@ -474,76 +582,56 @@ void DrawLine(
 	// Start from the beginning of the line
 	characterPosition.x = GetLineStartX(flags, rect, totalWidth);
 
-	for (auto it = Utf8CodePoints(text).begin(), itEnd = Utf8CodePoints(text).end();
-	     it != itEnd; ++it) {
-		char32_t c = *it;
-		if (c == Utf8DecodeError) break;
-		const auto cpLen = it.size();
-		if (c == ZWSP) {
-			currentPos += cpLen;
+	for (const ShapedGlyph &glyph : glyphs) {
+		if (glyph.codepoint == ZWSP)
 			continue;
-		}
 
-		if (!currentFont.load(size, color, c)) {
-			c = U'?';
-			if (!currentFont.load(size, color, c)) {
-				app_fatal("Missing fonts");
-			}
-		}
-		const uint8_t frame = c & 0xFF;
+		const ClxSprite sprite = *glyph.sprite;
+		const int charWidth = sprite.width();
 
-		const ClxSprite glyph = currentFont.glyph(frame);
-		const int charWidth = glyph.width();
-
-		const auto byteIndex = static_cast<int>(lineStartPos + currentPos);
+		const auto byteIndex = static_cast<int>(glyph.byteOffset);
 
 		// Draw highlight
 		if (byteIndex >= opts.highlightRange.begin && byteIndex < opts.highlightRange.end) {
-			const bool lastInRange = static_cast<int>(byteIndex + cpLen) == opts.highlightRange.end;
+			const bool lastInRange = static_cast<int>(byteIndex + glyph.byteLength) == opts.highlightRange.end;
 			FillRect(out, characterPosition.x, characterPosition.y,
-			    glyph.width() + (lastInRange ? 0 : curSpacing), glyph.height(),
+			    sprite.width() + (lastInRange ? 0 : curSpacing), sprite.height(),
 			    opts.highlightColor);
 		}
 
-		DrawFont(out, characterPosition, glyph, color, outline);
-		maybeDrawCursor();
+		DrawFont(out, characterPosition, sprite, color, outline);
+		maybeDrawCursor(glyph.byteOffset);
 
 		// Move to the next position
 		characterPosition.x += charWidth + curSpacing;
-		currentPos += cpLen;
 	}
-	assert(currentPos == text.size());
-	maybeDrawCursor();
+	maybeDrawCursor(lineEndPos);
 }
 
-uint32_t DoDrawString(const Surface &out, std::string_view text, Rectangle rect, Point &characterPosition,
+uint32_t DoDrawString(const Surface &out, std::string_view text, std::span<const ShapedGlyph> glyphs, Rectangle rect, Point &characterPosition,
     int lineWidth, int charactersInLine, int rightMargin, int bottomMargin, GameFontTables size, text_color color, bool outline,
     TextRenderOptions &opts)
 {
-	CurrentFont currentFont;
 	int curSpacing = opts.spacing;
 	if (HasAnyOf(opts.flags, UiFlags::KerningFitSpacing)) {
 		curSpacing = AdjustSpacingToFitHorizontally(lineWidth, opts.spacing, charactersInLine, rect.size.width);
 		if (curSpacing != opts.spacing && HasAnyOf(opts.flags, UiFlags::AlignCenter | UiFlags::AlignRight)) {
-			const int adjustedLineWidth = GetLineWidth(text, size, curSpacing, &charactersInLine);
+			const int adjustedLineWidth = GetShapedLineWidth(glyphs, curSpacing, &charactersInLine);
 			characterPosition.x = GetLineStartX(opts.flags, rect, adjustedLineWidth);
 		}
 	}
 
-	char32_t next;
-	std::string_view remaining = text;
-	size_t cpLen;
-
-	// Track line boundaries
+	// Track line boundaries, both as byte offsets and as glyph indices
 	size_t lineStartPos = 0;
 	size_t lineEndPos = 0;
+	size_t lineStartGlyph = 0;
+	size_t lineEndGlyph = 0;
 
 	const auto drawLine = [&]() {
-		std::string_view lineText = text.substr(lineStartPos, lineEndPos - lineStartPos);
-		if (!lineText.empty()) {
+		if (lineStartPos < lineEndPos) {
 			DrawLine(
 			    out,
-			    lineText,
+			    glyphs.subspan(lineStartGlyph, lineEndGlyph - lineStartGlyph),
 			    characterPosition,
 			    rect,
 			    opts.flags,
@@ -552,28 +640,22 @@ uint32_t DoDrawString(const Surface &out, std::string_view text, Rectangle rect,
 			    color,
 			    outline,
 			    opts,
-			    lineStartPos,
+			    lineEndPos,
 			    lineWidth);
 		}
 	};
 
-	for (; !remaining.empty() && remaining[0] != '\0'
-	     && (next = DecodeFirstUtf8CodePoint(remaining, &cpLen)) != Utf8DecodeError;
-	     remaining.remove_prefix(cpLen)) {
-		if (next == ZWSP)
+	size_t i = 0;
+	for (; i < glyphs.size() && glyphs[i].codepoint != U'\0'; ++i) {
+		const ShapedGlyph &glyph = glyphs[i];
+		if (glyph.codepoint == ZWSP)
 			continue;
 
-		if (!currentFont.load(size, color, next)) {
-			next = U'?';
-			if (!currentFont.load(size, color, next)) {
-				app_fatal("Missing fonts");
-			}
-		}
-
-		const uint8_t frame = next & 0xFF;
-		const uint16_t width = currentFont.glyph(frame).width();
-		if (next == U'\n' || characterPosition.x + width > rightMargin) {
-			lineEndPos = text.size() - remaining.size();
+		const bool isNewline = glyph.codepoint == U'\n';
+		const int width = glyph.width();
+		if (isNewline || characterPosition.x + width > rightMargin) {
+			lineEndPos = glyph.byteOffset;
+			lineEndGlyph = i;
 
 			drawLine();
 
@@ -583,38 +665,39 @@ uint32_t DoDrawString(const Surface &out, std::string_view text, Rectangle rect,
 			characterPosition.y = nextLineY;
 
 			if (HasAnyOf(opts.flags, UiFlags::KerningFitSpacing)) {
-				int nextLineWidth = GetLineWidth(remaining.substr(cpLen), size, opts.spacing, &charactersInLine);
+				int nextLineWidth = GetShapedLineWidth(glyphs.subspan(i + 1), opts.spacing, &charactersInLine);
 				curSpacing = AdjustSpacingToFitHorizontally(nextLineWidth, opts.spacing, charactersInLine, rect.size.width);
 			}
 
 			if (HasAnyOf(opts.flags, UiFlags::AlignCenter | UiFlags::AlignRight)) {
 				lineWidth = width;
-				if (remaining.size() > cpLen)
-					lineWidth += curSpacing + GetLineWidth(remaining.substr(cpLen), size, curSpacing);
+				if (glyph.byteOffset + glyph.byteLength < text.size())
+					lineWidth += curSpacing + GetShapedLineWidth(glyphs.subspan(i + 1), curSpacing);
 			}
 			characterPosition.x = GetLineStartX(opts.flags, rect, lineWidth);
 
 			// Start a new line
-			lineStartPos = next == U'\n' ? (text.size() - remaining.size() + cpLen) : (text.size() - remaining.size());
+			lineStartPos = isNewline ? glyph.byteOffset + glyph.byteLength : glyph.byteOffset;
+			lineStartGlyph = isNewline ? i + 1 : i;
 			lineEndPos = lineStartPos;
+			lineEndGlyph = lineStartGlyph;
 
-			if (next == U'\n')
+			if (isNewline)
 				continue;
 		}
 
 		// Update end position as we add characters
-		lineEndPos = text.size() - remaining.size() + cpLen;
+		lineEndPos = glyph.byteOffset + glyph.byteLength;
+		lineEndGlyph = i + 1;
 
 		// Update position for the next character
 		characterPosition.x += width + curSpacing;
 	}
 
 	// Draw any remaining characters in the last line
-	if (lineStartPos < lineEndPos) {
-		drawLine();
-	}
+	drawLine();
 
-	return static_cast<uint32_t>(remaining.data() - text.data());
+	return static_cast<uint32_t>(i < glyphs.size() ? glyphs[i].byteOffset : GetShapedTextEnd(glyphs));
 }
 
 } // namespace
@@ -626,38 +709,25 @@ void LoadSmallSelectionSpinner()
 
 void UnloadFonts()
 {
+	// The cached glyphs point into the fonts.
+	ClearTextLayoutCache();
 	Fonts.clear();
 }
 
-int GetLineWidth(std::string_view text, GameFontTables size, int spacing, int *charactersInLine)
+void ClearTextLayoutCache()
 {
-	int lineWidth = 0;
-	CurrentFont currentFont;
-	uint32_t codepoints = 0;
-	for (char32_t next : Utf8CodePoints(text)) {
-		if (next == Utf8DecodeError)
-			break;
-		if (next == ZWSP)
-			continue;
-
-		if (next == U'\n')
-			break;
-
-		if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
-			next = U'?';
-			if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
-				app_fatal("Missing fonts");
-			}
-		}
+	ShapedTexts.clear();
+	WrappedTexts.clear();
+}
 
-		const uint8_t frame = next & 0xFF;
-		lineWidth += currentFont.glyph(frame).width() + spacing;
-		++codepoints;
-	}
-	if (charactersInLine != nullptr)
-		*charactersInLine = codepoints;
+TextLayoutCacheStats GetTextLayoutCacheStats()
+{
+	return { ShapedTexts.stats(), WrappedTexts.stats() };
+}
 
-	return lineWidth != 0 ? (lineWidth - spacing) : 0;
+int GetLineWidth(std::string_view text, GameFontTables size, int spacing, int *charactersInLine)
+{
+	return GetShapedLineWidth(ShapeText(text, size), spacing, charactersInLine);
 }
 
 bool IsConsumed(std::string_view s) { return s.empty() || s[0] == '\0'; };
@@ -745,56 +815,48 @@ std::string WordWrapString(std::string_view text, unsigned width, GameFontTables
 	if (text.empty() || text[0] == '\0')
 		return output;
 
+	const uint64_t key = HashText(text, size, spacing, width);
+	if (const WrappedText *cached = WrappedTexts.find(key); cached != nullptr
+	    && cached->size == size && cached->spacing == spacing && cached->width == width && cached->text == text) {
+		return cached->wrapped;
+	}
+
+	const std::span<const ShapedGlyph> glyphs = ShapeText(text, size);
 	output.reserve(text.size());
-	const char *begin = text.data();
-	const char *processedEnd = text.data();
+	size_t processedEnd = 0;
 	std::string_view::size_type lastBreakablePos = std::string_view::npos;
 	std::size_t lastBreakableLen = 0;
 	unsigned lineWidth = 0;
-	CurrentFont currentFont;
 
-	char32_t codepoint = U'\0'; // the current codepoint
-	char32_t nextCodepoint;     // the next codepoint
-	std::size_t nextCodepointLen;
-	std::string_view remaining = text;
-	nextCodepoint = DecodeFirstUtf8CodePoint(remaining, &nextCodepointLen);
-	do {
-		codepoint = nextCodepoint;
-		const std::size_t codepointLen = nextCodepointLen;
-		if (codepoint == Utf8DecodeError)
-			break;
-		remaining.remove_prefix(codepointLen);
-		nextCodepoint = !remaining.empty() ? DecodeFirstUtf8CodePoint(remaining, &nextCodepointLen) : U'\0';
+	size_t i = 0;
+	while (i < glyphs.size() && glyphs[i].codepoint != U'\0') {
+		const ShapedGlyph &glyph = glyphs[i];
+		const char32_t codepoint = glyph.codepoint;
+		const char32_t nextCodepoint = i + 1 < glyphs.size() ? glyphs[i + 1].codepoint : U'\0';
+		const size_t glyphEnd = glyph.byteOffset + glyph.byteLength;
+		++i;
 
 		if (codepoint == U'\n') { // Existing line break, scan next line
 			lastBreakablePos = std::string_view::npos;
 			lineWidth = 0;
-			output.append(processedEnd, remaining.data());
-			processedEnd = remaining.data();
+			output.append(text.substr(processedEnd, glyphEnd - processedEnd));
+			processedEnd = glyphEnd;
 			continue;
 		}
 
 		if (codepoint != ZWSP) {
-			const uint8_t frame = codepoint & 0xFF;
-			if (!currentFont.load(size, text_color::ColorDialogWhite, codepoint)) {
-				codepoint = U'?';
-				if (!currentFont.load(size, text_color::ColorDialogWhite, codepoint)) {
-					app_fatal("Missing fonts");
-				}
-			}
-
-			lineWidth += currentFont.glyph(frame).width() + spacing;
+			lineWidth += glyph.width() + spacing;
 		}
 
 		if (IsBreakableWhitespace(codepoint)) {
-			lastBreakablePos = remaining.data() - begin - codepointLen;
-			lastBreakableLen = codepointLen;
+			lastBreakablePos = glyph.byteOffset;
+			lastBreakableLen = glyph.byteLength;
 			continue;
 		}
 
 		if (lineWidth - spacing <= width) {
 			if (IsBreakAllowed(codepoint, nextCodepoint)) {
-				lastBreakablePos = remaining.data() - begin;
+				lastBreakablePos = glyphEnd;
 				lastBreakableLen = 0;
 			}
 
@@ -802,23 +864,24 @@ std::string WordWrapString(std::string_view text, unsigned width, GameFontTables
 		}
 
 		if (lastBreakablePos == std::string_view::npos) { // Single word longer than width
-			lastBreakablePos = remaining.data() - begin - codepointLen;
+			lastBreakablePos = glyph.byteOffset;
 			lastBreakableLen = 0;
 		}
 
 		// Break line and continue to next line
-		const char *end = &text[lastBreakablePos];
-		output.append(processedEnd, end);
+		output.append(text.substr(processedEnd, lastBreakablePos - processedEnd));
 		output += '\n';
 
 		// Restart from the beginning of the new line.
-		remaining = text.substr(lastBreakablePos + lastBreakableLen);
-		processedEnd = remaining.data();
+		processedEnd = lastBreakablePos + lastBreakableLen;
+		i = static_cast<size_t>(std::lower_bound(glyphs.begin(), glyphs.end(), processedEnd, [](const ShapedGlyph &shapedGlyph, size_t offset) { return shapedGlyph.byteOffset < offset; }) - glyphs.begin());
 		lastBreakablePos = std::string_view::npos;
 		lineWidth = 0;
-		nextCodepoint = !remaining.empty() ? DecodeFirstUtf8CodePoint(remaining, &nextCodepointLen) : U'\0';
-	} while (!remaining.empty() && remaining[0] != '\0');
-	output.append(processedEnd, remaining.data());
+	}
+	const size_t end = i < glyphs.size() ? glyphs[i].byteOffset : GetShapedTextEnd(glyphs);
+	output.append(text.substr(processedEnd, end - processedEnd));
+
+	WrappedTexts.insert(key, WrappedText { std::string(text), size, spacing, width, output });
 	return output;
 }
 
@@ -830,10 +893,13 @@ uint32_t DrawString(const Surface &out, std::string_view text, const Rectangle &
 	const GameFontTables size = GetFontSizeFromUiFlags(opts.flags);
 	const text_color color = GetColorFromFlags(opts.flags);
 
+	LoadColorTranslation(color);
+	const std::span<const ShapedGlyph> glyphs = ShapeText(text, size);
+
 	int charactersInLine = 0;
 	int lineWidth = 0;
 	if (HasAnyOf(opts.flags, (UiFlags::AlignCenter | UiFlags::AlignRight | UiFlags::KerningFitSpacing)))
-		lineWidth = GetLineWidth(text, size, opts.spacing, &charactersInLine);
+		lineWidth = GetShapedLineWidth(glyphs, opts.spacing, &charactersInLine);
 
 	Point characterPosition { GetLineStartX(opts.flags, rect, lineWidth), rect.position.y };
 	const int initialX = characterPosition.x;
@@ -860,7 +926,7 @@ uint32_t DrawString(const Surface &out, std::string_view text, const Rectangle &
 		opts.cursorPosition = -1;
 	}
 
-	const uint32_t bytesDrawn = DoDrawString(clippedOut, text, rect, characterPosition,
+	const uint32_t bytesDrawn = DoDrawString(clippedOut, text, glyphs, rect, characterPosition,
 	    lineWidth, charactersInLine, rightMargin, bottomMargin, size, color, outlined, opts);
 
 	if (HasAnyOf(opts.flags, UiFlags::PentaCursor)) {
@@ -23,6 +23,7 @@
 #include "engine/rectangle.hpp"
 #include "engine/surface.hpp"
 #include "utils/enum_traits.h"
+#include "utils/lru_cache.hpp"
 
 namespace devilution {
 
@@ -268,6 +269,18 @@ inline void DrawStringWithColors(const Surface &out, std::string_view fmt, std::
 uint8_t PentSpn2Spin();
 void UnloadFonts();
 
+struct TextLayoutCacheStats {
+	/** Decoded texts with their glyphs, used by DrawString and GetLineWidth */
+	LruCacheStats glyphRuns;
+	/** Results of WordWrapString */
+	LruCacheStats wrappedTexts;
+};
+
+TextLayoutCacheStats GetTextLayoutCacheStats();
+
+/** @brief Drops all cached text layouts, which is also done by UnloadFonts. */
+void ClearTextLayoutCache();
+
 /** @brief Whether this character can be substituted by a newline when word-wrapping. */
 bool IsBreakableWhitespace(char32_t c);
 
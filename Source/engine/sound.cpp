@@ -6,12 +6,11 @@
 #include "engine/sound.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <list>
 #include <memory>
-#include <mutex>
-#include <optional>
 #include <string>
 #include <utility>
 
@@ -31,7 +30,6 @@
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/math.h"
-#include "utils/sdl_mutex.h"
 #include "utils/status_macros.hpp"
 #include "utils/stdcompat/shared_ptr_array.hpp"
 #include "utils/str_cat.hpp"
@@ -114,29 +112,106 @@ tl::expected<void, std::string> LoadAudioFile(const char *path, bool stream, Sou
 	return {};
 }
 
-std::list<std::unique_ptr<SoundSample>> duplicateSounds;
-std::optional<SdlMutex> duplicateSoundsMutex;
+/** Number of copies of sound effects that can play at once, on top of one playing instance of each effect. */
+constexpr size_t MaxVoices = 32;
+/** Number of copies of a single sound effect that can play at once. */
+constexpr size_t MaxVoicesPerEffect = 4;
 
-SoundSample *DuplicateSound(const SoundSample &sound)
+/**
+ * @brief A copy of a sound effect, used when the effect is triggered again while it is still playing.
+ *
+ * Voices are only claimed and set up by the game thread. The audio thread only marks them as finished.
+ */
+struct Voice {
+	SoundSample sample;
+	std::atomic<bool> playing = false;
+	/** Volume the voice was started with, quieter voices are stolen first. */
+	int volume = 0;
+	uint32_t startTick = 0;
+};
+
+std::array<Voice, MaxVoices> Voices;
+uint64_t DroppedVoices;
+uint64_t StolenVoices;
+
+bool IsVoicePlaying(Voice &voice)
 {
-	auto duplicate = std::make_unique<SoundSample>();
-	if (duplicate->DuplicateFrom(sound) != 0)
+#ifdef USE_SDL3
+	// SDL_mixer has no finish callback, so ask the track instead.
+	if (voice.playing.load(std::memory_order_acquire) && !voice.sample.IsPlaying())
+		voice.playing.store(false, std::memory_order_relaxed);
+#endif
+	return voice.playing.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Picks the voice to play a copy of `sound` with, stopping a playing one if needed.
+ *
+ * At most MaxVoicesPerEffect voices play the same effect, beyond that the oldest of them is restarted.
+ * If all voices are busy, the quietest one is stolen, unless it is louder than the new sound.
+ */
+Voice *ClaimVoice(const SoundSample &sound, int volume)
+{
+	Voice *idle = nullptr;
+	Voice *oldestSameEffect = nullptr;
+	Voice *quietest = nullptr;
+	size_t sameEffect = 0;
+	for (Voice &voice : Voices) {
+		if (!IsVoicePlaying(voice)) {
+			// Prefer a voice that already has this effect loaded, so it doesn't have to be duplicated again.
+			if (idle == nullptr || (!idle->sample.PlaysSameAudioAs(sound) && voice.sample.PlaysSameAudioAs(sound)))
+				idle = &voice;
+			continue;
+		}
+		if (voice.sample.PlaysSameAudioAs(sound)) {
+			sameEffect++;
+			if (oldestSameEffect == nullptr || voice.startTick < oldestSameEffect->startTick)
+				oldestSameEffect = &voice;
+		}
+		if (quietest == nullptr || voice.volume < quietest->volume
+		    || (voice.volume == quietest->volume && voice.startTick < quietest->startTick)) {
+			quietest = &voice;
+		}
+	}
+
+	Voice *victim;
+	if (sameEffect >= MaxVoicesPerEffect) {
+		victim = oldestSameEffect;
+	} else if (idle != nullptr) {
+		return idle;
+	} else if (quietest->volume <= volume) {
+		victim = quietest;
+	} else {
+		DroppedVoices++;
 		return nullptr;
-	auto *result = duplicate.get();
-	decltype(duplicateSounds.begin()) it;
-	{
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.push_back(std::move(duplicate));
-		it = duplicateSounds.end();
-		--it;
 	}
+	StolenVoices++;
+	victim->sample.Stop();
+	victim->playing.store(false, std::memory_order_relaxed);
+	return victim;
+}
+
+SoundSample *DuplicateSound(const SoundSample &sound, int volume, uint32_t tick)
+{
+	Voice *voice = ClaimVoice(sound, volume);
+	if (voice == nullptr)
+		return nullptr;
+	if (!voice->sample.PlaysSameAudioAs(sound)) {
+		voice->sample.Release();
+		if (voice->sample.DuplicateFrom(sound) != 0) {
+			voice->sample.Release();
+			return nullptr;
+		}
 #ifndef USE_SDL3
-	result->SetFinishCallback([it]([[maybe_unused]] Aulib::Stream &stream) {
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.erase(it);
-	});
+		voice->sample.SetFinishCallback([voice]([[maybe_unused]] Aulib::Stream &stream) {
+			voice->playing.store(false, std::memory_order_release);
+		});
 #endif
-	return result;
+	}
+	voice->volume = volume;
+	voice->startTick = tick;
+	voice->playing.store(true, std::memory_order_relaxed);
+	return &voice->sample;
 }
 
 /** Maps from track ID to track name in spawn. */
@@ -191,15 +266,39 @@ const auto OptionChangeDevice = (GetOptions().Audio.device.SetValueChangedCallba
 
 void ClearDuplicateSounds()
 {
-	// Move sound samples to a temporary list,
-	// avoiding a deadlock that involves SDL's
-	// mixer lock being taken by finalizers
-	std::list<std::unique_ptr<SoundSample>> drain;
-	{
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		drain = std::move(duplicateSounds);
-		duplicateSounds.clear();
+	for (Voice &voice : Voices) {
+		voice.sample.Release();
+		voice.playing.store(false, std::memory_order_relaxed);
+	}
+}
+
+bool IsDuplicateSoundPlaying(const TSnd &snd)
+{
+	for (Voice &voice : Voices) {
+		if (voice.sample.PlaysSameAudioAs(snd.DSB) && IsVoicePlaying(voice))
+			return true;
+	}
+	return false;
+}
+
+void ReleaseDuplicateSounds(const TSnd &snd)
+{
+	for (Voice &voice : Voices) {
+		if (voice.sample.PlaysSameAudioAs(snd.DSB) && !IsVoicePlaying(voice))
+			voice.sample.Release();
+	}
+}
+
+SoundVoiceStats GetSoundVoiceStats()
+{
+	SoundVoiceStats stats {};
+	for (Voice &voice : Voices) {
+		if (IsVoicePlaying(voice))
+			stats.playing++;
 	}
+	stats.dropped = DroppedVoices;
+	stats.stolen = StolenVoices;
+	return stats;
 }
 
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume)
@@ -215,7 +314,7 @@ void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume)
 
 	SoundSample *sound = &pSnd->DSB;
 	if (sound->IsPlaying()) {
-		sound = DuplicateSound(*sound);
+		sound = DuplicateSound(*sound, lVolume + (userVolume * (ATTENUATION_MIN / VOLUME_MIN)), tc);
 		if (sound == nullptr)
 			return;
 	}
@@ -286,7 +385,6 @@ void snd_init()
 	    Aulib::sampleRate(), Aulib::channelCount(), Aulib::frameSize(), Aulib::sampleFormat());
 #endif
 
-	duplicateSoundsMutex.emplace();
 	gbSndInited = true;
 }
 
@@ -301,7 +399,6 @@ void snd_deinit()
 #else
 		Aulib::quit();
 #endif
-		duplicateSoundsMutex = std::nullopt;
 	}
 
 	gbSndInited = false;
@@ -64,7 +64,22 @@ extern MIX_Mixer *CurrentMixer;
 
 extern _music_id sgnMusicTrack;
 
+struct SoundVoiceStats {
+	/** Copies of sound effects currently playing */
+	uint32_t playing;
+	/** Copies that weren't played because every voice was busy with a louder sound */
+	uint64_t dropped;
+	/** Playing copies that were cut off to make room for a new one */
+	uint64_t stolen;
+};
+
+/** @brief Stops and unloads all copies of sound effects that were played while the original was still playing. */
 void ClearDuplicateSounds();
+/** @brief Whether a copy of the sound, played while the sound itself was playing, is still playing. */
+bool IsDuplicateSoundPlaying(const TSnd &snd);
+/** @brief Unloads the copies of the sound that have finished playing, as they share its data and keep it loaded. */
+void ReleaseDuplicateSounds(const TSnd &snd);
+SoundVoiceStats GetSoundVoiceStats();
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume);
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream = false);
 tl::expected<std::unique_ptr<TSnd>, std::string> SoundFileLoadWithStatus(const char *path, bool stream = false);
@@ -9,6 +9,9 @@ bool gbSoundOn;
 _music_id sgnMusicTrack = NUM_MUSIC;
 
 void ClearDuplicateSounds() { }
+bool IsDuplicateSoundPlaying(const TSnd &snd) { return false; }
+void ReleaseDuplicateSounds(const TSnd &snd) { }
+SoundVoiceStats GetSoundVoiceStats() { return {}; }
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, int userVolume) { }
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream) { return nullptr; }
 tl::expected<std::unique_ptr<TSnd>, std::string> SoundFileLoadWithStatus(const char *path, bool stream) { return nullptr; }
@@ -85,9 +85,9 @@
 #include "utils/is_of.hpp"
 #include "utils/language.h"
 #include "utils/log.hpp"
+#include "utils/lru_cache.hpp"
 #include "utils/math.h"
 #include "utils/sdl_geometry.h"
-#include "utils/static_vector.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
 #include "utils/string_or_view.hpp"
@@ -1032,9 +1032,63 @@ int SaveItemPower(const Player &player, Item &item, ItemPower &power)
 	return r;
 }
 
+/** @brief The filters `SelectAffix` applies to an affix list. The levels are clamped to the range of `PLMinLvl`. */
+struct AffixFilter {
+	const std::vector<PLStruct> *affixList;
+	AffixItemType type;
+	int16_t minlvl;
+	int16_t maxlvl;
+	bool onlygood;
+	goodorevil goe;
+	bool excludeChargesForStaffs;
+
+	bool operator==(const AffixFilter &other) const = default;
+};
+
+struct AffixFilterHash {
+	size_t operator()(const AffixFilter &filter) const
+	{
+		size_t hash = std::hash<const void *> {}(filter.affixList);
+		hash ^= static_cast<size_t>(filter.type) << 1;
+		hash ^= static_cast<size_t>(static_cast<uint16_t>(filter.minlvl)) << 8;
+		hash ^= static_cast<size_t>(static_cast<uint16_t>(filter.maxlvl)) << 20;
+		hash ^= static_cast<size_t>(filter.goe) << 4;
+		hash ^= static_cast<size_t>(filter.onlygood) << 6;
+		return hash ^ (static_cast<size_t>(filter.excludeChargesForStaffs) << 7);
+	}
+};
+
+/** @brief The affixes that pass an `AffixFilter`, in list order, with the running total of their chances. */
+struct AffixCandidates {
+	std::vector<const PLStruct *> affixes;
+	std::vector<uint32_t> chanceTotals;
+};
+
+/** Only a few level ranges occur per item type, so this holds all of them in practice. */
+LruCache<AffixFilter, AffixCandidates, AffixFilterHash> AffixCandidatesCache { 512 };
+/** Whether a name fits the item info panel. Names are made from a limited set of parts, so the same ones come up a lot. */
+LruCache<std::string, bool> NameFitsPanelCache { 1024 };
+uint32_t AffixCachesGeneration;
+
+/** @brief Drops the cached affix tables and name widths if the item data has been reloaded, e.g. by a mod. */
+void ValidateAffixCaches()
+{
+	if (AffixCachesGeneration == ItemAffixesGeneration)
+		return;
+	AffixCandidatesCache.clear();
+	NameFitsPanelCache.clear();
+	AffixCachesGeneration = ItemAffixesGeneration;
+}
+
 bool StringInPanel(const char *str)
 {
-	return GetLineWidth(str, GameFont12, 2) < 254;
+	ValidateAffixCaches();
+	const std::string key = str;
+	if (const bool *fits = NameFitsPanelCache.find(key); fits != nullptr)
+		return *fits;
+	const bool fits = GetLineWidth(str, GameFont12, 2) < 254;
+	NameFitsPanelCache.insert(key, fits);
+	return fits;
 }
 
 int PLVal(int pv, int p1, int p2, int minv, int maxv)
@@ -1061,37 +1115,59 @@ void SaveItemAffix(const Player &player, Item &item, const PLStruct &affix)
 	}
 }
 
-std::optional<const PLStruct *> SelectAffix(
-    const std::vector<PLStruct> &affixList,
-    AffixItemType type,
-    int minlvl, int maxlvl,
-    bool onlygood,
-    goodorevil goe,
-    bool excludeChargesForStaffs)
+const AffixCandidates &GetAffixCandidates(const AffixFilter &filter)
 {
-	StaticVector<const PLStruct *, 256> eligibleAffixes;
+	ValidateAffixCaches();
+	if (const AffixCandidates *cached = AffixCandidatesCache.find(filter); cached != nullptr)
+		return *cached;
 
-	for (const PLStruct &affix : affixList) {
-		if (!HasAnyOf(type, affix.PLIType))
+	AffixCandidates candidates;
+	uint32_t chanceTotal = 0;
+	for (const PLStruct &affix : *filter.affixList) {
+		if (!HasAnyOf(filter.type, affix.PLIType))
 			continue;
-		if (affix.PLMinLvl < minlvl || affix.PLMinLvl > maxlvl)
+		if (affix.PLMinLvl < filter.minlvl || affix.PLMinLvl > filter.maxlvl)
 			continue;
-		if (onlygood && !affix.PLOk)
+		if (filter.onlygood && !affix.PLOk)
 			continue;
-		if ((goe == GOE_GOOD && affix.PLGOE == GOE_EVIL) || (goe == GOE_EVIL && affix.PLGOE == GOE_GOOD))
+		if ((filter.goe == GOE_GOOD && affix.PLGOE == GOE_EVIL) || (filter.goe == GOE_EVIL && affix.PLGOE == GOE_GOOD))
 			continue;
-		if (excludeChargesForStaffs && type == AffixItemType::Staff && affix.power.type == IPL_CHARGES)
+		if (filter.excludeChargesForStaffs && filter.type == AffixItemType::Staff && affix.power.type == IPL_CHARGES)
+			continue;
+		if (affix.PLChance == 0)
 			continue;
 
-		for (int i = 0; i < affix.PLChance; ++i) {
-			eligibleAffixes.push_back(&affix);
-		}
+		chanceTotal += affix.PLChance;
+		candidates.affixes.push_back(&affix);
+		candidates.chanceTotals.push_back(chanceTotal);
 	}
+	return *AffixCandidatesCache.insert(filter, std::move(candidates));
+}
 
-	if (eligibleAffixes.empty())
+std::optional<const PLStruct *> SelectAffix(
+    const std::vector<PLStruct> &affixList,
+    AffixItemType type,
+    int minlvl, int maxlvl,
+    bool onlygood,
+    goodorevil goe,
+    bool excludeChargesForStaffs)
+{
+	const AffixCandidates &candidates = GetAffixCandidates({
+	    &affixList,
+	    type,
+	    static_cast<int16_t>(std::clamp(minlvl, INT8_MIN, INT8_MAX + 1)),
+	    static_cast<int16_t>(std::clamp(maxlvl, INT8_MIN - 1, INT8_MAX)),
+	    onlygood,
+	    goe,
+	    excludeChargesForStaffs,
+	});
+	if (candidates.affixes.empty())
 		return std::nullopt;
 
-	return eligibleAffixes[GenerateRnd(static_cast<int>(eligibleAffixes.size()))];
+	// Each affix stands for `PLChance` consecutive values of the roll, as if it was listed that many times.
+	const uint32_t roll = static_cast<uint32_t>(GenerateRnd(static_cast<int>(candidates.chanceTotals.back())));
+	const auto it = std::upper_bound(candidates.chanceTotals.begin(), candidates.chanceTotals.end(), roll);
+	return candidates.affixes[it - candidates.chanceTotals.begin()];
 }
 
 std::optional<const PLStruct *> GetStaffPrefix(int maxlvl, bool onlygood)
@@ -0,0 +1,258 @@
+/**
+ * @file levels/drlg_sweep.cpp
+ *
+ * Implementation of devilutionx-drlg-sweep, which generates a range of seeds for one level
+ * and prints a hash of each layout, so that generator changes and mods can be checked
+ * against a known-good corpus.
+ *
+ * The generators keep their state in globals, so seeds are spread over worker processes
+ * (this executable started again with --worker) rather than over threads.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "diablo.h"
+#include "engine/assets.hpp"
+#include "headless_mode.hpp"
+#include "levels/gendung.h"
+#include "levels/themes.h"
+#include "multi.h"
+#include "player.h"
+#include "quests.h"
+#include "utils/parse_int.hpp"
+#include "utils/paths.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace devilution {
+namespace {
+
+/** @brief Everything, apart from the game data itself, that determines the generated layouts. */
+struct DungeonGenerationParams {
+	uint8_t level = 1;
+	lvl_entry entry = ENTRY_MAIN;
+	bool hellfire = false;
+	bool multiplayer = false;
+};
+
+struct SweepOptions {
+	DungeonGenerationParams params;
+	/** @brief Files in this folder override the MPQ contents, as with the game's --save-dir. */
+	std::optional<std::string> saveDir;
+	uint32_t firstSeed = 0;
+	uint32_t count = 0;
+	unsigned jobs = 0;
+	bool worker = false;
+};
+
+void PrintUsage()
+{
+	std::fputs(
+	    "Usage: devilutionx-drlg-sweep [options] <level> <first seed> <count>\n"
+	    "\n"
+	    "Prints \"<seed> <hash>\" for every generated layout, followed by a digest of all of them.\n"
+	    "\n"
+	    "Options:\n"
+	    "  --jobs <n>        number of worker processes (default: number of cores)\n"
+	    "  --entry <entry>   main, prev or rtnlvl (default: main)\n"
+	    "  --hellfire        load the Hellfire data\n"
+	    "  --multiplayer     use the multiplayer quest set\n"
+	    "  --save-dir <dir>  folder whose files override the MPQ contents\n",
+	    stderr);
+}
+
+std::optional<SweepOptions> ParseOptions(int argc, char **argv)
+{
+	SweepOptions options;
+	std::vector<std::string_view> positional;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--jobs" && hasValue) {
+			const ParseIntResult<unsigned> jobs = ParseInt<unsigned>(argv[++i], 1, 1024);
+			if (!jobs.has_value())
+				return std::nullopt;
+			options.jobs = *jobs;
+		} else if (arg == "--entry" && hasValue) {
+			const std::string_view entry = argv[++i];
+			if (entry == "main") {
+				options.params.entry = ENTRY_MAIN;
+			} else if (entry == "prev") {
+				options.params.entry = ENTRY_PREV;
+			} else if (entry == "rtnlvl") {
+				options.params.entry = ENTRY_RTNLVL;
+			} else {
+				return std::nullopt;
+			}
+		} else if (arg == "--save-dir" && hasValue) {
+			options.saveDir = argv[++i];
+		} else if (arg == "--hellfire") {
+			options.params.hellfire = true;
+		} else if (arg == "--multiplayer") {
+			options.params.multiplayer = true;
+		} else if (arg == "--worker") {
+			options.worker = true;
+		} else if (!arg.empty() && arg[0] != '-') {
+			positional.push_back(arg);
+		} else {
+			return std::nullopt;
+		}
+	}
+	if (positional.size() != 3)
+		return std::nullopt;
+
+	const ParseIntResult<uint8_t> level = ParseInt<uint8_t>(positional[0], 1, NUMLEVELS - 1);
+	const ParseIntResult<uint32_t> firstSeed = ParseInt<uint32_t>(positional[1]);
+	const ParseIntResult<uint32_t> count = ParseInt<uint32_t>(positional[2]);
+	if (!level.has_value() || !firstSeed.has_value() || !count.has_value())
+		return std::nullopt;
+	options.params.level = *level;
+	options.firstSeed = *firstSeed;
+	options.count = static_cast<uint32_t>(std::min<uint64_t>(*count, uint64_t { UINT32_MAX } - *firstSeed + 1));
+	if (options.jobs == 0)
+		options.jobs = std::max(std::thread::hardware_concurrency(), 1U);
+	return options;
+}
+
+/** @brief Sets up the same game state as the drlg_l*_test fixtures. */
+void InitGeneration(const DungeonGenerationParams &params)
+{
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	MyPlayer->pOriginalCathedral = true;
+
+	sgGameInitInfo.fullQuests = params.multiplayer ? 0 : 1;
+	gbIsMultiplayer = params.multiplayer;
+
+	LoadCoreArchives();
+	LoadQuestData();
+	if (params.hellfire) {
+		LoadModArchives({ { "Hellfire" } });
+	} else {
+		LoadModArchives({});
+	}
+	InitQuests();
+
+	currlevel = params.level;
+	leveltype = GetLevelType(params.level);
+	// Only the tile contents depend on the megatiles, not the layout, so they are left blank.
+	pMegaTiles = std::make_unique<MegaTile[]>(MAXTILES);
+}
+
+uint64_t Fnv1a(uint64_t hash, const void *data, size_t size)
+{
+	const auto *bytes = static_cast<const uint8_t *>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001B3;
+	}
+	return hash;
+}
+
+uint64_t GenerateAndHash(const DungeonGenerationParams &params, uint32_t seed)
+{
+	LevelSeeds[params.level] = std::nullopt;
+	CreateDungeon(seed, params.entry);
+	CreateThemeRooms();
+	return HashDungeonLayout();
+}
+
+int RunWorker(const SweepOptions &options)
+{
+	InitGeneration(options.params);
+	// Results are only written once all seeds are done, so that the parent reading the
+	// workers one after another doesn't stall the ones it isn't reading yet.
+	std::string output;
+	for (uint32_t i = 0; i < options.count; i++) {
+		const uint32_t seed = options.firstSeed + i;
+		output += fmt::format("{} {:016x}\n", seed, GenerateAndHash(options.params, seed));
+	}
+	std::fwrite(output.data(), 1, output.size(), stdout);
+	return EXIT_SUCCESS;
+}
+
+std::string WorkerCommand(const char *executable, const SweepOptions &options, uint32_t firstSeed, uint32_t count)
+{
+	std::string command = fmt::format("\"{}\" --worker", executable);
+	if (options.params.entry == ENTRY_PREV)
+		command += " --entry prev";
+	else if (options.params.entry == ENTRY_RTNLVL)
+		command += " --entry rtnlvl";
+	if (options.params.hellfire)
+		command += " --hellfire";
+	if (options.params.multiplayer)
+		command += " --multiplayer";
+	if (options.saveDir)
+		command += fmt::format(" --save-dir \"{}\"", *options.saveDir);
+	command += fmt::format(" {} {} {}", options.params.level, firstSeed, count);
+	return command;
+}
+
+int RunSweep(const char *executable, const SweepOptions &options)
+{
+	const unsigned jobs = std::clamp<unsigned>(options.jobs, 1, std::max<uint32_t>(options.count, 1));
+	std::vector<FILE *> workers;
+	uint32_t firstSeed = options.firstSeed;
+	for (unsigned job = 0; job < jobs; job++) {
+		const uint32_t count = (options.count / jobs) + (job < options.count % jobs ? 1 : 0);
+		FILE *worker = popen(WorkerCommand(executable, options, firstSeed, count).c_str(), "r");
+		if (worker == nullptr) {
+			std::perror("Failed to start worker");
+			return EXIT_FAILURE;
+		}
+		workers.push_back(worker);
+		firstSeed += count;
+	}
+
+	// Each worker covers the next range of seeds, so reading them in order keeps the output sorted by seed.
+	uint64_t digest = 0xCBF29CE484222325;
+	bool failed = false;
+	char line[64];
+	for (FILE *worker : workers) {
+		while (std::fgets(line, sizeof(line), worker) != nullptr) {
+			std::fputs(line, stdout);
+			digest = Fnv1a(digest, line, std::string_view(line).size());
+		}
+		failed |= pclose(worker) != 0;
+	}
+	if (failed) {
+		std::fputs("A worker failed\n", stderr);
+		return EXIT_FAILURE;
+	}
+	std::fprintf(stderr, "digest %016llx over %u seeds\n", static_cast<unsigned long long>(digest), options.count);
+	return EXIT_SUCCESS;
+}
+
+} // namespace
+} // namespace devilution
+
+int main(int argc, char **argv)
+{
+	using namespace devilution;
+
+	HeadlessMode = true;
+
+	const std::optional<SweepOptions> options = ParseOptions(argc, argv);
+	if (!options) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+	if (options->saveDir)
+		paths::SetPrefPath(*options->saveDir);
+	if (options->worker)
+		return RunWorker(*options);
+	return RunSweep(argv[0], *options);
+}
@@ -833,6 +833,24 @@ void FloodTransparencyValues(uint8_t floorID)
 	}
 }
 
+uint64_t HashDungeonLayout()
+{
+	// FNV-1a
+	uint64_t hash = 0xCBF29CE484222325;
+	const auto hashBytes = [&hash](const void *data, size_t size) {
+		const auto *bytes = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 0x100000001B3;
+		}
+	};
+	hashBytes(dungeon, sizeof(dungeon));
+	hashBytes(dTransVal, sizeof(dTransVal));
+	const int32_t view[2] = { ViewPosition.x, ViewPosition.y };
+	hashBytes(view, sizeof(view));
+	return hash;
+}
+
 tl::expected<dungeon_type, std::string> ParseDungeonType(std::string_view value)
 {
 	if (value.empty()) return DTYPE_NONE;
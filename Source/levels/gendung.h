@@ -145,7 +145,7 @@ extern DVL_API_FOR_TEST Point ViewPosition;
 extern uint_fast8_t MicroTileLen;
 extern int8_t TransVal;
 /** Specifies the active transparency indices. */
-extern std::array<bool, 256> TransList;
+extern DVL_API_FOR_TEST std::array<bool, 256> TransList;
 /** Contains the piece IDs of each tile on the map. */
 extern DVL_API_FOR_TEST uint16_t dPiece[MAXDUNX][MAXDUNY];
 /** Map of micros that comprises a full tile for any given dungeon piece. */
@@ -157,7 +157,7 @@ extern DVL_API_FOR_TEST uint8_t dLight[MAXDUNX][MAXDUNY];
 /** Precalculated static lights. dLight uses this as a base before applying lights. Per tile. */
 extern uint8_t dPreLight[MAXDUNX][MAXDUNY];
 /** Holds various information about dungeon tiles, @see DungeonFlag */
-extern DungeonFlag dFlags[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST DungeonFlag dFlags[MAXDUNX][MAXDUNY];
 /** Contains the player numbers (players array indices) of the map. negative id indicates player moving. */
 extern int8_t dPlayer[MAXDUNX][MAXDUNY];
 /**
@@ -332,4 +332,11 @@ bool IsNearThemeRoom(WorldTilePosition position);
 void InitLevels();
 void FloodTransparencyValues(uint8_t floorID);
 
+/**
+ * @brief Hashes the generated layout: the tiles, the transparency regions and the entry position.
+ *
+ * These are what the drlg_l*_test fixtures compare, so equal hashes mean matching fixtures.
+ */
+uint64_t HashDungeonLayout();
+
 } // namespace devilution
@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <optional>
 
 #include <fmt/format.h>
 
@@ -16,6 +17,7 @@
 #include "cursor.h"
 #include "diablo_msg.hpp"
 #include "game_mode.hpp"
+#include "monster.h"
 #include "multi.h"
 #include "utils/algorithm/container.hpp"
 #include "utils/is_of.hpp"
@@ -30,6 +32,16 @@ TriggerStruct trigs[MAXTRIGGERS];
 int TWarpFrom;
 
 namespace {
+/** Distance in tiles to a trigger at which the level behind it starts loading in the background. */
+constexpr int TriggerPrefetchDistance = 10;
+
+/** The level that was prefetched last and the level the player was on at the time */
+struct {
+	int level = -1;
+	int fromLevel = -1;
+	bool fromSetLevel = false;
+} LastPrefetch;
+
 /** Specifies the dungeon piece IDs which constitute stairways leading down to the cathedral from town. */
 const uint16_t TownDownList[] = { 715, 714, 718, 719, 720, 722, 723, 724, 725, 726 };
 /** Specifies the dungeon piece IDs which constitute stairways leading down to the catacombs from town. */
@@ -66,6 +78,58 @@ const uint16_t L5DownList[] = { 124, 125, 128, 130, 131, 134, 135, 139, 141 };
 const uint16_t L6TWarpUpList[] = { 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91 };
 const uint16_t L6UpList[] = { 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77 };
 const uint16_t L6DownList[] = { 56, 57, 58, 59, 60, 61, 62, 63 };
+
+/** @brief Returns the level behind the trigger, unless it has no monsters to prefetch. */
+std::optional<int> GetTriggerPrefetchLevel(const TriggerStruct &trigger)
+{
+	int level;
+	switch (trigger._tmsg) {
+	case WM_DIABNEXTLVL:
+		level = currlevel + 1;
+		break;
+	case WM_DIABPREVLVL:
+		level = currlevel - 1;
+		break;
+	case WM_DIABRTNLVL:
+		level = GetMapReturnLevel();
+		break;
+	case WM_DIABTOWNWARP:
+		level = trigger._tlvl;
+		break;
+	default:
+		return std::nullopt;
+	}
+	// There are no monsters in town
+	if (level <= 0 || level >= NUMLEVELS || (gbIsSpawn && level > 2))
+		return std::nullopt;
+	return level;
+}
+
+/** @brief Returns the level behind the trigger closest to the player, if one is within TriggerPrefetchDistance. */
+std::optional<int> FindNearbyTriggerLevel()
+{
+	const Point playerPosition = MyPlayer->position.tile;
+	std::optional<int> nearestLevel;
+	int nearestDistance = TriggerPrefetchDistance + 1;
+	for (int i = 0; i < numtrigs; i++) {
+		const int distance = playerPosition.WalkingDistance(trigs[i].position);
+		if (distance >= nearestDistance)
+			continue;
+		const std::optional<int> level = GetTriggerPrefetchLevel(trigs[i]);
+		if (!level)
+			continue;
+		nearestLevel = level;
+		nearestDistance = distance;
+	}
+	return nearestLevel;
+}
+
+void SetLastPrefetch(int level)
+{
+	LastPrefetch.level = level;
+	LastPrefetch.fromLevel = currlevel;
+	LastPrefetch.fromSetLevel = setlevel;
+}
 } // namespace
 
 void InitNoTriggers()
@@ -935,6 +999,25 @@ void CheckTriggers()
 	}
 }
 
+void SkipArrivalTriggerPrefetch()
+{
+	const std::optional<int> level = FindNearbyTriggerLevel();
+	if (level)
+		SetLastPrefetch(*level);
+}
+
+void PrefetchTriggerLevels()
+{
+	const std::optional<int> level = FindNearbyTriggerLevel();
+	if (!level)
+		return;
+	if (*level == LastPrefetch.level && currlevel == LastPrefetch.fromLevel && setlevel == LastPrefetch.fromSetLevel)
+		return;
+
+	SetLastPrefetch(*level);
+	PrefetchLevelMonsterSprites(*level);
+}
+
 bool EntranceBoundaryContains(Point entrance, Point position)
 {
 	constexpr Displacement entranceOffsets[7] = { { 0, 0 }, { -1, 0 }, { 0, -1 }, { -1, -1 }, { -2, -1 }, { -1, -2 }, { -2, -2 } };
@@ -41,6 +41,19 @@ void Freeupstairs();
 void CheckTrigForce();
 void CheckTriggers();
 
+/**
+ * @brief Marks the level behind the trigger the player arrived by as already prefetched.
+ *
+ * Call after the player has been placed on a level entered by stairs, so that the level just
+ * left isn't prefetched again before the player heads towards another exit.
+ */
+void SkipArrivalTriggerPrefetch();
+
+/**
+ * @brief Starts loading the level behind the closest trigger in the background once the player gets close to it.
+ */
+void PrefetchTriggerLevels();
+
 /**
  * @brief Check if the provided position is in the entrance boundary of the entrance.
  * @param entrance The entrance to check.
@@ -19,12 +19,15 @@
 #include "engine/load_file.hpp"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
+#include "engine/rectangle.hpp"
 #include "engine/world_tile.hpp"
 #include "levels/tile_properties.hpp"
 #include "objects.h"
 #include "player.h"
 #include "utils/attributes.h"
+#include "utils/bitset2d.hpp"
 #include "utils/is_of.hpp"
+#include "utils/static_vector.hpp"
 #include "utils/status_macros.hpp"
 #include "vision.hpp"
 
@@ -56,6 +59,39 @@ bool UpdateVision;
 /** interpolations of a 32x32 (16x16 mirrored) light circle moving between tiles in steps of 1/8 of a tile */
 uint8_t LightConeInterpolations[8][8][16][16];
 
+/** @brief The position and radius a light was last added to dLight with. */
+struct AppliedLight {
+	WorldTilePosition tile;
+	DisplacementOf<int8_t> offset;
+	uint8_t radius;
+	bool isApplied;
+};
+
+std::array<AppliedLight, MAXLIGHTS> AppliedLights;
+/** Number of applied lights brightening each tile */
+uint8_t LightContributors[MAXDUNX][MAXDUNY];
+/** Tiles that have to be rebuilt from dPreLight and the lights that still cover them */
+bool DirtyLight[MAXDUNX][MAXDUNY];
+/** Bounds of the tiles marked in DirtyLight */
+StaticVector<Rectangle, MAXLIGHTS> DirtyLightAreas;
+
+/** @brief The tiles a vision last marked in dFlags, so that only the visions that changed have to be recomputed. */
+struct AppliedVision {
+	Bitset2d<MAXDUNX, MAXDUNY> tiles;
+	/** Transparency groups (dTransVal) of the tiles in sight */
+	std::array<bool, 256> transparency;
+	MapExplorationType doAutomap;
+	bool visible;
+	bool isApplied;
+	/**
+	 * Whether tiles is filled in. It is only recorded once DoUnVision clears some of the vision's tiles for
+	 * another vision, so that visions that move every tick don't pay for it.
+	 */
+	bool hasTiles;
+};
+
+std::array<AppliedVision, MAXVISION> AppliedVisions;
+
 void RotateRadius(DisplacementOf<int8_t> &offset, DisplacementOf<int8_t> &dist, DisplacementOf<int8_t> &light, DisplacementOf<int8_t> &block)
 {
 	dist = { static_cast<int8_t>(7 - dist.deltaY), dist.deltaX };
@@ -97,38 +133,14 @@ bool TileAllowsLight(Point position)
 	return !TileHasAny(position, TileProperties::BlockLight);
 }
 
-void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
-{
-	if (doAutomap != MAP_EXP_NONE) {
-		if (dFlags[position.x][position.y] != DungeonFlag::None)
-			SetAutomapView(position, doAutomap);
-		dFlags[position.x][position.y] |= DungeonFlag::Explored;
-	}
-	if (visible)
-		dFlags[position.x][position.y] |= DungeonFlag::Lit;
-	dFlags[position.x][position.y] |= DungeonFlag::Visible;
-}
-
-} // namespace
-
-void DoUnLight(Point position, uint8_t radius)
-{
-	radius++;
-	radius++; // If lights moved at a diagonal it can result in some extra tiles being lit
-
-	auto searchArea = PointsInRectangle(WorldTileRectangle { position, radius });
-
-	for (const WorldTilePosition targetPosition : searchArea) {
-		if (InDungeonBounds(targetPosition))
-			dLight[targetPosition.x][targetPosition.y] = dPreLight[targetPosition.x][targetPosition.y];
-	}
-}
-
-void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
+/**
+ * @brief Calls visitFn(tile, lightLevel) for every tile reached by a light.
+ *
+ * Tiles can be visited with a light level of LightsMax, which never brightens them.
+ */
+template <typename F>
+DVL_ALWAYS_INLINE void ForEachLitTile(Point position, uint8_t radius, DisplacementOf<int8_t> offset, F &&visitFn)
 {
-	assert(radius >= 0 && radius <= NumLightRadiuses);
-	assert(InDungeonBounds(position));
-
 	DisplacementOf<int8_t> light = {};
 	DisplacementOf<int8_t> block = {};
 
@@ -159,18 +171,15 @@ void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
 	if (position.y + 15 > MAXDUNY) {
 		maxY = MAXDUNY - position.y;
 	}
+	// Tiles further away than radius + 1 are past the end of the falloff and stay unlit
+	const int reach = radius + 2;
 
 	// Allow for dim lights in crypt and nest
-	if (IsAnyOf(leveltype, DTYPE_NEST, DTYPE_CRYPT)) {
-		if (GetLight(position) > LightFalloffs[radius][0])
-			SetLight(position, LightFalloffs[radius][0]);
-	} else {
-		SetLight(position, 0);
-	}
+	visitFn(position, IsAnyOf(leveltype, DTYPE_NEST, DTYPE_CRYPT) ? LightFalloffs[radius][0] : 0);
 
 	for (int i = 0; i < 4; i++) {
-		const int yBound = i > 0 && i < 3 ? maxY : minY;
-		const int xBound = i < 2 ? maxX : minX;
+		const int yBound = std::min(i > 0 && i < 3 ? maxY : minY, reach);
+		const int xBound = std::min(i < 2 ? maxX : minX, reach);
 		for (int y = 0; y < yBound; y++) {
 			for (int x = 1; x < xBound; x++) {
 				const int linearDistance = LightConeInterpolations[offset.deltaX][offset.deltaY][x + block.deltaX][y + block.deltaY];
@@ -180,21 +189,228 @@ void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
 				const uint8_t v = LightFalloffs[radius][linearDistance];
 				if (!InDungeonBounds(temp))
 					continue;
-				if (v < GetLight(temp))
-					SetLight(temp, v);
+				visitFn(temp, v);
 			}
 		}
 		RotateRadius(offset, dist, light, block);
 	}
 }
 
-void DoUnVision(Point position, uint8_t radius)
+void ResetAppliedLights()
+{
+	AppliedLights = {};
+	memset(LightContributors, 0, sizeof(LightContributors));
+	memset(DirtyLight, 0, sizeof(DirtyLight));
+	DirtyLightAreas.clear();
+}
+
+/**
+ * @brief Returns the area that can be brightened by a light.
+ *
+ * This is one tile more than the falloff, as negative offsets move the light to the previous tile.
+ */
+Rectangle GetLightArea(const AppliedLight &applied)
+{
+	return Rectangle { applied.tile, applied.radius + 3 };
+}
+
+bool Overlaps(const Rectangle &a, const Rectangle &b)
+{
+	return a.position.x < b.position.x + b.size.width && b.position.x < a.position.x + a.size.width
+	    && a.position.y < b.position.y + b.size.height && b.position.y < a.position.y + a.size.height;
+}
+
+template <typename F>
+void ForEachDirtyLightTile(F &&visitFn)
+{
+	for (const Rectangle &area : DirtyLightAreas) {
+		for (int x = area.position.x; x < area.position.x + area.size.width; x++) {
+			for (int y = area.position.y; y < area.position.y + area.size.height; y++) {
+				visitFn(x, y);
+			}
+		}
+	}
+}
+
+void AddLightContribution(int lid)
+{
+	const Light &light = Lights[lid];
+	AppliedLight &applied = AppliedLights[lid];
+	applied = { light.position.tile, light.position.offset, light.radius, true };
+
+	ForEachLitTile(applied.tile, applied.radius, applied.offset, [](Point tile, uint8_t v) {
+		if (v >= LightsMax)
+			return;
+		LightContributors[tile.x][tile.y]++;
+		if (v < dLight[tile.x][tile.y])
+			dLight[tile.x][tile.y] = v;
+	});
+}
+
+void RemoveLightContribution(int lid)
+{
+	AppliedLight &applied = AppliedLights[lid];
+	if (!applied.isApplied)
+		return;
+	applied.isApplied = false;
+
+	Point dirtyMin { MAXDUNX, MAXDUNY };
+	Point dirtyMax { -1, -1 };
+	ForEachLitTile(applied.tile, applied.radius, applied.offset, [&dirtyMin, &dirtyMax](Point tile, uint8_t v) {
+		if (v >= LightsMax)
+			return;
+		if (--LightContributors[tile.x][tile.y] == 0) {
+			// This was the only light here, no need to look at the neighbours
+			dLight[tile.x][tile.y] = dPreLight[tile.x][tile.y];
+			return;
+		}
+		// Only tiles where this light was the brightest one have to be rebuilt
+		if (v <= dLight[tile.x][tile.y]) {
+			DirtyLight[tile.x][tile.y] = true;
+			dirtyMin = { std::min(dirtyMin.x, tile.x), std::min(dirtyMin.y, tile.y) };
+			dirtyMax = { std::max(dirtyMax.x, tile.x), std::max(dirtyMax.y, tile.y) };
+		}
+	});
+	if (dirtyMin.x <= dirtyMax.x)
+		DirtyLightAreas.push_back(dirtyMin, Size { dirtyMax.x - dirtyMin.x + 1, dirtyMax.y - dirtyMin.y + 1 });
+}
+
+/**
+ * @brief Resets the dirty tiles to dPreLight and adds back the lights that still cover them.
+ */
+void RebuildDirtyLight()
+{
+	if (DirtyLightAreas.empty())
+		return;
+
+	ForEachDirtyLightTile([](int x, int y) {
+		if (DirtyLight[x][y])
+			dLight[x][y] = dPreLight[x][y];
+	});
+
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const AppliedLight &applied = AppliedLights[ActiveLights[i]];
+		if (!applied.isApplied)
+			continue;
+		const Rectangle lightArea = GetLightArea(applied);
+		if (std::none_of(DirtyLightAreas.begin(), DirtyLightAreas.end(), [&lightArea](const Rectangle &area) { return Overlaps(lightArea, area); }))
+			continue;
+		ForEachLitTile(applied.tile, applied.radius, applied.offset, [](Point tile, uint8_t v) {
+			if (DirtyLight[tile.x][tile.y] && v < dLight[tile.x][tile.y])
+				dLight[tile.x][tile.y] = v;
+		});
+	}
+
+	ForEachDirtyLightTile([](int x, int y) {
+		DirtyLight[x][y] = false;
+	});
+	DirtyLightAreas.clear();
+}
+
+/**
+ * @brief Returns the area DoUnVision clears.
+ */
+WorldTileRectangle GetUnVisionArea(Point position, uint8_t radius)
 {
 	radius++;
 	radius++; // increasing the radius even further here prevents leaving stray vision tiles behind and doesn't seem to affect monster AI - applying new vision happens in the same tick
 
+	return WorldTileRectangle { position, radius };
+}
+
+void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
+{
+	if (doAutomap != MAP_EXP_NONE) {
+		if (dFlags[position.x][position.y] != DungeonFlag::None)
+			SetAutomapView(position, doAutomap);
+		dFlags[position.x][position.y] |= DungeonFlag::Explored;
+	}
+	if (visible)
+		dFlags[position.x][position.y] |= DungeonFlag::Lit;
+	dFlags[position.x][position.y] |= DungeonFlag::Visible;
+}
+
+bool AreasOverlap(WorldTileRectangle a, WorldTileRectangle b)
+{
+	return a.position.x < b.position.x + b.size.width && b.position.x < a.position.x + a.size.width
+	    && a.position.y < b.position.y + b.size.height && b.position.y < a.position.y + a.size.height;
+}
+
+/**
+ * @brief Finds the tiles in sight of a vision and marks them in dFlags.
+ * @param recordTiles Whether to also keep the tiles in applied.tiles
+ */
+void ApplyVision(AppliedVision &applied, Point position, uint8_t radius, MapExplorationType doAutomap, bool visible, bool recordTiles)
+{
+	if (recordTiles)
+		applied.tiles.reset();
+	applied.transparency = {};
+
+	auto markVisibleFn = [&applied, doAutomap, visible, recordTiles](Point rayPoint) {
+		if (recordTiles)
+			applied.tiles.set(rayPoint.x, rayPoint.y);
+		DoVisionFlags(rayPoint, doAutomap, visible);
+	};
+	auto markTransparentFn = [&applied](Point rayPoint) {
+		const int8_t trans = dTransVal[rayPoint.x][rayPoint.y];
+		if (trans != 0)
+			applied.transparency[trans] = true;
+	};
+	auto passesLightFn = [](Point rayPoint) {
+		return TileAllowsLight(rayPoint);
+	};
+	auto inBoundsFn = [](Point rayPoint) {
+		return InDungeonBounds(rayPoint);
+	};
+	DoVision(position, radius, markVisibleFn, markTransparentFn, passesLightFn, inBoundsFn);
+
+	applied.doAutomap = doAutomap;
+	applied.visible = visible;
+	applied.isApplied = true;
+	applied.hasTiles = recordTiles;
+}
+
+/**
+ * @brief Marks the tiles in sight of a vision again where DoUnVision cleared them for another vision.
+ */
+void ReapplyVision(const AppliedVision &applied, WorldTileRectangle area)
+{
+	for (const WorldTilePosition tile : PointsInRectangle(area)) {
+		if (InDungeonBounds(tile) && applied.tiles.test(tile.x, tile.y))
+			DoVisionFlags(tile, applied.doAutomap, applied.visible);
+	}
+}
+
+} // namespace
+
+void DoUnLight(Point position, uint8_t radius)
+{
+	radius++;
+	radius++; // If lights moved at a diagonal it can result in some extra tiles being lit
+
 	auto searchArea = PointsInRectangle(WorldTileRectangle { position, radius });
 
+	for (const WorldTilePosition targetPosition : searchArea) {
+		if (InDungeonBounds(targetPosition))
+			dLight[targetPosition.x][targetPosition.y] = dPreLight[targetPosition.x][targetPosition.y];
+	}
+}
+
+void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
+{
+	assert(radius >= 0 && radius <= NumLightRadiuses);
+	assert(InDungeonBounds(position));
+
+	ForEachLitTile(position, radius, offset, [](Point tile, uint8_t v) {
+		if (v < GetLight(tile))
+			SetLight(tile, v);
+	});
+}
+
+void DoUnVision(Point position, uint8_t radius)
+{
+	auto searchArea = PointsInRectangle(GetUnVisionArea(position, radius));
+
 	for (const WorldTilePosition targetPosition : searchArea) {
 		if (InDungeonBounds(targetPosition))
 			dFlags[targetPosition.x][targetPosition.y] &= ~(DungeonFlag::Visible | DungeonFlag::Lit);
@@ -331,6 +547,7 @@ void MakeLightTable()
 void ToggleLighting()
 {
 	DisableLighting = !DisableLighting;
+	ResetAppliedLights();
 
 	if (DisableLighting) {
 		memset(dLight, 0, sizeof(dLight));
@@ -356,7 +573,10 @@ void InitLighting()
 #endif
 
 	std::iota(ActiveLights.begin(), ActiveLights.end(), uint8_t { 0 });
+	ResetAppliedLights();
 	VisionActive = {};
+	for (AppliedVision &applied : AppliedVisions)
+		applied.isApplied = false;
 	TransList = {};
 }
 
@@ -481,26 +701,28 @@ void ProcessLightList()
 	if (!UpdateLighting)
 		return;
 	for (int i = 0; i < ActiveLightCount; i++) {
-		Light &light = Lights[ActiveLights[i]];
-		if (light.isInvalid) {
-			DoUnLight(light.position.tile, light.radius);
-		}
-		if (light.hasChanged) {
-			DoUnLight(light.position.old, light.oldRadius);
+		const int lid = ActiveLights[i];
+		Light &light = Lights[lid];
+		if (light.isInvalid || light.hasChanged) {
+			RemoveLightContribution(lid);
 			light.hasChanged = false;
 		}
 	}
+	RebuildDirtyLight();
 	for (int i = 0; i < ActiveLightCount; i++) {
-		const Light &light = Lights[ActiveLights[i]];
+		const int lid = ActiveLights[i];
+		const Light &light = Lights[lid];
 		if (light.isInvalid) {
 			ActiveLightCount--;
 			std::swap(ActiveLights[ActiveLightCount], ActiveLights[i]);
 			i--;
 			continue;
 		}
+		if (AppliedLights[lid].isApplied)
+			continue;
 		if (TileHasAny(light.position.tile, TileProperties::Solid))
 			continue; // Monster hidden in a wall, don't spoil the surprise
-		DoLighting(light.position.tile, light.radius, light.position.offset);
+		AddLightContribution(lid);
 	}
 
 	UpdateLighting = false;
@@ -511,6 +733,13 @@ void SavePreLighting()
 	memcpy(dPreLight, dLight, sizeof(dPreLight));
 }
 
+void RestorePreLighting()
+{
+	memcpy(dLight, dPreLight, sizeof(dLight));
+	ResetAppliedLights();
+	UpdateLighting = true;
+}
+
 void ActivateVision(Point position, int r, size_t id)
 {
 	auto &vision = VisionList[id];
@@ -519,6 +748,7 @@ void ActivateVision(Point position, int r, size_t id)
 	vision.isInvalid = false;
 	vision.hasChanged = false;
 	VisionActive[id] = true;
+	AppliedVisions[id].isApplied = false;
 
 	UpdateVision = true;
 }
@@ -548,7 +778,8 @@ void ProcessVisionList()
 	if (!UpdateVision)
 		return;
 
-	TransList = {};
+	// Areas cleared by DoUnVision, the visions that didn't change have to mark their tiles there again
+	StaticVector<WorldTileRectangle, MAXVISION> clearedAreas;
 
 	for (const Player &player : Players) {
 		const size_t id = player.getId();
@@ -557,27 +788,46 @@ void ProcessVisionList()
 		Light &vision = VisionList[id];
 		if (!player.plractive || !player.isOnActiveLevel() || (player._pLvlChanging && &player != MyPlayer)) {
 			DoUnVision(vision.position.tile, vision.radius);
+			clearedAreas.push_back(GetUnVisionArea(vision.position.tile, vision.radius));
 			VisionActive[id] = false;
+			AppliedVisions[id].isApplied = false;
 			continue;
 		}
 		if (vision.hasChanged) {
 			DoUnVision(vision.position.old, vision.oldRadius);
+			clearedAreas.push_back(GetUnVisionArea(vision.position.old, vision.oldRadius));
 			vision.hasChanged = false;
+			AppliedVisions[id].isApplied = false;
 		}
 	}
+
+	TransList = {};
 	for (const Player &player : Players) {
 		const size_t id = player.getId();
 		if (!VisionActive[id])
 			continue;
 		const Light &vision = VisionList[id];
+		AppliedVision &applied = AppliedVisions[id];
 		MapExplorationType doautomap = MAP_EXP_SELF;
 		if (&player != MyPlayer)
 			doautomap = player.friendlyMode ? MAP_EXP_OTHERS : MAP_EXP_NONE;
-		DoVision(
-		    vision.position.tile,
-		    vision.radius,
-		    doautomap,
-		    &player == MyPlayer);
+		const bool visible = &player == MyPlayer;
+		if (!applied.isApplied || applied.doAutomap != doautomap || applied.visible != visible) {
+			ApplyVision(applied, vision.position.tile, vision.radius, doautomap, visible, false);
+		} else {
+			const WorldTileRectangle reach { vision.position.tile, vision.radius };
+			for (const WorldTileRectangle &area : clearedAreas) {
+				if (!AreasOverlap(reach, area))
+					continue;
+				if (!applied.hasTiles) {
+					ApplyVision(applied, vision.position.tile, vision.radius, doautomap, visible, true);
+					break;
+				}
+				ReapplyVision(applied, area);
+			}
+		}
+		for (size_t i = 0; i < TransList.size(); i++)
+			TransList[i] = TransList[i] || applied.transparency[i];
 	}
 
 	UpdateVision = false;
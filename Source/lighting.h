@@ -71,6 +71,10 @@ void ChangeLightOffset(int i, DisplacementOf<int8_t> offset);
 void ChangeLight(int i, Point position, uint8_t radius);
 void ProcessLightList();
 void SavePreLighting();
+/**
+ * @brief Resets dLight to the static level lighting, the next ProcessLightList adds all lights back.
+ */
+void RestorePreLighting();
 void ActivateVision(Point position, int r, size_t id);
 void ChangeVisionRadius(size_t id, int r);
 void ChangeVisionXY(size_t id, Point position);
@@ -30,6 +30,7 @@
 #include "menu.h"
 #include "missiles.h"
 #include "monster.h"
+#include "monsters/hot_data.hpp"
 #include "monsters/validation.hpp"
 #include "mpq/mpq_common.hpp"
 #include "pfile.h"
@@ -186,15 +187,15 @@ public:
 };
 
 class SaveHelper {
-	SaveWriter &m_mpqWriter;
+	SaveSnapshot &m_snapshot;
 	const char *m_szFileName_;
 	std::unique_ptr<std::byte[]> m_buffer_;
 	size_t m_cur_ = 0;
 	size_t m_capacity_;
 
 public:
-	SaveHelper(SaveWriter &mpqWriter, const char *szFileName, size_t bufferLen)
-	    : m_mpqWriter(mpqWriter)
+	SaveHelper(SaveSnapshot &snapshot, const char *szFileName, size_t bufferLen)
+	    : m_snapshot(snapshot)
 	    , m_szFileName_(szFileName)
 	    , m_buffer_(new std::byte[codec_get_encoded_len(bufferLen)])
 	    , m_capacity_(bufferLen)
@@ -250,7 +251,7 @@ public:
 		const auto encodedLen = codec_get_encoded_len(m_cur_);
 		const char *const password = pfile_get_password();
 		codec_encode(m_buffer_.get(), m_cur_, encodedLen, password);
-		m_mpqWriter.WriteFile(m_szFileName_, m_buffer_.get(), encodedLen);
+		m_snapshot.WriteFile(m_szFileName_, std::move(m_buffer_), encodedLen);
 	}
 };
 
@@ -811,10 +812,12 @@ void LoadMonsters(LoadHelper &file, ankerl::unordered_dense::set<unsigned> &remo
 		for (size_t i = 0; i < ActiveMonsterCount; i++) {
 			Monster &activeMonster = Monsters[ActiveMonsters[i]];
 			if ((activeMonster.flags & MFLAG_TARGETS_MONSTER) != 0 && activeMonster.enemy == removedMonsterId) {
-				activeMonster.flags |= MFLAG_NO_ENEMY;
+				activeMonster.setFlags(activeMonster.flags | MFLAG_NO_ENEMY);
 			}
 		}
 	}
+
+	SyncAllMonsterHotData();
 }
 
 /**
@@ -1859,18 +1862,18 @@ void SaveDroppedItemLocations(SaveHelper &file, const ankerl::unordered_dense::m
 
 constexpr uint32_t VersionAdditionalMissiles = 0;
 
-void SaveAdditionalMissiles(SaveWriter &saveWriter)
+void SaveAdditionalMissiles(SaveSnapshot &snapshot)
 {
 	constexpr size_t BytesWrittenBySaveMissile = 180;
 	const uint32_t missileCountAdditional = (Missiles.size() > MaxMissilesForSaveGame) ? static_cast<uint32_t>(Missiles.size() - MaxMissilesForSaveGame) : 0;
-	SaveHelper file(saveWriter, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
+	SaveHelper file(snapshot, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
 
 	file.WriteLE<uint32_t>(VersionAdditionalMissiles);
 	file.WriteLE<uint32_t>(missileCountAdditional);
 
 	if (missileCountAdditional > 0) {
 		auto it = Missiles.cbegin();
-		// std::list::const_iterator doesn't provide operator+() :/ using std::advance to get past the missiles we've already saved
+		// StablePool::const_iterator doesn't provide operator+() :/ using std::advance to get past the missiles we've already saved
 		std::advance(it, MaxMissilesForSaveGame);
 		for (; it != Missiles.cend(); it++) {
 			SaveMissile(&file, *it);
@@ -1898,9 +1901,9 @@ void LoadAdditionalMissiles()
 	}
 }
 
-void SaveLevelSeeds(SaveWriter &saveWriter)
+void SaveLevelSeeds(SaveSnapshot &snapshot)
 {
-	SaveHelper file(saveWriter, "levelseeds", giNumberOfLevels * (sizeof(uint8_t) + sizeof(uint32_t)));
+	SaveHelper file(snapshot, "levelseeds", giNumberOfLevels * (sizeof(uint8_t) + sizeof(uint32_t)));
 
 	for (int i = 0; i < giNumberOfLevels; i++) {
 		file.WriteLE<uint8_t>(LevelSeeds[i] ? 1 : 0);
@@ -1925,7 +1928,7 @@ void LoadLevelSeeds()
 	}
 }
 
-void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
+void SaveLevel(SaveSnapshot &snapshot, LevelConversionData *levelConversionData)
 {
 	Player &myPlayer = *MyPlayer;
 
@@ -1936,7 +1939,7 @@ void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
 
 	char szName[MaxMpqPathSize];
 	GetTempLevelNames(szName);
-	SaveHelper file(saveWriter, szName, 256 * 1024);
+	SaveHelper file(snapshot, szName, 256 * 1024);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
@@ -2085,7 +2088,7 @@ tl::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionDa
 		}
 
 		// No need to load dLight, we can recreate it accurately from LightList
-		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
+		RestorePreLighting();                                                          // resets the light on entering a level to get rid of incorrect light
 		ChangeLightXY(Players[MyPlayerId].lightId, Players[MyPlayerId].position.tile); // forces player light refresh
 	} else {
 		memset(dLight, 0, sizeof(dLight));
@@ -2145,7 +2148,9 @@ tl::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter)
 
 		LevelConversionData levelConversionData;
 		RETURN_IF_ERROR(LoadLevel(&levelConversionData));
-		SaveLevel(saveWriter, &levelConversionData);
+		SaveSnapshot snapshot;
+		SaveLevel(snapshot, &levelConversionData);
+		snapshot.Apply(saveWriter);
 	}
 
 	setlevel = true; // Convert quest levels
@@ -2165,7 +2170,9 @@ tl::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter)
 
 		LevelConversionData levelConversionData;
 		RETURN_IF_ERROR(LoadLevel(&levelConversionData));
-		SaveLevel(saveWriter, &levelConversionData);
+		SaveSnapshot snapshot;
+		SaveLevel(snapshot, &levelConversionData);
+		snapshot.Apply(saveWriter);
 	}
 
 	gbSkipSync = false;
@@ -2371,9 +2378,9 @@ void LoadHotkeys()
 	myPlayer._pRSplType = static_cast<SpellType>(file.NextLE<uint8_t>());
 }
 
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player)
 {
-	SaveHelper file(saveWriter, "hotkeys", HotkeysSize());
+	SaveHelper file(snapshot, "hotkeys", HotkeysSize());
 
 	// Write the number of spell hotkeys
 	file.WriteLE<uint8_t>(static_cast<uint8_t>(NumHotkeys));
@@ -2642,7 +2649,7 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 		file.Skip(MAXDUNX * MAXDUNY); // dMissile
 
 		// No need to load dLight, we can recreate it accurately from LightList
-		memcpy(dLight, dPreLight, sizeof(dLight));               // resets the light on entering a level to get rid of incorrect light
+		RestorePreLighting();                                    // resets the light on entering a level to get rid of incorrect light
 		ChangeLightXY(myPlayer.lightId, myPlayer.position.tile); // forces player light refresh
 	} else {
 		memset(dLight, 0, sizeof(dLight));
@@ -2687,10 +2694,10 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 	return {};
 }
 
-void SaveHeroItems(SaveWriter &saveWriter, Player &player)
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player)
 {
 	const size_t itemCount = static_cast<size_t>(NUM_INVLOC) + InventoryGridCells + MaxBeltItems;
-	SaveHelper file(saveWriter, "heroitems", (itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize)) + sizeof(uint8_t));
+	SaveHelper file(snapshot, "heroitems", (itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize)) + sizeof(uint8_t));
 
 	file.WriteLE<uint8_t>(gbIsHellfire ? 1 : 0);
 
@@ -2702,7 +2709,7 @@ void SaveHeroItems(SaveWriter &saveWriter, Player &player)
 		SaveItem(file, item);
 }
 
-void SaveStash(SaveWriter &stashWriter)
+void SaveStash(SaveSnapshot &snapshot)
 {
 	const char *filename;
 	if (!gbIsMultiplayer)
@@ -2713,7 +2720,7 @@ void SaveStash(SaveWriter &stashWriter)
 	const int itemSize = (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize);
 
 	SaveHelper file(
-	    stashWriter,
+	    snapshot,
 	    filename,
 	    sizeof(uint8_t)
 	        + sizeof(uint32_t)
@@ -2759,9 +2766,9 @@ void SaveStash(SaveWriter &stashWriter)
 	file.WriteLE<uint32_t>(static_cast<uint32_t>(Stash.GetPage()));
 }
 
-void SaveGameData(SaveWriter &saveWriter)
+void SaveGameData(SaveSnapshot &snapshot)
 {
-	SaveHelper file(saveWriter, "game", 320 * 1024);
+	SaveHelper file(snapshot, "game", 320 * 1024);
 
 	if (gbIsSpawn && !gbIsHellfire)
 		file.WriteLE<uint32_t>(LoadLE32("SHAR"));
@@ -2922,20 +2929,20 @@ void SaveGameData(SaveWriter &saveWriter)
 	file.WriteLE<uint8_t>(AutomapActive ? 1 : 0);
 	file.WriteBE<int32_t>(AutoMapScale);
 
-	SaveAdditionalMissiles(saveWriter);
-	SaveLevelSeeds(saveWriter);
+	SaveAdditionalMissiles(snapshot);
+	SaveLevelSeeds(snapshot);
 }
 
 void SaveGame()
 {
 	gbValidSaveFile = true;
-	pfile_write_hero(/*writeGameData=*/true);
+	pfile_write_hero_in_background(/*writeGameData=*/true);
 	sfile_write_stash();
 }
 
-void SaveLevel(SaveWriter &saveWriter)
+void SaveLevel(SaveSnapshot &snapshot)
 {
-	SaveLevel(saveWriter, nullptr);
+	SaveLevel(snapshot, nullptr);
 }
 
 tl::expected<void, std::string> LoadLevel()
@@ -37,14 +37,14 @@ void RemoveEmptyInventory(Player &player);
  * @param firstflag Can be set to false if we are simply reloading the current game
  */
 tl::expected<void, std::string> LoadGame(bool firstflag);
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player);
-void SaveHeroItems(SaveWriter &saveWriter, Player &player);
-void SaveGameData(SaveWriter &saveWriter);
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player);
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player);
+void SaveGameData(SaveSnapshot &snapshot);
 void SaveGame();
-void SaveLevel(SaveWriter &saveWriter);
+void SaveLevel(SaveSnapshot &snapshot);
 tl::expected<void, std::string> LoadLevel();
 tl::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter);
 void LoadStash();
-void SaveStash(SaveWriter &stashWriter);
+void SaveStash(SaveSnapshot &snapshot);
 
 } // namespace devilution
@@ -23,6 +23,7 @@
 #include <config.h>
 
 #include "appfat.h"
+#include "data/table_cache.hpp"
 #include "effects.h"
 #include "engine/assets.hpp"
 #include "lua/lua_event.hpp"
@@ -250,6 +251,7 @@ void LuaReloadActiveMods()
 
 	std::vector<std::string_view> modnames = GetOptions().Mods.GetActiveModList();
 	LoadModArchives(modnames);
+	SetTableCacheModList(modnames);
 
 	for (const std::string_view modname : modnames) {
 		const std::string packageName = StrCat("mods.", modname, ".init");
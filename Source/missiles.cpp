@@ -13,7 +13,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <list>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -70,7 +69,7 @@
 
 namespace devilution {
 
-std::list<Missile> Missiles;
+StablePool<Missile> Missiles;
 bool MissilePreFlag;
 
 void Missile::setAnimation(MissileGraphicID animtype)
@@ -1052,7 +1051,7 @@ bool MonsterTrapHit(Monster &monster, int mindam, int maxdam, int dist, MissileI
 	ApplyMonsterDamage(damageType, monster, dam);
 #ifdef _DEBUG
 	if (DebugGodMode)
-		monster.hitPoints = 0;
+		monster.setHitPoints(0);
 #endif
 	if (monster.hasNoLife()) {
 		MonsterDeath(monster, monster.direction, true);
@@ -1337,7 +1336,7 @@ void AddBerserk(Missile &missile, AddMissileParameter &parameter)
 		Monster &monster = Monsters[std::abs(dMonster[targetMonsterPosition->x][targetMonsterPosition->y]) - 1];
 		const Player &player = *missile.sourcePlayer();
 		const int slvl = player.GetSpellLevel(SpellID::Berserk);
-		monster.flags |= MFLAG_BERSERK | MFLAG_GOLEM;
+		monster.setFlags(monster.flags | MFLAG_BERSERK | MFLAG_GOLEM);
 		monster.minDamage = (GenerateRnd(10) + 120) * monster.minDamage / 100 + slvl;
 		monster.maxDamage = (GenerateRnd(10) + 120) * monster.maxDamage / 100 + slvl;
 		monster.minDamageSpecial = (GenerateRnd(10) + 120) * monster.minDamageSpecial / 100 + slvl;
@@ -3772,9 +3771,9 @@ void ProcessRhino(Missile &missile)
 		missile._miDelFlag = true;
 		return;
 	}
-	monster.position.future = newPos;
+	monster.setFuture(newPos);
 	monster.position.old = newPos;
-	monster.position.tile = newPos;
+	monster.setTile(newPos);
 	monster.occupyTile(newPos, true);
 	if (monster.isUnique())
 		ChangeLightXY(missile._mlid, newPos);
@@ -6,7 +6,6 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
 #include <optional>
 
 #include "engine/displacement.hpp"
@@ -17,6 +16,7 @@
 #include "tables/misdat.h"
 #include "tables/spelldat.h"
 #include "utils/is_of.hpp"
+#include "utils/stable_pool.hpp"
 
 namespace devilution {
 
@@ -235,7 +235,7 @@ public:
 	}
 };
 
-extern std::list<Missile> Missiles;
+extern StablePool<Missile> Missiles;
 extern bool MissilePreFlag;
 
 struct DamageRange {
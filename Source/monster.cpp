@@ -74,6 +74,9 @@
 #include "lua/lua_event.hpp"
 #include "minitext.h"
 #include "missiles.h"
+#include "monsters/hot_data.hpp"
+#include "monsters/path_service.hpp"
+#include "monsters/sprite_loader.hpp"
 #include "movie.h"
 #include "msg.h"
 #include "multi.h"
@@ -103,6 +106,7 @@
 #include "utils/static_vector.hpp"
 #include "utils/status_macros.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/trace.hpp"
 
 #ifdef _DEBUG
 #include "debug.h"
@@ -197,8 +201,8 @@ void InitMonsterTRN(CMonster &monst)
 void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point position)
 {
 	monster.direction = rd;
-	monster.position.tile = position;
-	monster.position.future = position;
+	monster.setTile(position);
+	monster.setFuture(position);
 	monster.position.old = position;
 	monster.levelType = static_cast<uint8_t>(typeIndex);
 	monster.mode = MonsterMode::Stand;
@@ -213,7 +217,7 @@ void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point positio
 	if (!gbIsMultiplayer)
 		monster.maxHitPoints = std::max(monster.maxHitPoints / 2, 64);
 
-	monster.hitPoints = monster.maxHitPoints;
+	monster.setHitPoints(monster.maxHitPoints);
 	monster.ai = monster.data().ai;
 	monster.intelligence = monster.data().intelligence;
 	monster.goal = MonsterGoal::Normal;
@@ -243,13 +247,13 @@ void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point positio
 	monster.resistance = monster.data().resistance;
 	monster.leader = Monster::NoLeader;
 	monster.leaderRelation = LeaderRelation::None;
-	monster.flags = monster.data().abilityFlags;
+	monster.setFlags(monster.data().abilityFlags);
 	monster.talkMsg = TEXT_NONE;
 
 	if (monster.ai == MonsterAIID::Gargoyle) {
 		monster.changeAnimationData(MonsterGraphic::Special);
 		monster.animInfo.currentFrame = 0;
-		monster.flags |= MFLAG_ALLOW_SPECIAL;
+		monster.setFlags(monster.flags | MFLAG_ALLOW_SPECIAL);
 		monster.mode = MonsterMode::SpecialMeleeAttack;
 	}
 
@@ -259,7 +263,7 @@ void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point positio
 			monster.maxHitPoints += (gbIsMultiplayer ? 100 : 50) << 6;
 		else
 			monster.maxHitPoints += 100 << 6;
-		monster.hitPoints = monster.maxHitPoints;
+		monster.setHitPoints(monster.maxHitPoints);
 		monster.minDamage = 2 * (monster.minDamage + 2);
 		monster.maxDamage = 2 * (monster.maxDamage + 2);
 		monster.minDamageSpecial = 2 * (monster.minDamageSpecial + 2);
@@ -271,7 +275,7 @@ void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point positio
 			monster.maxHitPoints += (gbIsMultiplayer ? 200 : 100) << 6;
 		else
 			monster.maxHitPoints += 200 << 6;
-		monster.hitPoints = monster.maxHitPoints;
+		monster.setHitPoints(monster.maxHitPoints);
 		monster.minDamage = 4 * monster.minDamage + 6;
 		monster.maxDamage = 4 * monster.maxDamage + 6;
 		monster.minDamageSpecial = 4 * monster.minDamageSpecial + 6;
@@ -352,7 +356,7 @@ void PlaceGroup(size_t typeIndex, size_t num, Monster *leader = nullptr, bool le
 			if (leader != nullptr) {
 				Monster &minion = Monsters[ActiveMonsterCount];
 				minion.maxHitPoints *= 2;
-				minion.hitPoints = minion.maxHitPoints;
+				minion.setHitPoints(minion.maxHitPoints);
 				minion.intelligence = leader->intelligence;
 
 				if (leashed) {
@@ -362,7 +366,7 @@ void PlaceGroup(size_t typeIndex, size_t num, Monster *leader = nullptr, bool le
 				if (minion.ai != MonsterAIID::Gargoyle) {
 					minion.changeAnimationData(MonsterGraphic::Stand);
 					minion.animInfo.currentFrame = GenerateRnd(minion.animInfo.numberOfFrames - 1);
-					minion.flags &= ~MFLAG_ALLOW_SPECIAL;
+					minion.setFlags(minion.flags & ~MFLAG_ALLOW_SPECIAL);
 					minion.mode = MonsterMode::Stand;
 				}
 			}
@@ -490,12 +494,12 @@ void ClrAllMonsters()
 		monster.mode = MonsterMode::Stand;
 		monster.var1 = 0;
 		monster.var2 = 0;
-		monster.position.tile = { 0, 0 };
-		monster.position.future = { 0, 0 };
+		monster.setTile({ 0, 0 });
+		monster.setFuture({ 0, 0 });
 		monster.position.old = { 0, 0 };
 		monster.direction = static_cast<Direction>(GenerateRnd(8));
 		monster.animInfo = {};
-		monster.flags = MFLAG_NO_ENEMY;
+		monster.setFlags(MFLAG_NO_ENEMY);
 		monster.isInvalid = false;
 		monster.enemy = 0;
 		monster.enemyPosition = {};
@@ -647,7 +651,7 @@ void DeleteMonster(size_t activeIndex)
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
 		Monster &activeMonster = Monsters[ActiveMonsters[i]];
 		if ((activeMonster.flags & MFLAG_TARGETS_MONSTER) != 0 && activeMonster.enemy == monsterId) {
-			activeMonster.flags |= MFLAG_NO_ENEMY;
+			activeMonster.setFlags(activeMonster.flags | MFLAG_NO_ENEMY);
 		}
 	}
 }
@@ -656,7 +660,7 @@ void NewMonsterAnim(Monster &monster, MonsterGraphic graphic, Direction md, Anim
 {
 	const auto &animData = monster.type().getAnimData(graphic);
 	monster.animInfo.setNewAnimation(animData.spritesForDirection(md), animData.frames, animData.rate, flags, numSkippedFrames, distributeFramesBeforeFrame);
-	monster.flags &= ~(MFLAG_LOCK_ANIMATION | MFLAG_ALLOW_SPECIAL);
+	monster.setFlags(monster.flags & ~(MFLAG_LOCK_ANIMATION | MFLAG_ALLOW_SPECIAL));
 	monster.direction = md;
 }
 
@@ -667,8 +671,8 @@ void StartMonsterGotHit(Monster &monster)
 		NewMonsterAnim(monster, MonsterGraphic::GotHit, monster.direction, animationFlags);
 		monster.mode = MonsterMode::HitRecovery;
 	}
-	monster.position.tile = monster.position.old;
-	monster.position.future = monster.position.old;
+	monster.setTile(monster.position.old);
+	monster.setFuture(monster.position.old);
 	M_ClearSquares(monster);
 	monster.occupyTile(monster.position.tile, false);
 }
@@ -686,6 +690,7 @@ void UpdateEnemy(Monster &monster)
 	bool bestsameroom = false;
 	const WorldTilePosition position = monster.position.tile;
 	const bool isPlayerMinion = monster.isPlayerMinion();
+	const bool huntsMonsters = (monster.flags & (MFLAG_GOLEM | MFLAG_BERSERK)) != 0;
 	if (!isPlayerMinion) {
 		for (size_t pnum = 0; pnum < Players.size(); pnum++) {
 			const Player &player = Players[pnum];
@@ -697,7 +702,7 @@ void UpdateEnemy(Monster &monster)
 			if ((sameroom && !bestsameroom)
 			    || ((sameroom || !bestsameroom) && dist < bestDist)
 			    || (menemy == -1)) {
-				monster.flags &= ~MFLAG_TARGETS_MONSTER;
+				monster.setFlags(monster.flags & ~MFLAG_TARGETS_MONSTER);
 				menemy = static_cast<int>(pnum);
 				target = player.position.future;
 				bestDist = dist;
@@ -707,6 +712,9 @@ void UpdateEnemy(Monster &monster)
 	}
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
 		const unsigned monsterId = ActiveMonsters[i];
+		// Most monsters only go after golems, so skip the others without touching them
+		if (!huntsMonsters && (MonstersHot.flags[monsterId] & MFLAG_GOLEM) == 0)
+			continue;
 		Monster &otherMonster = Monsters[monsterId];
 		if (&otherMonster == &monster)
 			continue;
@@ -720,20 +728,14 @@ void UpdateEnemy(Monster &monster)
 			continue;
 
 		const int dist = otherMonster.position.tile.WalkingDistance(position);
-		if (((monster.flags & MFLAG_GOLEM) == 0
-		        && (monster.flags & MFLAG_BERSERK) == 0
-		        && dist >= 2
-		        && !IsRanged(monster))
-		    || ((monster.flags & MFLAG_GOLEM) == 0
-		        && (monster.flags & MFLAG_BERSERK) == 0
-		        && (otherMonster.flags & MFLAG_GOLEM) == 0)) {
+		if (!huntsMonsters && dist >= 2 && !IsRanged(monster)) {
 			continue;
 		}
 		const bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
 		if ((sameroom && !bestsameroom)
 		    || ((sameroom || !bestsameroom) && dist < bestDist)
 		    || (menemy == -1)) {
-			monster.flags |= MFLAG_TARGETS_MONSTER;
+			monster.setFlags(monster.flags | MFLAG_TARGETS_MONSTER);
 			menemy = static_cast<int>(monsterId);
 			target = otherMonster.position.future;
 			bestDist = dist;
@@ -741,11 +743,11 @@ void UpdateEnemy(Monster &monster)
 		}
 	}
 	if (menemy != -1) {
-		monster.flags &= ~MFLAG_NO_ENEMY;
+		monster.setFlags(monster.flags & ~MFLAG_NO_ENEMY);
 		monster.enemy = menemy;
 		monster.enemyPosition = target;
 	} else {
-		monster.flags |= MFLAG_NO_ENEMY;
+		monster.setFlags(monster.flags | MFLAG_NO_ENEMY);
 	}
 }
 
@@ -780,7 +782,7 @@ void StartSpecialStand(Monster &monster, Direction md)
 {
 	NewMonsterAnim(monster, MonsterGraphic::Special, md);
 	monster.mode = MonsterMode::SpecialStand;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 }
 
@@ -814,7 +816,7 @@ void WalkInDirection(Monster &monster, Direction endDir)
 	}
 	monster.mode = mode;
 	monster.position.old = monster.position.tile;
-	monster.position.future = { fx, fy };
+	monster.setFuture({ fx, fy });
 	monster.occupyTile(monster.position.future, true);
 	monster.var1 = dir.x;
 	monster.var2 = dir.y;
@@ -827,7 +829,7 @@ void StartAttack(Monster &monster)
 	const Direction md = GetMonsterDirection(monster);
 	NewMonsterAnim(monster, MonsterGraphic::Attack, md, AnimationDistributionFlags::ProcessAnimationPending);
 	monster.mode = MonsterMode::MeleeAttack;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 }
 
@@ -838,7 +840,7 @@ void StartRangedAttack(Monster &monster, MissileID missileType, int dam)
 	monster.mode = MonsterMode::RangedAttack;
 	monster.var1 = static_cast<int8_t>(missileType);
 	monster.var2 = dam;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 }
 
@@ -853,7 +855,7 @@ void StartRangedSpecialAttack(Monster &monster, MissileID missileType, int dam)
 	monster.var1 = static_cast<int8_t>(missileType);
 	monster.var2 = 0;
 	monster.var3 = dam;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 }
 
@@ -862,7 +864,7 @@ void StartSpecialAttack(Monster &monster)
 	const Direction md = GetMonsterDirection(monster);
 	NewMonsterAnim(monster, MonsterGraphic::Special, md);
 	monster.mode = MonsterMode::SpecialMeleeAttack;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 }
 
@@ -870,7 +872,7 @@ void StartEating(Monster &monster)
 {
 	NewMonsterAnim(monster, MonsterGraphic::Special, monster.direction);
 	monster.mode = MonsterMode::SpecialMeleeAttack;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 }
 
@@ -892,8 +894,8 @@ void DiabloDeath(Monster &diablo, bool sendmsg)
 		NewMonsterAnim(monster, MonsterGraphic::Death, monster.direction);
 		monster.mode = MonsterMode::Death;
 		monster.var1 = 0;
-		monster.position.tile = monster.position.old;
-		monster.position.future = monster.position.tile;
+		monster.setTile(monster.position.old);
+		monster.setFuture(monster.position.tile);
 		M_ClearSquares(monster);
 		monster.occupyTile(monster.position.tile, false);
 	}
@@ -1020,11 +1022,11 @@ void StartFadein(Monster &monster, Direction md, bool backwards)
 {
 	NewMonsterAnim(monster, MonsterGraphic::Special, md);
 	monster.mode = MonsterMode::FadeIn;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
-	monster.flags &= ~MFLAG_HIDDEN;
+	monster.setFlags(monster.flags & ~MFLAG_HIDDEN);
 	if (backwards) {
-		monster.flags |= MFLAG_LOCK_ANIMATION;
+		monster.setFlags(monster.flags | MFLAG_LOCK_ANIMATION);
 		monster.animInfo.currentFrame = monster.animInfo.numberOfFrames - 1;
 	}
 }
@@ -1033,10 +1035,10 @@ void StartFadeout(Monster &monster, Direction md, bool backwards)
 {
 	NewMonsterAnim(monster, MonsterGraphic::Special, md);
 	monster.mode = MonsterMode::FadeOut;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 	if (backwards) {
-		monster.flags |= MFLAG_LOCK_ANIMATION;
+		monster.setFlags(monster.flags | MFLAG_LOCK_ANIMATION);
 		monster.animInfo.currentFrame = monster.animInfo.numberOfFrames - 1;
 	}
 }
@@ -1054,7 +1056,7 @@ void StartHeal(Monster &monster)
 {
 	monster.changeAnimationData(MonsterGraphic::Special);
 	monster.animInfo.currentFrame = monster.type().getAnimData(MonsterGraphic::Special).frames - 1;
-	monster.flags |= MFLAG_LOCK_ANIMATION;
+	monster.setFlags(monster.flags | MFLAG_LOCK_ANIMATION);
 	monster.mode = MonsterMode::Heal;
 	monster.var1 = monster.maxHitPoints / (16 * (GenerateRnd(5) + 4));
 }
@@ -1091,8 +1093,10 @@ bool MonsterWalk(Monster &monster)
 	const bool isAnimationEnd = monster.animInfo.isLastFrame();
 	if (isAnimationEnd) {
 		dMonster[monster.position.tile.x][monster.position.tile.y] = 0;
-		monster.position.tile.x += monster.var1;
-		monster.position.tile.y += monster.var2;
+		WorldTilePosition tile = monster.position.tile;
+		tile.x += monster.var1;
+		tile.y += monster.var2;
+		monster.setTile(tile);
 		// dMonster is set here for backwards compatibility; without it, the monster would be invisible if loaded from a vanilla save.
 		monster.occupyTile(monster.position.tile, false);
 		ChangeLightXY(monster.lightId, monster.position.tile);
@@ -1238,7 +1242,7 @@ void MonsterAttackPlayer(Monster &monster, Player &player, int hit, int minDam,
 	}
 
 	if ((monster.flags & MFLAG_NOLIFESTEAL) == 0 && monster.type().type == MT_SKING && gbIsMultiplayer)
-		monster.hitPoints += dam;
+		monster.setHitPoints(monster.hitPoints + dam);
 	if (player.hasNoLife()) {
 		if (gbIsHellfire)
 			M_StartStand(monster, monster.direction);
@@ -1347,9 +1351,9 @@ bool MonsterRangedSpecialAttack(Monster &monster)
 
 	if (monster.ai == MonsterAIID::Mega && monster.animInfo.currentFrame == monster.data().animFrameNumSpecial - 1) {
 		if (monster.var2++ == 0) {
-			monster.flags |= MFLAG_ALLOW_SPECIAL;
+			monster.setFlags(monster.flags | MFLAG_ALLOW_SPECIAL);
 		} else if (monster.var2 == 15) {
-			monster.flags &= ~MFLAG_ALLOW_SPECIAL;
+			monster.setFlags(monster.flags & ~MFLAG_ALLOW_SPECIAL);
 		}
 	}
 
@@ -1383,7 +1387,7 @@ bool MonsterFadein(Monster &monster)
 	}
 
 	M_StartStand(monster, monster.direction);
-	monster.flags &= ~MFLAG_LOCK_ANIMATION;
+	monster.setFlags(monster.flags & ~MFLAG_LOCK_ANIMATION);
 
 	return true;
 }
@@ -1395,8 +1399,8 @@ bool MonsterFadeout(Monster &monster)
 		return false;
 	}
 
-	monster.flags &= ~MFLAG_LOCK_ANIMATION;
-	monster.flags |= MFLAG_HIDDEN;
+	monster.setFlags(monster.flags & ~MFLAG_LOCK_ANIMATION);
+	monster.setFlags(monster.flags | MFLAG_HIDDEN);
 
 	M_StartStand(monster, monster.direction);
 
@@ -1414,13 +1418,13 @@ bool MonsterFadeout(Monster &monster)
 void MonsterHeal(Monster &monster)
 {
 	if (monster.animInfo.currentFrame == 0) {
-		monster.flags &= ~MFLAG_LOCK_ANIMATION;
-		monster.flags |= MFLAG_ALLOW_SPECIAL;
+		monster.setFlags(monster.flags & ~MFLAG_LOCK_ANIMATION);
+		monster.setFlags(monster.flags | MFLAG_ALLOW_SPECIAL);
 		if (monster.var1 + monster.hitPoints < monster.maxHitPoints) {
-			monster.hitPoints = monster.var1 + monster.hitPoints;
+			monster.setHitPoints(monster.var1 + monster.hitPoints);
 		} else {
-			monster.hitPoints = monster.maxHitPoints;
-			monster.flags &= ~MFLAG_ALLOW_SPECIAL;
+			monster.setHitPoints(monster.maxHitPoints);
+			monster.setFlags(monster.flags & ~MFLAG_ALLOW_SPECIAL);
 			monster.mode = MonsterMode::SpecialMeleeAttack;
 		}
 	}
@@ -1443,7 +1447,7 @@ void MonsterTalk(Monster &monster)
 			Quests[Q_LTBANNER]._qvar1 = 2;
 			if (Quests[Q_LTBANNER]._qactive == QUEST_INIT)
 				Quests[Q_LTBANNER]._qactive = QUEST_ACTIVE;
-			monster.flags |= MFLAG_QUEST_COMPLETE;
+			monster.setFlags(monster.flags | MFLAG_QUEST_COMPLETE);
 			NetSendCmdQuest(true, Quests[Q_LTBANNER]);
 		}
 		if (Quests[Q_LTBANNER]._qvar1 < 2) {
@@ -1691,7 +1695,7 @@ void FollowTheLeader(Monster &monster)
 		return;
 	if (leader->mode == MonsterMode::SpecialMeleeAttack)
 		return;
-	monster.flags &= ~MFLAG_ALLOW_SPECIAL;
+	monster.setFlags(monster.flags & ~MFLAG_ALLOW_SPECIAL);
 	monster.mode = MonsterMode::SpecialMeleeAttack;
 }
 
@@ -1724,7 +1728,7 @@ void GroupUnity(Monster &monster)
 			leader.activeForTicks = monster.activeForTicks - 1;
 		}
 		if (leader.ai == MonsterAIID::Gargoyle && (leader.flags & MFLAG_ALLOW_SPECIAL) != 0) {
-			leader.flags &= ~MFLAG_ALLOW_SPECIAL;
+			leader.setFlags(leader.flags & ~MFLAG_ALLOW_SPECIAL);
 			leader.mode = MonsterMode::SpecialMeleeAttack;
 		}
 	}
@@ -1816,16 +1820,16 @@ bool IsTileAccessible(const Monster &monster, Point position)
 
 bool AiPlanWalk(Monster &monster)
 {
-	int8_t path[MaxPathLengthMonsters];
-
 	/** Maps from walking path step to facing direction. */
 	const Direction plr2monst[9] = { Direction::South, Direction::NorthEast, Direction::NorthWest, Direction::SouthEast, Direction::SouthWest, Direction::North, Direction::East, Direction::South, Direction::West };
 
-	if (FindPath(CanStep, [&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
+	const bool canOpenDoors = (monster.flags & MFLAG_CAN_OPEN_DOOR) != 0;
+	const int8_t step = FindMonsterPathStep(monster.position.tile, monster.enemyPosition, canOpenDoors, [&monster](Point position) { return IsTileAccessible(monster, position); });
+	if (step == 0) {
 		return false;
 	}
 
-	RandomWalk(monster, plr2monst[path[0]]);
+	RandomWalk(monster, plr2monst[step]);
 	return true;
 }
 
@@ -2219,12 +2223,12 @@ void ScavengerAi(Monster &monster)
 			StartEating(monster);
 			if (gbIsHellfire) {
 				const int mMaxHP = monster.maxHitPoints;
-				monster.hitPoints += mMaxHP / 8;
-				monster.hitPoints = std::min(monster.hitPoints, monster.maxHitPoints);
+				monster.setHitPoints(monster.hitPoints + mMaxHP / 8);
+				monster.setHitPoints(std::min(monster.hitPoints, monster.maxHitPoints));
 				if (monster.goalVar3 <= 0 || monster.hitPoints == monster.maxHitPoints)
 					dCorpse[monster.position.tile.x][monster.position.tile.y] = 0;
 			} else {
-				monster.hitPoints += 64;
+				monster.setHitPoints(monster.hitPoints + 64);
 			}
 			int targetHealth = monster.maxHitPoints;
 			if (!gbIsHellfire)
@@ -2338,9 +2342,9 @@ void FallenAi(Monster &monster)
 		}
 		StartSpecialStand(monster, monster.direction);
 		if (monster.maxHitPoints - (2 * monster.intelligence + 2) >= monster.hitPoints)
-			monster.hitPoints += 2 * monster.intelligence + 2;
+			monster.setHitPoints(monster.hitPoints + 2 * monster.intelligence + 2);
 		else
-			monster.hitPoints = monster.maxHitPoints;
+			monster.setHitPoints(monster.maxHitPoints);
 		const int rad = (2 * monster.intelligence) + 4;
 		for (int y = -rad; y <= rad; y++) {
 			for (int x = -rad; x <= rad; x++) {
@@ -2486,7 +2490,7 @@ void GargoyleAi(Monster &monster)
 	if (monster.activeForTicks != 0 && (monster.flags & MFLAG_ALLOW_SPECIAL) != 0) {
 		UpdateEnemy(monster);
 		if (distanceToEnemy < monster.intelligence + 2U) {
-			monster.flags &= ~MFLAG_ALLOW_SPECIAL;
+			monster.setFlags(monster.flags & ~MFLAG_ALLOW_SPECIAL);
 		}
 		return;
 	}
@@ -3082,8 +3086,8 @@ std::string_view GetMonsterTypeText(const MonsterData &monsterData)
 void ActivateSpawn(Monster &monster, Point position, Direction dir)
 {
 	monster.occupyTile(position, false);
-	monster.position.tile = position;
-	monster.position.future = position;
+	monster.setTile(position);
+	monster.setFuture(position);
 	monster.position.old = position;
 	StartSpecialStand(monster, dir);
 }
@@ -3153,7 +3157,7 @@ bool IsRelativeMoveOK(const Monster &monster, Point position, Direction mdir)
 	return true;
 }
 
-bool IsMonsterAvailable(const MonsterData &monsterData)
+bool IsMonsterAvailable(const MonsterData &monsterData, int level)
 {
 	if (monsterData.availability == MonsterAvailability::Never)
 		return false;
@@ -3161,7 +3165,7 @@ bool IsMonsterAvailable(const MonsterData &monsterData)
 	if (gbIsSpawn && monsterData.availability == MonsterAvailability::Retail)
 		return false;
 
-	return currlevel >= monsterData.minDunLvl && currlevel <= monsterData.maxDunLvl;
+	return level >= monsterData.minDunLvl && level <= monsterData.maxDunLvl;
 }
 
 bool UpdateModeStance(Monster &monster)
@@ -3209,44 +3213,6 @@ bool UpdateModeStance(Monster &monster)
 	}
 }
 
-MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData)
-{
-	const size_t numAnims = GetNumAnims(monsterData);
-
-	MonsterSpritesData result;
-	result.data = MultiFileLoader<MonsterSpritesData::MaxAnims> {}(
-	    numAnims,
-	    FileNameWithCharAffixGenerator({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter),
-	    result.offsets.data(),
-	    [&monsterData](size_t index) { return monsterData.hasAnim(index); });
-
-#ifndef UNPACKED_MPQS
-	// Convert CL2 to CLX:
-	std::vector<std::vector<uint8_t>> clxData;
-	size_t accumulatedSize = 0;
-	for (size_t i = 0, j = 0; i < numAnims; ++i) {
-		if (!monsterData.hasAnim(i))
-			continue;
-		const uint32_t begin = result.offsets[j];
-		const uint32_t end = result.offsets[j + 1];
-		clxData.emplace_back();
-		Cl2ToClx(reinterpret_cast<uint8_t *>(&result.data[begin]), end - begin,
-		    PointerOrValue<uint16_t> { monsterData.width }, clxData.back());
-		result.offsets[j] = static_cast<uint32_t>(accumulatedSize);
-		accumulatedSize += clxData.back().size();
-		++j;
-	}
-	result.offsets[clxData.size()] = static_cast<uint32_t>(accumulatedSize);
-	result.data = nullptr;
-	result.data = std::unique_ptr<std::byte[]>(new std::byte[accumulatedSize]);
-	for (size_t i = 0; i < clxData.size(); ++i) {
-		memcpy(&result.data[result.offsets[i]], clxData[i].data(), clxData[i].size());
-	}
-#endif
-
-	return result;
-}
-
 void EnsureMonsterIndexIsActive(size_t monsterId)
 {
 	assert(monsterId < MaxMonsters);
@@ -3264,11 +3230,11 @@ void EnsureMonsterIndexIsActive(size_t monsterId)
 
 void InitGolem(devilution::Monster &monster, uint8_t golemOwnerPlayerId, int16_t golemSpellLevel)
 {
-	monster.flags |= MFLAG_GOLEM;
+	monster.setFlags(monster.flags | MFLAG_GOLEM);
 	monster.goalVar3 = static_cast<int8_t>(golemOwnerPlayerId);
 	const Player &player = Players[golemOwnerPlayerId];
 	monster.maxHitPoints = 2 * (320 * golemSpellLevel + player._pMaxMana / 3);
-	monster.hitPoints = monster.maxHitPoints;
+	monster.setHitPoints(monster.maxHitPoints);
 	monster.armorClass = 25;
 	monster.golemToHit = 5 * (golemSpellLevel + 8) + 2 * player.getCharacterLevel();
 	monster.minDamage = 2 * (golemSpellLevel + 4);
@@ -3286,8 +3252,176 @@ bool PosOkMovingMissile(Point position)
 	return !IsMissileBlockedByTile(position);
 }
 
+/**
+ * @brief Adds the monster types of a level to `types`, see GetLevelMTypes.
+ *
+ * Apart from the quests, this only depends on the level and the random numbers, so the same choices can be made
+ * ahead of time for a level that is about to be entered.
+ *
+ * @param types Needs `add(_monster_id, placeflag)`, `count()` and `imageTotal()`.
+ * @param generateRnd Same as GenerateRnd, for the random number generator of the level.
+ */
+template <typename LevelTypes, typename RandomFn>
+tl::expected<void, std::string> ChooseLevelMonsterTypes(LevelTypes &types, int level, bool isSetLevel, _setlevels setLevelNum, RandomFn &&generateRnd)
+{
+	const auto addUnique = [&types](UniqueMonsterType uniqueType, placeflag placeflag) {
+		return types.add(UniqueMonstersData[static_cast<size_t>(uniqueType)].mtype, placeflag);
+	};
+
+	RETURN_IF_ERROR(types.add(MT_GOLEM, PLACE_SPECIAL));
+	if (level == 16) {
+		RETURN_IF_ERROR(types.add(MT_ADVOCATE, PLACE_SCATTER));
+		RETURN_IF_ERROR(types.add(MT_RBLACK, PLACE_SCATTER));
+		RETURN_IF_ERROR(types.add(MT_DIABLO, PLACE_SPECIAL));
+		return {};
+	}
+
+	if (level == 18)
+		RETURN_IF_ERROR(types.add(MT_HORKSPWN, PLACE_SCATTER));
+	if (level == 19) {
+		RETURN_IF_ERROR(types.add(MT_HORKSPWN, PLACE_SCATTER));
+		RETURN_IF_ERROR(types.add(MT_HORKDMN, PLACE_UNIQUE));
+	}
+	if (level == 20)
+		RETURN_IF_ERROR(types.add(MT_DEFILER, PLACE_UNIQUE));
+	if (level == 24) {
+		RETURN_IF_ERROR(types.add(MT_ARCHLICH, PLACE_SCATTER));
+		RETURN_IF_ERROR(types.add(MT_NAKRUL, PLACE_SPECIAL));
+	}
+
+	if (!isSetLevel) {
+		if (Quests[Q_BUTCHER].IsAvailableOnLevel(level))
+			RETURN_IF_ERROR(types.add(MT_CLEAVER, PLACE_SPECIAL));
+		if (Quests[Q_GARBUD].IsAvailableOnLevel(level))
+			RETURN_IF_ERROR(addUnique(UniqueMonsterType::Garbud, PLACE_UNIQUE));
+		if (Quests[Q_ZHAR].IsAvailableOnLevel(level))
+			RETURN_IF_ERROR(addUnique(UniqueMonsterType::Zhar, PLACE_UNIQUE));
+		if (Quests[Q_LTBANNER].IsAvailableOnLevel(level))
+			RETURN_IF_ERROR(addUnique(UniqueMonsterType::SnotSpill, PLACE_UNIQUE));
+		if (Quests[Q_VEIL].IsAvailableOnLevel(level))
+			RETURN_IF_ERROR(addUnique(UniqueMonsterType::Lachdan, PLACE_UNIQUE));
+		if (Quests[Q_WARLORD].IsAvailableOnLevel(level))
+			RETURN_IF_ERROR(addUnique(UniqueMonsterType::WarlordOfBlood, PLACE_UNIQUE));
+
+		if (UseMultiplayerQuests() && level == Quests[Q_SKELKING]._qlevel) {
+
+			RETURN_IF_ERROR(types.add(MT_SKING, PLACE_UNIQUE));
+
+			int skeletonTypeCount = 0;
+			_monster_id skeltypes[NUM_MAX_MTYPES];
+			for (const _monster_id skeletonType : SkeletonTypes) {
+				if (!IsMonsterAvailable(MonstersData[skeletonType], level))
+					continue;
+
+				skeltypes[skeletonTypeCount++] = skeletonType;
+			}
+			RETURN_IF_ERROR(types.add(skeltypes[generateRnd(skeletonTypeCount)], PLACE_SCATTER));
+		}
+
+		_monster_id typelist[MaxMonsters];
+
+		int nt = 0;
+		for (size_t i = 0; i < MonstersData.size(); i++) {
+			if (!IsMonsterAvailable(MonstersData[i], level))
+				continue;
+
+			typelist[nt++] = (_monster_id)i;
+		}
+
+		while (nt > 0 && types.count() < MaxLvlMTypes && types.imageTotal() < 4000) {
+			for (int i = 0; i < nt;) {
+				if (MonstersData[typelist[i]].image > 4000 - types.imageTotal()) {
+					typelist[i] = typelist[--nt];
+					continue;
+				}
+
+				i++;
+			}
+
+			if (nt != 0) {
+				const int i = generateRnd(nt);
+				RETURN_IF_ERROR(types.add(typelist[i], PLACE_SCATTER));
+				typelist[i] = typelist[--nt];
+			}
+		}
+	} else {
+		if (setLevelNum == SL_SKELKING) {
+			RETURN_IF_ERROR(types.add(MT_SKING, PLACE_UNIQUE));
+		}
+	}
+	return {};
+}
+
+/** @brief Adds the chosen monster types to LevelMonsterTypes. */
+struct CurrentLevelMonsterTypes {
+	tl::expected<void, std::string> add(_monster_id type, placeflag placeflag)
+	{
+		RETURN_IF_ERROR(AddMonsterType(type, placeflag));
+		return {};
+	}
+
+	[[nodiscard]] size_t count() const { return LevelMonsterTypeCount; }
+	[[nodiscard]] int imageTotal() const { return monstimgtot; }
+};
+
+/** @brief Only records the chosen monster types, the same way AddMonsterType counts them. */
+struct GuessedMonsterTypes {
+	StaticVector<_monster_id, MaxLvlMTypes> types;
+	int images = 0;
+
+	tl::expected<void, std::string> add(_monster_id type, placeflag /*placeflag*/)
+	{
+		if (c_find(types, type) != types.end())
+			return {};
+		types.emplace_back(type);
+		images += MonstersData[type].image;
+		return {};
+	}
+
+	[[nodiscard]] size_t count() const { return types.size(); }
+	[[nodiscard]] int imageTotal() const { return images; }
+};
+
 } // namespace
 
+MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData, bool threadsafe)
+{
+	const size_t numAnims = GetNumAnims(monsterData);
+
+	MonsterSpritesData result;
+	result.data = MultiFileLoader<MonsterSpritesData::MaxAnims> { threadsafe }(
+	    numAnims,
+	    FileNameWithCharAffixGenerator({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter),
+	    result.offsets.data(),
+	    [&monsterData](size_t index) { return monsterData.hasAnim(index); });
+
+#ifndef UNPACKED_MPQS
+	// Convert CL2 to CLX:
+	std::vector<std::vector<uint8_t>> clxData;
+	size_t accumulatedSize = 0;
+	for (size_t i = 0, j = 0; i < numAnims; ++i) {
+		if (!monsterData.hasAnim(i))
+			continue;
+		const uint32_t begin = result.offsets[j];
+		const uint32_t end = result.offsets[j + 1];
+		clxData.emplace_back();
+		Cl2ToClx(reinterpret_cast<uint8_t *>(&result.data[begin]), end - begin,
+		    PointerOrValue<uint16_t> { monsterData.width }, clxData.back());
+		result.offsets[j] = static_cast<uint32_t>(accumulatedSize);
+		accumulatedSize += clxData.back().size();
+		++j;
+	}
+	result.offsets[clxData.size()] = static_cast<uint32_t>(accumulatedSize);
+	result.data = nullptr;
+	result.data = std::unique_ptr<std::byte[]>(new std::byte[accumulatedSize]);
+	for (size_t i = 0; i < clxData.size(); ++i) {
+		memcpy(&result.data[result.offsets[i]], clxData[i].data(), clxData[i].size());
+	}
+#endif
+
+	return result;
+}
+
 tl::expected<size_t, std::string> AddMonsterType(_monster_id type, placeflag placeflag)
 {
 	const size_t typeIndex = GetMonsterTypeIndex(type);
@@ -3332,7 +3466,7 @@ tl::expected<void, std::string> PrepareUniqueMonst(Monster &monster, UniqueMonst
 	if (!gbIsMultiplayer)
 		monster.maxHitPoints = std::max(monster.maxHitPoints / 2, 64);
 
-	monster.hitPoints = monster.maxHitPoints;
+	monster.setHitPoints(monster.maxHitPoints);
 	monster.ai = uniqueMonsterData.mAi;
 	monster.intelligence = uniqueMonsterData.mint;
 	monster.minDamage = uniqueMonsterData.mMinDamage;
@@ -3370,7 +3504,7 @@ tl::expected<void, std::string> PrepareUniqueMonst(Monster &monster, UniqueMonst
 			monster.maxHitPoints += (gbIsMultiplayer ? 100 : 50) << 6;
 		else
 			monster.maxHitPoints += 100 << 6;
-		monster.hitPoints = monster.maxHitPoints;
+		monster.setHitPoints(monster.maxHitPoints);
 		monster.minDamage = 2 * (monster.minDamage + 2);
 		monster.maxDamage = 2 * (monster.maxDamage + 2);
 		monster.minDamageSpecial = 2 * (monster.minDamageSpecial + 2);
@@ -3381,7 +3515,7 @@ tl::expected<void, std::string> PrepareUniqueMonst(Monster &monster, UniqueMonst
 			monster.maxHitPoints += (gbIsMultiplayer ? 200 : 100) << 6;
 		else
 			monster.maxHitPoints += 200 << 6;
-		monster.hitPoints = monster.maxHitPoints;
+		monster.setHitPoints(monster.maxHitPoints);
 		monster.minDamage = 4 * monster.minDamage + 6;
 		monster.maxDamage = 4 * monster.maxDamage + 6;
 		monster.minDamageSpecial = 4 * monster.minDamageSpecial + 6;
@@ -3408,7 +3542,7 @@ tl::expected<void, std::string> PrepareUniqueMonst(Monster &monster, UniqueMonst
 	if (monster.ai != MonsterAIID::Gargoyle) {
 		monster.changeAnimationData(MonsterGraphic::Stand);
 		monster.animInfo.currentFrame = GenerateRnd(monster.animInfo.numberOfFrames - 1);
-		monster.flags &= ~MFLAG_ALLOW_SPECIAL;
+		monster.setFlags(monster.flags & ~MFLAG_ALLOW_SPECIAL);
 		monster.mode = MonsterMode::Stand;
 	}
 	return {};
@@ -3433,88 +3567,21 @@ void InitLevelMonsters()
 
 tl::expected<void, std::string> GetLevelMTypes()
 {
-	RETURN_IF_ERROR(AddMonsterType(MT_GOLEM, PLACE_SPECIAL));
-	if (currlevel == 16) {
-		RETURN_IF_ERROR(AddMonsterType(MT_ADVOCATE, PLACE_SCATTER));
-		RETURN_IF_ERROR(AddMonsterType(MT_RBLACK, PLACE_SCATTER));
-		RETURN_IF_ERROR(AddMonsterType(MT_DIABLO, PLACE_SPECIAL));
-		return {};
-	}
-
-	if (currlevel == 18)
-		RETURN_IF_ERROR(AddMonsterType(MT_HORKSPWN, PLACE_SCATTER));
-	if (currlevel == 19) {
-		RETURN_IF_ERROR(AddMonsterType(MT_HORKSPWN, PLACE_SCATTER));
-		RETURN_IF_ERROR(AddMonsterType(MT_HORKDMN, PLACE_UNIQUE));
-	}
-	if (currlevel == 20)
-		RETURN_IF_ERROR(AddMonsterType(MT_DEFILER, PLACE_UNIQUE));
-	if (currlevel == 24) {
-		RETURN_IF_ERROR(AddMonsterType(MT_ARCHLICH, PLACE_SCATTER));
-		RETURN_IF_ERROR(AddMonsterType(MT_NAKRUL, PLACE_SPECIAL));
-	}
-
-	if (!setlevel) {
-		if (Quests[Q_BUTCHER].IsAvailable())
-			RETURN_IF_ERROR(AddMonsterType(MT_CLEAVER, PLACE_SPECIAL));
-		if (Quests[Q_GARBUD].IsAvailable())
-			RETURN_IF_ERROR(AddMonsterType(UniqueMonsterType::Garbud, PLACE_UNIQUE));
-		if (Quests[Q_ZHAR].IsAvailable())
-			RETURN_IF_ERROR(AddMonsterType(UniqueMonsterType::Zhar, PLACE_UNIQUE));
-		if (Quests[Q_LTBANNER].IsAvailable())
-			RETURN_IF_ERROR(AddMonsterType(UniqueMonsterType::SnotSpill, PLACE_UNIQUE));
-		if (Quests[Q_VEIL].IsAvailable())
-			RETURN_IF_ERROR(AddMonsterType(UniqueMonsterType::Lachdan, PLACE_UNIQUE));
-		if (Quests[Q_WARLORD].IsAvailable())
-			RETURN_IF_ERROR(AddMonsterType(UniqueMonsterType::WarlordOfBlood, PLACE_UNIQUE));
-
-		if (UseMultiplayerQuests() && currlevel == Quests[Q_SKELKING]._qlevel) {
-
-			RETURN_IF_ERROR(AddMonsterType(MT_SKING, PLACE_UNIQUE));
-
-			int skeletonTypeCount = 0;
-			_monster_id skeltypes[NUM_MAX_MTYPES];
-			for (const _monster_id skeletonType : SkeletonTypes) {
-				if (!IsMonsterAvailable(MonstersData[skeletonType]))
-					continue;
-
-				skeltypes[skeletonTypeCount++] = skeletonType;
-			}
-			RETURN_IF_ERROR(AddMonsterType(skeltypes[GenerateRnd(skeletonTypeCount)], PLACE_SCATTER));
-		}
-
-		_monster_id typelist[MaxMonsters];
-
-		int nt = 0;
-		for (size_t i = 0; i < MonstersData.size(); i++) {
-			if (!IsMonsterAvailable(MonstersData[i]))
-				continue;
-
-			typelist[nt++] = (_monster_id)i;
-		}
-
-		while (nt > 0 && LevelMonsterTypeCount < MaxLvlMTypes && monstimgtot < 4000) {
-			for (int i = 0; i < nt;) {
-				if (MonstersData[typelist[i]].image > 4000 - monstimgtot) {
-					typelist[i] = typelist[--nt];
-					continue;
-				}
+	CurrentLevelMonsterTypes types;
+	return ChooseLevelMonsterTypes(types, currlevel, setlevel, setlvlnum, GenerateRnd);
+}
 
-				i++;
-			}
+void PrefetchLevelMonsterSprites(int level)
+{
+	if (HeadlessMode)
+		return;
 
-			if (nt != 0) {
-				const int i = GenerateRnd(nt);
-				RETURN_IF_ERROR(AddMonsterType(typelist[i], PLACE_SCATTER));
-				typelist[i] = typelist[--nt];
-			}
-		}
-	} else {
-		if (setlvlnum == SL_SKELKING) {
-			RETURN_IF_ERROR(AddMonsterType(MT_SKING, PLACE_UNIQUE));
-		}
-	}
-	return {};
+	// Same seed as SetRndSeedForDungeonLevel, which is set right before GetLevelMTypes
+	DiabloGenerator rng(DungeonSeeds[level]);
+	GuessedMonsterTypes types;
+	if (!ChooseLevelMonsterTypes(types, level, /*isSetLevel=*/false, SL_NONE, [&rng](int32_t v) { return rng.generateRnd(v); }))
+		return;
+	PrefetchMonsterSprites({ types.types.data(), types.types.size() });
 }
 
 tl::expected<void, std::string> InitMonsterSND(CMonster &monsterType)
@@ -3555,6 +3622,8 @@ tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpr
 	const MonsterData &monsterData = MonstersData[mtype];
 	if (spritesData.data == nullptr)
 		spritesData = LoadMonsterSpritesData(monsterData);
+	if (monsterType.animData != nullptr)
+		ClearClxDrawCache();
 	monsterType.animData = std::move(spritesData.data);
 
 	const size_t numAnims = GetNumAnims(monsterData);
@@ -3622,6 +3691,7 @@ tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpr
 
 tl::expected<void, std::string> InitAllMonsterGFX()
 {
+	const TraceZone traceZone("InitAllMonsterGFX");
 	if (HeadlessMode)
 		return {};
 
@@ -3630,6 +3700,15 @@ tl::expected<void, std::string> InitAllMonsterGFX()
 	for (size_t i = 0; i < LevelMonsterTypeCount; ++i) {
 		monstersBySprite[static_cast<size_t>(LevelMonsterTypes[i].data().spriteId)].emplace_back(i);
 	}
+
+	// Sprites that weren't prefetched are loaded by the worker threads as well, while this thread wires them up in order.
+	StaticVector<_monster_id, MaxLvlMTypes> spritesToLoad;
+	for (const LevelMonsterTypeIndices &monsterTypes : monstersBySprite) {
+		if (!monsterTypes.empty() && LevelMonsterTypes[monsterTypes[0]].animData == nullptr)
+			spritesToLoad.emplace_back(LevelMonsterTypes[monsterTypes[0]].type);
+	}
+	PrefetchMonsterSprites({ spritesToLoad.data(), spritesToLoad.size() });
+
 	size_t totalUniqueBytes = 0;
 	size_t totalBytes = 0;
 	for (const LevelMonsterTypeIndices &monsterTypes : monstersBySprite) {
@@ -3638,7 +3717,7 @@ tl::expected<void, std::string> InitAllMonsterGFX()
 		CMonster &firstMonster = LevelMonsterTypes[monsterTypes[0]];
 		if (firstMonster.animData != nullptr)
 			continue;
-		MonsterSpritesData spritesData = LoadMonsterSpritesData(firstMonster.data());
+		MonsterSpritesData spritesData = TakeMonsterSprites(firstMonster.type);
 		const size_t spritesDataSize = spritesData.offsets[GetNumAnimsWithGraphics(firstMonster.data())];
 		for (size_t i = 1; i < monsterTypes.size(); ++i) {
 			MonsterSpritesData spritesDataCopy { std::unique_ptr<std::byte[]> { new std::byte[spritesDataSize] }, spritesData.offsets };
@@ -3673,7 +3752,7 @@ void WeakenNaKrul()
 	monster.armorClass -= 50;
 	const int hp = monster.maxHitPoints / 2;
 	monster.resistance = 0;
-	monster.hitPoints = hp;
+	monster.setHitPoints(hp);
 	monster.maxHitPoints = hp;
 }
 
@@ -3871,7 +3950,7 @@ void ApplyMonsterDamage(DamageType damageType, Monster &monster, int damage)
 {
 	lua::OnMonsterTakeDamage(&monster, damage, static_cast<int>(damageType));
 
-	monster.hitPoints -= damage;
+	monster.setHitPoints(monster.hitPoints - damage);
 
 	if (monster.hasNoLife()) {
 		delta_kill_monster(monster, monster.position.tile, *MyPlayer);
@@ -3935,7 +4014,7 @@ void M_StartStand(Monster &monster, Direction md)
 	monster.var1 = static_cast<int>(monster.mode);
 	monster.var2 = 0;
 	monster.mode = MonsterMode::Stand;
-	monster.position.future = monster.position.tile;
+	monster.setFuture(monster.position.tile);
 	monster.position.old = monster.position.tile;
 	UpdateEnemy(monster);
 }
@@ -3985,7 +4064,7 @@ void M_StartHit(Monster &monster, const Player &player, int dam)
 	if (IsHardHit(monster, dam)) {
 		monster.enemy = player.getId();
 		monster.enemyPosition = player.position.future;
-		monster.flags &= ~MFLAG_TARGETS_MONSTER;
+		monster.setFlags(monster.flags & ~MFLAG_TARGETS_MONSTER);
 		if (monster.mode != MonsterMode::Petrified) {
 			monster.direction = GetMonsterDirection(monster);
 		}
@@ -4000,8 +4079,8 @@ void MonsterDeath(Monster &monster, Direction md, bool sendmsg)
 		AddPlrMonstExper(monster.level(sgGameInitInfo.nDifficulty), monster.exp(sgGameInitInfo.nDifficulty), monster.whoHit);
 
 	MonsterKillCounts[monster.type().type]++;
-	monster.hitPoints = 0;
-	monster.flags &= ~MFLAG_HIDDEN;
+	monster.setHitPoints(0);
+	monster.setFlags(monster.flags & ~MFLAG_HIDDEN);
 	SetRndSeed(monster.rndItemSeed);
 
 	SpawnLoot(monster, sendmsg);
@@ -4021,8 +4100,8 @@ void MonsterDeath(Monster &monster, Direction md, bool sendmsg)
 	}
 	monster.goal = MonsterGoal::None;
 	monster.var1 = 0;
-	monster.position.tile = monster.position.old;
-	monster.position.future = monster.position.old;
+	monster.setTile(monster.position.old);
+	monster.setFuture(monster.position.old);
 	M_ClearSquares(monster);
 	monster.occupyTile(monster.position.tile, false);
 	CheckQuestKill(monster, sendmsg);
@@ -4058,7 +4137,7 @@ void M_SyncStartKill(Monster &monster, Point position, const Player &player)
 
 	if (dMonster[position.x][position.y] == 0) {
 		M_ClearSquares(monster);
-		monster.position.tile = position;
+		monster.setTile(position);
 		monster.position.old = position;
 	}
 
@@ -4224,8 +4303,8 @@ void DeleteMonsterList()
 		if (!golem.isInvalid)
 			continue;
 
-		golem.position.tile = GolemHoldingCell;
-		golem.position.future = { 0, 0 };
+		golem.setTile(GolemHoldingCell);
+		golem.setFuture({ 0, 0 });
 		golem.position.old = { 0, 0 };
 		golem.isInvalid = false;
 	}
@@ -4250,7 +4329,7 @@ void RemoveEnemyReferences(const Player &player)
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
 		Monster &activeMonster = Monsters[ActiveMonsters[i]];
 		if ((activeMonster.flags & MFLAG_TARGETS_MONSTER) == 0 && activeMonster.enemy == playerId) {
-			activeMonster.flags |= MFLAG_NO_ENEMY;
+			activeMonster.setFlags(activeMonster.flags | MFLAG_NO_ENEMY);
 		}
 	}
 }
@@ -4269,11 +4348,11 @@ void ProcessMonsters()
 		}
 		if (monster.hitPoints < monster.maxHitPoints && !monster.hasNoLife()) {
 			if (monster.level(sgGameInitInfo.nDifficulty) > 1) {
-				monster.hitPoints += monster.level(sgGameInitInfo.nDifficulty) / 2;
+				monster.setHitPoints(monster.hitPoints + monster.level(sgGameInitInfo.nDifficulty) / 2);
 			} else {
-				monster.hitPoints += monster.level(sgGameInitInfo.nDifficulty);
+				monster.setHitPoints(monster.hitPoints + monster.level(sgGameInitInfo.nDifficulty));
 			}
-			monster.hitPoints = std::min(monster.hitPoints, monster.maxHitPoints); // prevent going over max HP with part of a single regen tick
+			monster.setHitPoints(std::min(monster.hitPoints, monster.maxHitPoints)); // prevent going over max HP with part of a single regen tick
 		}
 
 		const bool isMonsterVisible = IsTileVisible(monster.position.tile);
@@ -4352,6 +4431,7 @@ void FreeMonsters()
 			}
 		}
 	}
+	ClearClxDrawCache();
 }
 
 bool DirOK(const Monster &monster, Direction mdir)
@@ -4586,7 +4666,7 @@ void MissToMonst(Missile &missile, Point position)
 	const Point oldPosition = missile.position.tile;
 	monster.occupyTile(position, false);
 	monster.direction = missile.getDirection();
-	monster.position.tile = position;
+	monster.setTile(position);
 	M_StartStand(monster, monster.direction);
 	M_StartHit(monster, 0);
 
@@ -4630,8 +4710,8 @@ void MissToMonst(Missile &missile, Point position)
 	if (IsTileAvailable(*target, newPosition)) {
 		monster.occupyTile(newPosition, false);
 		dMonster[oldPosition.x][oldPosition.y] = 0;
-		monster.position.tile = newPosition;
-		monster.position.future = newPosition;
+		monster.setTile(newPosition);
+		monster.setFuture(newPosition);
 	}
 }
 
@@ -4764,7 +4844,7 @@ void TalktoMonster(Player &player, Monster &monster)
 		if (RemoveInventoryItemById(player, IDI_GLDNELIX) && (monster.flags & MFLAG_QUEST_COMPLETE) == 0) {
 			monster.talkMsg = TEXT_VEIL11;
 			monster.goal = MonsterGoal::Inquiring;
-			monster.flags |= MFLAG_QUEST_COMPLETE;
+			monster.setFlags(monster.flags | MFLAG_QUEST_COMPLETE);
 			if (MyPlayer == &player) {
 				SpawnUnique(UITEM_STEELVEIL, monster.position.tile + Direction::South);
 				Quests[Q_VEIL]._qvar2 = QS_VEIL_ITEM_SPAWNED;
@@ -4782,7 +4862,7 @@ void TalktoMonster(Player &player, Monster &monster)
 			SetRndSeed(monster.rndItemSeed);
 			DiscardRandomValues(10);
 			CreateTypeItem(monster.position.tile + Displacement { 1, 1 }, false, ItemType::Misc, IMISC_BOOK, false, false, true);
-			monster.flags |= MFLAG_QUEST_COMPLETE;
+			monster.setFlags(monster.flags | MFLAG_QUEST_COMPLETE);
 			NetSendCmdQuest(true, Quests[Q_ZHAR]);
 		}
 	}
@@ -4797,7 +4877,7 @@ void TalktoMonster(Player &player, Monster &monster)
 			SetRndSeed(monster.rndItemSeed);
 			DiscardRandomValues(10);
 			SpawnItem(monster, monster.position.tile + Displacement { 1, 1 }, false, true);
-			monster.flags |= MFLAG_QUEST_COMPLETE;
+			monster.setFlags(monster.flags | MFLAG_QUEST_COMPLETE);
 			Quests[Q_GARBUD]._qvar1 = QS_GHARBAD_FIRST_ITEM_SPAWNED;
 			NetSendCmdQuest(true, Quests[Q_GARBUD]);
 		}
@@ -4861,11 +4941,11 @@ void decode_enemy(Monster &monster, uint8_t enemyId)
 {
 	if (enemyId >= MaxMonsters) {
 		enemyId -= MaxMonsters;
-		monster.flags &= ~MFLAG_TARGETS_MONSTER;
+		monster.setFlags(monster.flags & ~MFLAG_TARGETS_MONSTER);
 		monster.enemy = enemyId;
 		monster.enemyPosition = Players[enemyId].position.future;
 	} else {
-		monster.flags |= MFLAG_TARGETS_MONSTER;
+		monster.setFlags(monster.flags | MFLAG_TARGETS_MONSTER);
 		monster.enemy = enemyId;
 		monster.enemyPosition = Monsters[enemyId].position.future;
 	}
@@ -4977,7 +5057,7 @@ void Monster::tag(const Player &tagger)
 bool Monster::tryLiftGargoyle()
 {
 	if (ai == MonsterAIID::Gargoyle && (flags & MFLAG_ALLOW_SPECIAL) != 0) {
-		flags &= ~MFLAG_ALLOW_SPECIAL;
+		setFlags(flags & ~MFLAG_ALLOW_SPECIAL);
 		mode = MonsterMode::SpecialMeleeAttack;
 		return true;
 	}
@@ -5039,4 +5119,28 @@ void Monster::occupyTile(Point tile, bool isMoving) const
 	dMonster[tile.x][tile.y] = isMoving ? -id : id;
 }
 
+void Monster::setTile(WorldTilePosition tile)
+{
+	position.tile = tile;
+	MonstersHot.tile[getId()] = tile;
+}
+
+void Monster::setFuture(WorldTilePosition tile)
+{
+	position.future = tile;
+	MonstersHot.future[getId()] = tile;
+}
+
+void Monster::setHitPoints(int hitPoints)
+{
+	this->hitPoints = hitPoints;
+	MonstersHot.hitPoints[getId()] = hitPoints;
+}
+
+void Monster::setFlags(uint32_t flags)
+{
+	this->flags = flags;
+	MonstersHot.flags[getId()] = flags;
+}
+
 } // namespace devilution
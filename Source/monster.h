@@ -216,7 +216,9 @@ struct Monster { // note: missing field _mAFNum
 	 */
 	AnimationInfo animInfo;
 	int maxHitPoints;
+	/** Mirrored in MonstersHot, only change it through setHitPoints() */
 	int hitPoints;
+	/** Mirrored in MonstersHot, only change it through setFlags() */
 	uint32_t flags;
 	/** Seed used to determine item drops on death */
 	uint32_t rndItemSeed;
@@ -245,6 +247,7 @@ struct Monster { // note: missing field _mAFNum
 	int16_t var2;
 	int8_t var3;
 
+	/** The tile and future tile are mirrored in MonstersHot, only change them through setTile() and setFuture() */
 	ActorPosition position;
 
 	/** Specifies current goal of the monster */
@@ -483,6 +486,15 @@ struct Monster { // note: missing field _mAFNum
 	 */
 	void occupyTile(Point tile, bool isMoving) const;
 
+	/** @brief Sets position.tile and its copy in MonstersHot. */
+	void setTile(WorldTilePosition tile);
+	/** @brief Sets position.future and its copy in MonstersHot. */
+	void setFuture(WorldTilePosition tile);
+	/** @brief Sets hitPoints and its copy in MonstersHot. */
+	void setHitPoints(int hitPoints);
+	/** @brief Sets flags and its copy in MonstersHot. */
+	void setFlags(uint32_t flags);
+
 	bool hasNoLife() const
 	{
 		return hitPoints >> 6 <= 0;
@@ -499,12 +511,24 @@ extern bool sgbSaveSoundOn;
 tl::expected<void, std::string> PrepareUniqueMonst(Monster &monster, UniqueMonsterType monsterType, size_t miniontype, int bosspacksize, const UniqueMonsterData &uniqueMonsterData);
 void InitLevelMonsters();
 tl::expected<void, std::string> GetLevelMTypes();
+/**
+ * @brief Starts loading the sprites of the monster types GetLevelMTypes will pick for a dungeon level in the background.
+ *
+ * The types are guessed from the level seed, so they only differ if the quests change before the level is entered.
+ */
+void PrefetchLevelMonsterSprites(int level);
 tl::expected<size_t, std::string> AddMonsterType(_monster_id type, placeflag placeflag);
 inline tl::expected<size_t, std::string> AddMonsterType(UniqueMonsterType uniqueType, placeflag placeflag)
 {
 	return AddMonsterType(UniqueMonstersData[static_cast<size_t>(uniqueType)].mtype, placeflag);
 }
 tl::expected<void, std::string> InitMonsterSND(CMonster &monsterType);
+/**
+ * @brief Reads the sprites of a monster type and converts them to CLX.
+ *
+ * @param threadsafe Whether other threads may read from the archives at the same time.
+ */
+MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData, bool threadsafe = false);
 tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpritesData &&spritesData = {});
 tl::expected<void, std::string> InitAllMonsterGFX();
 void WeakenNaKrul();
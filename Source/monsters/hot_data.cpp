@@ -0,0 +1,27 @@
+/**
+ * @file monsters/hot_data.cpp
+ *
+ * Implementation of the mirror of the monster fields read by the hot loops.
+ */
+#include "monsters/hot_data.hpp"
+
+#include <cstddef>
+
+#include "monster.h"
+
+namespace devilution {
+
+MonsterHotData MonstersHot;
+
+void SyncAllMonsterHotData()
+{
+	for (size_t id = 0; id < MaxMonsters; id++) {
+		const Monster &monster = Monsters[id];
+		MonstersHot.tile[id] = monster.position.tile;
+		MonstersHot.future[id] = monster.position.future;
+		MonstersHot.hitPoints[id] = monster.hitPoints;
+		MonstersHot.flags[id] = monster.flags;
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,48 @@
+/**
+ * @file monsters/hot_data.hpp
+ *
+ * Interface of the mirror of the monster fields read by the hot loops.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "engine/world_tile.hpp"
+#include "monster.h"
+
+namespace devilution {
+
+/**
+ * @brief Copies of the fields that AI, targeting and rendering check for every active monster, stored per field so
+ * that skipping most monsters doesn't pull each one's Monster into the cache.
+ *
+ * Indexed by monster id, like Monsters. The entries are written by the Monster setters for these fields, so they are
+ * always current. Only loading a game writes the fields directly, and it calls SyncAllMonsterHotData() afterwards.
+ */
+struct MonsterHotData {
+	std::array<WorldTilePosition, MaxMonsters> tile;
+	std::array<WorldTilePosition, MaxMonsters> future;
+	std::array<int, MaxMonsters> hitPoints;
+	std::array<uint32_t, MaxMonsters> flags;
+
+	[[nodiscard]] bool hasNoLife(size_t monsterId) const
+	{
+		return hitPoints[monsterId] >> 6 <= 0;
+	}
+
+	[[nodiscard]] bool isPlayerMinion(size_t monsterId) const
+	{
+		return (flags[monsterId] & MFLAG_GOLEM) != 0 && (flags[monsterId] & MFLAG_BERSERK) == 0;
+	}
+};
+
+extern MonsterHotData MonstersHot;
+
+/**
+ * @brief Refreshes the mirrored fields of all monsters, active or not.
+ */
+void SyncAllMonsterHotData();
+
+} // namespace devilution
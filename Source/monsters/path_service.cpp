@@ -0,0 +1,61 @@
+/**
+ * @file monsters/path_service.cpp
+ *
+ * Implementation of the path finding shared by all monsters on the level.
+ */
+#include "monsters/path_service.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <function_ref.hpp>
+
+#include "engine/flow_field.hpp"
+#include "engine/path.h"
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+#include "levels/tile_properties.hpp"
+
+namespace devilution {
+
+namespace {
+
+/** Walkability for monsters that can't and that can open doors */
+std::array<WalkabilityGrid, 2> WalkabilityGrids { WalkabilityGrid { Size { MAXDUNX, MAXDUNY } }, WalkabilityGrid { Size { MAXDUNX, MAXDUNY } } };
+std::array<bool, 2> WalkabilityGridIsCurrent;
+
+/** Flow fields on each of the walkability grids */
+std::array<FlowFieldCache, 2> FlowFields { FlowFieldCache { MaxPathLengthMonsters }, FlowFieldCache { MaxPathLengthMonsters } };
+
+const WalkabilityGrid &GetWalkabilityGrid(bool canOpenDoors)
+{
+	WalkabilityGrid &grid = WalkabilityGrids[canOpenDoors ? 1 : 0];
+	if (!WalkabilityGridIsCurrent[canOpenDoors ? 1 : 0]) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			for (int x = 0; x < MAXDUNX; x++) {
+				const Point position { x, y };
+				grid.setTile(position, IsTileWalkable(position, canOpenDoors), IsTileNotSolid(position));
+			}
+		}
+		WalkabilityGridIsCurrent[canOpenDoors ? 1 : 0] = true;
+	}
+	return grid;
+}
+
+} // namespace
+
+int8_t FindMonsterPathStep(Point start, Point target, bool canOpenDoors, tl::function_ref<bool(Point)> posOk)
+{
+	const WalkabilityGrid &grid = GetWalkabilityGrid(canOpenDoors);
+	return FlowFields[canOpenDoors ? 1 : 0].firstStep(grid, CanStep, posOk, start, target);
+}
+
+void ResetMonsterPathCache()
+{
+	WalkabilityGridIsCurrent = {};
+	for (FlowFieldCache &fields : FlowFields)
+		fields.clear();
+}
+
+} // namespace devilution
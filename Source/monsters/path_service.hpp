@@ -0,0 +1,37 @@
+/**
+ * @file monsters/path_service.hpp
+ *
+ * Interface of the path finding shared by all monsters on the level.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <function_ref.hpp>
+
+#include "engine/point.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Finds the first step of a path from `start` to `target` for a monster.
+ *
+ * Returns the same step as FindPath. Once a search for a target finds no path, the monsters heading there share a
+ * flow field, which rules out the ones that can't reach it without running a search per monster.
+ *
+ * @param canOpenDoors Whether doors count as walkable.
+ * @param posOk Checks tiles for things that change during the tick, like other monsters.
+ * @return The step as returned by GetPathDirection, or 0 if there is no path within MaxPathLengthMonsters steps.
+ */
+int8_t FindMonsterPathStep(Point start, Point target, bool canOpenDoors, tl::function_ref<bool(Point)> posOk);
+
+/**
+ * @brief Throws away the walkability grids and flow fields.
+ *
+ * They are kept across game ticks, so this needs to be called when a level is loaded and whenever a tile becomes
+ * walkable, like when a door opens or a barrel breaks. Tiles that stop being walkable only make the fields rule out
+ * fewer searches.
+ */
+void ResetMonsterPathCache();
+
+} // namespace devilution
@@ -0,0 +1,237 @@
+/**
+ * @file monsters/sprite_loader.cpp
+ *
+ * Implementation of the loading of monster sprites on worker threads.
+ */
+#include "monsters/sprite_loader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_cpuinfo.h>
+#else
+#include <SDL.h>
+#endif
+
+#include "monster.h"
+#include "tables/monstdat.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+/** Upper bound for the number of threads loading sprites, which are mostly waiting for the disk. */
+constexpr size_t MaxLoaderThreads = 3;
+
+size_t DetectLoaderThreads()
+{
+#if defined(__DJGPP__) || defined(__EMSCRIPTEN__)
+	return 0;
+#elif defined(USE_SDL1)
+	return 1;
+#else
+#ifdef USE_SDL3
+	const int cpuCount = SDL_GetNumLogicalCPUCores();
+#else
+	const int cpuCount = SDL_GetCPUCount();
+#endif
+	// Leave one core to the thread that is waiting for the sprites.
+	return std::clamp<size_t>(static_cast<size_t>(std::max(cpuCount - 1, 1)), 1, MaxLoaderThreads);
+#endif
+}
+
+enum class SpriteJobState : uint8_t {
+	Queued,
+	Loading,
+	Loaded,
+};
+
+struct SpriteJob {
+	/** Tells a job apart from a later one for the same sprites, after the first one was dropped. */
+	uint32_t id;
+	uint16_t spriteId;
+	_monster_id type;
+	SpriteJobState state;
+	MonsterSpritesData sprites;
+};
+
+class MonsterSpriteLoader {
+public:
+	explicit MonsterSpriteLoader(size_t numThreads)
+	{
+		threads_.reserve(numThreads);
+		for (size_t i = 0; i < numThreads; ++i) {
+			threads_.emplace_back(WorkerMain, this);
+		}
+	}
+
+	~MonsterSpriteLoader()
+	{
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			quit_ = true;
+			jobs_.clear();
+		}
+		for (size_t i = 0; i < threads_.size(); ++i) {
+			jobQueued_.post();
+		}
+		for (SdlThread &thread : threads_) {
+			thread.join();
+		}
+	}
+
+	MonsterSpriteLoader(const MonsterSpriteLoader &) = delete;
+	MonsterSpriteLoader &operator=(const MonsterSpriteLoader &) = delete;
+
+	void prefetch(std::span<const _monster_id> types)
+	{
+		if (threads_.empty())
+			return;
+
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		const auto isWanted = [types](const SpriteJob &job) {
+			return std::any_of(types.begin(), types.end(), [&job](_monster_id type) { return MonstersData[type].spriteId == job.spriteId; });
+		};
+		jobs_.erase(std::remove_if(jobs_.begin(), jobs_.end(), [&isWanted](const SpriteJob &job) { return !isWanted(job); }), jobs_.end());
+
+		for (const _monster_id type : types) {
+			if (findJob(MonstersData[type].spriteId) != nullptr)
+				continue;
+			jobs_.push_back(SpriteJob { nextJobId_++, MonstersData[type].spriteId, type, SpriteJobState::Queued, {} });
+			jobQueued_.post();
+		}
+	}
+
+	MonsterSpritesData take(_monster_id type)
+	{
+		const uint16_t spriteId = MonstersData[type].spriteId;
+		std::unique_lock<SdlMutex> lock(mutex_);
+		while (true) {
+			SpriteJob *job = findJob(spriteId);
+			if (job == nullptr || job->state == SpriteJobState::Queued) {
+				// Nobody is working on these yet, so it's quicker to load them here than to wait for a worker thread.
+				if (job != nullptr)
+					eraseJob(job->id);
+				lock.unlock();
+				return LoadMonsterSpritesData(MonstersData[type]);
+			}
+			if (job->state == SpriteJobState::Loaded) {
+				MonsterSpritesData sprites = std::move(job->sprites);
+				eraseJob(job->id);
+				return sprites;
+			}
+			waitingForJob_ = job->id;
+			lock.unlock();
+			jobFinished_.wait();
+			lock.lock();
+		}
+	}
+
+	void clear()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		jobs_.clear();
+	}
+
+private:
+	static int SDLCALL WorkerMain(void *data)
+	{
+		auto &loader = *static_cast<MonsterSpriteLoader *>(data);
+		while (true) {
+			loader.jobQueued_.wait();
+			uint32_t jobId;
+			_monster_id type;
+			{
+				const std::lock_guard<SdlMutex> lock(loader.mutex_);
+				if (loader.quit_)
+					return 0;
+				const auto it = std::find_if(loader.jobs_.begin(), loader.jobs_.end(), [](const SpriteJob &job) { return job.state == SpriteJobState::Queued; });
+				if (it == loader.jobs_.end())
+					continue; // Taken or dropped in the meantime
+				it->state = SpriteJobState::Loading;
+				jobId = it->id;
+				type = it->type;
+			}
+
+			MonsterSpritesData sprites = LoadMonsterSpritesData(MonstersData[type], /*threadsafe=*/true);
+
+			const std::lock_guard<SdlMutex> lock(loader.mutex_);
+			const auto it = std::find_if(loader.jobs_.begin(), loader.jobs_.end(), [jobId](const SpriteJob &job) { return job.id == jobId; });
+			if (it == loader.jobs_.end())
+				continue; // Dropped while loading
+			it->sprites = std::move(sprites);
+			it->state = SpriteJobState::Loaded;
+			if (loader.waitingForJob_ == jobId) {
+				loader.waitingForJob_ = 0;
+				loader.jobFinished_.post();
+			}
+		}
+	}
+
+	/** @pre mutex_ is locked */
+	SpriteJob *findJob(uint16_t spriteId)
+	{
+		const auto it = std::find_if(jobs_.begin(), jobs_.end(), [spriteId](const SpriteJob &job) { return job.spriteId == spriteId; });
+		return it != jobs_.end() ? &*it : nullptr;
+	}
+
+	/** @pre mutex_ is locked */
+	void eraseJob(uint32_t jobId)
+	{
+		jobs_.erase(std::find_if(jobs_.begin(), jobs_.end(), [jobId](const SpriteJob &job) { return job.id == jobId; }));
+	}
+
+	std::vector<SdlThread> threads_;
+	SdlSemaphore jobQueued_;
+	SdlSemaphore jobFinished_;
+
+	// The fields below are guarded by `mutex_`.
+	SdlMutex mutex_;
+	std::vector<SpriteJob> jobs_;
+	uint32_t nextJobId_ = 1;
+	/** The job `take` is waiting for, 0 if none. */
+	uint32_t waitingForJob_ = 0;
+	bool quit_ = false;
+};
+
+std::unique_ptr<MonsterSpriteLoader> Loader;
+
+MonsterSpriteLoader &GetLoader()
+{
+	if (Loader == nullptr)
+		Loader = std::make_unique<MonsterSpriteLoader>(DetectLoaderThreads());
+	return *Loader;
+}
+
+} // namespace
+
+void PrefetchMonsterSprites(std::span<const _monster_id> types)
+{
+	GetLoader().prefetch(types);
+}
+
+MonsterSpritesData TakeMonsterSprites(_monster_id type)
+{
+	return GetLoader().take(type);
+}
+
+void ClearPrefetchedMonsterSprites()
+{
+	if (Loader != nullptr)
+		Loader->clear();
+}
+
+void ShutdownMonsterSpriteLoader()
+{
+	Loader = nullptr;
+}
+
+} // namespace devilution
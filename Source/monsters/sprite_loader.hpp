@@ -0,0 +1,39 @@
+/**
+ * @file monsters/sprite_loader.hpp
+ *
+ * Interface of the loading of monster sprites on worker threads.
+ */
+#pragma once
+
+#include <span>
+
+#include "monster.h"
+#include "tables/monstdat.h"
+
+namespace devilution {
+
+/**
+ * @brief Starts loading the sprites of the given monster types on the worker threads.
+ *
+ * Sprites of earlier calls that are not in `types` are dropped. Does nothing on platforms without threads.
+ */
+void PrefetchMonsterSprites(std::span<const _monster_id> types);
+
+/**
+ * @brief Hands over the sprites of a monster type, loading them right away if they weren't prefetched.
+ *
+ * Waits for a worker thread that is still busy with them.
+ */
+MonsterSpritesData TakeMonsterSprites(_monster_id type);
+
+/**
+ * @brief Drops all prefetched sprites that weren't taken.
+ */
+void ClearPrefetchedMonsterSprites();
+
+/**
+ * @brief Stops and joins the worker threads.
+ */
+void ShutdownMonsterSpriteLoader();
+
+} // namespace devilution
@@ -1,5 +1,6 @@
 #include "mpq/mpq_reader.hpp"
 
+#include <atomic>
 #include <cerrno>
 #include <cstring>
 #include <limits>
@@ -9,6 +10,7 @@
 
 #include <mpqfs/mpqfs.h>
 
+#include "mpq/mpq_sector_cache.hpp"
 #include "utils/str_cat.hpp"
 
 namespace devilution {
@@ -36,17 +38,23 @@ std::string FormatMpqfsError(mpqfs_error_code code)
 	return mpqfs_error_message(code);
 }
 
+std::atomic<uint32_t> NextArchiveId { 1 };
+
 } // namespace
 
-MpqArchive::MpqArchive(std::string path, mpqfs_archive_t *archive)
+MpqArchive::MpqArchive(std::string path, mpqfs_archive_t *archive, uint32_t id, bool isClone)
     : path_(std::move(path))
     , archive_(archive)
+    , id_(id)
+    , isClone_(isClone)
 {
 }
 
 MpqArchive::MpqArchive(MpqArchive &&other) noexcept
     : path_(std::move(other.path_))
     , archive_(other.archive_)
+    , id_(other.id_)
+    , isClone_(other.isClone_)
 {
 	other.archive_ = nullptr;
 }
@@ -54,9 +62,13 @@ MpqArchive::MpqArchive(MpqArchive &&other) noexcept
 MpqArchive &MpqArchive::operator=(MpqArchive &&other) noexcept
 {
 	if (this != &other) {
+		if (archive_ != nullptr && !isClone_)
+			GetMpqSectorCache().eraseArchive(id_);
 		mpqfs_close(archive_);
 		path_ = std::move(other.path_);
 		archive_ = other.archive_;
+		id_ = other.id_;
+		isClone_ = other.isClone_;
 		other.archive_ = nullptr;
 	}
 	return *this;
@@ -64,6 +76,8 @@ MpqArchive &MpqArchive::operator=(MpqArchive &&other) noexcept
 
 MpqArchive::~MpqArchive()
 {
+	if (archive_ != nullptr && !isClone_)
+		GetMpqSectorCache().eraseArchive(id_);
 	mpqfs_close(archive_);
 }
 
@@ -74,7 +88,7 @@ tl::expected<MpqArchive, std::string> MpqArchive::Open(const char *path)
 	if (code != MPQFS_OK) {
 		return tl::make_unexpected(FormatMpqfsError(code));
 	}
-	return MpqArchive(path, handle);
+	return MpqArchive(path, handle, NextArchiveId++, /*isClone=*/false);
 }
 
 tl::expected<MpqArchive, std::string> MpqArchive::Clone()
@@ -84,7 +98,7 @@ tl::expected<MpqArchive, std::string> MpqArchive::Clone()
 	if (code != MPQFS_OK) {
 		return tl::make_unexpected(FormatMpqfsError(code));
 	}
-	return MpqArchive(path_, clone);
+	return MpqArchive(path_, clone, id_, /*isClone=*/true);
 }
 
 bool MpqArchive::HasFile(std::string_view filename) const
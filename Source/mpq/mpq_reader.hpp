@@ -41,11 +41,16 @@ public:
 
 	mpqfs_archive_t *handle() const { return archive_; }
 
+	/** @brief Identifies the archive file in the sector cache. Clones share the ID of the original. */
+	uint32_t id() const { return id_; }
+
 private:
-	MpqArchive(std::string path, mpqfs_archive_t *archive);
+	MpqArchive(std::string path, mpqfs_archive_t *archive, uint32_t id, bool isClone);
 
 	std::string path_;
 	mpqfs_archive_t *archive_ = nullptr;
+	uint32_t id_ = 0;
+	bool isClone_ = false;
 };
 
 } // namespace devilution
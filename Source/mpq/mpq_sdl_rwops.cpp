@@ -1,5 +1,7 @@
 #include "mpq/mpq_sdl_rwops.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 
@@ -16,6 +18,8 @@
 #include "utils/sdl_compat.h"
 #endif
 
+#include "mpq/mpq_sector_cache.hpp"
+
 namespace devilution {
 
 namespace {
@@ -28,11 +32,20 @@ constexpr size_t MaxMpqPathSize = 256;
  * Wraps an mpqfs_stream_t (sector-based, on-demand decompression) and,
  * for the threadsafe variant, an independently cloned archive so that
  * reads don't race with the main thread's archive FILE*.
+ *
+ * Decompressed sectors go through the shared MpqSectorCache, so the
+ * stream itself is only read from on a cache miss.
  * ----------------------------------------------------------------------- */
 
 struct MpqStreamCtx {
 	mpqfs_stream_t *stream;      /* Sector-based stream (owned)           */
 	mpqfs_archive_t *ownedClone; /* Non-null if we cloned for threadsafe  */
+	uint32_t archiveId;
+	uint32_t hashIndex;
+	bool cached;     /* Whether reads go through the sector cache  */
+	size_t size;     /* File size, only set if cached              */
+	size_t position; /* Read position, only tracked if cached      */
+	std::byte sector[MpqSectorSize]; /* For sectors read in part   */
 };
 
 static void DestroyCtx(MpqStreamCtx *ctx)
@@ -50,16 +63,17 @@ static void DestroyCtx(MpqStreamCtx *ctx)
  * thread-safety.  Tries hash-based open first, falls back to filename.
  * ----------------------------------------------------------------------- */
 
-static MpqStreamCtx *CreateCtx(mpqfs_archive_t *archive,
+static MpqStreamCtx *CreateCtx(MpqArchive &archive,
     uint32_t hashIndex,
     const char *filename,
-    bool threadsafe)
+    bool threadsafe,
+    bool cacheSectors)
 {
-	mpqfs_archive_t *target = archive;
+	mpqfs_archive_t *target = archive.handle();
 	mpqfs_archive_t *clone = nullptr;
 
 	if (threadsafe) {
-		if (mpqfs_clone(archive, &clone) != MPQFS_OK)
+		if (mpqfs_clone(archive.handle(), &clone) != MPQFS_OK)
 			return nullptr;
 		target = clone;
 	}
@@ -81,7 +95,7 @@ static MpqStreamCtx *CreateCtx(mpqfs_archive_t *archive,
 		return nullptr;
 	}
 
-	auto *ctx = new (std::nothrow) MpqStreamCtx { stream, clone };
+	auto *ctx = new (std::nothrow) MpqStreamCtx { stream, clone, archive.id(), hashIndex };
 	if (ctx == nullptr) {
 		mpqfs_stream_close(stream);
 		if (clone != nullptr)
@@ -89,9 +103,89 @@ static MpqStreamCtx *CreateCtx(mpqfs_archive_t *archive,
 		return nullptr;
 	}
 
+	/* Sectors are identified by the hash index, so files opened by name
+	 * bypass the cache. */
+	ctx->cached = cacheSectors
+	    && hashIndex != UINT32_MAX
+	    && GetMpqSectorCache().budget() > 0
+	    && mpqfs_stream_size(stream, &ctx->size) == MPQFS_OK;
+
 	return ctx;
 }
 
+/* -----------------------------------------------------------------------
+ * Helpers shared by both SDL implementations that go through the sector
+ * cache when the stream is cached and straight to mpqfs otherwise.
+ * ----------------------------------------------------------------------- */
+
+static mpqfs_error_code ReadSector(MpqStreamCtx *ctx, size_t start, std::byte *out, size_t length)
+{
+	int64_t pos = 0;
+	mpqfs_error_code code = mpqfs_stream_seek(ctx->stream, static_cast<int64_t>(start), SEEK_SET, &pos);
+	while (code == MPQFS_OK && length > 0) {
+		size_t n = 0;
+		code = mpqfs_stream_read(ctx->stream, out, length, &n);
+		if (n == 0)
+			break;
+		out += n;
+		length -= n;
+	}
+	if (code == MPQFS_OK && length > 0)
+		return MPQFS_ERR_IO;
+	return code;
+}
+
+static mpqfs_error_code StreamRead(MpqStreamCtx *ctx, void *ptr, size_t size, size_t *bytesRead)
+{
+	if (!ctx->cached)
+		return mpqfs_stream_read(ctx->stream, ptr, size, bytesRead);
+
+	MpqSectorCache &cache = GetMpqSectorCache();
+	auto *out = static_cast<std::byte *>(ptr);
+	size = std::min(size, ctx->size - std::min(ctx->position, ctx->size));
+	*bytesRead = 0;
+	while (*bytesRead < size) {
+		const size_t sector = ctx->position / MpqSectorSize;
+		const size_t sectorStart = sector * MpqSectorSize;
+		const size_t sectorLength = std::min(MpqSectorSize, ctx->size - sectorStart);
+		const size_t offset = ctx->position - sectorStart;
+		const size_t count = std::min(sectorLength - offset, size - *bytesRead);
+
+		/* Whole sectors are read straight into the destination. */
+		std::byte *dest = count == sectorLength ? out + *bytesRead : ctx->sector;
+		const MpqSectorKey key { ctx->archiveId, ctx->hashIndex, static_cast<uint32_t>(sector) };
+		if (!cache.read(key, { dest, sectorLength })) {
+			const mpqfs_error_code code = ReadSector(ctx, sectorStart, dest, sectorLength);
+			if (code != MPQFS_OK)
+				return code;
+			cache.insert(key, { dest, sectorLength });
+		}
+		if (dest == ctx->sector)
+			std::memcpy(out + *bytesRead, dest + offset, count);
+
+		*bytesRead += count;
+		ctx->position += count;
+	}
+	return MPQFS_OK;
+}
+
+static mpqfs_error_code StreamSeek(MpqStreamCtx *ctx, int64_t offset, int whence, int64_t *pos)
+{
+	if (!ctx->cached)
+		return mpqfs_stream_seek(ctx->stream, offset, whence, pos);
+
+	/* The underlying stream is only positioned on cache misses, so
+	 * relative seeks are resolved against our own position. */
+	if (whence == SEEK_CUR) {
+		offset += static_cast<int64_t>(ctx->position);
+		whence = SEEK_SET;
+	}
+	const mpqfs_error_code code = mpqfs_stream_seek(ctx->stream, offset, whence, pos);
+	if (code == MPQFS_OK)
+		ctx->position = static_cast<size_t>(*pos);
+	return code;
+}
+
 /* =======================================================================
  * SDL3 implementation
  * ======================================================================= */
@@ -123,7 +217,7 @@ static Sint64 SDLCALL MpqStream_Seek(void *userdata, Sint64 offset, SDL_IOWhence
 		return -1;
 	}
 	int64_t pos = 0;
-	const mpqfs_error_code code = mpqfs_stream_seek(ctx->stream, offset, w, &pos);
+	const mpqfs_error_code code = StreamSeek(ctx, offset, w, &pos);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return -1;
@@ -135,7 +229,7 @@ static size_t SDLCALL MpqStream_Read(void *userdata, void *ptr, size_t size, SDL
 {
 	auto *ctx = static_cast<MpqStreamCtx *>(userdata);
 	size_t n = 0;
-	const mpqfs_error_code code = mpqfs_stream_read(ctx->stream, ptr, size, &n);
+	const mpqfs_error_code code = StreamRead(ctx, ptr, size, &n);
 	if (code != MPQFS_OK) {
 		if (status != nullptr)
 			*status = SDL_IO_STATUS_ERROR;
@@ -215,7 +309,7 @@ static OffsetType SDLCALL MpqStream_Seek(SDL_RWops *rw, OffsetType offset, int w
 	}
 
 	int64_t pos = 0;
-	const mpqfs_error_code code = mpqfs_stream_seek(ctx->stream, offset, w, &pos);
+	const mpqfs_error_code code = StreamSeek(ctx, offset, w, &pos);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return -1;
@@ -231,7 +325,7 @@ static SizeType SDLCALL MpqStream_Read(SDL_RWops *rw, void *ptr,
 
 	size_t totalBytes = static_cast<size_t>(size) * static_cast<size_t>(maxnum);
 	size_t n = 0;
-	const mpqfs_error_code code = mpqfs_stream_read(ctx->stream, ptr, totalBytes, &n);
+	const mpqfs_error_code code = StreamRead(ctx, ptr, totalBytes, &n);
 	if (code != MPQFS_OK) {
 		SDL_SetError("%s", mpqfs_error_message(code));
 		return 0;
@@ -265,7 +359,8 @@ static int SDLCALL MpqStream_Close(SDL_RWops *rw)
 SdlRwopsType *SDL_RWops_FromMpqFile(MpqArchive &archive,
     uint32_t hashIndex,
     std::string_view filename,
-    bool threadsafe)
+    bool threadsafe,
+    bool cacheSectors)
 {
 	/* NUL-terminate the filename for the C API. */
 	char pathBuf[MaxMpqPathSize];
@@ -274,7 +369,7 @@ SdlRwopsType *SDL_RWops_FromMpqFile(MpqArchive &archive,
 	std::memcpy(pathBuf, filename.data(), filename.size());
 	pathBuf[filename.size()] = '\0';
 
-	MpqStreamCtx *ctx = CreateCtx(archive.handle(), hashIndex, pathBuf, threadsafe);
+	MpqStreamCtx *ctx = CreateCtx(archive, hashIndex, pathBuf, threadsafe, cacheSectors);
 	if (ctx == nullptr)
 		return nullptr;
 
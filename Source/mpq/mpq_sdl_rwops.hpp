@@ -15,9 +15,14 @@ using SdlRwopsType = SDL_RWops;
 
 namespace devilution {
 
+/**
+ * @param cacheSectors Whether reads go through the MpqSectorCache. Assets that are streamed should bypass it, as they
+ *                     are read once from start to end and their sectors would only push out sectors that get reused.
+ */
 SdlRwopsType *SDL_RWops_FromMpqFile(MpqArchive &archive,
     uint32_t hashIndex,
     std::string_view filename,
-    bool threadsafe);
+    bool threadsafe,
+    bool cacheSectors = true);
 
 } // namespace devilution
@@ -0,0 +1,251 @@
+/**
+ * @file mpq/mpq_sector_cache.cpp
+ *
+ * Implementation of the cache of decompressed MPQ file data.
+ */
+#include "mpq/mpq_sector_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#ifndef MPQ_SECTOR_CACHE_SIZE
+#define MPQ_SECTOR_CACHE_SIZE (16 * 1024 * 1024)
+#endif
+
+namespace devilution {
+
+namespace {
+
+size_t HashSectorKey(const MpqSectorKey &key)
+{
+	uint64_t hash = (static_cast<uint64_t>(key.archiveId) << 32) | key.hashIndex;
+	hash ^= (key.sector + 0x9E3779B97F4A7C15ULL) + (hash << 6) + (hash >> 2);
+	return static_cast<size_t>(hash * 0xFF51AFD7ED558CCDULL);
+}
+
+} // namespace
+
+MpqSectorCache::MpqSectorCache(size_t budget)
+{
+	allocateSlots(budget);
+}
+
+size_t MpqSectorCache::budget() const
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	return budget_;
+}
+
+void MpqSectorCache::setBudget(size_t budget)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	allocateSlots(budget);
+}
+
+bool MpqSectorCache::read(const MpqSectorKey &key, std::span<std::byte> out)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	const size_t bucket = findBucket(key);
+	if (bucket == NoSlot || slots_[buckets_[bucket]].size != out.size()) {
+		misses_++;
+		return false;
+	}
+	hits_++;
+	const uint32_t slot = buckets_[bucket];
+	unlink(slot);
+	linkFront(slot);
+	std::memcpy(out.data(), slotData(slot), out.size());
+	return true;
+}
+
+void MpqSectorCache::insert(const MpqSectorKey &key, std::span<const std::byte> data)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	if (slots_.empty() || data.size() > MpqSectorSize || findBucket(key) != NoSlot)
+		return;
+
+	const uint32_t slot = claimSlot();
+	slots_[slot].key = key;
+	slots_[slot].size = static_cast<uint32_t>(data.size());
+	std::memcpy(slotData(slot), data.data(), data.size());
+	linkFront(slot);
+	addToIndex(slot);
+	size_ += data.size();
+}
+
+void MpqSectorCache::eraseArchive(uint32_t archiveId)
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	for (uint32_t slot = head_; slot != NoSlot;) {
+		const uint32_t next = slots_[slot].next;
+		if (slots_[slot].key.archiveId == archiveId)
+			freeSlot(slot);
+		slot = next;
+	}
+}
+
+void MpqSectorCache::clear()
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	while (head_ != NoSlot)
+		freeSlot(head_);
+}
+
+MpqSectorCacheStats MpqSectorCache::stats() const
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	return { hits_, misses_, evictions_, size_ };
+}
+
+void MpqSectorCache::resetStats()
+{
+	const std::lock_guard<SdlMutex> lock(mutex_);
+	hits_ = 0;
+	misses_ = 0;
+	evictions_ = 0;
+}
+
+void MpqSectorCache::allocateSlots(size_t budget)
+{
+	const std::vector<Slot> oldSlots = std::move(slots_);
+	const std::unique_ptr<std::byte[]> oldData = std::move(data_);
+	const uint32_t oldHead = head_;
+
+	budget_ = budget;
+	size_ = 0;
+	head_ = NoSlot;
+	tail_ = NoSlot;
+	free_ = NoSlot;
+	const size_t numSlots = std::min<size_t>(budget / MpqSectorSize, NoSlot);
+	slots_.assign(numSlots, Slot {});
+	data_ = numSlots == 0 ? nullptr : std::unique_ptr<std::byte[]> { new std::byte[numSlots * MpqSectorSize] };
+	for (size_t slot = numSlots; slot-- > 0;) {
+		slots_[slot].next = free_;
+		free_ = static_cast<uint32_t>(slot);
+	}
+	size_t numBuckets = numSlots == 0 ? 0 : 1;
+	while (numBuckets < 2 * numSlots)
+		numBuckets *= 2;
+	buckets_.assign(numBuckets, NoSlot);
+
+	for (uint32_t oldSlot = oldHead; oldSlot != NoSlot; oldSlot = oldSlots[oldSlot].next) {
+		if (free_ == NoSlot) {
+			evictions_++;
+			continue;
+		}
+		const uint32_t slot = free_;
+		free_ = slots_[slot].next;
+		slots_[slot].key = oldSlots[oldSlot].key;
+		slots_[slot].size = oldSlots[oldSlot].size;
+		std::memcpy(slotData(slot), &oldData[oldSlot * MpqSectorSize], slots_[slot].size);
+		linkBack(slot);
+		addToIndex(slot);
+		size_ += slots_[slot].size;
+	}
+}
+
+std::byte *MpqSectorCache::slotData(uint32_t slot) const
+{
+	return &data_[slot * MpqSectorSize];
+}
+
+size_t MpqSectorCache::findBucket(const MpqSectorKey &key) const
+{
+	if (buckets_.empty())
+		return NoSlot;
+	const size_t mask = buckets_.size() - 1;
+	for (size_t bucket = HashSectorKey(key) & mask; buckets_[bucket] != NoSlot; bucket = (bucket + 1) & mask) {
+		if (slots_[buckets_[bucket]].key == key)
+			return bucket;
+	}
+	return NoSlot;
+}
+
+void MpqSectorCache::addToIndex(uint32_t slot)
+{
+	const size_t mask = buckets_.size() - 1;
+	size_t bucket = HashSectorKey(slots_[slot].key) & mask;
+	while (buckets_[bucket] != NoSlot)
+		bucket = (bucket + 1) & mask;
+	buckets_[bucket] = slot;
+}
+
+void MpqSectorCache::removeFromIndex(size_t bucket)
+{
+	// Move later slots of the same probe sequence back into the gap, so that lookups don't stop early.
+	const size_t mask = buckets_.size() - 1;
+	size_t gap = bucket;
+	for (size_t next = (gap + 1) & mask; buckets_[next] != NoSlot; next = (next + 1) & mask) {
+		const size_t home = HashSectorKey(slots_[buckets_[next]].key) & mask;
+		if (((next - home) & mask) >= ((next - gap) & mask)) {
+			buckets_[gap] = buckets_[next];
+			gap = next;
+		}
+	}
+	buckets_[gap] = NoSlot;
+}
+
+void MpqSectorCache::linkFront(uint32_t slot)
+{
+	slots_[slot].prev = NoSlot;
+	slots_[slot].next = head_;
+	if (head_ != NoSlot)
+		slots_[head_].prev = slot;
+	else
+		tail_ = slot;
+	head_ = slot;
+}
+
+void MpqSectorCache::linkBack(uint32_t slot)
+{
+	slots_[slot].prev = tail_;
+	slots_[slot].next = NoSlot;
+	if (tail_ != NoSlot)
+		slots_[tail_].next = slot;
+	else
+		head_ = slot;
+	tail_ = slot;
+}
+
+void MpqSectorCache::unlink(uint32_t slot)
+{
+	const Slot &entry = slots_[slot];
+	if (entry.prev != NoSlot)
+		slots_[entry.prev].next = entry.next;
+	else
+		head_ = entry.next;
+	if (entry.next != NoSlot)
+		slots_[entry.next].prev = entry.prev;
+	else
+		tail_ = entry.prev;
+}
+
+uint32_t MpqSectorCache::claimSlot()
+{
+	if (free_ == NoSlot) {
+		freeSlot(tail_);
+		evictions_++;
+	}
+	const uint32_t slot = free_;
+	free_ = slots_[slot].next;
+	return slot;
+}
+
+void MpqSectorCache::freeSlot(uint32_t slot)
+{
+	size_ -= slots_[slot].size;
+	removeFromIndex(findBucket(slots_[slot].key));
+	unlink(slot);
+	slots_[slot].next = free_;
+	free_ = slot;
+}
+
+MpqSectorCache &GetMpqSectorCache()
+{
+	// Never destroyed, as archives held by other globals drop their sectors when they are destroyed.
+	static MpqSectorCache *cache = new MpqSectorCache { MPQ_SECTOR_CACHE_SIZE };
+	return *cache;
+}
+
+} // namespace devilution
@@ -0,0 +1,132 @@
+/**
+ * @file mpq/mpq_sector_cache.hpp
+ *
+ * Cache of decompressed MPQ file data, shared by everything that reads from the archives.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+/** Files are cached in blocks of this size, which is the sector size of the game's archives. */
+constexpr size_t MpqSectorSize = 4096;
+
+struct MpqSectorKey {
+	uint32_t archiveId;
+	uint32_t hashIndex;
+	uint32_t sector;
+
+	bool operator==(const MpqSectorKey &other) const = default;
+};
+
+struct MpqSectorCacheStats {
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+	/** Bytes of decompressed data currently held */
+	size_t size;
+};
+
+/**
+ * @brief Least recently used decompressed sectors, up to a budget in bytes.
+ *
+ * The budget is split into slots of MpqSectorSize that are allocated up front, so that a miss doesn't allocate.
+ * A shorter last sector of a file takes up a whole slot too.
+ *
+ * Thread-safe, as assets are also streamed from the audio threads.
+ */
+class MpqSectorCache {
+public:
+	explicit MpqSectorCache(size_t budget);
+
+	MpqSectorCache(const MpqSectorCache &) = delete;
+	MpqSectorCache &operator=(const MpqSectorCache &) = delete;
+
+	[[nodiscard]] size_t budget() const;
+
+	/**
+	 * @brief Changes the budget, evicting the least recently used sectors right away if they don't fit anymore.
+	 * 0 disables the cache.
+	 */
+	void setBudget(size_t budget);
+
+	/**
+	 * @brief Copies a cached sector to `out`, which must have the size of the sector.
+	 *
+	 * @return false if the sector is not cached.
+	 */
+	bool read(const MpqSectorKey &key, std::span<std::byte> out);
+
+	void insert(const MpqSectorKey &key, std::span<const std::byte> data);
+
+	/** @brief Drops all sectors of an archive that is being closed. */
+	void eraseArchive(uint32_t archiveId);
+
+	void clear();
+
+	[[nodiscard]] MpqSectorCacheStats stats() const;
+	void resetStats();
+
+private:
+	/** Marks the end of a list of slots and an empty bucket. */
+	static constexpr uint32_t NoSlot = UINT32_MAX;
+
+	/** Holds a sector and is in the recently used list, or is in the list of free slots. */
+	struct Slot {
+		MpqSectorKey key;
+		uint32_t size;
+		/** The more recently used slot */
+		uint32_t prev;
+		/** The less recently used slot, or the next free slot */
+		uint32_t next;
+	};
+
+	// The functions below expect mutex_ to be locked.
+
+	/** @brief Reallocates the slots for the budget, keeping the most recently used sectors that fit. */
+	void allocateSlots(size_t budget);
+	[[nodiscard]] std::byte *slotData(uint32_t slot) const;
+	/** @return The bucket that holds the slot of the sector, or NoSlot if it is not cached. */
+	[[nodiscard]] size_t findBucket(const MpqSectorKey &key) const;
+	void addToIndex(uint32_t slot);
+	void removeFromIndex(size_t bucket);
+	void linkFront(uint32_t slot);
+	void linkBack(uint32_t slot);
+	void unlink(uint32_t slot);
+	/** @brief Takes a slot from the free list, evicting the least recently used sector if there are none. */
+	uint32_t claimSlot();
+	void freeSlot(uint32_t slot);
+
+	mutable SdlMutex mutex_;
+	size_t budget_ = 0;
+	size_t size_ = 0;
+	uint64_t hits_ = 0;
+	uint64_t misses_ = 0;
+	uint64_t evictions_ = 0;
+	std::vector<Slot> slots_;
+	/** MpqSectorSize bytes for each slot */
+	std::unique_ptr<std::byte[]> data_;
+	/** The most recently used slot */
+	uint32_t head_ = NoSlot;
+	/** The least recently used slot */
+	uint32_t tail_ = NoSlot;
+	uint32_t free_ = NoSlot;
+	/** Slots by the hash of their key, with linear probing. Twice as many as there are slots, and a power of 2. */
+	std::vector<uint32_t> buckets_;
+};
+
+/**
+ * @brief The cache shared by all MPQ archives.
+ *
+ * The default budget is set by MPQ_SECTOR_CACHE_SIZE.
+ */
+MpqSectorCache &GetMpqSectorCache();
+
+} // namespace devilution
@@ -31,6 +31,7 @@ std::string FormatMpqfsError(mpqfs_error_code code)
 
 MpqWriter::MpqWriter(const char *path, bool carryForward)
     : path_(path)
+    , tmpPath_(StrCat(path, ".tmp"))
 {
 	const std::string dir = std::string(Dirname(path));
 	if (!dir.empty()) {
@@ -38,28 +39,23 @@ MpqWriter::MpqWriter(const char *path, bool carryForward)
 	}
 	LogVerbose("Opening {}", path);
 
-	// If the file already exists and we need to preserve its contents,
-	// rename it to a temp path so we can read from it after the writer
-	// truncates the original path.
-	std::string tmpPath;
+	// The new archive is written to a temp path and only replaces the
+	// existing one once it has been closed, so that a crash or a full
+	// disk while saving leaves the previous archive intact.
+	::devilution::RemoveFile(tmpPath_.c_str());
+
 	mpqfs_archive_t *oldArchive = nullptr;
 	if (carryForward && FileExists(path)) {
-		tmpPath = std::string(path) + ".tmp";
-		// Remove any stale temp file, then rename old → tmp.
-		::devilution::RemoveFile(tmpPath.c_str());
-		::devilution::RenameFile(path, tmpPath.c_str());
 		// If it fails to open (e.g. corrupt), we proceed without
 		// carry-forward — the file will be recreated from scratch.
-		(void)mpqfs_open(tmpPath.c_str(), &oldArchive);
+		(void)mpqfs_open(path, &oldArchive);
 	}
 
-	const mpqfs_error_code code = mpqfs_writer_create(path, MpqWriterHashTableSize, &writer_);
+	const mpqfs_error_code code = mpqfs_writer_create(tmpPath_.c_str(), MpqWriterHashTableSize, &writer_);
 	if (code != MPQFS_OK) {
 		LogError("Failed to write MPQ archive to {}: {}", path, FormatMpqfsError(code));
 		if (oldArchive != nullptr)
 			mpqfs_close(oldArchive);
-		if (!tmpPath.empty())
-			::devilution::RemoveFile(tmpPath.c_str());
 		return;
 	}
 
@@ -70,13 +66,11 @@ MpqWriter::MpqWriter(const char *path, bool carryForward)
 		}
 		mpqfs_close(oldArchive);
 	}
-
-	if (!tmpPath.empty())
-		::devilution::RemoveFile(tmpPath.c_str());
 }
 
 MpqWriter::MpqWriter(MpqWriter &&other) noexcept
     : path_(std::move(other.path_))
+    , tmpPath_(std::move(other.tmpPath_))
     , writer_(other.writer_)
 {
 	other.writer_ = nullptr;
@@ -85,9 +79,12 @@ MpqWriter::MpqWriter(MpqWriter &&other) noexcept
 MpqWriter &MpqWriter::operator=(MpqWriter &&other) noexcept
 {
 	if (this != &other) {
-		if (writer_ != nullptr)
+		if (writer_ != nullptr) {
 			mpqfs_writer_discard(writer_);
+			::devilution::RemoveFile(tmpPath_.c_str());
+		}
 		path_ = std::move(other.path_);
+		tmpPath_ = std::move(other.tmpPath_);
 		writer_ = other.writer_;
 		other.writer_ = nullptr;
 	}
@@ -104,7 +101,10 @@ MpqWriter::~MpqWriter()
 	const mpqfs_error_code code = mpqfs_writer_close(writer_);
 	if (code != MPQFS_OK) {
 		LogError("Failed to close MPQ archive {}: {}", path_, FormatMpqfsError(code));
+		::devilution::RemoveFile(tmpPath_.c_str());
+		return;
 	}
+	::devilution::RenameFile(tmpPath_.c_str(), path_.c_str());
 }
 
 bool MpqWriter::HasFile(std::string_view name) const
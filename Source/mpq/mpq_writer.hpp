@@ -40,6 +40,8 @@ public:
 
 private:
 	std::string path_;
+	/** The archive is written here and renamed to `path_` once complete. */
+	std::string tmpPath_;
 	mpqfs_writer_t *writer_ = nullptr;
 };
 
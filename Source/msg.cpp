@@ -5,9 +5,12 @@
  */
 #include "msg.h"
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <list>
 #include <memory>
 
@@ -60,6 +63,7 @@
 #include "utils/endian_swap.hpp"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
+#include "utils/lz_codec.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
 #include "utils/utf8.hpp"
@@ -275,6 +279,21 @@ struct DJunk {
 constexpr size_t MaxMultiplayerLevels = NUMLEVELS + SL_LAST;
 constexpr size_t MaxChunks = MaxMultiplayerLevels + 4;
 
+/**
+ * @brief Format of the level deltas sent to joining players.
+ *
+ * Version 1 only lists the item and monster slots that changed since dungeon generation, as index/value pairs.
+ */
+constexpr uint8_t DeltaLevelVersion = 1;
+
+/** Marker byte in front of a delta message, telling how the rest of it is compressed */
+enum class DeltaCodec : uint8_t {
+	None,
+	Pkware,
+	/** Only sent in games hosted with GameCodecLz */
+	Lz,
+};
+
 uint32_t sgdwOwnerWait;
 uint32_t sgdwRecvOffset;
 int sgnCurrMegaPlayer;
@@ -286,10 +305,13 @@ uint8_t sbLastCmd;
  */
 std::byte sgRecvBuf[1U                                               /* marker byte, always 0 */
     + sizeof(uint8_t)                                                /* level id */
-    + sizeof(DLevel::item)                                           /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
+    + sizeof(uint8_t)                                                /* format version */
+    + sizeof(uint8_t)                                                /* count of changed item slots */
+    + ((sizeof(uint8_t) + sizeof(TCmdPItem)) * MAXITEMS)             /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
     + sizeof(uint8_t)                                                /* count of object interactions which caused a state change since dungeon generation */
     + ((sizeof(WorldTilePosition) + sizeof(_cmd_id)) * MAXOBJECTS)   /* location/action pairs for the object interactions */
-    + sizeof(DLevel::monster)                                        /* latest monster state */
+    + sizeof(uint8_t)                                                /* count of changed monster slots */
+    + ((sizeof(uint8_t) + sizeof(DMonsterStr)) * MaxMonsters)        /* latest monster state */
     + sizeof(uint16_t)                                               /* spawned monster count */
     + ((sizeof(uint16_t) + sizeof(DSpawnedMonster)) * MaxMonsters)]; /* spawned monsters */
 
@@ -537,40 +559,90 @@ int WaitForTurns()
 	return 100 * sgbDeltaChunks / static_cast<int>(MaxChunks);
 }
 
-std::byte *DeltaExportItem(std::byte *dst, const TCmdPItem *src)
+bool IsItemDeltaChanged(const TCmdPItem &item)
 {
-	for (int i = 0; i < MAXITEMS; i++, src++) {
-		if (src->bCmd == CMD_INVALID) {
-			*dst++ = std::byte { 0xFF };
-		} else {
-			memcpy(dst, src, sizeof(TCmdPItem));
-			dst += sizeof(TCmdPItem);
-		}
+	return item.bCmd != CMD_INVALID;
+}
+
+bool IsMonsterDeltaChanged(const DMonsterStr &monster)
+{
+	return monster.position.x != 0xFF;
+}
+
+/**
+ * @brief Checks whether anything on the level changed since dungeon generation, otherwise there is no need to send it.
+ */
+bool IsDeltaLevelChanged(const DLevel &deltaLevel)
+{
+	return !deltaLevel.object.empty()
+	    || !deltaLevel.spawnedMonsters.empty()
+	    || std::any_of(std::begin(deltaLevel.item), std::end(deltaLevel.item), IsItemDeltaChanged)
+	    || std::any_of(std::begin(deltaLevel.monster), std::end(deltaLevel.monster), IsMonsterDeltaChanged);
+}
+
+/**
+ * @brief Writes the slots that changed since dungeon generation as a count followed by index/value pairs.
+ */
+template <typename T, size_t N, typename IsChanged>
+std::byte *DeltaExportSlots(std::byte *dst, const T (&src)[N], IsChanged &&isChanged)
+{
+	static_assert(N <= 0xFF, "slot indices and counts are sent as a single byte");
+	std::byte *count = dst++;
+	*count = std::byte { 0 };
+	for (size_t i = 0; i < N; i++) {
+		if (!isChanged(src[i]))
+			continue;
+		*dst++ = static_cast<std::byte>(i);
+		memcpy(dst, &src[i], sizeof(T));
+		dst += sizeof(T);
+		*count = static_cast<std::byte>(static_cast<uint8_t>(*count) + 1);
 	}
 
 	return dst;
 }
 
-const std::byte *DeltaImportItem(const std::byte *src, const std::byte *end, TCmdPItem *dst)
+/**
+ * @brief Reads slots written by DeltaExportSlots, the slots that aren't listed are reset to their unchanged state.
+ */
+template <typename T, size_t N>
+const std::byte *DeltaImportSlots(const std::byte *src, const std::byte *end, T (&dst)[N])
 {
-	size_t size = 0;
-	for (int i = 0; i < MAXITEMS; i++, dst++) {
-		if (&src[size] >= end)
+	if (src == nullptr || src >= end)
+		return nullptr;
+
+	const auto count = static_cast<uint8_t>(*src++);
+	if (count > N || src + ((sizeof(uint8_t) + sizeof(T)) * count) > end)
+		return nullptr;
+
+	memset(&dst, 0xFF, sizeof(dst));
+	for (unsigned i = 0; i < count; i++) {
+		const auto index = static_cast<uint8_t>(*src++);
+		if (index >= N)
 			return nullptr;
-		if (src[size] == std::byte { 0xFF }) {
-			memset(dst, 0xFF, sizeof(TCmdPItem));
-			size++;
-		} else {
-			if (&src[size] + sizeof(TCmdPItem) > end)
-				return nullptr;
-			memcpy(dst, &src[size], sizeof(TCmdPItem));
-			if (!IsItemDeltaValid(*dst))
-				memset(dst, 0xFF, sizeof(TCmdPItem));
-			size += sizeof(TCmdPItem);
-		}
+		memcpy(&dst[index], src, sizeof(T));
+		src += sizeof(T);
+	}
+
+	return src;
+}
+
+std::byte *DeltaExportItem(std::byte *dst, const TCmdPItem (&src)[MAXITEMS])
+{
+	return DeltaExportSlots(dst, src, IsItemDeltaChanged);
+}
+
+const std::byte *DeltaImportItem(const std::byte *src, const std::byte *end, TCmdPItem (&dst)[MAXITEMS])
+{
+	src = DeltaImportSlots(src, end, dst);
+	if (src == nullptr)
+		return nullptr;
+
+	for (TCmdPItem &item : dst) {
+		if (IsItemDeltaChanged(item) && !IsItemDeltaValid(item))
+			memset(&item, 0xFF, sizeof(TCmdPItem));
 	}
 
-	return src + size;
+	return src;
 }
 
 std::byte *DeltaExportObject(std::byte *dst, const ankerl::unordered_dense::map<WorldTilePosition, DObjectStr> &src)
@@ -611,41 +683,14 @@ const std::byte *DeltaImportObjects(const std::byte *src, const std::byte *end,
 	return src;
 }
 
-std::byte *DeltaExportMonster(std::byte *dst, const DMonsterStr *src)
+std::byte *DeltaExportMonster(std::byte *dst, const DMonsterStr (&src)[MaxMonsters])
 {
-	for (size_t i = 0; i < MaxMonsters; i++, src++) {
-		if (src->position.x == 0xFF) {
-			*dst++ = std::byte { 0xFF };
-		} else {
-			memcpy(dst, src, sizeof(DMonsterStr));
-			dst += sizeof(DMonsterStr);
-		}
-	}
-
-	return dst;
+	return DeltaExportSlots(dst, src, IsMonsterDeltaChanged);
 }
 
-const std::byte *DeltaImportMonster(const std::byte *src, const std::byte *end, DMonsterStr *dst)
+const std::byte *DeltaImportMonster(const std::byte *src, const std::byte *end, DMonsterStr (&dst)[MaxMonsters])
 {
-	if (src == nullptr)
-		return nullptr;
-
-	size_t size = 0;
-	for (size_t i = 0; i < MaxMonsters; i++, dst++) {
-		if (&src[size] >= end)
-			return nullptr;
-		if (src[size] == std::byte { 0xFF }) {
-			memset(dst, 0xFF, sizeof(DMonsterStr));
-			size++;
-		} else {
-			if (&src[size] + sizeof(DMonsterStr) > end)
-				return nullptr;
-			memcpy(dst, &src[size], sizeof(DMonsterStr));
-			size += sizeof(DMonsterStr);
-		}
-	}
-
-	return src + size;
+	return DeltaImportSlots(src, end, dst);
 }
 
 std::byte *DeltaExportSpawnedMonsters(std::byte *dst, const ankerl::unordered_dense::map<size_t, DSpawnedMonster> &spawnedMonsters)
@@ -763,18 +808,54 @@ const std::byte *DeltaImportJunk(const std::byte *src, const std::byte *end)
 	return src;
 }
 
+/**
+ * @brief Writes the delta of a level, starting with the level id and format version.
+ */
+std::byte *DeltaExportLevel(std::byte *dst, uint8_t levelNum, const DLevel &deltaLevel)
+{
+	*dst++ = static_cast<std::byte>(levelNum);
+	*dst++ = static_cast<std::byte>(DeltaLevelVersion);
+	dst = DeltaExportItem(dst, deltaLevel.item);
+	dst = DeltaExportObject(dst, deltaLevel.object);
+	dst = DeltaExportMonster(dst, deltaLevel.monster);
+	return DeltaExportSpawnedMonsters(dst, deltaLevel.spawnedMonsters);
+}
+
+/**
+ * @brief Reads a level delta written by DeltaExportLevel, returns nullptr if it is truncated, invalid or in an unknown format.
+ */
+const std::byte *DeltaImportLevel(const std::byte *src, const std::byte *end)
+{
+	if (end - src < static_cast<std::ptrdiff_t>(2 * sizeof(uint8_t)) || static_cast<uint8_t>(src[1]) != DeltaLevelVersion)
+		return nullptr;
+
+	const auto levelNum = static_cast<uint8_t>(src[0]);
+	src += 2 * sizeof(uint8_t);
+	DLevel &deltaLevel = GetDeltaLevel(levelNum);
+	src = DeltaImportItem(src, end, deltaLevel.item);
+	src = DeltaImportObjects(src, end, deltaLevel.object);
+	src = DeltaImportMonster(src, end, deltaLevel.monster);
+	return DeltaImportSpawnedMonsters(src, end, deltaLevel.spawnedMonsters);
+}
+
 uint32_t CompressData(std::byte *buffer, std::byte *end)
 {
-#ifdef USE_PKWARE
 	const auto size = static_cast<uint32_t>(end - buffer - 1);
+	if ((sgGameInitInfo.codecs & GameCodecLz) != 0) {
+		const uint32_t lzSize = LzCompress(buffer + 1, size);
+		*buffer = static_cast<std::byte>(size != lzSize ? DeltaCodec::Lz : DeltaCodec::None);
+		return lzSize + 1;
+	}
+
+#ifdef USE_PKWARE
 	const uint32_t pkSize = PkwareCompress(buffer + 1, size);
 
-	*buffer = size != pkSize ? std::byte { 1 } : std::byte { 0 };
+	*buffer = static_cast<std::byte>(size != pkSize ? DeltaCodec::Pkware : DeltaCodec::None);
 
 	return pkSize + 1;
 #else
-	*buffer = std::byte { 0 };
-	return end - buffer;
+	*buffer = static_cast<std::byte>(DeltaCodec::None);
+	return size + 1;
 #endif
 }
 
@@ -782,29 +863,35 @@ void DeltaImportData(_cmd_id cmd, uint32_t recvOffset, int pnum)
 {
 	size_t deltaSize = recvOffset;
 
+	const auto codec = static_cast<DeltaCodec>(sgRecvBuf[0]);
+	if (codec != DeltaCodec::None) {
+		switch (codec) {
 #ifdef USE_PKWARE
-	if (sgRecvBuf[0] != std::byte { 0 }) {
-		deltaSize = PkwareDecompress(&sgRecvBuf[1], static_cast<uint32_t>(deltaSize), sizeof(sgRecvBuf) - 1);
+		case DeltaCodec::Pkware:
+			deltaSize = PkwareDecompress(&sgRecvBuf[1], static_cast<uint32_t>(deltaSize), sizeof(sgRecvBuf) - 1);
+			break;
+#endif
+		case DeltaCodec::Lz:
+			// Unlike PKWARE streams, LZ blocks have no end marker, so the marker byte must not be counted.
+			deltaSize = recvOffset > 0 ? LzDecompress(&sgRecvBuf[1], recvOffset - 1, sizeof(sgRecvBuf) - 1) : 0;
+			break;
+		default:
+			deltaSize = 0;
+			break;
+		}
 		if (deltaSize == 0) {
-			Log("PKWare decompression failure, dropping player {}", pnum);
+			Log("Delta decompression failure, dropping player {}", pnum);
 			SNetDropPlayer(pnum, leaveinfo_t::LEAVE_DROP);
 			return;
 		}
 	}
-#endif
 
 	const std::byte *src = &sgRecvBuf[1];
 	const std::byte *end = src + deltaSize;
 	if (cmd == CMD_DLEVEL_JUNK) {
 		src = DeltaImportJunk(src, end);
 	} else if (cmd == CMD_DLEVEL) {
-		auto i = static_cast<uint8_t>(src[0]);
-		src += sizeof(uint8_t);
-		DLevel &deltaLevel = GetDeltaLevel(i);
-		src = DeltaImportItem(src, end, deltaLevel.item);
-		src = DeltaImportObjects(src, end, deltaLevel.object);
-		src = DeltaImportMonster(src, end, deltaLevel.monster);
-		src = DeltaImportSpawnedMonsters(src, end, deltaLevel.spawnedMonsters);
+		src = DeltaImportLevel(src, end);
 	} else {
 		Log("Received invalid deltas, dropping player {}", pnum);
 		SNetDropPlayer(pnum, leaveinfo_t::LEAVE_DROP);
@@ -844,7 +931,7 @@ void DeltaLoadEnemies(const DLevel &deltaLevel)
 			monster.occupyTile(monster.position.tile, false);
 		if (monster.type().type == MT_GOLEM) {
 			GolumAi(monster);
-			monster.flags |= (MFLAG_TARGETS_MONSTER | MFLAG_GOLEM);
+			monster.setFlags(monster.flags | (MFLAG_TARGETS_MONSTER | MFLAG_GOLEM));
 		} else {
 			M_StartStand(monster, monster.direction);
 		}
@@ -863,14 +950,14 @@ void DeltaLoadMonsters(const DLevel &deltaLevel)
 		M_ClearSquares(monster);
 		{
 			const WorldTilePosition position = deltaMonster.position;
-			monster.position.tile = position;
+			monster.setTile(position);
 			monster.position.old = position;
-			monster.position.future = position;
+			monster.setFuture(position);
 			if (monster.lightId != NO_LIGHT)
 				ChangeLightXY(monster.lightId, position);
 		}
 
-		monster.hitPoints = Swap32LE(deltaMonster.hitPoints);
+		monster.setHitPoints(Swap32LE(deltaMonster.hitPoints));
 		monster.whoHit = deltaMonster.mWhoHit;
 		if (deltaMonster.hitPoints != 0)
 			continue;
@@ -2053,9 +2140,9 @@ size_t OnMonstDamage(const TCmdMonDamage &message, Player &player)
 				Monster &monster = Monsters[monsterIdx];
 				monster.tag(player);
 				if (monster.hitPoints > 0) {
-					monster.hitPoints -= Swap32LE(message.dwDam);
+					monster.setHitPoints(monster.hitPoints - Swap32LE(message.dwDam));
 					if ((monster.hitPoints >> 6) < 1)
-						monster.hitPoints = 1 << 6;
+						monster.setHitPoints(1 << 6);
 					delta_monster_hp(monster, player);
 				}
 			}
@@ -2773,23 +2860,23 @@ void run_delta_info()
 void DeltaExportData(uint8_t pnum)
 {
 	for (const auto &[levelNum, deltaLevel] : DeltaLevels) {
+		if (!IsDeltaLevelChanged(deltaLevel))
+			continue;
+
 		const size_t bufferSize = 1U                                                              /* marker byte, always 0 */
 		    + sizeof(uint8_t)                                                                     /* level id */
-		    + sizeof(deltaLevel.item)                                                             /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
+		    + sizeof(uint8_t)                                                                     /* format version */
+		    + sizeof(uint8_t)                                                                     /* count of changed item slots */
+		    + ((sizeof(uint8_t) + sizeof(TCmdPItem)) * MAXITEMS)                                  /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
 		    + sizeof(uint8_t)                                                                     /* count of object interactions which caused a state change since dungeon generation */
 		    + ((sizeof(WorldTilePosition) + sizeof(DObjectStr)) * deltaLevel.object.size())       /* location/action pairs for the object interactions */
-		    + sizeof(deltaLevel.monster)                                                          /* latest monster state */
+		    + sizeof(uint8_t)                                                                     /* count of changed monster slots */
+		    + ((sizeof(uint8_t) + sizeof(DMonsterStr)) * MaxMonsters)                             /* latest monster state */
 		    + sizeof(uint16_t)                                                                    /* spawned monster count */
 		    + ((sizeof(uint16_t) + sizeof(DSpawnedMonster)) * deltaLevel.spawnedMonsters.size()); /* spawned monsters */
 		const std::unique_ptr<std::byte[]> dst { new std::byte[bufferSize] };
 
-		std::byte *dstEnd = &dst.get()[1];
-		*dstEnd = static_cast<std::byte>(levelNum);
-		dstEnd += sizeof(uint8_t);
-		dstEnd = DeltaExportItem(dstEnd, deltaLevel.item);
-		dstEnd = DeltaExportObject(dstEnd, deltaLevel.object);
-		dstEnd = DeltaExportMonster(dstEnd, deltaLevel.monster);
-		dstEnd = DeltaExportSpawnedMonsters(dstEnd, deltaLevel.spawnedMonsters);
+		std::byte *dstEnd = DeltaExportLevel(&dst.get()[1], levelNum, deltaLevel);
 		const uint32_t size = CompressData(dst.get(), dstEnd);
 		multi_send_zero_packet(pnum, CMD_DLEVEL, dst.get(), size);
 	}
@@ -2804,6 +2891,18 @@ void DeltaExportData(uint8_t pnum)
 	multi_send_zero_packet(pnum, CMD_DLEVEL_END, src, 1);
 }
 
+#ifdef BUILD_TESTING
+size_t TestDeltaExportLevel(uint8_t level, std::byte *dst)
+{
+	return static_cast<size_t>(DeltaExportLevel(dst, level, GetDeltaLevel(level)) - dst);
+}
+
+bool TestDeltaImportLevel(const std::byte *src, size_t size)
+{
+	return DeltaImportLevel(src, src + size) != nullptr;
+}
+#endif
+
 void delta_init()
 {
 	memset(&sgJunk, 0xFF, sizeof(sgJunk));
@@ -2852,7 +2951,7 @@ void delta_sync_monster(const TSyncMonster &monsterSync, uint8_t level)
 	monster.position.y = monsterSync._my;
 	monster.mactive = UINT8_MAX;
 	monster.menemy = monsterSync._menemy;
-	monster.hitPoints = monsterSync._mhitpoints;
+	monster.setHitPoints(monsterSync._mhitpoints);
 	monster.mWhoHit = monsterSync.mWhoHit;
 }
 
@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "dvlnet/leaveinfo.hpp"
@@ -763,4 +764,11 @@ void delta_close_portal(const Player &player);
 bool ValidateCmdSize(size_t requiredCmdSize, size_t maxCmdSize, size_t playerId);
 size_t ParseCmd(uint8_t pnum, const TCmd *pCmd, size_t maxCmdSize);
 
+#ifdef BUILD_TESTING
+/** @brief Writes the delta of a level as it is sent to joining players, without the codec marker. */
+size_t TestDeltaExportLevel(uint8_t level, std::byte *dst);
+/** @brief Applies a level delta as it is received by joining players, without the codec marker. */
+bool TestDeltaImportLevel(const std::byte *src, size_t size);
+#endif
+
 } // namespace devilution
@@ -47,6 +47,7 @@
 #include "utils/language.h"
 #include "utils/log.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/trace.hpp"
 
 namespace devilution {
 
@@ -609,6 +610,7 @@ void InitGameInfo()
 	sgGameInitInfo.versionMajor = PROJECT_VERSION_MAJOR;
 	sgGameInitInfo.versionMinor = PROJECT_VERSION_MINOR;
 	sgGameInitInfo.versionPatch = PROJECT_VERSION_PATCH;
+	sgGameInitInfo.codecs = GameCodecLz;
 	const Options &options = GetOptions();
 	sgGameInitInfo.nTickRate = *options.Gameplay.tickRate;
 	sgGameInitInfo.bRunInTown = *options.Gameplay.runInTown ? 1 : 0;
@@ -691,6 +693,7 @@ void multi_net_ping()
 
 bool multi_handle_delta()
 {
+	const TraceZone traceZone("multi_handle_delta");
 	if (gbGameDestroyed) {
 		gbRunGame = false;
 		return false;
@@ -732,6 +735,7 @@ bool multi_handle_delta()
 
 void ProcessGameMessagePackets()
 {
+	const TraceZone traceZone("ProcessGameMessagePackets");
 	ClearPlayerLeftState();
 	ProcessTmsgs();
 
@@ -23,9 +23,14 @@ struct Player;
 // must be unsigned to generate unsigned comparisons with pnum
 #define MAX_PLRS 4
 
+/** Set in GameData::codecs by hosts that send and receive level deltas compressed with LzCompress */
+constexpr uint8_t GameCodecLz = 1 << 0;
+
 struct GameData {
 	int32_t size;
-	uint8_t reserved[4];
+	/** Compression codecs supported by the host, older versions leave this at 0 and only use PKWARE */
+	uint8_t codecs;
+	uint8_t reserved[3];
 	uint32_t programid;
 	uint8_t versionMajor;
 	uint8_t versionMinor;
@@ -27,6 +27,7 @@
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
+#include "engine/render/clx_render.hpp"
 #include "headless_mode.hpp"
 #include "inv.h"
 #include "inv_iterators.hpp"
@@ -39,6 +40,7 @@
 #include "minitext.h"
 #include "missiles.h"
 #include "monster.h"
+#include "monsters/path_service.hpp"
 #include "options.h"
 #include "qol/stash.h"
 #include "stores.h"
@@ -905,6 +907,7 @@ void DeleteObject(int oi, int i)
 	const Object &object = Objects[oi];
 	const Point position = object.position;
 	dObject[position.x][position.y] = 0;
+	ResetMonsterPathCache();
 	AvailableObjects[-ActiveObjectCount + MAXOBJECTS] = oi;
 	ActiveObjectCount--;
 	if (ObjectUnderCursor == &object) // Unselect object if this was highlighted by player
@@ -952,6 +955,8 @@ void AddChest(Object &chest)
 void ObjSetMicro(Point position, int pn)
 {
 	dPiece[position.x][position.y] = pn;
+	// Opened doors and map changes make tiles walkable
+	ResetMonsterPathCache();
 }
 
 void DoorSet(Point position, bool isLeftDoor)
@@ -3471,6 +3476,7 @@ void BreakBarrel(const Player &player, Object &barrel, bool forcebreak, bool sen
 	barrel._oAnimFrame = 1;
 	barrel._oAnimDelay = 1;
 	barrel._oSolidFlag = false;
+	ResetMonsterPathCache();
 	barrel._oMissFlag = true;
 	barrel._oBreak = -1;
 	barrel.selectionRegion = SelectionRegion::None;
@@ -3748,6 +3754,7 @@ void FreeObjectGFX()
 		pObjCels[i] = std::nullopt;
 	}
 	numobjfiles = 0;
+	ClearClxDrawCache();
 }
 
 void AddL1Objs(int x1, int y1, int x2, int y2)
@@ -4715,6 +4722,7 @@ void DeltaSyncBreakObj(Object &object)
 
 	if (object.IsBarrel()) {
 		object._oSolidFlag = false;
+		ResetMonsterPathCache();
 	} else if (object.IsCrux() && AreAllCruxesOfTypeBroken(object._oVar8)) {
 		ObjChangeMap(object._oVar1, object._oVar2, object._oVar3, object._oVar4);
 	}
@@ -4923,6 +4931,7 @@ void SyncNakrulRoom()
 	dPiece[UberRow][UberCol - 1] = 300;
 	dPiece[UberRow][UberCol - 2] = 299;
 	dPiece[UberRow][UberCol + 1] = 298;
+	ResetMonsterPathCache();
 }
 
 } // namespace devilution
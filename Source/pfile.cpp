@@ -7,9 +7,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include <ankerl/unordered_dense.h>
 #include <expected.hpp>
@@ -36,9 +39,12 @@
 #include "utils/endian_swap.hpp"
 #include "utils/file_util.h"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/parse_int.hpp"
 #include "utils/paths.h"
 #include "utils/sdl_compat.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/stdcompat/filesystem.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
@@ -121,7 +127,7 @@ bool GetTempSaveNames(uint8_t dwIndex, char *szTemp)
 	return GetSaveNames(dwIndex, "temp", szTemp);
 }
 
-void RenameTempToPerm(SaveWriter &saveWriter)
+void RenameTempToPerm(SaveSnapshot &snapshot)
 {
 	char szTemp[MaxMpqPathSize];
 	char szPerm[MaxMpqPathSize];
@@ -131,11 +137,15 @@ void RenameTempToPerm(SaveWriter &saveWriter)
 		[[maybe_unused]] const bool result = GetPermSaveNames(dwIndex, szPerm); // DO NOT PUT DIRECTLY INTO ASSERT!
 		assert(result);
 		dwIndex++;
-		if (saveWriter.HasFile(szTemp)) {
-			if (saveWriter.HasFile(szPerm))
-				saveWriter.RemoveHashEntry(szPerm);
-			saveWriter.RenameFile(szTemp, szPerm);
-		}
+		// Which levels have been saved is only known once the earlier saves have been written.
+		snapshot.Defer([temp = std::string(szTemp), perm = std::string(szPerm)](SaveWriter &saveWriter) {
+			if (saveWriter.HasFile(temp.c_str())) {
+				if (saveWriter.HasFile(perm.c_str()))
+					saveWriter.RemoveHashEntry(perm.c_str());
+				saveWriter.RenameFile(temp.c_str(), perm.c_str());
+			}
+			return true;
+		});
 	}
 	assert(!GetPermSaveNames(dwIndex, szPerm));
 }
@@ -157,14 +167,14 @@ bool ReadHero(SaveReader &archive, PlayerPack *pPack)
 	return ret;
 }
 
-void EncodeHero(SaveWriter &saveWriter, const PlayerPack *pack)
+void EncodeHero(SaveSnapshot &snapshot, const PlayerPack *pack)
 {
 	const size_t packedLen = codec_get_encoded_len(sizeof(*pack));
-	const std::unique_ptr<std::byte[]> packed { new std::byte[packedLen] };
+	std::unique_ptr<std::byte[]> packed { new std::byte[packedLen] };
 
 	memcpy(packed.get(), pack, sizeof(*pack));
 	codec_encode(packed.get(), sizeof(*pack), packedLen, pfile_get_password());
-	saveWriter.WriteFile("hero", packed.get(), packedLen);
+	snapshot.WriteFile("hero", std::move(packed), packedLen);
 }
 
 SaveWriter GetSaveWriter(uint32_t saveNum, bool carryForward = true)
@@ -172,14 +182,157 @@ SaveWriter GetSaveWriter(uint32_t saveNum, bool carryForward = true)
 	return SaveWriter(GetSavePath(saveNum), carryForward);
 }
 
-SaveWriter GetStashWriter()
+#if defined(__DJGPP__) || defined(__EMSCRIPTEN__)
+constexpr bool HasSaveThread = false;
+#else
+constexpr bool HasSaveThread = true;
+#endif
+
+struct SaveJob {
+	std::string path;
+	bool carryForward = false;
+	SaveSnapshot snapshot;
+	SaveCompletedCallback onCompleted;
+	bool success = false;
+};
+
+bool WriteSave(SaveJob &job)
 {
-	return SaveWriter(GetStashSavePath(), /*carryForward=*/true);
+	// The archive is only complete once the writer is closed.
+	SaveWriter saveWriter(std::move(job.path), job.carryForward);
+	return job.snapshot.Apply(saveWriter);
+}
+
+/**
+ * @brief Writes save archives on a worker thread, one after the other in the order they were queued.
+ */
+class SaveThread {
+public:
+	SaveThread()
+	    : thread_(WorkerMain, this)
+	{
+	}
+
+	~SaveThread()
+	{
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			quit_ = true;
+		}
+		jobQueued_.post();
+		thread_.join();
+	}
+
+	SaveThread(const SaveThread &) = delete;
+	SaveThread &operator=(const SaveThread &) = delete;
+
+	void push(SaveJob &&job)
+	{
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			jobs_.push_back(std::move(job));
+			inFlight_++;
+		}
+		jobQueued_.post();
+	}
+
+	bool isBusy()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		return inFlight_ != 0;
+	}
+
+	void wait()
+	{
+		while (isBusy()) {
+			jobFinished_.wait();
+		}
+	}
+
+	std::vector<SaveJob> takeFinished()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		return std::exchange(finished_, {});
+	}
+
+private:
+	static int SDLCALL WorkerMain(void *data)
+	{
+		auto &saveThread = *static_cast<SaveThread *>(data);
+		while (true) {
+			saveThread.jobQueued_.wait();
+			SaveJob job;
+			{
+				const std::lock_guard<SdlMutex> lock(saveThread.mutex_);
+				if (saveThread.jobs_.empty()) {
+					if (saveThread.quit_)
+						return 0;
+					continue;
+				}
+				job = std::move(saveThread.jobs_.front());
+				saveThread.jobs_.pop_front();
+			}
+
+			job.success = WriteSave(job);
+
+			{
+				const std::lock_guard<SdlMutex> lock(saveThread.mutex_);
+				saveThread.finished_.push_back(std::move(job));
+				saveThread.inFlight_--;
+			}
+			saveThread.jobFinished_.post();
+		}
+	}
+
+	SdlSemaphore jobQueued_;
+	SdlSemaphore jobFinished_;
+
+	// The fields below are guarded by `mutex_`.
+	SdlMutex mutex_;
+	std::deque<SaveJob> jobs_;
+	/** Jobs that were written, but whose callbacks haven't been run yet. */
+	std::vector<SaveJob> finished_;
+	/** Number of jobs that are queued or being written. */
+	size_t inFlight_ = 0;
+	bool quit_ = false;
+
+	/** Declared last, so that everything the thread uses is initialized by the time it starts. */
+	SdlThread thread_;
+};
+
+std::unique_ptr<SaveThread> BackgroundSaves;
+
+void QueueSave(std::string &&path, bool carryForward, SaveSnapshot &&snapshot, SaveCompletedCallback &&onCompleted = {})
+{
+	SaveJob job { std::move(path), carryForward, std::move(snapshot), std::move(onCompleted), false };
+	if (!HasSaveThread) {
+		job.success = WriteSave(job);
+		if (job.onCompleted)
+			job.onCompleted(job.success);
+		return;
+	}
+
+	if (BackgroundSaves == nullptr)
+		BackgroundSaves = std::make_unique<SaveThread>();
+	BackgroundSaves->push(std::move(job));
+}
+
+void RunSaveCallbacks()
+{
+	if (BackgroundSaves == nullptr)
+		return;
+	for (SaveJob &job : BackgroundSaves->takeFinished()) {
+		if (!job.success)
+			LogError("Failed to write save archive");
+		if (job.onCompleted)
+			job.onCompleted(job.success);
+	}
 }
 
 #ifndef DISABLE_DEMOMODE
 void CopySaveFile(uint32_t saveNum, std::string targetPath)
 {
+	pfile_wait_for_saves();
 	const std::string savePath = GetSavePath(saveNum);
 #if defined(UNPACKED_SAVES)
 #ifdef DVL_NO_FILESYSTEM
@@ -249,6 +402,7 @@ bool ArchiveContainsGame(SaveReader &hsArchive)
 
 std::optional<SaveReader> CreateSaveReader(std::string &&path)
 {
+	pfile_wait_for_saves();
 #ifdef UNPACKED_SAVES
 	if (!FileExists(path))
 		return std::nullopt;
@@ -513,20 +667,20 @@ HeroCompareResult CompareSaves(const std::string &actualSavePath, const std::str
 }
 #endif // !DISABLE_DEMOMODE
 
-void pfile_write_hero(SaveWriter &saveWriter, bool writeGameData)
+void pfile_write_hero(SaveSnapshot &snapshot, bool writeGameData)
 {
 	if (writeGameData) {
-		SaveGameData(saveWriter);
-		RenameTempToPerm(saveWriter);
+		SaveGameData(snapshot);
+		RenameTempToPerm(snapshot);
 	}
 	PlayerPack pkplr;
 	Player &myPlayer = *MyPlayer;
 
 	PackPlayer(pkplr, myPlayer);
-	EncodeHero(saveWriter, &pkplr);
+	EncodeHero(snapshot, &pkplr);
 	if (!gbVanilla) {
-		SaveHotkeys(saveWriter, myPlayer);
-		SaveHeroItems(saveWriter, myPlayer);
+		SaveHotkeys(snapshot, myPlayer);
+		SaveHeroItems(snapshot, myPlayer);
 	}
 }
 
@@ -572,16 +726,20 @@ std::unique_ptr<std::byte[]> SaveReader::ReadFile(const char *filename, std::siz
 
 bool SaveWriter::WriteFile(const char *filename, const std::byte *data, size_t size)
 {
+	// Write next to the file and replace it once complete, so that a crash while saving keeps the previous version.
 	const std::string path = dir_ + filename;
-	FILE *file = OpenFile(path.c_str(), "wb");
+	const std::string tmpPath = path + ".tmp";
+	FILE *file = OpenFile(tmpPath.c_str(), "wb");
 	if (file == nullptr) {
 		return false;
 	}
 	if (std::fwrite(data, size, 1, file) != 1) {
 		std::fclose(file);
+		::devilution::RemoveFile(tmpPath.c_str());
 		return false;
 	}
 	std::fclose(file);
+	::devilution::RenameFile(tmpPath.c_str(), path.c_str());
 	return true;
 }
 
@@ -595,6 +753,29 @@ void SaveWriter::RemoveHashEntries(bool (*fnGetName)(uint8_t, char *))
 }
 #endif
 
+void SaveSnapshot::WriteFile(const char *filename, std::unique_ptr<std::byte[]> data, size_t size)
+{
+	// std::function only takes copyable functors
+	changes_.emplace_back([name = std::string(filename), contents = std::shared_ptr<std::byte[]>(std::move(data)), size](SaveWriter &saveWriter) {
+		return saveWriter.WriteFile(name.c_str(), contents.get(), size);
+	});
+}
+
+void SaveSnapshot::Defer(std::function<bool(SaveWriter &)> change)
+{
+	changes_.push_back(std::move(change));
+}
+
+bool SaveSnapshot::Apply(SaveWriter &saveWriter) const
+{
+	bool success = true;
+	for (const std::function<bool(SaveWriter &)> &change : changes_) {
+		if (!change(saveWriter))
+			success = false;
+	}
+	return success;
+}
+
 std::optional<SaveReader> OpenSaveArchive(uint32_t saveNum)
 {
 	return CreateSaveReader(GetSavePath(saveNum));
@@ -633,22 +814,50 @@ const char *pfile_get_password()
 
 void pfile_write_hero(bool writeGameData)
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber, /*carryForward=*/writeGameData);
-	pfile_write_hero(saveWriter, writeGameData);
+	pfile_write_hero_in_background(writeGameData);
+	pfile_wait_for_saves();
+}
+
+void pfile_write_hero_in_background(bool writeGameData, SaveCompletedCallback onCompleted)
+{
+	SaveSnapshot snapshot;
+	pfile_write_hero(snapshot, writeGameData);
+	QueueSave(GetSavePath(gSaveNumber), /*carryForward=*/writeGameData, std::move(snapshot), std::move(onCompleted));
 
 #ifdef __EMSCRIPTEN__
-	// Persist saves to IndexedDB for browser storage
+	// Persist saves to IndexedDB for browser storage, there is no save thread so the archive has been written already
 	emscripten_run_script("if (typeof Module !== 'undefined' && Module.saveToIndexedDB) Module.saveToIndexedDB();");
 #endif
 }
 
+bool pfile_is_save_in_flight()
+{
+	return BackgroundSaves != nullptr && BackgroundSaves->isBusy();
+}
+
+void pfile_wait_for_saves()
+{
+	if (BackgroundSaves == nullptr)
+		return;
+	BackgroundSaves->wait();
+	RunSaveCallbacks();
+}
+
+void pfile_shutdown_save_thread()
+{
+	pfile_wait_for_saves();
+	BackgroundSaves = nullptr;
+}
+
 #ifndef DISABLE_DEMOMODE
 void pfile_write_hero_demo(int demo)
 {
 	const std::string savePath = GetSavePath(gSaveNumber, StrCat("demo_", demo, "_reference_"));
 	CopySaveFile(gSaveNumber, savePath);
+	SaveSnapshot snapshot;
+	pfile_write_hero(snapshot, true);
 	auto saveWriter = SaveWriter(savePath.c_str());
-	pfile_write_hero(saveWriter, true);
+	snapshot.Apply(saveWriter);
 }
 
 HeroCompareResult pfile_compare_hero_demo(int demo, bool logDetails)
@@ -661,8 +870,10 @@ HeroCompareResult pfile_compare_hero_demo(int demo, bool logDetails)
 	const std::string actualSavePath = GetSavePath(gSaveNumber, StrCat("demo_", demo, "_actual_"));
 	{
 		CopySaveFile(gSaveNumber, actualSavePath);
+		SaveSnapshot snapshot;
+		pfile_write_hero(snapshot, true);
 		SaveWriter saveWriter(actualSavePath.c_str());
-		pfile_write_hero(saveWriter, true);
+		snapshot.Apply(saveWriter);
 	}
 
 	return CompareSaves(actualSavePath, referenceSavePath, logDetails);
@@ -674,9 +885,9 @@ void sfile_write_stash()
 	if (!Stash.dirty)
 		return;
 
-	SaveWriter stashWriter = GetStashWriter();
-
-	SaveStash(stashWriter);
+	SaveSnapshot snapshot;
+	SaveStash(snapshot);
+	QueueSave(GetStashSavePath(), /*carryForward=*/true, std::move(snapshot));
 
 	Stash.dirty = false;
 }
@@ -743,6 +954,7 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 
 	giNumberOfLevels = gbIsHellfire ? 25 : 17;
 
+	pfile_wait_for_saves();
 	SaveWriter saveWriter = GetSaveWriter(saveNum, /*carryForward=*/false);
 	saveWriter.RemoveHashEntries(GetFileName);
 	CopyUtf8(hero_names[saveNum], heroinfo->name, sizeof(hero_names[saveNum]));
@@ -751,12 +963,14 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 	CreatePlayer(player, heroinfo->heroclass);
 	CopyUtf8(player._pName, heroinfo->name, PlayerNameLength);
 	PackPlayer(pkplr, player);
-	EncodeHero(saveWriter, &pkplr);
+	SaveSnapshot snapshot;
+	EncodeHero(snapshot, &pkplr);
 	Game2UiPlayer(player, heroinfo, false);
 	if (!gbVanilla) {
-		SaveHotkeys(saveWriter, player);
-		SaveHeroItems(saveWriter, player);
+		SaveHotkeys(snapshot, player);
+		SaveHeroItems(snapshot, player);
 	}
+	snapshot.Apply(saveWriter);
 
 	return true;
 }
@@ -765,6 +979,7 @@ bool pfile_delete_save(_uiheroinfo *heroInfo)
 {
 	const uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
+		pfile_wait_for_saves();
 		hero_names[saveNum][0] = '\0';
 		RemoveFile(GetSavePath(saveNum).c_str());
 	}
@@ -794,12 +1009,14 @@ void pfile_read_player_from_save(uint32_t saveNum, Player &player)
 
 void pfile_save_level()
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	SaveLevel(saveWriter);
+	SaveSnapshot snapshot;
+	SaveLevel(snapshot);
+	QueueSave(GetSavePath(gSaveNumber), /*carryForward=*/true, std::move(snapshot));
 }
 
 tl::expected<void, std::string> pfile_convert_levels()
 {
+	pfile_wait_for_saves();
 	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
 	return ConvertLevels(saveWriter);
 }
@@ -809,6 +1026,7 @@ void pfile_remove_temp_files()
 	if (gbIsMultiplayer)
 		return;
 
+	pfile_wait_for_saves();
 	SaveWriter saveWriter = GetSaveWriter(gSaveNumber, /*carryForward=*/true);
 	saveWriter.RemoveHashEntries(GetTempSaveNames);
 }
@@ -817,15 +1035,20 @@ void pfile_update(bool forceSave)
 {
 	static Uint32 prevTick;
 
+	RunSaveCallbacks();
+
 	if (!gbIsMultiplayer)
 		return;
 
 	const Uint32 tick = SDL_GetTicks();
 	if (!forceSave && tick - prevTick <= 60000)
 		return;
+	// Slow storage is still busy with the last save, try again on the next tick rather than queueing up saves.
+	if (!forceSave && pfile_is_save_in_flight())
+		return;
 
 	prevTick = tick;
-	pfile_write_hero();
+	pfile_write_hero_in_background();
 	sfile_write_stash();
 }
 
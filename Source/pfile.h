@@ -6,7 +6,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <expected.hpp>
 
@@ -83,6 +86,40 @@ using SaveReader = MpqArchive;
 using SaveWriter = MpqWriter;
 #endif
 
+/**
+ * @brief Changes to a save archive, kept in memory until they are applied to the archive.
+ *
+ * The game state is serialized into a snapshot on the main thread, the slow part of opening, compressing and writing
+ * the archive can then happen on the save thread.
+ */
+class SaveSnapshot {
+public:
+	/**
+	 * @brief Adds a file, taking over its already encoded contents.
+	 */
+	void WriteFile(const char *filename, std::unique_ptr<std::byte[]> data, size_t size);
+
+	/**
+	 * @brief Adds a change that depends on the contents of the archive, which is only known when writing it.
+	 * @param change Returns false on failure.
+	 */
+	void Defer(std::function<bool(SaveWriter &)> change);
+
+	/**
+	 * @brief Makes all changes in the order they were added.
+	 * @return false if any of them failed.
+	 */
+	bool Apply(SaveWriter &saveWriter) const;
+
+private:
+	std::vector<std::function<bool(SaveWriter &)>> changes_;
+};
+
+/**
+ * @brief Called on the main thread once a background save has been written, with false if writing it failed.
+ */
+using SaveCompletedCallback = std::function<void(bool success)>;
+
 /**
  * @brief Comparison result of pfile_compare_hero_demo
  */
@@ -102,6 +139,30 @@ const char *pfile_get_password();
 std::unique_ptr<std::byte[]> ReadArchive(SaveReader &archive, const char *pszName, size_t *pdwLen = nullptr);
 void pfile_write_hero(bool writeGameData = false);
 
+/**
+ * @brief Like pfile_write_hero, but writes the save archive on the save thread.
+ *
+ * The game state is captured before returning, so the game can go on right away.
+ */
+void pfile_write_hero_in_background(bool writeGameData = false, SaveCompletedCallback onCompleted = {});
+
+/**
+ * @brief Returns true while a background save is queued or being written.
+ */
+bool pfile_is_save_in_flight();
+
+/**
+ * @brief Blocks until all background saves have been written.
+ *
+ * Everything that reads or writes save archives directly calls this first.
+ */
+void pfile_wait_for_saves();
+
+/**
+ * @brief Finishes the pending saves and stops the save thread.
+ */
+void pfile_shutdown_save_thread();
+
 #ifndef DISABLE_DEMOMODE
 /**
  * @brief Save a reference game-state (save game) for the demo recording
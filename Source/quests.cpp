@@ -599,7 +599,7 @@ void ResyncQuests()
 			if (gbIsMultiplayer && snotSpill != nullptr && snotSpill->talkMsg != TEXT_BANNER12) {
 				snotSpill->goal = MonsterGoal::Inquiring;
 				snotSpill->talkMsg = Quests[Q_LTBANNER]._qactive == QUEST_DONE ? TEXT_BANNER12 : TEXT_BANNER11;
-				snotSpill->flags |= MFLAG_QUEST_COMPLETE;
+				snotSpill->setFlags(snotSpill->flags | MFLAG_QUEST_COMPLETE);
 			}
 		}
 		if (Quests[Q_LTBANNER]._qvar1 == 3) {
@@ -612,7 +612,7 @@ void ResyncQuests()
 			TransVal = tren;
 			if (gbIsMultiplayer && snotSpill != nullptr) {
 				snotSpill->goal = MonsterGoal::Normal;
-				snotSpill->flags |= MFLAG_QUEST_COMPLETE;
+				snotSpill->setFlags(snotSpill->flags | MFLAG_QUEST_COMPLETE);
 				snotSpill->talkMsg = TEXT_NONE;
 				snotSpill->activeForTicks = UINT8_MAX;
 				RedoPlayerVision();
@@ -688,22 +688,22 @@ void ResyncQuests()
 				break;
 			case QS_GHARBAD_FIRST_ITEM_SPAWNED:
 				garbud->talkMsg = TEXT_GARBUD2;
-				garbud->flags |= MFLAG_QUEST_COMPLETE;
+				garbud->setFlags(garbud->flags | MFLAG_QUEST_COMPLETE);
 				garbud->goal = MonsterGoal::Talking;
 				break;
 			case QS_GHARBAD_SECOND_ITEM_NEARLY_DONE:
 				garbud->talkMsg = TEXT_GARBUD3;
-				garbud->flags |= MFLAG_QUEST_COMPLETE;
+				garbud->setFlags(garbud->flags | MFLAG_QUEST_COMPLETE);
 				garbud->goal = MonsterGoal::Inquiring;
 				break;
 			case QS_GHARBAD_SECOND_ITEM_READY:
 				garbud->talkMsg = TEXT_GARBUD4;
-				garbud->flags |= MFLAG_QUEST_COMPLETE;
+				garbud->setFlags(garbud->flags | MFLAG_QUEST_COMPLETE);
 				garbud->goal = MonsterGoal::Inquiring;
 				break;
 			case QS_GHARBAD_ATTACKING:
 				garbud->talkMsg = TEXT_NONE;
-				garbud->flags |= MFLAG_QUEST_COMPLETE;
+				garbud->setFlags(garbud->flags | MFLAG_QUEST_COMPLETE);
 				garbud->goal = MonsterGoal::Normal;
 				garbud->activeForTicks = UINT8_MAX;
 				break;
@@ -713,7 +713,7 @@ void ResyncQuests()
 	if (Quests[Q_ZHAR].IsAvailable() && gbIsMultiplayer) {
 		Monster *zhar = FindUniqueMonster(UniqueMonsterType::Zhar);
 		if (zhar != nullptr && Quests[Q_ZHAR]._qvar1 != QS_ZHAR_INIT) {
-			zhar->flags |= MFLAG_QUEST_COMPLETE;
+			zhar->setFlags(zhar->flags | MFLAG_QUEST_COMPLETE);
 
 			switch (Quests[Q_ZHAR]._qvar1) {
 			case QS_ZHAR_ITEM_SPAWNED:
@@ -751,7 +751,7 @@ void ResyncQuests()
 				if (lachdan->talkMsg == TEXT_VEIL11)
 					break;
 				lachdan->talkMsg = TEXT_VEIL11;
-				lachdan->flags |= MFLAG_QUEST_COMPLETE;
+				lachdan->setFlags(lachdan->flags | MFLAG_QUEST_COMPLETE);
 				lachdan->goal = MonsterGoal::Inquiring;
 				break;
 			}
@@ -914,7 +914,12 @@ bool Quest::IsAvailable() const
 {
 	if (setlevel)
 		return false;
-	if (currlevel != _qlevel)
+	return IsAvailableOnLevel(currlevel);
+}
+
+bool Quest::IsAvailableOnLevel(int level) const
+{
+	if (level != _qlevel)
 		return false;
 	if (_qactive == QUEST_NOTAVAIL)
 		return false;
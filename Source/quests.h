@@ -92,6 +92,8 @@ struct Quest {
 	uint8_t _qvar2;
 
 	bool IsAvailable() const;
+	/** @brief Same as IsAvailable, for a dungeon level that doesn't need to be the current one. */
+	bool IsAvailableOnLevel(int level) const;
 };
 
 struct QuestData {
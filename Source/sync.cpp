@@ -194,7 +194,7 @@ void SyncMonster(bool isOwner, const TSyncMonster &monsterSync)
 	} else if (dMonster[position.x][position.y] == 0) {
 		M_ClearSquares(monster);
 		monster.occupyTile(position, false);
-		monster.position.tile = position;
+		monster.setTile(position);
 		if (monster.lightId != NO_LIGHT)
 			ChangeLightXY(monster.lightId, position);
 		decode_enemy(monster, enemyId);
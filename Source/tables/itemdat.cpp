@@ -6,7 +6,12 @@
 
 #include "tables/itemdat.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -14,6 +19,7 @@
 #include "data/file.hpp"
 #include "data/iterators.hpp"
 #include "data/record_reader.hpp"
+#include "data/table_cache.hpp"
 #include "lua/lua_event.hpp"
 #include "tables/spelldat.h"
 #include "utils/str_cat.hpp"
@@ -41,6 +47,8 @@ std::vector<PLStruct> ItemPrefixes;
 /** Contains the data related to each item suffix. */
 std::vector<PLStruct> ItemSuffixes;
 
+uint32_t ItemAffixesGeneration;
+
 tl::expected<_item_indexes, std::string> ParseItemId(std::string_view value)
 {
 	const std::optional<_item_indexes> enumValueOpt = magic_enum::enum_cast<_item_indexes>(value);
@@ -607,19 +615,127 @@ void LoadItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t
 	AllItemsList.shrink_to_fit();
 }
 
+/** Lists the fields of a record that the table cache stores, in order. */
+template <typename Visitor>
+void VisitCachedFields(ItemData &item, Visitor &&visit)
+{
+	visit(item.dropRate);
+	visit(item.iClass);
+	visit(item.iLoc);
+	visit(item.iCurs);
+	visit(item.itype);
+	visit(item.iItemId);
+	visit(item.iName);
+	visit(item.iSName);
+	visit(item.iMinMLvl);
+	visit(item.iDurability);
+	visit(item.iMinDam);
+	visit(item.iMaxDam);
+	visit(item.iMinAC);
+	visit(item.iMaxAC);
+	visit(item.iMinStr);
+	visit(item.iMinMag);
+	visit(item.iMinDex);
+	visit(item.iFlags);
+	visit(item.iMiscId);
+	visit(item.iSpell);
+	visit(item.iUsable);
+	visit(item.iValue);
+	visit(item.iMappingId);
+}
+
+template <typename Visitor>
+void VisitCachedFields(UniqueItem &item, Visitor &&visit)
+{
+	visit(item.UIName);
+	visit(item.UICurs);
+	visit(item.UIItemId);
+	visit(item.UIMinLvl);
+	visit(item.UINumPL);
+	visit(item.UIValue);
+	visit(item.powers);
+	visit(item.mappingId);
+}
+
+template <typename Visitor>
+void VisitCachedFields(PLStruct &item, Visitor &&visit)
+{
+	visit(item.PLName);
+	visit(item.power);
+	visit(item.PLMinLvl);
+	visit(item.PLIType);
+	visit(item.PLGOE);
+	visit(item.PLChance);
+	visit(item.PLOk);
+	visit(item.minVal);
+	visit(item.maxVal);
+	visit(item.multVal);
+}
+
 namespace {
 
-void LoadItemDat()
+bool LoadItemDatFromCache(std::string_view filename, uint64_t cacheKey)
+{
+	const std::optional<std::vector<std::byte>> cache = LoadTableCache(filename, cacheKey);
+	if (!cache)
+		return false;
+
+	TableCacheReader reader { *cache };
+	if (!ReadCachedRecords(reader, AllItemsList))
+		return false;
+	uint32_t numUniqueBaseItems;
+	if (!reader.read(numUniqueBaseItems))
+		return false;
+	for (uint32_t i = 0; i < numUniqueBaseItems; ++i) {
+		std::string name;
+		int8_t index;
+		reader.read(name);
+		reader.read(index);
+		AdditionalUniqueBaseItemStringsToIndices[std::move(name)] = index;
+	}
+	if (!reader.done())
+		return false;
+
+	for (size_t i = 0; i < AllItemsList.size(); ++i) {
+		ItemMappingIdsToIndices.emplace(AllItemsList[i].iMappingId, static_cast<int16_t>(i));
+	}
+	return true;
+}
+
+void StoreItemDatCache(std::string_view filename, uint64_t cacheKey)
+{
+	TableCacheWriter writer;
+	WriteCachedRecords(writer, AllItemsList);
+	writer.write(static_cast<uint32_t>(AdditionalUniqueBaseItemStringsToIndices.size()));
+	for (const auto &[name, index] : AdditionalUniqueBaseItemStringsToIndices) {
+		writer.write(name);
+		writer.write(index);
+	}
+	StoreTableCache(filename, cacheKey, writer.data());
+}
+
+/**
+ * @return The cache key of the table, which the unique items are keyed on as well.
+ */
+uint64_t LoadItemDat()
 {
 	const std::string_view filename = "txtdata\\items\\itemdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
+	const uint64_t cacheKey = GetTableCacheKey(filename, dataFile);
 
 	AllItemsList.clear();
 	AdditionalUniqueBaseItemStringsToIndices.clear();
 	ItemMappingIdsToIndices.clear();
-	LoadItemDatFromFile(dataFile, filename, 0);
+	if (!LoadItemDatFromCache(filename, cacheKey)) {
+		AllItemsList.clear();
+		AdditionalUniqueBaseItemStringsToIndices.clear();
+		ItemMappingIdsToIndices.clear();
+		LoadItemDatFromFile(dataFile, filename, 0);
+		StoreItemDatCache(filename, cacheKey);
+	}
 
 	lua::ItemDataLoaded();
+	return cacheKey;
 }
 
 void ReadItemPower(RecordReader &reader, std::string_view fieldName, ItemPower &power)
@@ -667,14 +783,24 @@ void LoadUniqueItemDatFromFile(DataFile &dataFile, std::string_view filename, in
 
 namespace {
 
-void LoadUniqueItemDat()
+void LoadUniqueItemDat(uint64_t itemDatCacheKey)
 {
 	const std::string_view filename = "txtdata\\items\\unique_itemdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
+	// The base items of unique items are looked up by name in the item table.
+	const uint64_t cacheKey = GetTableCacheKey(filename, dataFile, itemDatCacheKey);
 
 	UniqueItems.clear();
 	UniqueItemMappingIdsToIndices.clear();
-	LoadUniqueItemDatFromFile(dataFile, filename, 0);
+	if (LoadTableFromCache(filename, cacheKey, UniqueItems)) {
+		for (size_t i = 0; i < UniqueItems.size(); ++i) {
+			UniqueItemMappingIdsToIndices.emplace(UniqueItems[i].mappingId, static_cast<int32_t>(i));
+		}
+	} else {
+		UniqueItems.clear();
+		LoadUniqueItemDatFromFile(dataFile, filename, 0);
+		StoreTableInCache(filename, cacheKey, UniqueItems);
+	}
 
 	lua::UniqueItemDataLoaded();
 }
@@ -682,9 +808,14 @@ void LoadUniqueItemDat()
 void LoadItemAffixesDat(std::string_view filename, std::vector<PLStruct> &out)
 {
 	DataFile dataFile = DataFile::loadOrDie(filename);
-	dataFile.skipHeaderOrDie(filename);
+	const uint64_t cacheKey = GetTableCacheKey(filename, dataFile);
 
 	out.clear();
+	if (LoadTableFromCache(filename, cacheKey, out))
+		return;
+	out.clear();
+
+	dataFile.skipHeaderOrDie(filename);
 	out.reserve(dataFile.numRecords());
 	for (DataFileRecord record : dataFile) {
 		RecordReader reader { record, filename };
@@ -701,16 +832,19 @@ void LoadItemAffixesDat(std::string_view filename, std::vector<PLStruct> &out)
 		reader.readInt("multVal", item.multVal);
 	}
 	out.shrink_to_fit();
+
+	StoreTableInCache(filename, cacheKey, out);
 }
 
 } // namespace
 
 void LoadItemData()
 {
-	LoadItemDat();
-	LoadUniqueItemDat();
+	const uint64_t itemDatCacheKey = LoadItemDat();
+	LoadUniqueItemDat(itemDatCacheKey);
 	LoadItemAffixesDat("txtdata\\items\\item_prefixes.tsv", ItemPrefixes);
 	LoadItemAffixesDat("txtdata\\items\\item_suffixes.tsv", ItemSuffixes);
+	ItemAffixesGeneration++;
 }
 
 std::string_view ItemTypeToString(ItemType itemType)
@@ -514,6 +514,8 @@ struct ItemData {
 	bool iUsable;
 	uint16_t iValue;
 	int32_t iMappingId;
+
+	bool operator==(const ItemData &other) const = default;
 };
 
 enum item_effect_type : int8_t {
@@ -623,6 +625,8 @@ struct ItemPower {
 	item_effect_type type = IPL_INVALID;
 	int param1 = 0;
 	int param2 = 0;
+
+	bool operator==(const ItemPower &other) const = default;
 };
 
 struct PLStruct {
@@ -636,6 +640,8 @@ struct PLStruct {
 	int minVal;
 	int maxVal;
 	int multVal;
+
+	bool operator==(const PLStruct &other) const = default;
 };
 
 struct UniqueItem {
@@ -647,14 +653,18 @@ struct UniqueItem {
 	int UIValue;
 	ItemPower powers[6];
 	int32_t mappingId;
+
+	bool operator==(const UniqueItem &other) const = default;
 };
 
 extern DVL_API_FOR_TEST std::vector<ItemData> AllItemsList;
-extern ankerl::unordered_dense::map<int32_t, int16_t> ItemMappingIdsToIndices;
-extern std::vector<PLStruct> ItemPrefixes;
-extern std::vector<PLStruct> ItemSuffixes;
+extern DVL_API_FOR_TEST ankerl::unordered_dense::map<int32_t, int16_t> ItemMappingIdsToIndices;
+extern DVL_API_FOR_TEST std::vector<PLStruct> ItemPrefixes;
+extern DVL_API_FOR_TEST std::vector<PLStruct> ItemSuffixes;
+/** Incremented whenever the affixes are reloaded, so that tables derived from them know to rebuild. */
+extern uint32_t ItemAffixesGeneration;
 extern DVL_API_FOR_TEST std::vector<UniqueItem> UniqueItems;
-extern ankerl::unordered_dense::map<int32_t, int32_t> UniqueItemMappingIdsToIndices;
+extern DVL_API_FOR_TEST ankerl::unordered_dense::map<int32_t, int32_t> UniqueItemMappingIdsToIndices;
 
 tl::expected<_item_indexes, std::string> ParseItemId(std::string_view value);
 void LoadItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t baseMappingId);
@@ -11,6 +11,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <ankerl/unordered_dense.h>
@@ -24,6 +25,7 @@
 #include "data/file.hpp"
 #include "data/iterators.hpp"
 #include "data/record_reader.hpp"
+#include "data/table_cache.hpp"
 #include "items.h"
 #include "lua/lua_event.hpp"
 #include "monster.h"
@@ -403,16 +405,121 @@ void LoadMonstDatFromFile(DataFile &dataFile, const std::string_view filename, b
 	}
 }
 
+/** Lists the fields of a record that the table cache stores, in order. The sprite is stored by its path. */
+template <typename Visitor>
+void VisitCachedFields(MonsterData &monster, Visitor &&visit)
+{
+	visit(monster.name);
+	visit(monster.soundSuffix);
+	visit(monster.trnFile);
+	visit(monster.availability);
+	visit(monster.width);
+	visit(monster.image);
+	visit(monster.hasSpecial);
+	visit(monster.hasSpecialSound);
+	visit(monster.frames);
+	visit(monster.rate);
+	visit(monster.minDunLvl);
+	visit(monster.maxDunLvl);
+	visit(monster.level);
+	visit(monster.hitPointsMinimum);
+	visit(monster.hitPointsMaximum);
+	visit(monster.ai);
+	visit(monster.abilityFlags);
+	visit(monster.intelligence);
+	visit(monster.toHit);
+	visit(monster.animFrameNum);
+	visit(monster.minDamage);
+	visit(monster.maxDamage);
+	visit(monster.toHitSpecial);
+	visit(monster.animFrameNumSpecial);
+	visit(monster.minDamageSpecial);
+	visit(monster.maxDamageSpecial);
+	visit(monster.reducePlayerStrength);
+	visit(monster.reducePlayerMagic);
+	visit(monster.reducePlayerDexterity);
+	visit(monster.reducePlayerVitality);
+	visit(monster.reducePlayerMaxHP);
+	visit(monster.reducePlayerMaxMana);
+	visit(monster.armorClass);
+	visit(monster.monsterClass);
+	visit(monster.resistance);
+	visit(monster.resistanceHell);
+	visit(monster.selectionRegion);
+	visit(monster.treasure);
+	visit(monster.exp);
+}
+
 namespace {
 
+bool LoadMonstDatFromCache(std::string_view filename, uint64_t cacheKey)
+{
+	const std::optional<std::vector<std::byte>> cache = LoadTableCache(filename, cacheKey);
+	if (!cache)
+		return false;
+
+	TableCacheReader reader { *cache };
+	if (!ReadCachedRecords(reader, MonstersData))
+		return false;
+	std::vector<std::string> spritePaths(MonstersData.size());
+	for (std::string &spritePath : spritePaths) {
+		reader.read(spritePath);
+	}
+	uint32_t numAdditionalMonsterIds;
+	if (!reader.read(numAdditionalMonsterIds))
+		return false;
+	for (uint32_t i = 0; i < numAdditionalMonsterIds; ++i) {
+		std::string monsterId;
+		int16_t index;
+		reader.read(monsterId);
+		reader.read(index);
+		AdditionalMonsterIdStringsToIndices[std::move(monsterId)] = index;
+	}
+	if (!reader.done())
+		return false;
+
+	for (size_t i = 0; i < MonstersData.size(); ++i) {
+		const auto findIt = std::find(MonsterSpritePaths.begin(), MonsterSpritePaths.end(), spritePaths[i]);
+		if (findIt != MonsterSpritePaths.end()) {
+			MonstersData[i].spriteId = static_cast<uint16_t>(findIt - MonsterSpritePaths.begin());
+		} else {
+			MonstersData[i].spriteId = static_cast<uint16_t>(MonsterSpritePaths.size());
+			MonsterSpritePaths.emplace_back(std::move(spritePaths[i]));
+		}
+	}
+	return true;
+}
+
+void StoreMonstDatCache(std::string_view filename, uint64_t cacheKey)
+{
+	TableCacheWriter writer;
+	WriteCachedRecords(writer, MonstersData);
+	for (const MonsterData &monster : MonstersData) {
+		writer.write(MonsterSpritePaths[monster.spriteId]);
+	}
+	writer.write(static_cast<uint32_t>(AdditionalMonsterIdStringsToIndices.size()));
+	for (const auto &[monsterId, index] : AdditionalMonsterIdStringsToIndices) {
+		writer.write(monsterId);
+		writer.write(index);
+	}
+	StoreTableCache(filename, cacheKey, writer.data());
+}
+
 void LoadMonstDat()
 {
 	const std::string_view filename = "txtdata\\monsters\\monstdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
+	const uint64_t cacheKey = GetTableCacheKey(filename, dataFile);
+
 	MonstersData.clear();
 	AdditionalMonsterIdStringsToIndices.clear();
-	MonstersData.resize(NUM_DEFAULT_MTYPES); // ensure the hardcoded monster type slots are filled
-	LoadMonstDatFromFile(dataFile, filename, false);
+	if (!LoadMonstDatFromCache(filename, cacheKey)) {
+		MonstersData.clear();
+		AdditionalMonsterIdStringsToIndices.clear();
+		MonstersData.resize(NUM_DEFAULT_MTYPES); // ensure the hardcoded monster type slots are filled
+		LoadMonstDatFromFile(dataFile, filename, false);
+		StoreMonstDatCache(filename, cacheKey);
+	}
 
 	lua::MonsterDataLoaded();
 
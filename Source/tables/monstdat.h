@@ -14,6 +14,7 @@
 
 #include "cursor.h"
 #include "tables/textdat.h"
+#include "utils/attributes.h"
 
 namespace devilution {
 
@@ -155,6 +156,8 @@ struct MonsterData {
 	{
 		return frames[index] != 0;
 	}
+
+	bool operator==(const MonsterData &other) const = default;
 };
 
 enum _monster_id : int16_t {
@@ -347,7 +350,7 @@ struct UniqueMonsterData {
 	_speech_id mtalkmsg;
 };
 
-extern std::vector<MonsterData> MonstersData;
+extern DVL_API_FOR_TEST std::vector<MonsterData> MonstersData;
 extern const _monster_id MonstConvTbl[];
 extern std::vector<UniqueMonsterData> UniqueMonstersData;
 
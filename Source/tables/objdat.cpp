@@ -5,6 +5,9 @@
  */
 #include "tables/objdat.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -16,6 +19,7 @@
 #include "data/file.hpp"
 #include "data/iterators.hpp"
 #include "data/record_reader.hpp"
+#include "data/table_cache.hpp"
 
 namespace devilution {
 
@@ -254,14 +258,72 @@ tl::expected<SelectionRegion, std::string> ParseSelectionRegion(std::string_view
 
 } // namespace
 
+/** Lists the fields of a record that the table cache stores, in order. */
+template <typename Visitor>
+void VisitCachedFields(ObjectData &object, Visitor &&visit)
+{
+	visit(object.ofindex);
+	visit(object.minlvl);
+	visit(object.maxlvl);
+	visit(object.olvltype);
+	visit(object.otheme);
+	visit(object.oquest);
+	visit(object.flags);
+	visit(object.animDelay);
+	visit(object.animLen);
+	visit(object.animWidth);
+	visit(object.selectionRegion);
+}
+
+namespace {
+
+bool LoadObjectDataFromCache(std::string_view filename, uint64_t cacheKey)
+{
+	const std::optional<std::vector<std::byte>> cache = LoadTableCache(filename, cacheKey);
+	if (!cache)
+		return false;
+
+	TableCacheReader reader { *cache };
+	if (!ReadCachedRecords(reader, AllObjects))
+		return false;
+	uint32_t numFiles;
+	// Every file name takes up at least a byte for its size.
+	if (!reader.read(numFiles) || numFiles > reader.remaining())
+		return false;
+	ObjMasterLoadList.resize(numFiles);
+	for (std::string &objFilename : ObjMasterLoadList) {
+		reader.read(objFilename);
+	}
+	return reader.done() && static_cast<size_t>(OBJ_LAST) + 1 == AllObjects.size();
+}
+
+void StoreObjectDataCache(std::string_view filename, uint64_t cacheKey)
+{
+	TableCacheWriter writer;
+	WriteCachedRecords(writer, AllObjects);
+	writer.write(static_cast<uint32_t>(ObjMasterLoadList.size()));
+	for (const std::string &objFilename : ObjMasterLoadList) {
+		writer.write(objFilename);
+	}
+	StoreTableCache(filename, cacheKey, writer.data());
+}
+
+} // namespace
+
 void LoadObjectData()
 {
 	const std::string_view filename = "txtdata\\objects\\objdat.tsv";
 	DataFile dataFile = DataFile::loadOrDie(filename);
-	dataFile.skipHeaderOrDie(filename);
+	const uint64_t cacheKey = GetTableCacheKey(filename, dataFile);
 
 	AllObjects.clear();
 	ObjMasterLoadList.clear();
+	if (LoadObjectDataFromCache(filename, cacheKey))
+		return;
+	AllObjects.clear();
+	ObjMasterLoadList.clear();
+
+	dataFile.skipHeaderOrDie(filename);
 
 	ankerl::unordered_dense::map<std::string, uint8_t> filenameToId;
 
@@ -299,6 +361,8 @@ void LoadObjectData()
 
 	AllObjects.shrink_to_fit();
 	ObjMasterLoadList.shrink_to_fit();
+
+	StoreObjectDataCache(filename, cacheKey);
 }
 
 } // namespace devilution
@@ -234,11 +234,13 @@ struct ObjectData {
 	{
 		return HasAnyOf(flags, ObjectDataFlags::Breakable);
 	}
+
+	bool operator==(const ObjectData &other) const = default;
 };
 
 extern const _object_id ObjTypeConv[];
-extern std::vector<ObjectData> AllObjects;
-extern std::vector<std::string> ObjMasterLoadList;
+extern DVL_API_FOR_TEST std::vector<ObjectData> AllObjects;
+extern DVL_API_FOR_TEST std::vector<std::string> ObjMasterLoadList;
 
 void LoadObjectData();
 
@@ -0,0 +1,233 @@
+#include "utils/clx_cache.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/endian_read.hpp"
+#include "utils/file_util.h"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+namespace {
+
+/** Directory of the cached sprites, empty if disabled. */
+std::string CacheDir;
+
+/** The most the files in CacheDir may take up. */
+uintmax_t CacheMaxSize;
+
+/** The size of the files in CacheDir, as of the last time it was pruned plus what has been stored since. */
+uintmax_t CacheSize;
+
+/** Guards CacheSize and pruning, as sprites may be loaded on more than one thread. */
+SdlMutex CacheSizeMutex;
+
+constexpr char CacheMagic[4] = { 'D', 'X', 'C', 'X' };
+
+/** Bump whenever a change to CelToClx or Cl2ToClx changes their output. */
+constexpr uint32_t CacheVersion = 2;
+
+uint64_t Mix(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+/** Hashes 8 bytes at a time, so that hashing a sprite costs a fraction of converting it. */
+uint64_t GetCacheKey(ClxSourceFormat format, const uint8_t *data, size_t size, uint16_t width)
+{
+	uint64_t hash = Mix((static_cast<uint64_t>(CacheVersion) << 32) | (static_cast<uint64_t>(format) << 16) | width) ^ size;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t word;
+		std::memcpy(&word, &data[i], sizeof(word));
+		hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+		hash ^= hash >> 29;
+	}
+	uint64_t tail = 0;
+	std::memcpy(&tail, &data[i], size - i);
+	return Mix(hash ^ tail);
+}
+
+std::string GetCachePath(uint64_t key)
+{
+	std::string path = CacheDir;
+	for (int shift = 60; shift >= 0; shift -= 4) {
+		path += "0123456789abcdef"[(key >> shift) & 0xF];
+	}
+	path += ".clx";
+	return path;
+}
+
+/**
+ * @brief Checks the sprite offsets of a CLX list against the size of the data it is in.
+ *
+ * @return The size of the list, or 0 if it is malformed.
+ */
+size_t GetValidClxListSize(const uint8_t *data, size_t size)
+{
+	if (size < 8)
+		return 0;
+	const uint32_t numSprites = LoadLE32(data);
+	if (numSprites >= size / 4)
+		return 0;
+	const size_t headerSize = 4 * (static_cast<size_t>(numSprites) + 2);
+	if (headerSize > size)
+		return 0;
+	size_t begin = LoadLE32(&data[4]);
+	if (begin < headerSize || begin > size)
+		return 0;
+	for (uint32_t i = 1; i <= numSprites; ++i) {
+		const size_t end = LoadLE32(&data[4 * (i + 1)]);
+		// Every sprite has a header of at least 6 bytes that holds the header size, the width and the height.
+		if (end > size || end < begin + 6)
+			return 0;
+		const uint16_t spriteHeaderSize = LoadLE16(&data[begin]);
+		if (spriteHeaderSize < 6 || spriteHeaderSize > end - begin)
+			return 0;
+		begin = end;
+	}
+	return begin;
+}
+
+/** @brief Checks that a cached list or sheet is laid out as its number of lists says, so that it can be drawn safely. */
+bool IsValidClx(const uint8_t *data, size_t size, uint16_t numLists)
+{
+	if (numLists == 0)
+		return GetValidClxListSize(data, size) == size;
+	const size_t headerSize = 4 * static_cast<size_t>(numLists);
+	if (headerSize > size)
+		return false;
+	for (uint16_t i = 0; i < numLists; ++i) {
+		const size_t offset = LoadLE32(&data[4 * i]);
+		if (offset < headerSize || offset >= size)
+			return false;
+		const size_t listSize = GetValidClxListSize(&data[offset], size - offset);
+		if (listSize == 0)
+			return false;
+		// The size of a sheet is taken from where its last list ends.
+		if (i == numLists - 1 && offset + listSize != size)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Removes the least recently written files from the cache until they take up at most `targetSize`.
+ *
+ * @pre CacheSizeMutex is locked
+ */
+void PruneCache(uintmax_t targetSize)
+{
+	struct CacheFile {
+		std::string path;
+		std::int64_t modificationTime;
+		uintmax_t size;
+	};
+	std::vector<CacheFile> files;
+	CacheSize = 0;
+	for (const std::string &name : ListFiles(CacheDir.c_str())) {
+		CacheFile file { CacheDir + name, 0, 0 };
+		if (!GetFileSize(file.path.c_str(), &file.size) || !GetFileModificationTime(file.path.c_str(), &file.modificationTime))
+			continue;
+		CacheSize += file.size;
+		files.push_back(std::move(file));
+	}
+	if (CacheSize <= targetSize)
+		return;
+
+	std::sort(files.begin(), files.end(), [](const CacheFile &a, const CacheFile &b) {
+		return a.modificationTime < b.modificationTime;
+	});
+	for (const CacheFile &file : files) {
+		if (CacheSize <= targetSize)
+			break;
+		RemoveFile(file.path.c_str());
+		CacheSize -= file.size;
+	}
+}
+
+std::optional<OwnedClxSpriteListOrSheet> LoadCachedClx(uint64_t key)
+{
+	// The sprite data is followed by the number of lists.
+	std::unique_ptr<uint8_t[]> data;
+	size_t dataSize = 0;
+	const bool loaded = ReadCacheFile(GetCachePath(key).c_str(), CacheMagic, CacheVersion, key, [&](size_t size) -> std::byte * {
+		if (size <= sizeof(uint16_t))
+			return nullptr;
+		dataSize = size - sizeof(uint16_t);
+		data = std::unique_ptr<uint8_t[]> { new uint8_t[size] };
+		return reinterpret_cast<std::byte *>(data.get());
+	});
+	if (!loaded)
+		return std::nullopt;
+	uint16_t numLists;
+	std::memcpy(&numLists, &data[dataSize], sizeof(numLists));
+	if (!IsValidClx(data.get(), dataSize, numLists))
+		return std::nullopt;
+	return OwnedClxSpriteListOrSheet { std::move(data), numLists };
+}
+
+void StoreCachedClx(uint64_t key, const OwnedClxSpriteListOrSheet &clx)
+{
+	const ClxSpriteListOrSheet view { clx };
+	const uint8_t *data = view.isSheet() ? view.sheet().data() : view.list().data();
+	const uint16_t numLists = clx.numLists();
+
+	// Pruning lists the whole directory, so make room for a quarter of the cache at a time.
+	const uintmax_t size = view.dataSize() + sizeof(numLists);
+	if (size > CacheMaxSize / 4)
+		return;
+	const std::lock_guard<SdlMutex> lock(CacheSizeMutex);
+	if (CacheSize + size > CacheMaxSize)
+		PruneCache(CacheMaxSize - (CacheMaxSize / 4) - size);
+
+	const std::string path = GetCachePath(key);
+	if (!WriteCacheFile(path.c_str(), CacheMagic, CacheVersion, key,
+	        { std::as_bytes(std::span(data, view.dataSize())), std::as_bytes(std::span(&numLists, 1)) }))
+		return;
+	uintmax_t fileSize;
+	if (GetFileSize(path.c_str(), &fileSize))
+		CacheSize += fileSize;
+}
+
+} // namespace
+
+void SetClxCacheDir(std::string_view dir, uintmax_t maxSize)
+{
+	const std::lock_guard<SdlMutex> lock(CacheSizeMutex);
+	CacheDir = dir;
+	CacheMaxSize = maxSize;
+	CacheSize = 0;
+	if (!CacheDir.empty())
+		PruneCache(CacheMaxSize);
+}
+
+OwnedClxSpriteListOrSheet ConvertToClxCached(ClxSourceFormat format, const uint8_t *data, size_t size,
+    PointerOrValue<uint16_t> widthOrWidths, tl::function_ref<OwnedClxSpriteListOrSheet()> convert)
+{
+	if (CacheDir.empty() || widthOrWidths.HoldsPointer())
+		return convert();
+
+	const uint64_t key = GetCacheKey(format, data, size, widthOrWidths.AsValue());
+	if (std::optional<OwnedClxSpriteListOrSheet> cached = LoadCachedClx(key); cached.has_value())
+		return *std::move(cached);
+
+	OwnedClxSpriteListOrSheet clx = convert();
+	StoreCachedClx(key, clx);
+	return clx;
+}
+
+} // namespace devilution
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <function_ref.hpp>
+
+#include "engine/clx_sprite.hpp"
+#include "utils/pointer_value_union.hpp"
+
+namespace devilution {
+
+enum class ClxSourceFormat : uint8_t {
+	Cel,
+	Cl2,
+};
+
+/** The default for the most space the cached sprites may take up, small enough for handhelds with little storage. */
+constexpr uintmax_t DefaultClxCacheMaxSize = 64 * 1024 * 1024;
+
+/**
+ * @brief Sets the directory that converted sprites are cached in. The cache is disabled until this is called.
+ *
+ * Once the files in the directory take up more than `maxSize`, the least recently written ones are removed.
+ */
+void SetClxCacheDir(std::string_view dir, uintmax_t maxSize = DefaultClxCacheMaxSize);
+
+/**
+ * @brief Converts CEL or CL2 data to CLX with `convert`, or loads the result of an earlier conversion of the same data.
+ *
+ * Cached results are keyed by a hash of the source data and the frame width, so modified files are converted again.
+ * Sprites with per-frame widths are always converted, as the number of widths isn't known up front.
+ * Cached results whose layout doesn't match their number of lists are converted again.
+ */
+OwnedClxSpriteListOrSheet ConvertToClxCached(ClxSourceFormat format, const uint8_t *data, size_t size,
+    PointerOrValue<uint16_t> widthOrWidths, tl::function_ref<OwnedClxSpriteListOrSheet()> convert);
+
+} // namespace devilution
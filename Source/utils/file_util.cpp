@@ -2,9 +2,12 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <limits>
+#include <string>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_iostream.h>
@@ -263,6 +266,49 @@ bool GetFileSize(const char *path, std::uintmax_t *size)
 #endif
 }
 
+bool GetFileModificationTime(const char *path, std::int64_t *time)
+{
+#ifdef _WIN32
+	FILETIME lastWriteTime;
+#if defined(WINVER) && WINVER <= 0x0500 && (!defined(_WIN32_WINNT) || _WIN32_WINNT == 0)
+	HANDLE handle = ::CreateFileA(path, GENERIC_READ,
+	    FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+	    FILE_ATTRIBUTE_NORMAL, NULL);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	const bool success = ::GetFileTime(handle, NULL, NULL, &lastWriteTime);
+	::CloseHandle(handle);
+	if (!success)
+		return false;
+#else
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+#ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+#else
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!GetFileAttributesExW(&pathUtf16[0], GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+#endif
+	lastWriteTime = attr.ftLastWriteTime;
+#endif
+	*time = static_cast<std::int64_t>((static_cast<std::uint64_t>(lastWriteTime.dwHighDateTime) << 32) | lastWriteTime.dwLowDateTime);
+	return true;
+#else
+	struct ::stat statResult;
+	if (::stat(path, &statResult) == -1)
+		return false;
+	*time = static_cast<std::int64_t>(statResult.st_mtime);
+	return true;
+#endif
+}
+
 bool CreateDir(const char *path)
 {
 #ifdef DVL_HAS_FILESYSTEM
@@ -395,6 +441,8 @@ void RenameFile(const char *from, const char *to)
 {
 #ifdef _WIN32
 #ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	// MoveFileEx isn't available on Windows 9x
+	::DeleteFile(to);
 	::MoveFile(from, to);
 #else
 	const auto fromUtf16 = ToWideChar(from);
@@ -403,7 +451,7 @@ void RenameFile(const char *from, const char *to)
 		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
 		return;
 	}
-	::MoveFileW(&fromUtf16[0], &toUtf16[0]);
+	::MoveFileExW(&fromUtf16[0], &toUtf16[0], MOVEFILE_REPLACE_EXISTING);
 #endif // _WIN32
 #elif defined(DVL_HAS_FILESYSTEM)
 	std::error_code ec;
@@ -506,6 +554,71 @@ FILE *OpenFile(const char *path, const char *mode)
 #endif
 }
 
+namespace {
+
+struct CacheFileHeader {
+	char magic[4];
+	uint32_t version;
+	uint64_t key;
+	uint64_t size;
+};
+
+} // namespace
+
+bool WriteCacheFile(const char *path, const char (&magic)[4], uint32_t version, uint64_t key, std::initializer_list<std::span<const std::byte>> data)
+{
+	RecursivelyCreateDir(std::string(Dirname(path)).c_str());
+
+	const std::string tmpPath = std::string(path) + ".tmp";
+	FILE *file = OpenFile(tmpPath.c_str(), "wb");
+	if (file == nullptr)
+		return false;
+
+	CacheFileHeader header {};
+	std::memcpy(header.magic, magic, sizeof(header.magic));
+	header.version = version;
+	header.key = key;
+	for (const std::span<const std::byte> part : data) {
+		header.size += part.size();
+	}
+	bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	for (const std::span<const std::byte> part : data) {
+		written = written && (part.empty() || std::fwrite(part.data(), part.size(), 1, file) == 1);
+	}
+	written = std::fclose(file) == 0 && written;
+
+	if (!written) {
+		RemoveFile(tmpPath.c_str());
+		return false;
+	}
+	RenameFile(tmpPath.c_str(), path);
+	return true;
+}
+
+bool ReadCacheFile(const char *path, const char (&magic)[4], uint32_t version, uint64_t key, tl::function_ref<std::byte *(size_t size)> getBuffer)
+{
+	std::uintmax_t fileSize;
+	if (!GetFileSize(path, &fileSize) || fileSize < sizeof(CacheFileHeader))
+		return false;
+	FILE *file = OpenFile(path, "rb");
+	if (file == nullptr)
+		return false;
+
+	CacheFileHeader header;
+	bool loaded = std::fread(&header, sizeof(header), 1, file) == 1
+	    && std::memcmp(header.magic, magic, sizeof(header.magic)) == 0
+	    && header.version == version
+	    && header.key == key
+	    && header.size == fileSize - sizeof(header)
+	    && header.size <= std::numeric_limits<size_t>::max();
+	if (loaded) {
+		std::byte *buffer = getBuffer(static_cast<size_t>(header.size));
+		loaded = buffer != nullptr && (header.size == 0 || std::fread(buffer, static_cast<size_t>(header.size), 1, file) == 1);
+	}
+	std::fclose(file);
+	return loaded;
+}
+
 std::vector<std::string> ListDirectories(const char *path)
 {
 	std::vector<std::string> dirs;
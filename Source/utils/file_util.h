@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <initializer_list>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <function_ref.hpp>
+
 namespace devilution {
 
 #if defined(_WIN32) || defined(__DJGPP__)
@@ -29,6 +34,12 @@ std::string_view Dirname(std::string_view path);
 bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 
+/**
+ * @brief Gets the time the file was last written to, in platform-specific units that are only meaningful for comparing
+ * files with each other.
+ */
+bool GetFileModificationTime(const char *path, std::int64_t *time);
+
 /**
  * @brief Creates a single directory (non-recursively).
  *
@@ -38,11 +49,33 @@ bool CreateDir(const char *path);
 
 void RecursivelyCreateDir(const char *path);
 bool ResizeFile(const char *path, std::uintmax_t size);
+/** Renames a file, replacing `to` if it exists. */
 void RenameFile(const char *from, const char *to);
 void CopyFileOverwrite(const char *from, const char *to);
 void RemoveFile(const char *path);
 FILE *OpenFile(const char *path, const char *mode);
 
+/**
+ * @brief Replaces a cache file with a header and the given data, creating its directory if needed.
+ *
+ * The header holds the magic, the version of the format, the key the data is valid for and the size of the data.
+ * The file is written under a temporary name and renamed over the old one, so that an interrupted write can't leave
+ * a truncated file with a valid header.
+ *
+ * @param data Parts of the data, written one after the other.
+ * @return False if the file couldn't be written, in which case nothing is left behind.
+ */
+bool WriteCacheFile(const char *path, const char (&magic)[4], uint32_t version, uint64_t key, std::initializer_list<std::span<const std::byte>> data);
+
+/**
+ * @brief Reads the data of a cache file written by WriteCacheFile.
+ *
+ * @param getBuffer Called with the size of the data once the header matches and the size matches the file length.
+ *                  Returns where to read the data to, or nullptr to reject the file.
+ * @return False if the file is missing, doesn't match or can't be read.
+ */
+bool ReadCacheFile(const char *path, const char (&magic)[4], uint32_t version, uint64_t key, tl::function_ref<std::byte *(size_t size)> getBuffer);
+
 #if defined(_WIN32) && !defined(DEVILUTIONX_WINDOWS_NO_WCHAR)
 std::unique_ptr<wchar_t[]> ToWideChar(std::string_view path);
 #endif
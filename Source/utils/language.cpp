@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <vector>
 
@@ -16,7 +17,6 @@
 #endif
 #endif
 
-#include <ankerl/unordered_dense.h>
 #include <function_ref.hpp>
 
 #include "engine/assets.hpp"
@@ -26,7 +26,7 @@
 #include "utils/file_util.h"
 #include "utils/log.hpp"
 #include "utils/paths.h"
-#include "utils/string_view_hash.hpp"
+#include "utils/translation_catalog.hpp"
 
 #define MO_MAGIC 0x950412de
 
@@ -41,26 +41,7 @@ using namespace devilution;
 // and what translators use to test their work.
 constexpr std::array<const char *, 2> Extensions { ".mo", ".gmo" };
 
-std::unique_ptr<char[]> translationKeys;
-std::unique_ptr<char[]> translationValues;
-
-using TranslationRef = uint32_t;
-
-std::vector<ankerl::unordered_dense::map<const char *, TranslationRef, StringViewHash, StringViewEquals>> translation = { {}, {} };
-
-constexpr uint32_t TranslationRefOffsetBits = 19;
-constexpr uint32_t TranslationRefSizeBits = 32 - TranslationRefOffsetBits; // 13
-constexpr uint32_t TranslationRefSizeMask = (1 << TranslationRefSizeBits) - 1;
-
-TranslationRef EncodeTranslationRef(uint32_t offset, uint32_t size)
-{
-	return (offset << TranslationRefSizeBits) | size;
-}
-
-std::string_view GetTranslation(TranslationRef ref)
-{
-	return { &translationValues[ref >> TranslationRefSizeBits], ref & TranslationRefSizeMask };
-}
+TranslationCatalog translations;
 
 } // namespace
 
@@ -259,14 +240,6 @@ void ParseMetadata(std::string_view metadata)
 	}
 }
 
-bool ReadEntry(AssetHandle &handle, const MoEntry &e, char *result)
-{
-	if (!handle.seek(e.offset))
-		return false;
-	result[e.length] = '\0';
-	return handle.read(result, e.length);
-}
-
 bool CopyData(void *dst, const std::byte *data, size_t dataSize, size_t offset, size_t length)
 {
 	if (offset + length > dataSize)
@@ -275,55 +248,48 @@ bool CopyData(void *dst, const std::byte *data, size_t dataSize, size_t offset,
 	return true;
 }
 
-bool ReadEntry(const std::byte *data, size_t dataSize, const MoEntry &e, char *result)
+std::optional<std::string_view> GetEntry(const std::byte *data, size_t dataSize, const MoEntry &e)
 {
-	if (!CopyData(result, data, dataSize, e.offset, e.length))
-		return false;
-	result[e.length] = '\0';
-	return true;
+	if (e.offset + e.length > dataSize)
+		return std::nullopt;
+	return std::string_view { reinterpret_cast<const char *>(data + e.offset), e.length };
 }
 
 } // namespace
 
 std::string_view LanguageParticularTranslate(std::string_view context, std::string_view message)
 {
-	constexpr const char Glue = '\004';
-
-	std::string key = std::string(context);
-	key.reserve(key.size() + 1 + message.size());
-	key += Glue;
-	key.append(message);
-
-	auto it = translation[0].find(key.c_str());
-	if (it == translation[0].end()) {
+	const uint32_t slot = translations.findParticular(context, message);
+	if (slot == TranslationCatalog::NotFound) {
 		return message;
 	}
 
-	return GetTranslation(it->second);
+	return *translations.translation(slot, 0);
 }
 
 std::string_view LanguagePluralTranslate(const char *singular, std::string_view plural, int count)
 {
-	const int n = GetLocalPluralId(count);
-
-	auto it = translation[n].find(singular);
-	if (it == translation[n].end()) {
+	const uint32_t slot = translations.find(singular);
+	const std::optional<std::string_view> translation = slot != TranslationCatalog::NotFound
+	    ? translations.translation(slot, static_cast<unsigned>(GetLocalPluralId(count)))
+	    : std::nullopt;
+	if (!translation) {
 		if (count != 1)
 			return plural;
 		return singular;
 	}
 
-	return GetTranslation(it->second);
+	return *translation;
 }
 
 std::string_view LanguageTranslate(const char *key)
 {
-	auto it = translation[0].find(key);
-	if (it == translation[0].end()) {
+	const uint32_t slot = translations.find(key);
+	if (slot == TranslationCatalog::NotFound) {
 		return key;
 	}
 
-	return GetTranslation(it->second);
+	return *translations.translation(slot, 0);
 }
 
 bool HasTranslation(const std::string &locale)
@@ -348,9 +314,7 @@ std::string_view GetLanguageCode()
 
 void LanguageInitialize()
 {
-	translation = { {}, {} };
-	translationKeys = nullptr;
-	translationValues = nullptr;
+	translations = {};
 
 	const std::string lang(GetLanguageCode());
 
@@ -391,33 +355,15 @@ void LanguageInitialize()
 		return;
 	}
 
-#ifdef UNPACKED_MPQS
-	const bool readWholeFile = false;
-#else
-#ifdef USE_SDL3
-	// In SDL3, we don't have a way to check if the handle is to an MPQ file.
-	// Assume that it is.
-	const bool readWholeFile = true;
-#else
-	// If reading from an MPQ, it is much faster to
-	// load the whole file instead of seeking.
-	const bool readWholeFile = handle.handle->type == SDL_RWOPS_UNKNOWN;
-#endif
-#endif
-
-	std::unique_ptr<std::byte[]> data;
-	if (readWholeFile) {
-		data.reset(new std::byte[fileSize]);
-		if (!handle.read(data.get(), fileSize))
-			return;
-		handle = {};
-	}
+	// Every string ends up in the catalog, so read them all at once rather than seeking to each of them.
+	const std::unique_ptr<std::byte[]> data { new std::byte[fileSize] };
+	if (!handle.read(data.get(), fileSize))
+		return;
+	handle = {};
 
 	// Read header and do sanity checks
 	MoHead head;
-	if (readWholeFile
-	        ? !CopyData(&head, data.get(), fileSize, 0, sizeof(MoHead))
-	        : !handle.read(&head, sizeof(MoHead))) {
+	if (!CopyData(&head, data.get(), fileSize, 0, sizeof(MoHead))) {
 		return;
 	}
 	SwapLE(head);
@@ -432,9 +378,7 @@ void LanguageInitialize()
 
 	// Read entries of source strings
 	const std::unique_ptr<MoEntry[]> src { new MoEntry[head.nbMappings] };
-	if (readWholeFile
-	        ? !CopyData(src.get(), data.get(), fileSize, head.srcOffset, head.nbMappings * sizeof(MoEntry))
-	        : !handle.seek(head.srcOffset) || !handle.read(src.get(), head.nbMappings * sizeof(MoEntry))) {
+	if (!CopyData(src.get(), data.get(), fileSize, head.srcOffset, head.nbMappings * sizeof(MoEntry))) {
 		return;
 	}
 	for (size_t i = 0; i < head.nbMappings; ++i) {
@@ -443,9 +387,7 @@ void LanguageInitialize()
 
 	// Read entries of target strings
 	const std::unique_ptr<MoEntry[]> dst { new MoEntry[head.nbMappings] };
-	if (readWholeFile
-	        ? !CopyData(dst.get(), data.get(), fileSize, head.dstOffset, head.nbMappings * sizeof(MoEntry))
-	        : !handle.seek(head.dstOffset) || !handle.read(dst.get(), head.nbMappings * sizeof(MoEntry))) {
+	if (!CopyData(dst.get(), data.get(), fileSize, head.dstOffset, head.nbMappings * sizeof(MoEntry))) {
 		return;
 	}
 	for (size_t i = 0; i < head.nbMappings; ++i) {
@@ -453,53 +395,29 @@ void LanguageInitialize()
 	}
 
 	// MO header
-	if (src[0].length != 0) {
+	if (head.nbMappings == 0 || src[0].length != 0) {
 		return;
 	}
 	{
-		auto headerValue = std::unique_ptr<char[]> { new char[dst[0].length + 1] };
-		if (readWholeFile
-		        ? !ReadEntry(data.get(), fileSize, dst[0], &headerValue[0])
-		        : !ReadEntry(handle, dst[0], &headerValue[0])) {
+		const std::optional<std::string_view> headerValue = GetEntry(data.get(), fileSize, dst[0]);
+		if (!headerValue) {
 			return;
 		}
-		ParseMetadata(&headerValue[0]);
-	}
-
-	translation.resize(PluralForms);
-	for (unsigned i = 0; i < PluralForms; i++)
-		translation[i] = {};
-
-	// Read strings described by entries
-	size_t keysSize = 0;
-	size_t valuesSize = 0;
-	for (uint32_t i = 1; i < head.nbMappings; i++) {
-		keysSize += src[i].length + 1;
-		valuesSize += dst[i].length + 1;
+		ParseMetadata(*headerValue);
 	}
-	translationKeys = std::unique_ptr<char[]> { new char[keysSize] };
-	translationValues = std::unique_ptr<char[]> { new char[valuesSize] };
 
-	char *keyPtr = &translationKeys[0];
-	char *valuePtr = &translationValues[0];
-	translation[0].reserve(head.nbMappings - 1);
+	std::vector<TranslationCatalog::Entry> entries;
+	entries.reserve(head.nbMappings - 1);
 	for (uint32_t i = 1; i < head.nbMappings; i++) {
-		if (readWholeFile
-		        ? ReadEntry(data.get(), fileSize, src[i], keyPtr) && ReadEntry(data.get(), fileSize, dst[i], valuePtr)
-		        : ReadEntry(handle, src[i], keyPtr) && ReadEntry(handle, dst[i], valuePtr)) {
-			// Plural keys also have a plural form but it does not participate in lookup.
-			// Plural values are \0-terminated.
-			std::string_view value { valuePtr, dst[i].length + 1 };
-			for (size_t j = 0; j < PluralForms && !value.empty(); j++) {
-				const size_t formValueEnd = value.find('\0');
-				translation[j].emplace(keyPtr, EncodeTranslationRef(static_cast<uint32_t>(value.data() - &translationValues[0]), static_cast<uint32_t>(formValueEnd)));
-				value.remove_prefix(formValueEnd + 1);
-			}
-
-			keyPtr += src[i].length + 1;
-			valuePtr += dst[i].length + 1;
-		}
+		const std::optional<std::string_view> key = GetEntry(data.get(), fileSize, src[i]);
+		const std::optional<std::string_view> value = GetEntry(data.get(), fileSize, dst[i]);
+		if (!key || !value)
+			continue;
+		// Plural keys also have a plural form but it does not participate in lookup.
+		// Plural values are \0-separated.
+		entries.push_back({ key->substr(0, key->find('\0')), *value });
 	}
+	translations = TranslationCatalog::build(entries, PluralForms);
 
 	LogVerbose(StrCat("Loaded translations from ", translationsPath, " in ", SDL_GetTicks() - loadTranslationsStart, "ms"));
 }
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace devilution {
+
+struct LruCacheStats {
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+	/** Number of entries currently held */
+	size_t size;
+};
+
+/**
+ * @brief Maps keys to values, dropping the least recently used entry once it holds `capacity` entries.
+ *
+ * References to values stay valid until that entry is evicted, replaced or the cache is cleared.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+	explicit LruCache(size_t capacity)
+	    : capacity_(capacity)
+	{
+	}
+
+	LruCache(const LruCache &) = delete;
+	LruCache &operator=(const LruCache &) = delete;
+
+	[[nodiscard]] size_t capacity() const { return capacity_; }
+
+	/** @brief Changes the capacity, evicting entries right away if the cache is too large now. 0 disables the cache. */
+	void setCapacity(size_t capacity)
+	{
+		capacity_ = capacity;
+		evictTo(capacity_);
+	}
+
+	[[nodiscard]] size_t size() const { return entries_.size(); }
+
+	/**
+	 * @brief Returns the value for the key and marks it as the most recently used, nullptr if it isn't cached.
+	 */
+	Value *find(const Key &key)
+	{
+		const auto it = index_.find(key);
+		if (it == index_.end()) {
+			misses_++;
+			return nullptr;
+		}
+		hits_++;
+		entries_.splice(entries_.begin(), entries_, it->second);
+		return &it->second->second;
+	}
+
+	/**
+	 * @brief Adds or replaces the value for the key.
+	 *
+	 * @return The cached value, or nullptr if the cache is disabled.
+	 */
+	Value *insert(const Key &key, Value value)
+	{
+		if (capacity_ == 0)
+			return nullptr;
+		const auto it = index_.find(key);
+		if (it != index_.end()) {
+			it->second->second = std::move(value);
+			entries_.splice(entries_.begin(), entries_, it->second);
+			return &it->second->second;
+		}
+		evictTo(capacity_ - 1);
+		entries_.emplace_front(key, std::move(value));
+		index_.emplace(key, entries_.begin());
+		return &entries_.front().second;
+	}
+
+	void clear()
+	{
+		index_.clear();
+		entries_.clear();
+	}
+
+	[[nodiscard]] LruCacheStats stats() const
+	{
+		return { hits_, misses_, evictions_, entries_.size() };
+	}
+
+	void resetStats()
+	{
+		hits_ = 0;
+		misses_ = 0;
+		evictions_ = 0;
+	}
+
+private:
+	void evictTo(size_t size)
+	{
+		while (entries_.size() > size) {
+			index_.erase(entries_.back().first);
+			entries_.pop_back();
+			evictions_++;
+		}
+	}
+
+	size_t capacity_;
+	uint64_t hits_ = 0;
+	uint64_t misses_ = 0;
+	uint64_t evictions_ = 0;
+	/** Most recently used first */
+	std::list<std::pair<Key, Value>> entries_;
+	std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index_;
+};
+
+} // namespace devilution
@@ -0,0 +1,235 @@
+/**
+ * @file utils/lz_codec.cpp
+ *
+ * Implementation of a fast LZ77 block codec.
+ *
+ * The block is a list of sequences. Each sequence starts with a token byte holding the number of literals in the
+ * upper and the match length minus MinMatch in the lower 4 bits, a value of 15 being followed by extra length bytes
+ * that are added up until one is not 255. Then come the literals, the 16-bit little-endian offset of the match and
+ * the extra match length bytes. The last sequence only has literals.
+ */
+#include "utils/lz_codec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace devilution {
+
+namespace {
+
+constexpr size_t MinMatch = 4;
+constexpr size_t MaxOffset = 0xFFFF;
+/** Matches end this far from the end of the input, which keeps the 4-byte reads in bounds. */
+constexpr size_t LastLiterals = 5;
+constexpr unsigned HashBits = 12;
+constexpr uint32_t NoPosition = UINT32_MAX;
+
+uint32_t Read32(const std::byte *src)
+{
+	uint32_t value;
+	std::memcpy(&value, src, sizeof(value));
+	return value;
+}
+
+uint32_t Hash(uint32_t sequence)
+{
+	return (sequence * 2654435761U) >> (32 - HashBits);
+}
+
+/** Writes the extra bytes of a length that didn't fit into its 4 bits of the token. */
+std::byte *WriteLength(std::byte *dst, const std::byte *dstEnd, size_t length)
+{
+	for (; length >= 255; length -= 255) {
+		if (dst == dstEnd)
+			return nullptr;
+		*dst++ = std::byte { 255 };
+	}
+	if (dst == dstEnd)
+		return nullptr;
+	*dst++ = static_cast<std::byte>(length);
+	return dst;
+}
+
+std::byte *WriteSequence(std::byte *dst, const std::byte *dstEnd, const std::byte *literals, size_t literalCount, size_t offset, size_t matchLength)
+{
+	if (dst == dstEnd)
+		return nullptr;
+	std::byte &token = *dst++;
+	const size_t matchCode = matchLength != 0 ? matchLength - MinMatch : 0;
+	token = static_cast<std::byte>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+
+	if (literalCount >= 15 && (dst = WriteLength(dst, dstEnd, literalCount - 15)) == nullptr)
+		return nullptr;
+	if (static_cast<size_t>(dstEnd - dst) < literalCount)
+		return nullptr;
+	std::memcpy(dst, literals, literalCount);
+	dst += literalCount;
+
+	if (matchLength == 0)
+		return dst;
+	if (dstEnd - dst < 2)
+		return nullptr;
+	*dst++ = static_cast<std::byte>(offset & 0xFF);
+	*dst++ = static_cast<std::byte>(offset >> 8);
+	if (matchCode >= 15 && (dst = WriteLength(dst, dstEnd, matchCode - 15)) == nullptr)
+		return nullptr;
+	return dst;
+}
+
+/** Reads the extra bytes of a length, returns false if the input ends before the length does. */
+bool ReadLength(const std::byte *&src, const std::byte *srcEnd, size_t &length)
+{
+	uint8_t value;
+	do {
+		if (src == srcEnd)
+			return false;
+		value = static_cast<uint8_t>(*src++);
+		length += value;
+	} while (value == 255);
+	return true;
+}
+
+} // namespace
+
+size_t LzCompressBlock(const std::byte *src, size_t srcSize, std::byte *dst, size_t dstCapacity)
+{
+	const std::byte *const dstBegin = dst;
+	const std::byte *const dstEnd = dst + dstCapacity;
+
+	std::array<uint32_t, 1U << HashBits> positions;
+	positions.fill(NoPosition);
+
+	size_t anchor = 0;
+	if (srcSize > MinMatch + LastLiterals) {
+		const size_t matchLimit = srcSize - LastLiterals;
+		size_t pos = 0;
+		// Incompressible data is skipped faster the longer no match turns up.
+		unsigned misses = 0;
+		while (pos + MinMatch <= matchLimit) {
+			const uint32_t sequence = Read32(src + pos);
+			uint32_t &slot = positions[Hash(sequence)];
+			const uint32_t candidate = slot;
+			slot = static_cast<uint32_t>(pos);
+			if (candidate == NoPosition || pos - candidate > MaxOffset || Read32(src + candidate) != sequence) {
+				pos += 1 + (misses++ >> 5);
+				continue;
+			}
+			misses = 0;
+
+			size_t matchLength = MinMatch;
+			while (pos + matchLength < matchLimit && src[candidate + matchLength] == src[pos + matchLength])
+				matchLength++;
+
+			dst = WriteSequence(dst, dstEnd, src + anchor, pos - anchor, pos - candidate, matchLength);
+			if (dst == nullptr)
+				return 0;
+			pos += matchLength;
+			anchor = pos;
+		}
+	}
+
+	dst = WriteSequence(dst, dstEnd, src + anchor, srcSize - anchor, 0, 0);
+	if (dst == nullptr)
+		return 0;
+	return static_cast<size_t>(dst - dstBegin);
+}
+
+size_t LzDecompressBlock(const std::byte *src, size_t srcSize, std::byte *dst, size_t dstCapacity)
+{
+	const std::byte *const srcEnd = src + srcSize;
+	const std::byte *const dstBegin = dst;
+	const std::byte *const dstEnd = dst + dstCapacity;
+
+	while (src != srcEnd) {
+		const auto token = static_cast<uint8_t>(*src++);
+
+		size_t literalCount = token >> 4;
+		if (literalCount == 15 && !ReadLength(src, srcEnd, literalCount))
+			return 0;
+		if (static_cast<size_t>(srcEnd - src) < literalCount || static_cast<size_t>(dstEnd - dst) < literalCount)
+			return 0;
+		std::memcpy(dst, src, literalCount);
+		src += literalCount;
+		dst += literalCount;
+
+		if (src == srcEnd)
+			break; // The last sequence has no match
+
+		if (srcEnd - src < 2)
+			return 0;
+		const size_t offset = static_cast<uint8_t>(src[0]) | (static_cast<uint8_t>(src[1]) << 8);
+		src += 2;
+		size_t matchLength = token & 0xF;
+		if (matchLength == 15 && !ReadLength(src, srcEnd, matchLength))
+			return 0;
+		matchLength += MinMatch;
+		if (offset == 0 || offset > static_cast<size_t>(dst - dstBegin) || static_cast<size_t>(dstEnd - dst) < matchLength)
+			return 0;
+
+		const std::byte *match = dst - offset;
+		if (offset >= matchLength) {
+			std::memcpy(dst, match, matchLength);
+			dst += matchLength;
+		} else {
+			// Overlapping matches repeat the last `offset` bytes.
+			for (size_t i = 0; i < matchLength; i++)
+				*dst++ = *match++;
+		}
+	}
+
+	// An empty block is valid, but a decompressed size of 0 means failure to the callers.
+	return static_cast<size_t>(dst - dstBegin);
+}
+
+uint32_t LzCompress(std::byte *srcData, uint32_t size)
+{
+	// Stack buffer covers typical network messages, falls back to the heap for larger payloads.
+	constexpr size_t StackBufSize = 8192;
+	std::byte stackBuf[StackBufSize];
+
+	// Only a result smaller than the input is useful.
+	const size_t dstCap = size;
+	std::byte *dst;
+	std::unique_ptr<std::byte[]> heapBuf;
+	if (dstCap <= StackBufSize) {
+		dst = stackBuf;
+	} else {
+		heapBuf = std::make_unique<std::byte[]>(dstCap);
+		dst = heapBuf.get();
+	}
+
+	const size_t dstSize = LzCompressBlock(srcData, size, dst, dstCap);
+	if (dstSize == 0 || dstSize >= size)
+		return size;
+
+	std::memcpy(srcData, dst, dstSize);
+	return static_cast<uint32_t>(dstSize);
+}
+
+uint32_t LzDecompress(std::byte *inBuff, uint32_t recvSize, size_t maxBytes)
+{
+	constexpr size_t StackBufSize = 8192;
+	std::byte stackBuf[StackBufSize];
+
+	std::byte *out;
+	std::unique_ptr<std::byte[]> heapBuf;
+	if (maxBytes <= StackBufSize) {
+		out = stackBuf;
+	} else {
+		heapBuf = std::make_unique<std::byte[]>(maxBytes);
+		out = heapBuf.get();
+	}
+
+	const size_t outSize = LzDecompressBlock(inBuff, recvSize, out, maxBytes);
+	if (outSize == 0)
+		return 0;
+
+	std::memcpy(inBuff, out, outSize);
+	return static_cast<uint32_t>(outSize);
+}
+
+} // namespace devilution
@@ -0,0 +1,45 @@
+/**
+ * @file utils/lz_codec.hpp
+ *
+ * Interface of a fast LZ77 block codec, used instead of PKWARE where both sides support it.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Returns the size of the largest block LzCompressBlock can produce for `size` bytes of input.
+ */
+constexpr size_t LzCompressBound(size_t size)
+{
+	return size + (size / 255) + 16;
+}
+
+/**
+ * @brief Compresses a block of data.
+ * @return Compressed size, or 0 if the result doesn't fit into `dstCapacity` bytes.
+ */
+size_t LzCompressBlock(const std::byte *src, size_t srcSize, std::byte *dst, size_t dstCapacity);
+
+/**
+ * @brief Decompresses a block produced by LzCompressBlock.
+ * @return Decompressed size, or 0 if the block is malformed or doesn't fit into `dstCapacity` bytes.
+ */
+size_t LzDecompressBlock(const std::byte *src, size_t srcSize, std::byte *dst, size_t dstCapacity);
+
+/**
+ * @brief Compresses the buffer in place, like PkwareCompress.
+ * @return Compressed size, or `size` if compressing didn't make the data any smaller.
+ */
+uint32_t LzCompress(std::byte *srcData, uint32_t size);
+
+/**
+ * @brief Decompresses the buffer in place, like PkwareDecompress.
+ * @return Decompressed size, or 0 on failure.
+ */
+uint32_t LzDecompress(std::byte *inBuff, uint32_t recvSize, size_t maxBytes);
+
+} // namespace devilution
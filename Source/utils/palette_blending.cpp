@@ -1,7 +1,11 @@
 #include "utils/palette_blending.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_pixels.h>
@@ -9,6 +13,8 @@
 #include <SDL.h>
 #endif
 
+#include "engine/render/render_workers.hpp"
+#include "utils/file_util.h"
 #include "utils/palette_kd_tree.hpp"
 
 namespace devilution {
@@ -26,6 +32,17 @@ namespace {
 
 PaletteKdTree CurrentPaletteKdTree;
 
+/** Directory of the cached tables, empty if disabled. */
+std::string CacheDir;
+
+constexpr char CacheMagic[4] = { 'D', 'X', 'B', 'L' };
+
+/** Bump whenever a change to the blending or the color matching changes the tables. */
+constexpr uint32_t CacheVersion = 2;
+
+/** Row i only blends color i with the colors after it, so every job takes every BlendJobs-th row to even out the work. */
+constexpr size_t BlendJobs = 16;
+
 using RGB = std::array<uint8_t, 3>;
 
 RGB BlendColors(const SDL_Color &a, const SDL_Color &b)
@@ -44,21 +61,79 @@ void SetPaletteTransparencyLookupBlack16(unsigned i, unsigned j)
 }
 #endif
 
+/** 64-bit FNV-1a */
+uint64_t Hash(uint64_t hash, const void *data, size_t size)
+{
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= static_cast<const uint8_t *>(data)[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+uint64_t GetCacheKey(const SDL_Color *palette, int skipFrom, int skipTo)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (unsigned i = 0; i < 256; i++) {
+		const uint8_t rgb[3] = { palette[i].r, palette[i].g, palette[i].b };
+		hash = Hash(hash, rgb, sizeof(rgb));
+	}
+	const int32_t skipRange[2] = { skipFrom, skipTo };
+	return Hash(hash, skipRange, sizeof(skipRange));
+}
+
+std::string GetCachePath(uint64_t key)
+{
+	std::string path = CacheDir;
+	for (int shift = 60; shift >= 0; shift -= 4) {
+		path += "0123456789abcdef"[(key >> shift) & 0xF];
+	}
+	path += ".bin";
+	return path;
+}
+
+bool LoadCachedLookupTable(uint64_t key)
+{
+	if (CacheDir.empty())
+		return false;
+	return ReadCacheFile(GetCachePath(key).c_str(), CacheMagic, CacheVersion, key, [](size_t size) -> std::byte * {
+		return size == sizeof(paletteTransparencyLookup) ? reinterpret_cast<std::byte *>(paletteTransparencyLookup) : nullptr;
+	});
+}
+
+void StoreCachedLookupTable(uint64_t key)
+{
+	if (CacheDir.empty())
+		return;
+	WriteCacheFile(GetCachePath(key).c_str(), CacheMagic, CacheVersion, key,
+	    { std::as_bytes(std::span(&paletteTransparencyLookup[0][0], sizeof(paletteTransparencyLookup))) });
+}
+
+void BlendRows(const SDL_Color *palette, size_t job)
+{
+	for (size_t i = job; i < 256; i += BlendJobs) {
+		for (size_t j = i + 1; j < 256; j++) {
+			paletteTransparencyLookup[i][j] = CurrentPaletteKdTree.findNearestNeighbor(BlendColors(palette[i], palette[j]));
+		}
+	}
+}
+
 } // namespace
 
 void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom, int skipTo)
 {
 	CurrentPaletteKdTree = PaletteKdTree { palette, skipFrom, skipTo };
-	for (unsigned i = 0; i < 256; i++) {
-		paletteTransparencyLookup[i][i] = i;
-		unsigned j = 0;
-		for (; j < i; j++) {
-			paletteTransparencyLookup[i][j] = paletteTransparencyLookup[j][i];
-		}
-		++j;
-		for (; j < 256; j++) {
-			paletteTransparencyLookup[i][j] = CurrentPaletteKdTree.findNearestNeighbor(BlendColors(palette[i], palette[j]));
+
+	const uint64_t cacheKey = GetCacheKey(palette, skipFrom, skipTo);
+	if (!LoadCachedLookupTable(cacheKey)) {
+		ParallelRender(BlendJobs, [palette](size_t job) { BlendRows(palette, job); });
+		for (unsigned i = 0; i < 256; i++) {
+			paletteTransparencyLookup[i][i] = i;
+			for (unsigned j = 0; j < i; j++) {
+				paletteTransparencyLookup[i][j] = paletteTransparencyLookup[j][i];
+			}
 		}
+		StoreCachedLookupTable(cacheKey);
 	}
 
 #if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
@@ -72,6 +147,11 @@ void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom, int skip
 #endif
 }
 
+void SetBlendedLookupTableCacheDir(std::string_view dir)
+{
+	CacheDir = dir;
+}
+
 void UpdateBlendedLookupTableSingleColor(const SDL_Color *palette, unsigned i)
 {
 	for (unsigned j = 0; j < 256; j++) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_pixels.h>
@@ -23,11 +24,19 @@ extern uint8_t paletteTransparencyLookup[256][256];
  * To mimic 50% transparency we figure out what colors in the existing palette are the best match for the combination of any 2 colors.
  * We save this into a lookup table for use during rendering.
  *
+ * The rows of the table are spread over the render worker threads. If a cache directory is set, a table that was
+ * generated for the same palette before is loaded from there instead.
+ *
  * @param skipFrom Do not use colors between this index and skipTo
  * @param skipTo Do not use colors between skipFrom and this index
  */
 void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom = -1, int skipTo = -1);
 
+/**
+ * @brief Sets the directory where GenerateBlendedLookupTable keeps finished tables, an empty path disables the cache.
+ */
+void SetBlendedLookupTableCacheDir(std::string_view dir);
+
 /**
  * @brief Updates the transparency lookup table for a single color.
  */
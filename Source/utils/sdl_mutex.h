@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #ifdef USE_SDL3
@@ -102,4 +103,72 @@ private:
 };
 #endif
 
+/*
+ * RAII wrapper for SDL_sem.
+ */
+#if defined(__DJGPP__) || defined(__EMSCRIPTEN__)
+class SdlSemaphore final {
+public:
+	explicit SdlSemaphore(uint32_t /*initialValue*/ = 0) noexcept { }
+	~SdlSemaphore() noexcept { }
+
+	SdlSemaphore(const SdlSemaphore &) = delete;
+	SdlSemaphore(SdlSemaphore &&) = delete;
+	SdlSemaphore &operator=(const SdlSemaphore &) = delete;
+	SdlSemaphore &operator=(SdlSemaphore &&) = delete;
+
+	void wait() noexcept { }
+	void post() noexcept { }
+};
+#else
+class SdlSemaphore final {
+public:
+	explicit SdlSemaphore(uint32_t initialValue = 0)
+	    : semaphore_(SDL_CreateSemaphore(initialValue))
+	{
+		if (semaphore_ == nullptr)
+			ErrSdl();
+	}
+
+	~SdlSemaphore()
+	{
+		SDL_DestroySemaphore(semaphore_);
+	}
+
+	SdlSemaphore(const SdlSemaphore &) = delete;
+	SdlSemaphore(SdlSemaphore &&) = delete;
+	SdlSemaphore &operator=(const SdlSemaphore &) = delete;
+	SdlSemaphore &operator=(SdlSemaphore &&) = delete;
+
+	/** @brief Blocks until the semaphore value is positive, then decrements it. */
+	void wait() noexcept
+	{
+#ifdef USE_SDL3
+		SDL_WaitSemaphore(semaphore_);
+#else
+		int err = SDL_SemWait(semaphore_);
+		if (err == -1) ErrSdl();
+#endif
+	}
+
+	/** @brief Increments the semaphore value, waking up one waiting thread. */
+	void post() noexcept
+	{
+#ifdef USE_SDL3
+		SDL_SignalSemaphore(semaphore_);
+#else
+		int err = SDL_SemPost(semaphore_);
+		if (err == -1) ErrSdl();
+#endif
+	}
+
+private:
+#ifdef USE_SDL3
+	SDL_Semaphore *semaphore_;
+#else
+	SDL_sem *semaphore_;
+#endif
+};
+#endif
+
 } // namespace devilution
@@ -31,6 +31,7 @@
 #include "utils/log.hpp"
 #include "utils/math.h"
 #include "utils/stubs.h"
+#include "utils/trace.hpp"
 
 namespace devilution {
 
@@ -320,6 +321,7 @@ bool SoundSample::Play(int numIterations)
 
 int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors)
 {
+	const TraceZone traceZone("SoundSample::SetChunkStream");
 #ifdef USE_SDL3
 	SDL_IOStream *handle = OpenAssetAsSdlRwOps(filePath.c_str(), /*threadsafe=*/true);
 	if (handle == nullptr) {
@@ -363,6 +365,7 @@ int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors
 
 int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3)
 {
+	const TraceZone traceZone("SoundSample::SetChunk");
 #ifdef USE_SDL3
 	isMp3_ = isMp3;
 	file_data_ = std::move(fileData);
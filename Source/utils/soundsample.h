@@ -63,6 +63,14 @@ public:
 		return file_data_ == nullptr;
 	}
 
+	/**
+	 * @return Size of the audio data held in memory, 0 for streaming audio
+	 */
+	[[nodiscard]] std::size_t GetDataSize() const
+	{
+		return file_data_size_;
+	}
+
 	int DuplicateFrom(const SoundSample &other)
 	{
 		if (other.IsStreaming())
@@ -70,6 +78,18 @@ public:
 		return SetChunk(other.file_data_, other.file_data_size_, other.isMp3_);
 	}
 
+	/**
+	 * @brief Whether this sample is loaded with the same audio as `other`, e.g. because it was duplicated from it.
+	 */
+	[[nodiscard]] bool PlaysSameAudioAs(const SoundSample &other) const
+	{
+		if (!IsLoaded() || IsStreaming() != other.IsStreaming())
+			return false;
+		if (IsStreaming())
+			return file_path_ == other.file_path_;
+		return file_data_ == other.file_data_;
+	}
+
 	/**
 	 * @brief Start playing the sound for a given number of iterations (0 means loop).
 	 */
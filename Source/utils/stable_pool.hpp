@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief Refers to an element of a StablePool, or to nothing once that element was removed.
+ */
+struct StablePoolHandle {
+	static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	uint32_t index = InvalidIndex;
+	uint32_t generation = 0;
+
+	[[nodiscard]] bool isValid() const { return index != InvalidIndex; }
+
+	bool operator==(const StablePoolHandle &other) const = default;
+};
+
+/**
+ * @brief A list-like container that keeps its elements in reused, fixed-size chunks.
+ *
+ * Behaves like a std::list that is only appended to and filtered with remove_if(): elements never move, iteration is
+ * in insertion order and elements added while iterating are visited by the same loop. Removed slots are reused, so
+ * once the pool has grown to its peak size adding elements doesn't allocate.
+ *
+ * @tparam T element type.
+ * @tparam ChunkSize number of elements allocated at once.
+ */
+template <class T, size_t ChunkSize = 256>
+class StablePool {
+	struct Slot {
+		alignas(alignof(T)) std::byte data[sizeof(T)];
+		/** Incremented whenever the slot is freed, so that handles to the removed element no longer match. */
+		uint32_t generation = 0;
+		bool inUse = false;
+
+		[[nodiscard]] const T *ptr() const { return std::launder(reinterpret_cast<const T *>(data)); }
+		[[nodiscard]] T *ptr() { return std::launder(reinterpret_cast<T *>(data)); }
+	};
+
+	template <class Pool, class Value>
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value *;
+		using reference = Value &;
+
+		Iterator() = default;
+
+		Iterator(Pool *pool, size_t pos)
+		    : pool_(pool)
+		    , pos_(pos)
+		{
+		}
+
+		reference operator*() const { return pool_->at(pool_->order_[pos_]); }
+		pointer operator->() const { return &**this; }
+
+		Iterator &operator++()
+		{
+			++pos_;
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator copy = *this;
+			++pos_;
+			return copy;
+		}
+
+		bool operator==(const Iterator &other) const { return position() == other.position(); }
+		bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+	private:
+		/** The end iterator follows the size of the pool, so that range-for loops also visit elements added on the way. */
+		[[nodiscard]] size_t position() const { return pos_ == End ? pool_->order_.size() : pos_; }
+
+		static constexpr size_t End = std::numeric_limits<size_t>::max();
+		friend class StablePool;
+
+		Pool *pool_ = nullptr;
+		size_t pos_ = 0;
+	};
+
+public:
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using iterator = Iterator<StablePool, T>;
+	using const_iterator = Iterator<const StablePool, const T>;
+
+	StablePool() = default;
+	StablePool(const StablePool &) = delete;
+	StablePool &operator=(const StablePool &) = delete;
+
+	~StablePool()
+	{
+		clear();
+	}
+
+	[[nodiscard]] iterator begin() { return iterator(this, 0); }
+	[[nodiscard]] const_iterator begin() const { return const_iterator(this, 0); }
+	[[nodiscard]] const_iterator cbegin() const { return begin(); }
+
+	[[nodiscard]] iterator end() { return iterator(this, iterator::End); }
+	[[nodiscard]] const_iterator end() const { return const_iterator(this, const_iterator::End); }
+	[[nodiscard]] const_iterator cend() const { return end(); }
+
+	[[nodiscard]] size_t size() const { return order_.size(); }
+	[[nodiscard]] bool empty() const { return order_.empty(); }
+	[[nodiscard]] size_t max_size() const { return StablePoolHandle::InvalidIndex; } // NOLINT(readability-identifier-naming)
+
+	[[nodiscard]] T &back() { return at(order_.back()); }
+	[[nodiscard]] const T &back() const { return at(order_.back()); }
+
+	template <typename... Args>
+	void push_back(Args &&...args) // NOLINT(readability-identifier-naming)
+	{
+		emplace_back(std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	T &emplace_back(Args &&...args) // NOLINT(readability-identifier-naming)
+	{
+		uint32_t index;
+		if (!free_.empty()) {
+			index = free_.back();
+			free_.pop_back();
+		} else {
+			index = static_cast<uint32_t>(chunks_.size() * ChunkSize);
+			chunks_.push_back(std::make_unique<Slot[]>(ChunkSize));
+			// Hand out the new slots from the front, so that elements added in a row sit next to each other.
+			for (uint32_t i = ChunkSize - 1; i > 0; i--)
+				free_.push_back(index + i);
+		}
+		Slot &newSlot = slot(index);
+		T *element = ::new (newSlot.data) T(std::forward<Args>(args)...);
+		newSlot.inUse = true;
+		order_.push_back(index);
+		return *element;
+	}
+
+	/**
+	 * @brief Removes all elements that match the predicate, keeping the order of the others.
+	 *
+	 * Must not be called while iterating over the pool.
+	 */
+	template <typename Predicate>
+	size_t remove_if(Predicate &&pred) // NOLINT(readability-identifier-naming)
+	{
+		const size_t oldSize = order_.size();
+		const auto newEnd = std::remove_if(order_.begin(), order_.end(), [this, &pred](uint32_t index) {
+			if (!pred(at(index)))
+				return false;
+			release(index);
+			return true;
+		});
+		order_.erase(newEnd, order_.end());
+		return oldSize - order_.size();
+	}
+
+	/**
+	 * @brief Removes all elements, keeping the memory for the next ones.
+	 */
+	void clear()
+	{
+		for (const uint32_t index : order_)
+			release(index);
+		order_.clear();
+	}
+
+	/**
+	 * @brief Returns a handle to an element of this pool.
+	 */
+	[[nodiscard]] StablePoolHandle handleOf(const T &element) const
+	{
+		for (size_t chunk = 0; chunk < chunks_.size(); chunk++) {
+			const Slot *first = chunks_[chunk].get();
+			const Slot *elementSlot = reinterpret_cast<const Slot *>(reinterpret_cast<const std::byte *>(&element) - offsetof(Slot, data));
+			if (elementSlot >= first && elementSlot < first + ChunkSize) {
+				const auto index = static_cast<uint32_t>((chunk * ChunkSize) + (elementSlot - first));
+				return { index, elementSlot->generation };
+			}
+		}
+		assert(false && "element is not part of this pool");
+		return {};
+	}
+
+	/**
+	 * @brief Returns the element the handle refers to, or nullptr if it has been removed since.
+	 */
+	[[nodiscard]] T *get(StablePoolHandle handle)
+	{
+		return const_cast<T *>(std::as_const(*this).get(handle));
+	}
+
+	[[nodiscard]] const T *get(StablePoolHandle handle) const
+	{
+		if (!handle.isValid() || handle.index >= chunks_.size() * ChunkSize)
+			return nullptr;
+		const Slot &handleSlot = slot(handle.index);
+		if (!handleSlot.inUse || handleSlot.generation != handle.generation)
+			return nullptr;
+		return handleSlot.ptr();
+	}
+
+private:
+	[[nodiscard]] Slot &slot(uint32_t index) { return chunks_[index / ChunkSize][index % ChunkSize]; }
+	[[nodiscard]] const Slot &slot(uint32_t index) const { return chunks_[index / ChunkSize][index % ChunkSize]; }
+
+	[[nodiscard]] T &at(uint32_t index) { return *slot(index).ptr(); }
+	[[nodiscard]] const T &at(uint32_t index) const { return *slot(index).ptr(); }
+
+	void release(uint32_t index)
+	{
+		Slot &releasedSlot = slot(index);
+		std::destroy_at(releasedSlot.ptr());
+		releasedSlot.generation++;
+		releasedSlot.inUse = false;
+		free_.push_back(index);
+	}
+
+	std::vector<std::unique_ptr<Slot[]>> chunks_;
+	/** Indices of the elements in insertion order. */
+	std::vector<uint32_t> order_;
+	/** Indices of the unused slots, the next one to use at the back. */
+	std::vector<uint32_t> free_;
+};
+
+} // namespace devilution
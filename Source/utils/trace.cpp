@@ -0,0 +1,128 @@
+/**
+ * @file utils/trace.cpp
+ *
+ * Implementation of the recording and saving of timing zones.
+ */
+#include "utils/trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "utils/file_util.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+std::atomic<bool> TracingActive;
+
+namespace {
+
+struct TraceEvent {
+	const char *name;
+	uint64_t start;
+	uint64_t duration;
+	uint64_t threadId;
+};
+
+std::chrono::steady_clock::time_point TraceEpoch;
+uint64_t MainThreadId;
+
+// The fields below are guarded by `TraceMutex`.
+SdlMutex TraceMutex;
+std::vector<TraceEvent> Events;
+/** Where the next zone goes, the oldest zone is there once the buffer has wrapped around. */
+size_t NextEvent;
+bool Wrapped;
+
+void WriteJsonString(FILE *file, const char *str)
+{
+	std::fputc('"', file);
+	for (; *str != '\0'; ++str) {
+		if (*str == '"' || *str == '\\')
+			std::fputc('\\', file);
+		std::fputc(*str, file);
+	}
+	std::fputc('"', file);
+}
+
+} // namespace
+
+void EnableTracing(size_t capacity)
+{
+	const std::lock_guard<SdlMutex> lock(TraceMutex);
+	Events.assign(capacity, {});
+	NextEvent = 0;
+	Wrapped = false;
+	TraceEpoch = std::chrono::steady_clock::now();
+	MainThreadId = static_cast<uint64_t>(this_sdl_thread::get_id());
+	TracingActive = capacity != 0;
+}
+
+void DisableTracing()
+{
+	TracingActive = false;
+	const std::lock_guard<SdlMutex> lock(TraceMutex);
+	Events = {};
+	NextEvent = 0;
+	Wrapped = false;
+}
+
+uint64_t GetTraceTimestamp()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - TraceEpoch).count());
+}
+
+void RecordTraceZone(const char *name, uint64_t start, uint64_t end)
+{
+	const uint64_t threadId = static_cast<uint64_t>(this_sdl_thread::get_id());
+	const std::lock_guard<SdlMutex> lock(TraceMutex);
+	// Tracing may have been disabled since the zone started.
+	if (Events.empty())
+		return;
+	Events[NextEvent] = TraceEvent { name, start, end - start, threadId };
+	if (++NextEvent == Events.size()) {
+		NextEvent = 0;
+		Wrapped = true;
+	}
+}
+
+size_t GetTraceZoneCount()
+{
+	const std::lock_guard<SdlMutex> lock(TraceMutex);
+	return Wrapped ? Events.size() : NextEvent;
+}
+
+bool WriteTrace(const char *path)
+{
+	FILE *file = OpenFile(path, "wb");
+	if (file == nullptr)
+		return false;
+
+	const std::lock_guard<SdlMutex> lock(TraceMutex);
+	std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+	std::fprintf(file, R"({"name":"thread_name","ph":"M","pid":1,"tid":%llu,"args":{"name":"Main"}})", static_cast<unsigned long long>(MainThreadId));
+
+	const size_t count = Wrapped ? Events.size() : NextEvent;
+	const size_t first = Wrapped ? NextEvent : 0;
+	for (size_t i = 0; i < count; ++i) {
+		const TraceEvent &event = Events[(first + i) % Events.size()];
+		std::fputs(",\n{\"name\":", file);
+		WriteJsonString(file, event.name);
+		std::fprintf(file, R"(,"ph":"X","pid":1,"tid":%llu,"ts":%llu,"dur":%llu})",
+		    static_cast<unsigned long long>(event.threadId),
+		    static_cast<unsigned long long>(event.start),
+		    static_cast<unsigned long long>(event.duration));
+	}
+	std::fputs("\n]}\n", file);
+
+	const bool success = std::ferror(file) == 0;
+	return std::fclose(file) == 0 && success;
+}
+
+} // namespace devilution
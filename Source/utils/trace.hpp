@@ -0,0 +1,87 @@
+/**
+ * @file utils/trace.hpp
+ *
+ * Scoped timing zones for diagnosing hitches, saved in the Chrome trace event format.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+/** Number of zones kept by default, older zones are overwritten once the buffer is full. */
+constexpr size_t DefaultTraceCapacity = 1 << 16;
+
+/** Set while zones are being recorded, use IsTracingEnabled() to check it. */
+extern std::atomic<bool> TracingActive;
+
+/**
+ * @brief Starts recording zones to a ring buffer with room for `capacity` zones.
+ */
+void EnableTracing(size_t capacity = DefaultTraceCapacity);
+
+/**
+ * @brief Stops recording zones and drops the recorded ones.
+ */
+void DisableTracing();
+
+inline bool IsTracingEnabled()
+{
+	return TracingActive.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the time since tracing was enabled, in microseconds.
+ */
+uint64_t GetTraceTimestamp();
+
+/**
+ * @brief Records a zone that ran on the calling thread.
+ * @param name Name of the zone, must outlive the recorded trace.
+ */
+void RecordTraceZone(const char *name, uint64_t start, uint64_t end);
+
+/**
+ * @brief Returns the number of zones in the ring buffer.
+ */
+size_t GetTraceZoneCount();
+
+/**
+ * @brief Writes the recorded zones as a JSON trace that chrome://tracing and Perfetto can open.
+ * @return false if the file could not be written
+ */
+bool WriteTrace(const char *path);
+
+/**
+ * @brief Records the time from its construction to its destruction as a zone, if tracing is enabled.
+ *
+ * Zones that are nested within another zone on the same thread show up below it in the trace.
+ */
+class TraceZone {
+public:
+	/** @param name Name of the zone, must outlive the recorded trace. */
+	explicit TraceZone(const char *name)
+	{
+		if (IsTracingEnabled()) {
+			name_ = name;
+			start_ = GetTraceTimestamp();
+		}
+	}
+
+	~TraceZone()
+	{
+		if (name_ != nullptr)
+			RecordTraceZone(name_, start_, GetTraceTimestamp());
+	}
+
+	TraceZone(const TraceZone &) = delete;
+	TraceZone &operator=(const TraceZone &) = delete;
+
+private:
+	const char *name_ = nullptr;
+	uint64_t start_ = 0;
+};
+
+} // namespace devilution
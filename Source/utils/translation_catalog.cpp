@@ -0,0 +1,341 @@
+/**
+ * @file utils/translation_catalog.cpp
+ *
+ * Implementation of the lookup table of translated strings.
+ *
+ * The keys are spread over buckets of about KeysPerBucket keys each. Going from the largest bucket to the smallest,
+ * each bucket gets the first displacement that sends all of its keys to slots no other key took yet ("hash and
+ * displace"). A lookup then only needs the displacement of the key's bucket to know its slot.
+ */
+#include "utils/translation_catalog.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+
+#include "utils/endian_read.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr uint32_t TranslationRefOffsetBits = 19;
+constexpr uint32_t TranslationRefSizeBits = 32 - TranslationRefOffsetBits; // 13
+constexpr uint32_t TranslationRefSizeMask = (1 << TranslationRefSizeBits) - 1;
+
+/** More keys per bucket make the displacement table smaller but the catalog much slower to build. */
+constexpr uint32_t KeysPerBucket = 2;
+/** A bucket that doesn't fit with this many displacements makes us start over with another seed. */
+constexpr uint32_t MaxDisplacement = 1 << 16;
+/** Buckets with a single key store its slot instead of a displacement, marked by this bit. */
+constexpr uint32_t DirectSlotFlag = 1U << 31;
+constexpr uint64_t MaxSeeds = 8;
+
+constexpr uint64_t Multiplier = 0x9E3779B97F4A7C15ULL;
+
+uint32_t EncodeTranslationRef(size_t offset, size_t size)
+{
+	return (static_cast<uint32_t>(offset) << TranslationRefSizeBits) | static_cast<uint32_t>(size);
+}
+
+uint64_t Mix(uint64_t value)
+{
+	value ^= value >> 32;
+	value *= 0xD6E8FEB86659FD93ULL;
+	value ^= value >> 32;
+	return value;
+}
+
+/** Maps an evenly distributed value to [0, range) without a division. */
+uint32_t ScaleToRange(uint32_t value, uint32_t range)
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32);
+}
+
+uint32_t GetBucket(uint64_t hash, uint32_t bucketCount)
+{
+	return ScaleToRange(static_cast<uint32_t>(hash >> 32), bucketCount);
+}
+
+uint32_t GetDisplacedSlot(uint64_t hash, uint32_t displacement, uint32_t slotCount)
+{
+	if ((displacement & DirectSlotFlag) != 0)
+		return displacement & ~DirectSlotFlag;
+	return ScaleToRange(static_cast<uint32_t>(Mix(hash ^ (displacement * Multiplier))), slotCount);
+}
+
+/**
+ * @brief Hashes a key 8 bytes at a time, also when it is passed in several parts.
+ */
+class KeyHasher {
+public:
+	explicit KeyHasher(uint64_t seed)
+	    : state_(seed)
+	{
+	}
+
+	void update(std::string_view part)
+	{
+		const char *pos = part.data();
+		const char *const end = pos + part.size();
+		length_ += part.size();
+		while (pendingBytes_ != 0 && pos != end)
+			addByte(*pos++);
+		for (; end - pos >= 8; pos += 8)
+			addWord(LoadLE64(pos));
+		if (pos != end) {
+			// pendingBytes_ is 0 here, so the rest of the part can be loaded at once.
+			char tail[8] = {};
+			std::memcpy(tail, pos, end - pos);
+			pending_ = LoadLE64(tail);
+			pendingBytes_ = static_cast<unsigned>(end - pos);
+		}
+	}
+
+	uint64_t finish()
+	{
+		if (pendingBytes_ != 0)
+			addWord(pending_);
+		return Mix(state_ ^ (length_ * Multiplier));
+	}
+
+private:
+	static uint64_t LoadLE64(const char *bytes)
+	{
+		return LoadLE32(bytes) | (static_cast<uint64_t>(LoadLE32(bytes + 4)) << 32);
+	}
+
+	void addByte(char byte)
+	{
+		pending_ |= static_cast<uint64_t>(static_cast<uint8_t>(byte)) << (8 * pendingBytes_);
+		if (++pendingBytes_ == 8) {
+			addWord(pending_);
+			pending_ = 0;
+			pendingBytes_ = 0;
+		}
+	}
+
+	void addWord(uint64_t word)
+	{
+		state_ = (state_ ^ word) * Multiplier;
+		state_ ^= state_ >> 29;
+	}
+
+	uint64_t state_;
+	uint64_t pending_ = 0;
+	unsigned pendingBytes_ = 0;
+	uint64_t length_ = 0;
+};
+
+uint64_t HashKey(std::string_view key, uint64_t seed)
+{
+	KeyHasher hasher(seed);
+	hasher.update(key);
+	return hasher.finish();
+}
+
+/**
+ * @brief Lists the entries without the repeated keys.
+ *
+ * @return false if two different keys have the same hash, which means the seed has to change.
+ */
+bool FindUniqueKeys(std::span<const TranslationCatalog::Entry> entries, std::span<const uint64_t> hashes, std::vector<uint32_t> &unique)
+{
+	std::vector<uint32_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&hashes](uint32_t a, uint32_t b) {
+		return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : a < b;
+	});
+
+	unique.clear();
+	for (const uint32_t entry : order) {
+		if (!unique.empty() && hashes[unique.back()] == hashes[entry]) {
+			if (entries[unique.back()].key != entries[entry].key)
+				return false;
+			continue;
+		}
+		unique.push_back(entry);
+	}
+	return true;
+}
+
+/**
+ * @brief Finds a displacement for every bucket so that each key gets a slot of its own.
+ *
+ * @param slots Receives the entry that goes into each slot.
+ * @return false if some bucket didn't fit, which means the seed has to change.
+ */
+bool PlaceKeys(std::span<const uint64_t> hashes, std::span<const uint32_t> unique, std::vector<uint32_t> &displacements, std::vector<uint32_t> &slots)
+{
+	const auto slotCount = static_cast<uint32_t>(unique.size());
+	const uint32_t bucketCount = (slotCount + KeysPerBucket - 1) / KeysPerBucket;
+
+	// Group the keys by bucket
+	std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+	for (const uint32_t entry : unique)
+		bucketStart[GetBucket(hashes[entry], bucketCount) + 1]++;
+	std::partial_sum(bucketStart.begin(), bucketStart.end(), bucketStart.begin());
+	std::vector<uint32_t> bucketKeys(slotCount);
+	{
+		std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+		for (const uint32_t entry : unique)
+			bucketKeys[fill[GetBucket(hashes[entry], bucketCount)]++] = entry;
+	}
+	const auto bucketSize = [&bucketStart](uint32_t bucket) { return bucketStart[bucket + 1] - bucketStart[bucket]; };
+
+	std::vector<uint32_t> bucketOrder(bucketCount);
+	std::iota(bucketOrder.begin(), bucketOrder.end(), 0);
+	std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&bucketSize](uint32_t a, uint32_t b) { return bucketSize(a) > bucketSize(b); });
+
+	displacements.assign(bucketCount, 0);
+	slots.assign(slotCount, TranslationCatalog::NotFound);
+	std::vector<uint32_t> candidates;
+	uint32_t nextFreeSlot = 0;
+	for (const uint32_t bucket : bucketOrder) {
+		const std::span<const uint32_t> keys { &bucketKeys[bucketStart[bucket]], bucketSize(bucket) };
+		if (keys.empty())
+			break;
+		if (keys.size() == 1) {
+			// Searching a displacement for these gets slow as the slots fill up, so they simply take the free ones.
+			while (slots[nextFreeSlot] != TranslationCatalog::NotFound)
+				++nextFreeSlot;
+			displacements[bucket] = DirectSlotFlag | nextFreeSlot;
+			slots[nextFreeSlot] = keys[0];
+			continue;
+		}
+		uint32_t displacement = 0;
+		for (; displacement < MaxDisplacement; ++displacement) {
+			candidates.clear();
+			for (const uint32_t entry : keys) {
+				const uint32_t slot = GetDisplacedSlot(hashes[entry], displacement, slotCount);
+				if (slots[slot] != TranslationCatalog::NotFound || std::find(candidates.begin(), candidates.end(), slot) != candidates.end())
+					break;
+				candidates.push_back(slot);
+			}
+			if (candidates.size() == keys.size())
+				break;
+		}
+		if (displacement == MaxDisplacement)
+			return false;
+		displacements[bucket] = displacement;
+		for (size_t i = 0; i < keys.size(); ++i)
+			slots[candidates[i]] = keys[i];
+	}
+	return true;
+}
+
+} // namespace
+
+TranslationCatalog TranslationCatalog::build(std::span<const Entry> entries, unsigned pluralForms)
+{
+	TranslationCatalog catalog;
+	catalog.pluralForms_ = std::max(pluralForms, 1U);
+	if (entries.empty())
+		return catalog;
+
+	std::vector<uint64_t> hashes(entries.size());
+	std::vector<uint32_t> unique;
+	std::vector<uint32_t> slots;
+	for (uint64_t seed = 0; seed < MaxSeeds && slots.empty(); ++seed) {
+		catalog.seed_ = seed * Multiplier;
+		for (size_t i = 0; i < entries.size(); ++i)
+			hashes[i] = HashKey(entries[i].key, catalog.seed_);
+		if (!FindUniqueKeys(entries, hashes, unique) || !PlaceKeys(hashes, unique, catalog.displacements_, slots))
+			slots.clear();
+	}
+	if (slots.empty())
+		return catalog;
+
+	size_t keysSize = 0;
+	size_t valuesSize = 0;
+	for (const uint32_t entry : unique) {
+		keysSize += entries[entry].key.size();
+		valuesSize += entries[entry].value.size() + 1;
+	}
+	catalog.keys_ = std::unique_ptr<char[]> { new char[keysSize] };
+	catalog.values_ = std::unique_ptr<char[]> { new char[valuesSize] };
+
+	catalog.slotCount_ = static_cast<uint32_t>(slots.size());
+	const size_t stride = 1 + catalog.pluralForms_;
+	catalog.refs_.resize(slots.size() * stride);
+	size_t keyOffset = 0;
+	size_t valueOffset = 0;
+	for (size_t slot = 0; slot < slots.size(); ++slot) {
+		const Entry &entry = entries[slots[slot]];
+		TranslationRef *refs = &catalog.refs_[slot * stride];
+
+		std::memcpy(&catalog.keys_[keyOffset], entry.key.data(), entry.key.size());
+		refs[0] = EncodeTranslationRef(keyOffset, entry.key.size());
+		keyOffset += entry.key.size();
+
+		// The forms are copied together, the '\0' between them terminates each form.
+		std::memcpy(&catalog.values_[valueOffset], entry.value.data(), entry.value.size());
+		catalog.values_[valueOffset + entry.value.size()] = '\0';
+		size_t formStart = 0;
+		for (unsigned form = 0; form < catalog.pluralForms_; ++form) {
+			if (formStart > entry.value.size()) {
+				refs[1 + form] = NoTranslation;
+				continue;
+			}
+			const size_t formEnd = std::min(entry.value.find('\0', formStart), entry.value.size());
+			refs[1 + form] = EncodeTranslationRef(valueOffset + formStart, formEnd - formStart);
+			formStart = formEnd + 1;
+		}
+		valueOffset += entry.value.size() + 1;
+	}
+	return catalog;
+}
+
+uint32_t TranslationCatalog::slotOf(uint64_t hash) const
+{
+	const auto bucketCount = static_cast<uint32_t>(displacements_.size());
+	return GetDisplacedSlot(hash, displacements_[GetBucket(hash, bucketCount)], slotCount_);
+}
+
+uint32_t TranslationCatalog::find(std::string_view key) const
+{
+	if (empty())
+		return NotFound;
+	const uint32_t slot = slotOf(HashKey(key, seed_));
+	return this->key(slot) == key ? slot : NotFound;
+}
+
+uint32_t TranslationCatalog::findParticular(std::string_view context, std::string_view message) const
+{
+	if (empty())
+		return NotFound;
+	constexpr char Glue = '\004';
+	KeyHasher hasher(seed_);
+	hasher.update(context);
+	hasher.update({ &Glue, 1 });
+	hasher.update(message);
+	const uint32_t slot = slotOf(hasher.finish());
+
+	const std::string_view slotKey = key(slot);
+	if (slotKey.size() != context.size() + 1 + message.size()
+	    || slotKey.substr(0, context.size()) != context
+	    || slotKey[context.size()] != Glue
+	    || slotKey.substr(context.size() + 1) != message) {
+		return NotFound;
+	}
+	return slot;
+}
+
+std::string_view TranslationCatalog::key(uint32_t slot) const
+{
+	const TranslationRef ref = refs_[slot * (1 + pluralForms_)];
+	return { &keys_[ref >> TranslationRefSizeBits], ref & TranslationRefSizeMask };
+}
+
+std::optional<std::string_view> TranslationCatalog::translation(uint32_t slot, unsigned form) const
+{
+	if (form >= pluralForms_)
+		return std::nullopt;
+	const TranslationRef ref = refs_[(slot * (1 + pluralForms_)) + 1 + form];
+	if (ref == NoTranslation)
+		return std::nullopt;
+	return std::string_view { &values_[ref >> TranslationRefSizeBits], ref & TranslationRefSizeMask };
+}
+
+} // namespace devilution
@@ -0,0 +1,85 @@
+/**
+ * @file utils/translation_catalog.hpp
+ *
+ * Interface of the lookup table of translated strings.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief Read-only map from source strings to their translations, indexed by a minimal perfect hash.
+ *
+ * Every key owns exactly one slot, so a lookup hashes the key once, reads one displacement and compares the key of a
+ * single slot. The translations of a slot are stored next to its key as precomputed references into one buffer, one
+ * per plural form.
+ */
+class TranslationCatalog {
+public:
+	static constexpr uint32_t NotFound = std::numeric_limits<uint32_t>::max();
+
+	struct Entry {
+		std::string_view key;
+		/** The plural forms of the translation, separated by '\0'. */
+		std::string_view value;
+	};
+
+	TranslationCatalog() = default;
+
+	/**
+	 * @brief Builds the catalog for the given entries.
+	 *
+	 * Forms beyond `pluralForms` are dropped. The first entry wins if a key is listed more than once.
+	 */
+	static TranslationCatalog build(std::span<const Entry> entries, unsigned pluralForms);
+
+	[[nodiscard]] bool empty() const { return slotCount_ == 0; }
+	[[nodiscard]] uint32_t size() const { return slotCount_; }
+	[[nodiscard]] unsigned pluralForms() const { return pluralForms_; }
+
+	/**
+	 * @return the slot of the key, or NotFound.
+	 */
+	[[nodiscard]] uint32_t find(std::string_view key) const;
+
+	/**
+	 * @brief Looks up a message with a context, stored by gettext as context + '\004' + message.
+	 *
+	 * Unlike building that key and calling find(), this doesn't allocate.
+	 */
+	[[nodiscard]] uint32_t findParticular(std::string_view context, std::string_view message) const;
+
+	[[nodiscard]] std::string_view key(uint32_t slot) const;
+
+	/**
+	 * @return the given plural form of the translation in a slot, if the entry has that form. Always null-terminated.
+	 */
+	[[nodiscard]] std::optional<std::string_view> translation(uint32_t slot, unsigned form) const;
+
+private:
+	/** 19-bit offset and 13-bit size of a string in one of the string buffers. */
+	using TranslationRef = uint32_t;
+	static constexpr TranslationRef NoTranslation = std::numeric_limits<TranslationRef>::max();
+
+	[[nodiscard]] uint32_t slotOf(uint64_t hash) const;
+
+	uint64_t seed_ = 0;
+	uint32_t slotCount_ = 0;
+	unsigned pluralForms_ = 1;
+	/** Per bucket of keys, the seed that sends all of its keys to free slots. */
+	std::vector<uint32_t> displacements_;
+	/** Per slot, the reference to the key followed by the references to each plural form. */
+	std::vector<TranslationRef> refs_;
+	std::unique_ptr<char[]> keys_;
+	std::unique_ptr<char[]> values_;
+};
+
+} // namespace devilution
@@ -1,5 +1,6 @@
 #include "vision.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
 
@@ -68,7 +69,8 @@ void DoVision(Point position, uint8_t radius,
 	for (const auto &quadrant : Quadrants) {
 		// Cast a ray for a quadrant
 		for (unsigned int j = 0; j < std::size(VisionRays); j++) {
-			const int rayLen = radius - RayLenAdj[j];
+			// Radiuses above 15 would read past the end of the rays
+			const int rayLen = std::min<int>(radius - RayLenAdj[j], std::size(VisionRays[j]));
 			for (int k = 0; k < rayLen; k++) {
 				const auto &relRayPoint = VisionRays[j][k];
 				// Calculate the next point on a ray in the quadrant
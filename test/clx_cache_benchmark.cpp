@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "utils/cl2_to_clx.hpp"
+#include "utils/clx_cache.hpp"
+#include "utils/clx_encode.hpp"
+#include "utils/endian_write.hpp"
+#include "utils/file_util.h"
+
+namespace devilution {
+namespace {
+
+const std::string CacheDir = "clx_cache_benchmark_cache" DIRECTORY_SEPARATOR_STR;
+
+struct SheetSize {
+	uint16_t width;
+	uint16_t height;
+	uint32_t numGroups;
+	uint32_t numFrames;
+};
+
+// A player animation, such as the warrior's attack, and a large monster's walk.
+constexpr SheetSize PlayerSheet { 96, 96, 8, 16 };
+constexpr SheetSize MonsterSheet { 160, 128, 8, 16 };
+
+/**
+ * @brief Encodes a CL2 sheet where every frame has a figure in the middle, with fill runs mixed into its pixels.
+ */
+std::vector<uint8_t> MakeCl2Sheet(const SheetSize &sheet)
+{
+	std::mt19937 rng(1);
+	std::vector<uint8_t> cl2(4 * sheet.numGroups);
+	std::vector<uint8_t> pixels(sheet.width);
+	for (uint32_t group = 0; group < sheet.numGroups; ++group) {
+		const size_t groupBegin = cl2.size();
+		WriteLE32(&cl2[4 * group], static_cast<uint32_t>(groupBegin));
+		cl2.resize(groupBegin + (4 * (2 + static_cast<size_t>(sheet.numFrames))));
+		WriteLE32(&cl2[groupBegin], sheet.numFrames);
+		for (uint32_t frame = 0; frame < sheet.numFrames; ++frame) {
+			WriteLE32(&cl2[groupBegin + (4 * (1 + frame))], static_cast<uint32_t>(cl2.size() - groupBegin));
+			// Frame header: its size, followed by offsets that the conversion skips
+			const size_t frameBegin = cl2.size();
+			cl2.resize(frameBegin + 10);
+			WriteLE16(&cl2[frameBegin], 10);
+			for (unsigned y = 0; y < sheet.height; ++y) {
+				const unsigned figureWidth = y < sheet.height / 8 ? 0 : sheet.width / 3 + (rng() % (sheet.width / 4));
+				const unsigned left = (sheet.width - figureWidth) / 2;
+				AppendClxTransparentRun(left, cl2);
+				if (figureWidth != 0) {
+					for (unsigned x = 0; x < figureWidth; ++x)
+						pixels[x] = x != 0 && rng() % 2 == 0 ? pixels[x - 1] : static_cast<uint8_t>(rng());
+					AppendClxPixelsOrFillRun(pixels.data(), figureWidth, cl2);
+				}
+				AppendClxTransparentRun(sheet.width - left - figureWidth, cl2);
+			}
+		}
+		WriteLE32(&cl2[groupBegin + (4 * (1 + static_cast<size_t>(sheet.numFrames)))], static_cast<uint32_t>(cl2.size() - groupBegin));
+	}
+	return cl2;
+}
+
+const SheetSize &GetSheetSize(benchmark::State &state)
+{
+	return state.range(0) == 0 ? PlayerSheet : MonsterSheet;
+}
+
+OwnedClxSpriteListOrSheet Convert(const std::vector<uint8_t> &cl2, uint16_t width)
+{
+	std::vector<uint8_t> clxData;
+	const uint16_t numLists = Cl2ToClx(cl2.data(), cl2.size(), PointerOrValue<uint16_t> { width }, clxData);
+	std::unique_ptr<uint8_t[]> data { new uint8_t[clxData.size()] };
+	std::memcpy(&data[0], clxData.data(), clxData.size());
+	return OwnedClxSpriteListOrSheet { std::move(data), numLists };
+}
+
+OwnedClxSpriteListOrSheet LoadCached(const std::vector<uint8_t> &cl2, uint16_t width)
+{
+	return ConvertToClxCached(ClxSourceFormat::Cl2, cl2.data(), cl2.size(), PointerOrValue<uint16_t> { width }, [&]() {
+		return Convert(cl2, width);
+	});
+}
+
+void RemoveCachedSprites()
+{
+	for (const std::string &file : ListFiles(CacheDir.c_str()))
+		RemoveFile((CacheDir + file).c_str());
+}
+
+void BM_ConvertCl2(benchmark::State &state)
+{
+	const SheetSize &sheet = GetSheetSize(state);
+	const std::vector<uint8_t> cl2 = MakeCl2Sheet(sheet);
+	for (auto _ : state) {
+		OwnedClxSpriteListOrSheet clx = Convert(cl2, sheet.width);
+		benchmark::DoNotOptimize(clx);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * cl2.size()));
+}
+
+/** The first load of a sprite: it is converted and written to the cache. */
+void BM_ConvertCl2AndStore(benchmark::State &state)
+{
+	const SheetSize &sheet = GetSheetSize(state);
+	const std::vector<uint8_t> cl2 = MakeCl2Sheet(sheet);
+	SetClxCacheDir(CacheDir);
+	for (auto _ : state) {
+		state.PauseTiming();
+		RemoveCachedSprites();
+		state.ResumeTiming();
+		OwnedClxSpriteListOrSheet clx = LoadCached(cl2, sheet.width);
+		benchmark::DoNotOptimize(clx);
+	}
+	SetClxCacheDir("");
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * cl2.size()));
+}
+
+/** Every later load: the source is hashed and the sprite is read from the cache. */
+void BM_LoadCachedCl2(benchmark::State &state)
+{
+	const SheetSize &sheet = GetSheetSize(state);
+	const std::vector<uint8_t> cl2 = MakeCl2Sheet(sheet);
+	SetClxCacheDir(CacheDir);
+	RemoveCachedSprites();
+	LoadCached(cl2, sheet.width);
+	for (auto _ : state) {
+		OwnedClxSpriteListOrSheet clx = LoadCached(cl2, sheet.width);
+		benchmark::DoNotOptimize(clx);
+	}
+	SetClxCacheDir("");
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * cl2.size()));
+}
+
+BENCHMARK(BM_ConvertCl2)->ArgName("monster")->Arg(0)->Arg(1);
+BENCHMARK(BM_ConvertCl2AndStore)->ArgName("monster")->Arg(0)->Arg(1);
+BENCHMARK(BM_LoadCachedCl2)->ArgName("monster")->Arg(0)->Arg(1);
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,166 @@
+#include "utils/clx_cache.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/file_util.h"
+
+namespace devilution {
+namespace {
+
+const std::string CacheDir = "clx_cache_test_cache" DIRECTORY_SEPARATOR_STR;
+
+/** @brief Stands in for a conversion: a list with a single sprite whose pixel data is the source data. */
+OwnedClxSpriteListOrSheet FakeConvert(const uint8_t *data, size_t size)
+{
+	const uint32_t dataSize = static_cast<uint32_t>(12 + 6 + size);
+	std::unique_ptr<uint8_t[]> clx { new uint8_t[dataSize] };
+	const uint32_t header[] = { 1, 12, dataSize };
+	std::memcpy(&clx[0], header, sizeof(header));
+	const uint16_t spriteHeader[] = { 6, 2, 1 };
+	std::memcpy(&clx[12], spriteHeader, sizeof(spriteHeader));
+	std::memcpy(&clx[18], data, size);
+	return OwnedClxSpriteListOrSheet { std::move(clx), 0 };
+}
+
+PointerOrValue<uint16_t> Width(uint16_t width)
+{
+	return PointerOrValue<uint16_t> { width };
+}
+
+uintmax_t GetCacheDirSize()
+{
+	uintmax_t total = 0;
+	for (const std::string &file : ListFiles(CacheDir.c_str())) {
+		uintmax_t size;
+		if (GetFileSize((CacheDir + file).c_str(), &size))
+			total += size;
+	}
+	return total;
+}
+
+/** @brief Overwrites part of the only cache file, seeking like `std::fseek`. */
+void PatchCacheFile(long offset, int origin, const void *data, size_t size)
+{
+	const std::vector<std::string> files = ListFiles(CacheDir.c_str());
+	ASSERT_EQ(files.size(), 1);
+	FILE *file = OpenFile((CacheDir + files[0]).c_str(), "r+b");
+	ASSERT_NE(file, nullptr);
+	ASSERT_EQ(std::fseek(file, offset, origin), 0);
+	ASSERT_EQ(std::fwrite(data, size, 1, file), 1);
+	std::fclose(file);
+}
+
+class ClxCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		for (const std::string &file : ListFiles(CacheDir.c_str()))
+			RemoveFile((CacheDir + file).c_str());
+		SetClxCacheDir(CacheDir);
+	}
+
+	void TearDown() override
+	{
+		SetClxCacheDir("");
+	}
+
+	OwnedClxSpriteListOrSheet Load(ClxSourceFormat format, PointerOrValue<uint16_t> widthOrWidths)
+	{
+		return ConvertToClxCached(format, source.data(), source.size(), widthOrWidths, [&]() {
+			conversions++;
+			return FakeConvert(source.data(), source.size());
+		});
+	}
+
+	std::array<uint8_t, 13> source = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+	int conversions = 0;
+};
+
+TEST_F(ClxCacheTest, ConvertsOnce)
+{
+	const OwnedClxSpriteListOrSheet first = Load(ClxSourceFormat::Cl2, Width(32));
+	const OwnedClxSpriteListOrSheet second = Load(ClxSourceFormat::Cl2, Width(32));
+	EXPECT_EQ(conversions, 1);
+	EXPECT_EQ(ListFiles(CacheDir.c_str()).size(), 1);
+	ASSERT_FALSE(second.isSheet());
+	ASSERT_EQ(second.dataSize(), first.dataSize());
+	EXPECT_EQ(std::memcmp(ClxSpriteListOrSheet { second }.list().data(), ClxSpriteListOrSheet { first }.list().data(), first.dataSize()), 0);
+}
+
+TEST_F(ClxCacheTest, KeyedByFormatWidthAndData)
+{
+	Load(ClxSourceFormat::Cl2, Width(32));
+	Load(ClxSourceFormat::Cel, Width(32));
+	Load(ClxSourceFormat::Cl2, Width(64));
+	source.back() = 0;
+	Load(ClxSourceFormat::Cl2, Width(32));
+	EXPECT_EQ(conversions, 4);
+	EXPECT_EQ(ListFiles(CacheDir.c_str()).size(), 4);
+}
+
+TEST_F(ClxCacheTest, MalformedSpritesAreConvertedAgain)
+{
+	Load(ClxSourceFormat::Cl2, Width(32));
+
+	// The sprite data follows a 24-byte header. Claim more sprites than the list has offsets for.
+	const uint32_t numSprites = 1000;
+	PatchCacheFile(24, SEEK_SET, &numSprites, sizeof(numSprites));
+	Load(ClxSourceFormat::Cl2, Width(32));
+	EXPECT_EQ(conversions, 2);
+
+	// The number of lists is at the end. Claim that the list is a sheet.
+	const uint16_t numLists = 1;
+	PatchCacheFile(-2, SEEK_END, &numLists, sizeof(numLists));
+	Load(ClxSourceFormat::Cl2, Width(32));
+	EXPECT_EQ(conversions, 3);
+
+	Load(ClxSourceFormat::Cl2, Width(32));
+	EXPECT_EQ(conversions, 3);
+}
+
+TEST_F(ClxCacheTest, StaysWithinMaxSize)
+{
+	// Each file is 57 bytes: the header, 31 bytes of sprite data and the number of lists.
+	SetClxCacheDir(CacheDir, 300);
+	for (uint8_t i = 0; i < 10; ++i) {
+		source.back() = i;
+		Load(ClxSourceFormat::Cl2, Width(32));
+	}
+	EXPECT_LE(GetCacheDirSize(), 300);
+
+	// The sprite stored last is never the one pruned to make room.
+	Load(ClxSourceFormat::Cl2, Width(32));
+	EXPECT_EQ(conversions, 10);
+}
+
+TEST_F(ClxCacheTest, PrunedWhenEnabled)
+{
+	for (uint8_t i = 0; i < 4; ++i) {
+		source.back() = i;
+		Load(ClxSourceFormat::Cl2, Width(32));
+	}
+	ASSERT_EQ(ListFiles(CacheDir.c_str()).size(), 4);
+
+	SetClxCacheDir(CacheDir, 120);
+	EXPECT_EQ(ListFiles(CacheDir.c_str()).size(), 2);
+}
+
+TEST_F(ClxCacheTest, PerFrameWidthsAreNotCached)
+{
+	const uint16_t widths[] = { 32 };
+	Load(ClxSourceFormat::Cel, PointerOrValue<uint16_t> { widths });
+	Load(ClxSourceFormat::Cel, PointerOrValue<uint16_t> { widths });
+	EXPECT_EQ(conversions, 2);
+	EXPECT_TRUE(ListFiles(CacheDir.c_str()).empty());
+}
+
+} // namespace
+} // namespace devilution
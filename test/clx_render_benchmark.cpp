@@ -56,8 +56,38 @@ void BM_RenderLargeClx(benchmark::State &state)
 	state.SetItemsProcessed(state.iterations());
 }
 
+// Outlines several sprites per frame, like a fight with many highlighted monsters and items.
+void BM_RenderClxOutlines(benchmark::State &state)
+{
+	const SDLSurfaceUniquePtr sdl_surface = SDLWrap::CreateRGBSurfaceWithFormat(
+	    /*flags=*/0, /*width=*/640, /*height=*/480, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+	if (sdl_surface == nullptr) {
+		LogError("Failed to create SDL Surface: {}", SDL_GetError());
+		exit(1);
+	}
+	const Surface out = Surface(sdl_surface.get());
+	const OwnedClxSpriteList sprites = LoadClx("data\\resistance.clx");
+
+	ClearClxDrawCache();
+	const LruCacheStats before = GetClxOutlineCacheStats();
+	const size_t numSprites = sprites.numSprites();
+	for (auto _ : state) {
+		for (size_t i = 0; i < numSprites; ++i) {
+			ClxDrawOutline(out, /*col=*/255, Point { static_cast<int>(i * 100), static_cast<int>(i * 60) + 100 }, sprites[i]);
+			ClxDrawOutlineSkipColorZero(out, /*col=*/128, Point { static_cast<int>(i * 100) + 50, static_cast<int>(i * 60) + 100 }, sprites[i]);
+		}
+		uint8_t color = out[Point { 120, 120 }];
+		benchmark::DoNotOptimize(color);
+	}
+	const LruCacheStats after = GetClxOutlineCacheStats();
+	const uint64_t lookups = (after.hits - before.hits) + (after.misses - before.misses);
+	state.counters["hit_rate"] = lookups == 0 ? 0 : static_cast<double>(after.hits - before.hits) / static_cast<double>(lookups);
+	state.SetItemsProcessed(state.iterations() * numSprites * 2);
+}
+
 BENCHMARK(BM_RenderSmallClx);
 BENCHMARK(BM_RenderLargeClx);
+BENCHMARK(BM_RenderClxOutlines);
 
 } // namespace
 } // namespace devilution
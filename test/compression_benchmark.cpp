@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "encrypt.h"
+#include "utils/lz_codec.hpp"
+
+namespace devilution {
+namespace {
+
+/**
+ * @brief Builds data that looks like game state: fixed-size records of small numbers, flags and unused fields.
+ */
+std::vector<std::byte> MakeGameStateLikeData(size_t size)
+{
+	constexpr size_t RecordSize = 48;
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> smallValue(0, 15);
+	std::uniform_int_distribution<int> anyValue(0, 255);
+	std::vector<std::byte> data(size);
+	for (size_t i = 0; i < size; i++) {
+		const size_t field = i % RecordSize;
+		if (field < 4)
+			data[i] = static_cast<std::byte>(anyValue(rng));
+		else if (field < 16)
+			data[i] = static_cast<std::byte>(smallValue(rng));
+		else if (field < 24)
+			data[i] = std::byte { 0xFF };
+		else
+			data[i] = std::byte { 0 };
+	}
+	return data;
+}
+
+void BM_PkwareCompress(benchmark::State &state)
+{
+	const std::vector<std::byte> input = MakeGameStateLikeData(static_cast<size_t>(state.range(0)));
+	std::vector<std::byte> buffer;
+	uint32_t compressedSize = 0;
+	for (auto _ : state) {
+		buffer = input;
+		compressedSize = PkwareCompress(buffer.data(), static_cast<uint32_t>(buffer.size()));
+		benchmark::DoNotOptimize(compressedSize);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+	state.counters["ratio"] = static_cast<double>(compressedSize) / static_cast<double>(input.size());
+}
+
+void BM_LzCompress(benchmark::State &state)
+{
+	const std::vector<std::byte> input = MakeGameStateLikeData(static_cast<size_t>(state.range(0)));
+	std::vector<std::byte> buffer;
+	uint32_t compressedSize = 0;
+	for (auto _ : state) {
+		buffer = input;
+		compressedSize = LzCompress(buffer.data(), static_cast<uint32_t>(buffer.size()));
+		benchmark::DoNotOptimize(compressedSize);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+	state.counters["ratio"] = static_cast<double>(compressedSize) / static_cast<double>(input.size());
+}
+
+void BM_PkwareDecompress(benchmark::State &state)
+{
+	std::vector<std::byte> compressed = MakeGameStateLikeData(static_cast<size_t>(state.range(0)));
+	const size_t originalSize = compressed.size();
+	compressed.resize(PkwareCompress(compressed.data(), static_cast<uint32_t>(compressed.size())));
+	std::vector<std::byte> buffer(originalSize);
+	for (auto _ : state) {
+		std::copy(compressed.begin(), compressed.end(), buffer.begin());
+		benchmark::DoNotOptimize(PkwareDecompress(buffer.data(), static_cast<uint32_t>(compressed.size()), buffer.size()));
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * originalSize));
+}
+
+void BM_LzDecompress(benchmark::State &state)
+{
+	std::vector<std::byte> compressed = MakeGameStateLikeData(static_cast<size_t>(state.range(0)));
+	const size_t originalSize = compressed.size();
+	compressed.resize(LzCompress(compressed.data(), static_cast<uint32_t>(compressed.size())));
+	std::vector<std::byte> buffer(originalSize);
+	for (auto _ : state) {
+		std::copy(compressed.begin(), compressed.end(), buffer.begin());
+		benchmark::DoNotOptimize(LzDecompress(buffer.data(), static_cast<uint32_t>(compressed.size()), buffer.size()));
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * originalSize));
+}
+
+// A level delta, and the size of a save file entry.
+BENCHMARK(BM_PkwareCompress)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_LzCompress)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_PkwareDecompress)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_LzDecompress)->Arg(4096)->Arg(65536);
+
+} // namespace
+} // namespace devilution
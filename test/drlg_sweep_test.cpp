@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "drlg_test.hpp"
+#include "levels/gendung.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+using namespace devilution;
+
+namespace {
+
+struct SweepCase {
+	const char *fixture;
+	int level;
+	uint32_t seed;
+	lvl_entry entry;
+	bool fullQuests;
+	bool hellfire;
+};
+
+/** @brief Only fixtures that don't override quest states, since the sweep can't reproduce those. */
+const SweepCase SweepCases[] = {
+	{ "diablo/1-2588.dun", 1, 2588, ENTRY_MAIN, true, false },
+	{ "diablo/1-2588.dun", 1, 2588, ENTRY_PREV, true, false },
+	{ "diablo/3-844660068.dun", 3, 844660068, ENTRY_MAIN, true, false },
+	{ "diablo/8-1999936419.dun", 8, 1999936419, ENTRY_MAIN, true, false },
+	{ "diablo/8-1999936419.dun", 8, 1999936419, ENTRY_PREV, true, false },
+	{ "diablo/9-262005438.dun", 9, 262005438, ENTRY_MAIN, true, false },
+	{ "diablo/11-384626536.dun", 11, 384626536, ENTRY_PREV, true, false },
+	{ "diablo/14-717625719.dun", 14, 717625719, ENTRY_MAIN, true, false },
+	{ "diablo/15-1256511996.dun", 15, 1256511996, ENTRY_MAIN, false, false },
+	{ "hellfire/18-1522546307.dun", 18, 1522546307, ENTRY_MAIN, true, true },
+	{ "hellfire/23-97055268.dun", 23, 97055268, ENTRY_PREV, true, true },
+};
+
+/** @brief Runs devilutionx-drlg-sweep as a worker for a single seed and returns its output. */
+std::string RunSweepWorker(const SweepCase &sweepCase)
+{
+	std::string command = fmt::format("\"{}\" --worker --save-dir \"{}test/fixtures\"", DEVILUTIONX_DRLG_SWEEP_PATH, paths::BasePath());
+	if (sweepCase.entry == ENTRY_PREV)
+		command += " --entry prev";
+	if (!sweepCase.fullQuests)
+		command += " --multiplayer";
+	if (sweepCase.hellfire)
+		command += " --hellfire";
+	command += fmt::format(" {} {} 1", sweepCase.level, sweepCase.seed);
+
+	FILE *worker = popen(command.c_str(), "r");
+	if (worker == nullptr)
+		return {};
+	std::string output;
+	char buffer[64];
+	while (std::fgets(buffer, sizeof(buffer), worker) != nullptr)
+		output += buffer;
+	if (pclose(worker) != 0)
+		return {};
+	return output;
+}
+
+class DrlgSweepTest : public ::testing::TestWithParam<SweepCase> { };
+
+TEST_P(DrlgSweepTest, WorkerHashMatchesFixture)
+{
+	const SweepCase &sweepCase = GetParam();
+	ASSERT_NO_FATAL_FAILURE(LoadExpectedLevelData(sweepCase.fixture));
+	TestInitGame(sweepCase.fullQuests, true, sweepCase.hellfire);
+	// Fails unless the layout matches the fixture, so the hash below is the fixture's hash.
+	ASSERT_NO_FATAL_FAILURE(TestCreateDungeon(sweepCase.level, sweepCase.seed, sweepCase.entry));
+
+	const std::string expected = fmt::format("{} {:016x}\n", sweepCase.seed, HashDungeonLayout());
+	EXPECT_EQ(RunSweepWorker(sweepCase), expected) << sweepCase.fixture;
+}
+
+INSTANTIATE_TEST_SUITE_P(Fixtures, DrlgSweepTest, ::testing::ValuesIn(SweepCases));
+
+} // namespace
@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <benchmark/benchmark.h>
@@ -12,6 +13,7 @@
 #include "engine/lighting_defs.hpp"
 #include "engine/load_file.hpp"
 #include "engine/render/dun_render.hpp"
+#include "engine/render/lightmap_blit.hpp"
 #include "engine/surface.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung.h"
@@ -122,6 +124,62 @@ DEFINE_FOR_TILE_TYPE(Square)
 DEFINE_FOR_TILE_TYPE(LeftTrapezoid)
 DEFINE_FOR_TILE_TYPE(RightTrapezoid)
 
+void RunPerPixelForTileMask(benchmark::State &state, TileType tileType, MaskType maskType, LightmapBlitIsa isa)
+{
+	const LightmapBlitIsa defaultIsa = GetLightmapBlitIsa();
+	if (!SetLightmapBlitIsa(isa)) {
+		state.SkipWithError("Instruction set not supported");
+		return;
+	}
+
+	const Surface out = Surface(SdlSurface.get());
+	// Light levels change gradually across the screen, with a few levels per tile.
+	std::vector<uint8_t> lightmapBuffer(static_cast<size_t>(out.pitch()) * out.h());
+	for (int y = 0; y < out.h(); ++y) {
+		for (int x = 0; x < out.pitch(); ++x) {
+			lightmapBuffer[(y * out.pitch()) + x] = static_cast<uint8_t>(((x + y) / 24) % NumLightingLevels);
+		}
+	}
+	const Lightmap lightmap(out.at(0, 0), lightmapBuffer, out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable);
+
+	GetOptions().Graphics.perPixelLighting.SetValue(true);
+	const std::span<const LevelCelBlock> tiles = Tiles[tileType];
+	for (auto _ : state) {
+		for (const LevelCelBlock &levelCelBlock : tiles) {
+			RenderTile(out, lightmap, Point { 320, 240 }, BmDunCelData.get(), levelCelBlock, maskType, PartiallyLit());
+			uint8_t color = out[Point { 310, 200 }];
+			benchmark::DoNotOptimize(color);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * tiles.size());
+	GetOptions().Graphics.perPixelLighting.SetValue(false);
+	SetLightmapBlitIsa(defaultIsa);
+}
+
+template <TileType TileT, MaskType MaskT, LightmapBlitIsa IsaT>
+void RenderPerPixel(benchmark::State &state)
+{
+	InitOnce();
+	RunPerPixelForTileMask(state, TileT, MaskT, IsaT);
+}
+
+constexpr auto Scalar = LightmapBlitIsa::Scalar;
+constexpr auto AVX2 = LightmapBlitIsa::AVX2;
+constexpr auto NEON = LightmapBlitIsa::NEON;
+
+#define DEFINE_PER_PIXEL_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE) \
+	BENCHMARK_TEMPLATE(RenderPerPixel, TILE_TYPE, MASK_TYPE, Scalar); \
+	BENCHMARK_TEMPLATE(RenderPerPixel, TILE_TYPE, MASK_TYPE, AVX2);   \
+	BENCHMARK_TEMPLATE(RenderPerPixel, TILE_TYPE, MASK_TYPE, NEON);
+
+#define DEFINE_PER_PIXEL_FOR_TILE_TYPE(TILE_TYPE)             \
+	DEFINE_PER_PIXEL_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, Solid) \
+	DEFINE_PER_PIXEL_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, Transparent)
+
+DEFINE_PER_PIXEL_FOR_TILE_TYPE(LeftTriangle)
+DEFINE_PER_PIXEL_FOR_TILE_TYPE(Square)
+DEFINE_PER_PIXEL_FOR_TILE_TYPE(LeftTrapezoid)
+
 void BM_RenderBlackTile(benchmark::State &state)
 {
 	InitOnce();
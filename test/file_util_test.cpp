@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <cstdio>
+#include <span>
+#include <vector>
 
 #include "utils/file_util.h"
 
@@ -41,6 +44,15 @@ TEST(FileUtil, GetFileSize)
 	EXPECT_EQ(result, 42);
 }
 
+TEST(FileUtil, GetFileModificationTime)
+{
+	const std::string path = GetTmpPathName();
+	WriteDummyFile(path.c_str(), 42);
+	std::int64_t time;
+	EXPECT_TRUE(GetFileModificationTime(path.c_str(), &time));
+	EXPECT_FALSE(GetFileModificationTime("this-file-should-not-exist", &time));
+}
+
 TEST(FileUtil, FileExists)
 {
 	EXPECT_FALSE(FileExists("this-file-should-not-exist"));
@@ -82,4 +94,48 @@ TEST(FileUtil, RecursivelyCreateDir)
 	EXPECT_TRUE(DirectoryExists(path.c_str()));
 }
 
+constexpr char CacheMagic[4] = { 'T', 'E', 'S', 'T' };
+
+bool ReadCacheFileToVector(const std::string &path, uint32_t version, uint64_t key, std::vector<std::byte> &data)
+{
+	return ReadCacheFile(path.c_str(), CacheMagic, version, key, [&data](size_t size) {
+		data.resize(size);
+		return data.data();
+	});
+}
+
+TEST(FileUtil, CacheFile)
+{
+	const std::string path = GetTmpPathName(".bin");
+	const std::byte first[] = { std::byte { 1 }, std::byte { 2 }, std::byte { 3 } };
+	const std::byte second[] = { std::byte { 4 } };
+	ASSERT_TRUE(WriteCacheFile(path.c_str(), CacheMagic, 1, 42, { first, second }));
+	EXPECT_FALSE(FileExists(path + ".tmp"));
+
+	std::vector<std::byte> data;
+	ASSERT_TRUE(ReadCacheFileToVector(path, 1, 42, data));
+	EXPECT_EQ(data, (std::vector<std::byte> { std::byte { 1 }, std::byte { 2 }, std::byte { 3 }, std::byte { 4 } }));
+
+	EXPECT_FALSE(ReadCacheFileToVector(path, 2, 42, data));
+	EXPECT_FALSE(ReadCacheFileToVector(path, 1, 43, data));
+	EXPECT_FALSE(ReadCacheFile(path.c_str(), CacheMagic, 1, 42, [](size_t) -> std::byte * { return nullptr; }));
+}
+
+TEST(FileUtil, TruncatedCacheFile)
+{
+	const std::string path = GetTmpPathName(".bin");
+	const std::byte data[64] {};
+	ASSERT_TRUE(WriteCacheFile(path.c_str(), CacheMagic, 1, 42, { data }));
+	std::uintmax_t size;
+	ASSERT_TRUE(GetFileSize(path.c_str(), &size));
+	ASSERT_TRUE(ResizeFile(path.c_str(), size - 1));
+
+	bool bufferRequested = false;
+	EXPECT_FALSE(ReadCacheFile(path.c_str(), CacheMagic, 1, 42, [&bufferRequested](size_t) -> std::byte * {
+		bufferRequested = true;
+		return nullptr;
+	}));
+	EXPECT_FALSE(bufferRequested);
+}
+
 } // namespace
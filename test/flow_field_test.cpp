@@ -0,0 +1,229 @@
+#include "engine/flow_field.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/path.h"
+
+namespace devilution {
+namespace {
+
+WalkabilityGrid MakeGrid(Size size, const char *map)
+{
+	WalkabilityGrid grid { size };
+	for (int y = 0; y < size.height; y++) {
+		for (int x = 0; x < size.width; x++) {
+			const bool open = map[(y * size.width) + x] != '#';
+			grid.setTile({ x, y }, open, open);
+		}
+	}
+	return grid;
+}
+
+/** Maps the steps returned by GetPathDirection back to a displacement */
+constexpr Displacement PathSteps[9] = { { 0, 0 }, { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 }, { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+
+int StepCost(int8_t step)
+{
+	return PathSteps[step].deltaX != 0 && PathSteps[step].deltaY != 0 ? PathDiagonalStepCost : PathAxisAlignedStepCost;
+}
+
+int PathCost(const int8_t *path, int length)
+{
+	int cost = 0;
+	for (int i = 0; i < length; i++)
+		cost += StepCost(path[i]);
+	return cost;
+}
+
+TEST(FlowFieldTest, WalkabilityGridOutOfBounds)
+{
+	const WalkabilityGrid grid = MakeGrid({ 2, 2 }, "....");
+	EXPECT_TRUE(grid.isWalkable({ 1, 1 }));
+	EXPECT_FALSE(grid.isWalkable({ -1, 0 }));
+	EXPECT_FALSE(grid.isWalkable({ 2, 0 }));
+	EXPECT_FALSE(grid.isNotSolid({ 0, 2 }));
+}
+
+TEST(FlowFieldTest, CanStepDoesNotCutCorners)
+{
+	const WalkabilityGrid grid = MakeGrid({ 3, 3 },
+	    ".#."
+	    "..."
+	    "...");
+	EXPECT_TRUE(grid.canStep({ 0, 0 }, { 0, 1 }));
+	EXPECT_TRUE(grid.canStep({ 0, 1 }, { 1, 2 }));
+	EXPECT_FALSE(grid.canStep({ 0, 0 }, { 1, 1 }));
+	EXPECT_FALSE(grid.canStep({ 2, 0 }, { 1, 1 }));
+	EXPECT_FALSE(grid.canStep({ 1, 1 }, { 2, 0 }));
+}
+
+std::vector<char> MakeRandomMap(Size size, int wallPercent, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> percent(0, 99);
+	std::vector<char> map(static_cast<size_t>(size.width * size.height));
+	for (char &tile : map)
+		tile = percent(rng) < wallPercent ? '#' : '.';
+	return map;
+}
+
+TEST(FlowFieldTest, MatchesFindPathCosts)
+{
+	constexpr Size MapSize { 40, 40 };
+	constexpr size_t MaxPathLength = 25;
+	const std::vector<char> map = MakeRandomMap(MapSize, 25, 7);
+	const WalkabilityGrid grid = MakeGrid(MapSize, map.data());
+	const Point target { 20, 20 };
+	FlowField field;
+	field.build(grid, target, MaxPathLength);
+
+	for (int y = 0; y < MapSize.height; y++) {
+		for (int x = 0; x < MapSize.width; x++) {
+			const Point start { x, y };
+			if (start == target || !grid.isWalkable(start))
+				continue;
+			int8_t path[MaxPathLength];
+			// Like a player standing on the target, so the last step doesn't check corners
+			const int length = FindPath([&grid](Point a, Point b) { return grid.canStep(a, b); },
+			    [&](Point position) { return position != target && grid.isWalkable(position); },
+			    start, target, path, MaxPathLength);
+			if (length == 0) {
+				EXPECT_EQ(field.cost(start), FlowField::Unreachable) << "from " << start;
+				continue;
+			}
+			EXPECT_EQ(field.cost(start), PathCost(path, length)) << "from " << start;
+		}
+	}
+}
+
+TEST(FlowFieldTest, FirstStepMatchesFindPath)
+{
+	constexpr Size MapSize { 40, 40 };
+	int searches = 0;
+	int skippedSearches = 0;
+	for (unsigned seed = 1; seed <= 2; seed++) {
+		const std::vector<char> map = MakeRandomMap(MapSize, 30, seed);
+		const WalkabilityGrid grid = MakeGrid(MapSize, map.data());
+		// Monsters in the way, which the field doesn't know about
+		const std::vector<char> occupied = MakeRandomMap(MapSize, 15, seed + 100);
+		bool searched = false;
+		const auto canStep = [&](Point a, Point b) {
+			searched = true;
+			return grid.canStep(a, b);
+		};
+
+		for (const Point target : { Point { 20, 20 }, Point { 5, 33 } }) {
+			FlowFieldCache cache { MaxPathLengthMonsters };
+			for (const bool targetOccupied : { false, true }) {
+				const auto posOk = [&](Point position) {
+					if (position == target)
+						return !targetOccupied && grid.isWalkable(position);
+					return grid.isWalkable(position) && occupied[static_cast<size_t>((position.y * MapSize.width) + position.x)] != '#';
+				};
+				for (int y = 0; y < MapSize.height; y++) {
+					for (int x = 0; x < MapSize.width; x++) {
+						const Point start { x, y };
+						if (start == target)
+							continue;
+						int8_t path[MaxPathLengthMonsters];
+						const int length = FindPath(canStep, posOk, start, target, path, MaxPathLengthMonsters);
+						const int8_t expected = length == 0 ? 0 : path[0];
+						searched = false;
+						EXPECT_EQ(cache.firstStep(grid, canStep, posOk, start, target), expected)
+						    << "from " << start << " to " << target << (targetOccupied ? " (occupied)" : "");
+						searches++;
+						if (!searched)
+							skippedSearches++;
+					}
+				}
+			}
+		}
+	}
+	// Both the shortcut and the search need to be covered
+	EXPECT_GT(skippedSearches, searches / 10);
+	EXPECT_LT(skippedSearches, searches - (searches / 10));
+}
+
+TEST(FlowFieldTest, BuildsFieldsOnlyForTargetsWithoutPath)
+{
+	const WalkabilityGrid grid = MakeGrid({ 8, 3 },
+	    "...#...."
+	    "...#...."
+	    "...#....");
+	const auto canStep = [&grid](Point a, Point b) { return grid.canStep(a, b); };
+	const auto posOk = [&grid](Point position) { return grid.isWalkable(position); };
+	FlowFieldCache cache { MaxPathLengthMonsters };
+
+	EXPECT_NE(cache.firstStep(grid, canStep, posOk, { 0, 0 }, { 2, 2 }), 0);
+	EXPECT_NE(cache.firstStep(grid, canStep, posOk, { 1, 0 }, { 2, 2 }), 0);
+	EXPECT_EQ(cache.builds(), 0);
+
+	EXPECT_EQ(cache.firstStep(grid, canStep, posOk, { 0, 0 }, { 6, 1 }), 0);
+	EXPECT_EQ(cache.builds(), 1);
+	bool searched = false;
+	const auto countingCanStep = [&](Point a, Point b) {
+		searched = true;
+		return grid.canStep(a, b);
+	};
+	EXPECT_EQ(cache.firstStep(grid, countingCanStep, posOk, { 1, 2 }, { 6, 1 }), 0);
+	EXPECT_FALSE(searched) << "The field rules out the search";
+	EXPECT_NE(cache.firstStep(grid, canStep, posOk, { 4, 0 }, { 6, 1 }), 0);
+	EXPECT_EQ(cache.builds(), 1);
+
+	cache.clear();
+	EXPECT_EQ(cache.firstStep(grid, countingCanStep, posOk, { 1, 2 }, { 6, 1 }), 0);
+	EXPECT_TRUE(searched);
+	EXPECT_EQ(cache.builds(), 2);
+}
+
+TEST(FlowFieldTest, OccupiedTargetAcrossCorner)
+{
+	const WalkabilityGrid grid = MakeGrid({ 2, 2 },
+	    ".#"
+	    "#.");
+	const Point target { 1, 1 };
+	FlowField field;
+	field.build(grid, target, MaxPathLengthMonsters);
+	EXPECT_EQ(field.cost({ 0, 0 }), PathDiagonalStepCost);
+
+	FlowFieldCache cache { MaxPathLengthMonsters };
+	const auto canStep = [&grid](Point a, Point b) { return grid.canStep(a, b); };
+	const auto posOk = [&](Point position) { return position != target && grid.isWalkable(position); };
+	EXPECT_EQ(cache.firstStep(grid, canStep, posOk, { 0, 0 }, target), GetPathDirection({ 0, 0 }, target));
+}
+
+TEST(FlowFieldTest, TargetDoesNotNeedToBeWalkable)
+{
+	const WalkabilityGrid grid = MakeGrid({ 3, 1 }, "..#");
+	FlowField field;
+	field.build(grid, { 2, 0 }, MaxPathLengthMonsters);
+	EXPECT_EQ(field.cost({ 0, 0 }), 2 * PathAxisAlignedStepCost);
+
+	FlowFieldCache cache { MaxPathLengthMonsters };
+	const auto canStep = [&grid](Point a, Point b) { return grid.canStep(a, b); };
+	EXPECT_EQ(cache.firstStep(grid, canStep, [](Point) { return false; }, { 1, 0 }, { 2, 0 }), GetPathDirection({ 1, 0 }, { 2, 0 }));
+}
+
+TEST(FlowFieldTest, LongPaths)
+{
+	WalkabilityGrid grid { Size { 112, 112 } };
+	for (int y = 0; y < 112; y++) {
+		for (int x = 0; x < 112; x++) {
+			grid.setTile({ x, y }, true, true);
+		}
+	}
+	const Point target { 56, 56 };
+	FlowField field;
+	field.build(grid, target, 24);
+	EXPECT_EQ(field.cost(target + Displacement { 24, 24 }), 24 * PathDiagonalStepCost);
+	EXPECT_EQ(field.cost(target + Displacement { 25, 25 }), FlowField::Unreachable);
+	EXPECT_EQ(field.cost(target + Displacement { -24, 10 }), 10 * PathDiagonalStepCost + 14 * PathAxisAlignedStepCost);
+}
+
+} // namespace
+} // namespace devilution
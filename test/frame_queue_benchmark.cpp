@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dvlnet/frame_queue.h"
+#include "dvlnet/packet.h"
+
+namespace devilution::net {
+namespace {
+
+constexpr plr_t NumPlayers = 4;
+constexpr int NumTicks = 64;
+/** Bytes delivered per receive, small enough that frames get split between receives */
+constexpr size_t ReceiveSize = 1460;
+
+void AppendFrame(buffer_t &stream, tl::expected<std::unique_ptr<packet>, PacketError> &&pkt)
+{
+	const buffer_t frame = *frame_queue::MakeFrame((*pkt)->Data());
+	stream.insert(stream.end(), frame.begin(), frame.end());
+}
+
+/**
+ * @brief The data a player sends during a game: a turn and a few small game commands per tick.
+ */
+buffer_t MakeTurnTraffic(packet_factory &factory, plr_t player)
+{
+	buffer_t stream;
+	for (int tick = 0; tick < NumTicks; tick++) {
+		const turn_t turn { static_cast<seq_t>(tick), tick * 4 + player };
+		AppendFrame(stream, factory.make_packet<PT_TURN>(player, PLR_BROADCAST, turn));
+		for (int i = 0; i < tick % 3; i++) {
+			AppendFrame(stream, factory.make_packet<PT_MESSAGE>(player, PLR_BROADCAST, buffer_t(12 + 8 * i, static_cast<unsigned char>(tick))));
+		}
+	}
+	return stream;
+}
+
+void Receive(frame_queue &queue, std::span<const unsigned char> data)
+{
+	while (!data.empty()) {
+		const std::span<unsigned char> buffer = queue.WriteBuffer();
+		const size_t count = std::min({ data.size(), buffer.size(), ReceiveSize });
+		std::copy_n(data.begin(), count, buffer.begin());
+		queue.CommitWrite(count);
+		data = data.subspan(count);
+	}
+}
+
+/** @brief Client side: splits what the server forwards into packets and parses them. */
+void BM_ReceiveTurnTraffic(benchmark::State &state)
+{
+	packet_factory factory;
+	std::vector<buffer_t> streams;
+	size_t totalSize = 0;
+	for (plr_t player = 0; player < NumPlayers; player++) {
+		streams.push_back(MakeTurnTraffic(factory, player));
+		totalSize += streams.back().size();
+	}
+
+	frame_queue queue;
+	int64_t packets = 0;
+	for (auto _ : state) {
+		for (const buffer_t &stream : streams) {
+			for (size_t offset = 0; offset < stream.size(); offset += ReceiveSize) {
+				Receive(queue, std::span(stream).subspan(offset, std::min(ReceiveSize, stream.size() - offset)));
+				while (*queue.PacketReady()) {
+					tl::expected<packet_in, PacketError> pkt = factory.parse_packet(*queue.ReadPacket());
+					benchmark::DoNotOptimize(pkt->Source());
+					packets++;
+				}
+			}
+		}
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * totalSize));
+	state.SetItemsProcessed(packets);
+}
+
+/** @brief Server side: every packet is parsed and framed again for the other players. */
+void BM_RelayTurnTraffic(benchmark::State &state)
+{
+	packet_factory factory;
+	std::vector<buffer_t> streams;
+	size_t totalSize = 0;
+	for (plr_t player = 0; player < NumPlayers; player++) {
+		streams.push_back(MakeTurnTraffic(factory, player));
+		totalSize += streams.back().size();
+	}
+
+	std::vector<frame_queue> connections(NumPlayers);
+	int64_t packets = 0;
+	for (auto _ : state) {
+		for (plr_t player = 0; player < NumPlayers; player++) {
+			const buffer_t &stream = streams[player];
+			frame_queue &queue = connections[player];
+			for (size_t offset = 0; offset < stream.size(); offset += ReceiveSize) {
+				Receive(queue, std::span(stream).subspan(offset, std::min(ReceiveSize, stream.size() - offset)));
+				while (*queue.PacketReady()) {
+					tl::expected<packet_in, PacketError> pkt = factory.parse_packet(*queue.ReadPacket());
+					for (plr_t destination = 0; destination < NumPlayers; destination++) {
+						if (destination == pkt->Source())
+							continue;
+						tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt->Data());
+						benchmark::DoNotOptimize(frame->data());
+					}
+					packets++;
+				}
+			}
+		}
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * totalSize));
+	state.SetItemsProcessed(packets);
+}
+
+BENCHMARK(BM_ReceiveTurnTraffic);
+BENCHMARK(BM_RelayTurnTraffic);
+
+} // namespace
+} // namespace devilution::net
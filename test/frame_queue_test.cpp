@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dvlnet/frame_queue.h"
+#include "dvlnet/packet.h"
+
+namespace devilution::net {
+namespace {
+
+buffer_t MakeTestFrame(uint16_t size, uint16_t flags = 0)
+{
+	buffer_t data(size);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<unsigned char>(i * 7 + size);
+	return *frame_queue::MakeFrame(data, flags);
+}
+
+void ExpectFrame(frame_queue &queue, uint16_t size, uint16_t flags = 0)
+{
+	const buffer_t frame = MakeTestFrame(size, flags);
+	tl::expected<bool, PacketError> ready = queue.PacketReady();
+	ASSERT_TRUE(ready.has_value());
+	ASSERT_TRUE(*ready);
+	EXPECT_EQ(queue.ReadPacketFlags(), flags);
+	tl::expected<std::span<const unsigned char>, PacketError> packet = queue.ReadPacket();
+	ASSERT_TRUE(packet.has_value());
+	EXPECT_EQ(buffer_t(packet->begin(), packet->end()), buffer_t(frame.begin() + 4, frame.end()));
+}
+
+TEST(FrameQueueTest, MakeFrame)
+{
+	const unsigned char data[] = { 1, 2, 3 };
+	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(data, 0x8000);
+	ASSERT_TRUE(frame.has_value());
+	EXPECT_EQ(*frame, (buffer_t { 3, 0, 0, 0x80, 1, 2, 3 }));
+
+	EXPECT_FALSE(frame_queue::MakeFrame(buffer_t(frame_queue::max_frame_size + 1)).has_value());
+}
+
+TEST(FrameQueueTest, ReadsFramesSplitAcrossWrites)
+{
+	frame_queue queue;
+	buffer_t stream;
+	for (const uint16_t size : { 1, 8, 300, 2 }) {
+		const buffer_t frame = MakeTestFrame(size, size == 300 ? 0x8000 : 0);
+		stream.insert(stream.end(), frame.begin(), frame.end());
+	}
+
+	// Deliver the stream one byte at a time, then everything else at once
+	for (size_t i = 0; i < 6; i++)
+		ASSERT_TRUE(queue.Write(std::span(stream).subspan(i, 1)).has_value());
+	ASSERT_TRUE(queue.PacketReady().has_value());
+	ExpectFrame(queue, 1);
+	EXPECT_FALSE(*queue.PacketReady());
+	ASSERT_TRUE(queue.Write(std::span(stream).subspan(6)).has_value());
+	ExpectFrame(queue, 8);
+	ExpectFrame(queue, 300, 0x8000);
+	ExpectFrame(queue, 2);
+	EXPECT_FALSE(*queue.PacketReady());
+}
+
+TEST(FrameQueueTest, ReceivesIntoRingBuffer)
+{
+	frame_queue queue;
+	EXPECT_EQ(queue.WriteBuffer().size(), frame_queue::capacity);
+
+	// Keep going around the ring with frames that don't evenly divide it, and always keep one frame queued so that
+	// the queue never starts over at the beginning, to get headers and frames that wrap around
+	const auto frameSize = [](int i) { return static_cast<uint16_t>(5000 + i * 997); };
+	for (int i = 0; i < 40; i++) {
+		const buffer_t frame = MakeTestFrame(frameSize(i));
+		std::span<const unsigned char> remaining = frame;
+		while (!remaining.empty()) {
+			const std::span<unsigned char> buffer = queue.WriteBuffer();
+			ASSERT_FALSE(buffer.empty());
+			const size_t count = std::min(remaining.size(), buffer.size());
+			std::copy_n(remaining.begin(), count, buffer.begin());
+			queue.CommitWrite(count);
+			remaining = remaining.subspan(count);
+		}
+		if (i == 0)
+			continue;
+		ExpectFrame(queue, frameSize(i - 1));
+		if (HasFatalFailure())
+			return;
+	}
+	ExpectFrame(queue, frameSize(39));
+}
+
+TEST(FrameQueueTest, RejectsOverflowAndEmptyFrames)
+{
+	frame_queue queue;
+	EXPECT_FALSE(queue.Write(buffer_t(frame_queue::capacity + 1)).has_value());
+
+	ASSERT_TRUE(queue.Write(buffer_t(4)).has_value());
+	EXPECT_FALSE(queue.PacketReady().has_value());
+}
+
+TEST(FrameQueueTest, ParsesPacketsInPlace)
+{
+	packet_factory factory;
+	tl::expected<std::unique_ptr<packet>, PacketError> outgoing = factory.make_packet<PT_TURN>(plr_t { 1 }, PLR_BROADCAST, turn_t { 5, 0x12345678 });
+	ASSERT_TRUE(outgoing.has_value());
+
+	frame_queue queue;
+	ASSERT_TRUE(queue.Write(*frame_queue::MakeFrame((*outgoing)->Data())).has_value());
+	ASSERT_TRUE(*queue.PacketReady());
+	tl::expected<std::span<const unsigned char>, PacketError> data = queue.ReadPacket();
+	ASSERT_TRUE(data.has_value());
+
+	tl::expected<packet_in, PacketError> pkt = factory.parse_packet(*data);
+	ASSERT_TRUE(pkt.has_value());
+	EXPECT_EQ(pkt->Type(), PT_TURN);
+	EXPECT_EQ(pkt->Source(), 1);
+	EXPECT_EQ(pkt->Destination(), PLR_BROADCAST);
+	EXPECT_EQ(pkt->Turn()->SequenceNumber, 5);
+	EXPECT_EQ(pkt->Turn()->Value, 0x12345678);
+	// Forwarding uses the received data as is
+	EXPECT_EQ(pkt->Data().data(), data->data());
+
+	const unsigned char truncated[] = { PT_TURN, 1, PLR_BROADCAST, 5 };
+	EXPECT_FALSE(factory.parse_packet(truncated).has_value());
+}
+
+} // namespace
+} // namespace devilution::net
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/lighting_defs.hpp"
+#include "engine/point.hpp"
+#include "engine/render/light_render.hpp"
+#include "levels/dun_tile.hpp"
+#include "levels/gendung_defs.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr int ViewportWidth = 640;
+constexpr int ViewportHeight = 352;
+
+uint8_t TileLights[MAXDUNX][MAXDUNY];
+std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> LightTables;
+
+class LightmapTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		for (int x = 0; x < MAXDUNX; x++) {
+			for (int y = 0; y < MAXDUNY; y++) {
+				TileLights[x][y] = static_cast<uint8_t>(((x * 7) + (y * 3)) % (LightsMax + 1));
+			}
+		}
+	}
+
+	Lightmap BuildLightmap() const
+	{
+		return Lightmap::build(/*perPixelLighting=*/true, { 48, 44 }, { 0, -17 },
+		    ViewportWidth, ViewportHeight, /*rows=*/25, /*columns=*/10,
+		    out.data(), ViewportWidth, LightTables, LightTables[0].data(), LightTables.back().data(),
+		    TileLights, /*microTileLen=*/10);
+	}
+
+	[[nodiscard]] const uint8_t *OutAt(int x, int y) const
+	{
+		return out.data() + (y * ViewportWidth) + x;
+	}
+
+	std::vector<uint8_t> out = std::vector<uint8_t>(ViewportWidth * ViewportHeight);
+};
+
+TEST_F(LightmapTest, SubregionYMatchesFullLightmap)
+{
+	const Lightmap lightmap = BuildLightmap();
+	for (const int bandY : { 0, 64, 200 }) {
+		const Lightmap band = lightmap.subregionY(bandY);
+		for (int y = bandY; y < ViewportHeight; y++) {
+			for (int x = 0; x < ViewportWidth; x += 7) {
+				ASSERT_EQ(*band.getLightingAt(OutAt(x, y)), *lightmap.getLightingAt(OutAt(x, y)))
+				    << "band " << bandY << " at " << x << "," << y;
+			}
+		}
+	}
+}
+
+TEST_F(LightmapTest, BleedUpWithinBandMatchesFullLightmap)
+{
+	constexpr int BandY = 64;
+	constexpr int BandHeight = 96;
+
+	const Lightmap lightmap = BuildLightmap();
+	const Lightmap band = lightmap.subregionY(BandY);
+	for (const int tileX : { -16, 0, 288, 608 }) {
+		for (const int tileY : { 40, 64, 80, 95, 159, 170, 300, 400 }) {
+			uint8_t fullBuffer[TILE_WIDTH * TILE_HEIGHT];
+			uint8_t bandBuffer[TILE_WIDTH * TILE_HEIGHT];
+			const Lightmap fullBleed = Lightmap::bleedUp(true, lightmap, { tileX, tileY }, fullBuffer);
+			const Lightmap bandBleed = Lightmap::bleedUp(true, band, { tileX, tileY - BandY }, bandBuffer);
+
+			for (int y = std::max(tileY - TILE_HEIGHT + 1, BandY); y <= tileY && y < BandY + BandHeight; y++) {
+				for (int x = std::max(tileX, 0); x < tileX + TILE_WIDTH && x < ViewportWidth; x++) {
+					ASSERT_EQ(*bandBleed.getLightingAt(OutAt(x, y)), *fullBleed.getLightingAt(OutAt(x, y)))
+					    << "tile " << tileX << "," << tileY << " at " << x << "," << y;
+				}
+			}
+		}
+	}
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,219 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "levels/gendung.h"
+#include "lighting.h"
+#include "player.h"
+#include "vision.hpp"
+
+using namespace devilution;
+
+namespace {
+
+void InitTestLevel(dungeon_type type, std::mt19937 &rng)
+{
+	leveltype = type;
+	MakeLightTable();
+	InitLighting();
+
+	SOLData[0] = TileProperties::None;
+	SOLData[1] = TileProperties::Solid | TileProperties::BlockLight;
+	std::uniform_int_distribution<int> percent(0, 99);
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			dPiece[x][y] = percent(rng) < 5 ? 1 : 0;
+			dPreLight[x][y] = percent(rng) < 10 ? 8 : LightsMax;
+		}
+	}
+	RestorePreLighting();
+}
+
+void ExpectMatchesFullRebuild(int tick)
+{
+	uint8_t incremental[MAXDUNX][MAXDUNY];
+	memcpy(incremental, dLight, sizeof(dLight));
+
+	memcpy(dLight, dPreLight, sizeof(dLight));
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const Light &light = Lights[ActiveLights[i]];
+		if (!TileHasAny(light.position.tile, TileProperties::Solid))
+			DoLighting(light.position.tile, light.radius, light.position.offset);
+	}
+
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			ASSERT_EQ(incremental[x][y], dLight[x][y]) << "at " << x << "," << y << " on tick " << tick;
+		}
+	}
+	memcpy(dLight, incremental, sizeof(dLight));
+}
+
+void MoveLightsAround(dungeon_type type)
+{
+	std::mt19937 rng(1234);
+	InitTestLevel(type, rng);
+
+	std::uniform_int_distribution<int> coord(20, MAXDUNX - 20);
+	std::uniform_int_distribution<int> radius(1, 10);
+	std::uniform_int_distribution<int> step(-1, 1);
+	std::uniform_int_distribution<int> offset(-7, 7);
+	std::uniform_int_distribution<int> action(0, 9);
+
+	for (int i = 0; i < 24; i++)
+		AddLight({ coord(rng), coord(rng) }, radius(rng));
+	ProcessLightList();
+	ExpectMatchesFullRebuild(0);
+
+	for (int tick = 1; tick <= 300; tick++) {
+		const int count = ActiveLightCount;
+		for (int i = 0; i < count; i++) {
+			const int lid = ActiveLights[i];
+			const Light &light = Lights[lid];
+			switch (action(rng)) {
+			case 0:
+				ChangeLightXY(lid, light.position.tile + Displacement { step(rng), step(rng) });
+				break;
+			case 1:
+				ChangeLightOffset(lid, { static_cast<int8_t>(offset(rng)), static_cast<int8_t>(offset(rng)) });
+				break;
+			case 2:
+				ChangeLightRadius(lid, radius(rng));
+				break;
+			case 3:
+				if (step(rng) == 0)
+					AddUnLight(lid);
+				break;
+			default:
+				break;
+			}
+		}
+		if (ActiveLightCount < 24)
+			AddLight({ coord(rng), coord(rng) }, radius(rng));
+		ProcessLightList();
+		ExpectMatchesFullRebuild(tick);
+		if (::testing::Test::HasFatalFailure())
+			return;
+	}
+}
+
+TEST(Lighting, IncrementalUpdateMatchesFullRebuild)
+{
+	MoveLightsAround(DTYPE_CATACOMBS);
+}
+
+TEST(Lighting, IncrementalUpdateMatchesFullRebuildWithDimLights)
+{
+	MoveLightsAround(DTYPE_NEST);
+}
+
+void ExpectVisionMatchesFullRebuild(int tick)
+{
+	bool visible[MAXDUNX][MAXDUNY] = {};
+	bool lit[MAXDUNX][MAXDUNY] = {};
+	std::array<bool, 256> transList = {};
+	for (const Player &player : Players) {
+		if (!VisionActive[player.getId()])
+			continue;
+		const Light &vision = VisionList[player.getId()];
+		DoVision(
+		    vision.position.tile, vision.radius,
+		    [&](Point position) {
+			    visible[position.x][position.y] = true;
+			    if (&player == MyPlayer)
+				    lit[position.x][position.y] = true;
+		    },
+		    [&](Point position) {
+			    if (dTransVal[position.x][position.y] != 0)
+				    transList[dTransVal[position.x][position.y]] = true;
+		    },
+		    [](Point position) { return InDungeonBounds(position) && !TileHasAny(position, TileProperties::BlockLight); },
+		    [](Point position) { return InDungeonBounds(position); });
+	}
+
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			ASSERT_EQ(HasAnyOf(dFlags[x][y], DungeonFlag::Visible), visible[x][y]) << "at " << x << "," << y << " on tick " << tick;
+			ASSERT_EQ(HasAnyOf(dFlags[x][y], DungeonFlag::Lit), lit[x][y]) << "at " << x << "," << y << " on tick " << tick;
+		}
+	}
+	EXPECT_EQ(TransList, transList) << "on tick " << tick;
+}
+
+TEST(Lighting, VisionUpdatesMatchFullRebuild)
+{
+	std::mt19937 rng(99);
+	InitTestLevel(DTYPE_CAVES, rng);
+	memset(dFlags, 0, sizeof(dFlags));
+	std::uniform_int_distribution<int> trans(0, 3);
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			dTransVal[x][y] = static_cast<int8_t>(trans(rng));
+		}
+	}
+
+	currlevel = 9;
+	setlevel = false;
+	Players.resize(MAXVISION);
+	MyPlayer = &Players[0];
+	std::uniform_int_distribution<int> coord(30, MAXDUNX - 30);
+	std::uniform_int_distribution<int> radius(2, 15);
+	for (Player &player : Players) {
+		player.plractive = true;
+		player.plrlevel = currlevel;
+		player.plrIsOnSetLevel = false;
+		player._pLvlChanging = false;
+		player.friendlyMode = true;
+		ActivateVision({ coord(rng), coord(rng) }, radius(rng), player.getId());
+	}
+	ProcessVisionList();
+	ExpectVisionMatchesFullRebuild(0);
+
+	std::uniform_int_distribution<int> step(-1, 1);
+	std::uniform_int_distribution<int> action(0, 9);
+	for (int tick = 1; tick <= 200; tick++) {
+		for (const Player &player : Players) {
+			const size_t id = player.getId();
+			const Light &vision = VisionList[id];
+			switch (action(rng)) {
+			case 0:
+			case 1:
+				ChangeVisionXY(id, vision.position.tile + Displacement { step(rng), step(rng) });
+				break;
+			case 2:
+				ChangeVisionRadius(id, radius(rng));
+				break;
+			default:
+				break;
+			}
+		}
+		ProcessVisionList();
+		ExpectVisionMatchesFullRebuild(tick);
+		if (::testing::Test::HasFatalFailure())
+			return;
+	}
+}
+
+TEST(Lighting, RestorePreLightingAddsAllLightsBack)
+{
+	std::mt19937 rng(42);
+	InitTestLevel(DTYPE_CAVES, rng);
+	dPiece[30][30] = 0;
+	const int lid = AddLight({ 30, 30 }, 5);
+	ProcessLightList();
+	EXPECT_EQ(dLight[30][30], 0);
+
+	RestorePreLighting();
+	EXPECT_EQ(dLight[30][30], dPreLight[30][30]);
+	ProcessLightList();
+	EXPECT_EQ(dLight[30][30], 0);
+
+	AddUnLight(lid);
+	ProcessLightList();
+	EXPECT_EQ(dLight[30][30], dPreLight[30][30]);
+}
+
+} // namespace
@@ -0,0 +1,91 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/lighting_defs.hpp"
+#include "engine/render/lightmap_blit.hpp"
+#include "utils/palette_blending.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr unsigned MaxLength = 64;
+
+class LightmapBlitTest : public ::testing::TestWithParam<LightmapBlitIsa> {
+protected:
+	void SetUp() override
+	{
+		if (!SetLightmapBlitIsa(GetParam()))
+			GTEST_SKIP() << LightmapBlitIsaToString(GetParam()) << " is not supported";
+
+		for (size_t level = 0; level < NumLightingLevels; ++level) {
+			for (size_t color = 0; color < LightTableSize; ++color) {
+				lightTables[level][color] = static_cast<uint8_t>((color * 3) + (level * 17));
+			}
+		}
+		for (int i = 0; i < 256; ++i) {
+			for (int j = 0; j < 256; ++j) {
+				paletteTransparencyLookup[i][j] = static_cast<uint8_t>((i + j) / 2);
+			}
+		}
+		for (unsigned i = 0; i < MaxLength; ++i) {
+			src[i] = static_cast<uint8_t>(253 + (i * 37));
+			dst[i] = static_cast<uint8_t>(i * 91);
+			// Mostly smooth gradients, like the lightmap, with the occasional jump
+			light[i] = static_cast<uint8_t>((i / 5 + (i % 23 == 0 ? 9 : 0)) % NumLightingLevels);
+		}
+		// Exercise the lookups at the very end of the tables
+		light[MaxLength - 1] = LightsMax;
+		src[MaxLength - 1] = 255;
+		dst[MaxLength - 1] = 255;
+		lightTables[LightsMax][255] = 255;
+	}
+
+	void TearDown() override
+	{
+		SetLightmapBlitIsa(LightmapBlitIsa::Scalar);
+	}
+
+	[[nodiscard]] uint8_t Lit(unsigned i) const
+	{
+		return lightTables[light[i]][src[i]];
+	}
+
+	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
+	std::array<uint8_t, MaxLength> src;
+	std::array<uint8_t, MaxLength> dst;
+	std::array<uint8_t, MaxLength> light;
+};
+
+TEST_P(LightmapBlitTest, BlitLitPixels)
+{
+	for (unsigned length = 1; length <= MaxLength; ++length) {
+		std::array<uint8_t, MaxLength> out = dst;
+		BlitLitPixels(out.data(), src.data(), light.data(), length, lightTables[0].data());
+		for (unsigned i = 0; i < MaxLength; ++i) {
+			ASSERT_EQ(out[i], i < length ? Lit(i) : dst[i]) << "length " << length << " index " << i;
+		}
+	}
+}
+
+TEST_P(LightmapBlitTest, BlitLitPixelsBlended)
+{
+	for (unsigned length = 1; length <= MaxLength; ++length) {
+		std::array<uint8_t, MaxLength> out = dst;
+		BlitLitPixelsBlended(out.data(), src.data(), light.data(), length, lightTables[0].data());
+		for (unsigned i = 0; i < MaxLength; ++i) {
+			ASSERT_EQ(out[i], i < length ? paletteTransparencyLookup[dst[i]][Lit(i)] : dst[i]) << "length " << length << " index " << i;
+		}
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, LightmapBlitTest,
+    ::testing::Values(LightmapBlitIsa::Scalar, LightmapBlitIsa::AVX2, LightmapBlitIsa::NEON),
+    [](const ::testing::TestParamInfo<LightmapBlitIsa> &info) {
+	    return std::string(LightmapBlitIsaToString(info.param));
+    });
+
+} // namespace
+} // namespace devilution
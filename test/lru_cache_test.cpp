@@ -0,0 +1,78 @@
+#include "utils/lru_cache.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(LruCacheTest, FindsInsertedValues)
+{
+	LruCache<int, std::string> cache(4);
+	cache.insert(1, "one");
+	cache.insert(2, "two");
+	ASSERT_NE(cache.find(1), nullptr);
+	EXPECT_EQ(*cache.find(1), "one");
+	EXPECT_EQ(cache.find(3), nullptr);
+
+	cache.insert(1, "uno");
+	EXPECT_EQ(*cache.find(1), "uno");
+	EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed)
+{
+	LruCache<int, int> cache(3);
+	cache.insert(1, 10);
+	cache.insert(2, 20);
+	cache.insert(3, 30);
+	cache.find(1);
+	cache.insert(4, 40);
+
+	EXPECT_EQ(cache.size(), 3);
+	EXPECT_EQ(cache.find(2), nullptr);
+	EXPECT_NE(cache.find(1), nullptr);
+	EXPECT_NE(cache.find(3), nullptr);
+	EXPECT_NE(cache.find(4), nullptr);
+	EXPECT_EQ(cache.stats().evictions, 1);
+}
+
+TEST(LruCacheTest, CountsHitsAndMisses)
+{
+	LruCache<int, int> cache(2);
+	cache.insert(1, 10);
+	cache.find(1);
+	cache.find(1);
+	cache.find(2);
+
+	const LruCacheStats stats = cache.stats();
+	EXPECT_EQ(stats.hits, 2);
+	EXPECT_EQ(stats.misses, 1);
+	EXPECT_EQ(stats.evictions, 0);
+	EXPECT_EQ(stats.size, 1);
+
+	cache.resetStats();
+	EXPECT_EQ(cache.stats().hits, 0);
+	EXPECT_EQ(cache.stats().size, 1);
+}
+
+TEST(LruCacheTest, ShrinkingEvictsRightAway)
+{
+	LruCache<int, int> cache(4);
+	for (int i = 0; i < 4; i++)
+		cache.insert(i, i);
+	cache.setCapacity(2);
+	EXPECT_EQ(cache.size(), 2);
+	EXPECT_NE(cache.find(3), nullptr);
+	EXPECT_NE(cache.find(2), nullptr);
+	EXPECT_EQ(cache.find(1), nullptr);
+
+	cache.setCapacity(0);
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(cache.insert(5, 5), nullptr);
+	EXPECT_EQ(cache.find(5), nullptr);
+}
+
+} // namespace
+} // namespace devilution
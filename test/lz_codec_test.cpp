@@ -0,0 +1,107 @@
+#include "utils/lz_codec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+std::vector<std::byte> RoundTrip(const std::vector<std::byte> &data)
+{
+	std::vector<std::byte> compressed(LzCompressBound(data.size()));
+	const size_t compressedSize = LzCompressBlock(data.data(), data.size(), compressed.data(), compressed.size());
+	EXPECT_NE(compressedSize, 0U);
+	std::vector<std::byte> decompressed(data.size());
+	const size_t decompressedSize = LzDecompressBlock(compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+	decompressed.resize(decompressedSize);
+	return decompressed;
+}
+
+std::vector<std::byte> RandomBytes(size_t size, unsigned seed, int alphabet)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> dist(0, alphabet - 1);
+	std::vector<std::byte> data(size);
+	for (std::byte &b : data)
+		b = static_cast<std::byte>(dist(rng));
+	return data;
+}
+
+TEST(LzCodecTest, RoundTripsSmallInputs)
+{
+	for (size_t size = 1; size < 40; size++) {
+		const std::vector<std::byte> data(size, std::byte { 0x42 });
+		EXPECT_EQ(RoundTrip(data), data) << "size " << size;
+	}
+}
+
+TEST(LzCodecTest, RoundTripsRandomData)
+{
+	const std::vector<std::byte> data = RandomBytes(20000, 1, 256);
+	EXPECT_EQ(RoundTrip(data), data);
+}
+
+TEST(LzCodecTest, RoundTripsRepetitiveData)
+{
+	std::vector<std::byte> data = RandomBytes(100000, 2, 4);
+	// Long runs and far repeats exercise the extra length bytes and large offsets.
+	std::fill(data.begin() + 1000, data.begin() + 5000, std::byte { 0xFF });
+	std::copy(data.begin(), data.begin() + 3000, data.begin() + 70000);
+	EXPECT_EQ(RoundTrip(data), data);
+}
+
+TEST(LzCodecTest, ShrinksRepetitiveData)
+{
+	const std::vector<std::byte> data(4096, std::byte { 0xFF });
+	std::vector<std::byte> compressed(LzCompressBound(data.size()));
+	const size_t compressedSize = LzCompressBlock(data.data(), data.size(), compressed.data(), compressed.size());
+	EXPECT_GT(compressedSize, 0U);
+	EXPECT_LT(compressedSize, 64U);
+}
+
+TEST(LzCodecTest, CompressFailsWhenOutputDoesNotFit)
+{
+	const std::vector<std::byte> data = RandomBytes(1000, 3, 256);
+	std::vector<std::byte> compressed(500);
+	EXPECT_EQ(LzCompressBlock(data.data(), data.size(), compressed.data(), compressed.size()), 0U);
+}
+
+TEST(LzCodecTest, DecompressRejectsMalformedInput)
+{
+	std::vector<std::byte> out(64);
+	// Literal count beyond the end of the input
+	const std::byte truncated[] = { std::byte { 0x50 }, std::byte { 1 }, std::byte { 2 } };
+	EXPECT_EQ(LzDecompressBlock(truncated, sizeof(truncated), out.data(), out.size()), 0U);
+	// Match before the start of the output
+	const std::byte badOffset[] = { std::byte { 0x10 }, std::byte { 1 }, std::byte { 5 }, std::byte { 0 } };
+	EXPECT_EQ(LzDecompressBlock(badOffset, sizeof(badOffset), out.data(), out.size()), 0U);
+	// Output larger than the buffer
+	const std::byte tooLong[] = { std::byte { 0x1F }, std::byte { 1 }, std::byte { 1 }, std::byte { 0 }, std::byte { 200 } };
+	EXPECT_EQ(LzDecompressBlock(tooLong, sizeof(tooLong), out.data(), out.size()), 0U);
+}
+
+TEST(LzCodecTest, InPlaceRoundTrip)
+{
+	std::vector<std::byte> data = RandomBytes(10000, 4, 8);
+	const std::vector<std::byte> original = data;
+	const uint32_t compressedSize = LzCompress(data.data(), static_cast<uint32_t>(data.size()));
+	ASSERT_LT(compressedSize, data.size());
+	EXPECT_EQ(LzDecompress(data.data(), compressedSize, data.size()), data.size());
+	EXPECT_EQ(data, original);
+}
+
+TEST(LzCodecTest, InPlaceKeepsIncompressibleData)
+{
+	std::vector<std::byte> data = RandomBytes(300, 5, 256);
+	const std::vector<std::byte> original = data;
+	EXPECT_EQ(LzCompress(data.data(), static_cast<uint32_t>(data.size())), data.size());
+	EXPECT_EQ(data, original);
+}
+
+} // namespace
+} // namespace devilution
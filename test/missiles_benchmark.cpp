@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <list>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/direction.hpp"
+#include "engine/displacement.hpp"
+#include "engine/world_tile.hpp"
+#include "engine/random.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+#include "missiles.h"
+#include "player.h"
+#include "tables/misdat.h"
+#include "utils/stable_pool.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr size_t NumCasters = 4;
+/** Upper bound for the ticks a burst of spells keeps missiles alive, in case one of them never ends. */
+constexpr int MaxTicks = 512;
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		Players.resize(NumCasters);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+		for (size_t i = 0; i < NumCasters; i++) {
+			Player &player = Players[i];
+			player = {};
+			player.setCharacterLevel(30);
+			player.position.tile = WorldTilePosition(40 + (static_cast<int>(i) * 10), 56);
+			player.position.future = player.position.tile;
+		}
+		leveltype = DTYPE_CATHEDRAL;
+		currlevel = 1;
+		LoadMissileData();
+		return true;
+	}();
+}
+
+/**
+ * @brief Every caster casts the spell a few times in the same tick, then the missiles are processed until they are gone.
+ */
+void RunSpellBurst(benchmark::State &state, MissileID spell)
+{
+	InitOnce();
+	const int castsPerPlayer = static_cast<int>(state.range(0));
+	size_t missilesProcessed = 0;
+	for (auto _ : state) {
+		InitLighting();
+		Missiles.clear();
+		SetRndSeed(12345);
+		for (int cast = 0; cast < castsPerPlayer; cast++) {
+			for (const Player &player : Players) {
+				const Direction direction = static_cast<Direction>(cast % 8);
+				const WorldTilePosition target = player.position.tile + Displacement(direction) * 4;
+				AddMissile(player.position.tile, target, direction, spell, TARGET_MONSTERS, player, 0, 10);
+			}
+		}
+		for (int tick = 0; tick < MaxTicks && !Missiles.empty(); tick++) {
+			missilesProcessed += Missiles.size();
+			ProcessMissiles();
+		}
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(missilesProcessed));
+}
+
+void BM_Nova(benchmark::State &state) { RunSpellBurst(state, MissileID::Nova); }
+void BM_ChainLightning(benchmark::State &state) { RunSpellBurst(state, MissileID::ChainLightning); }
+void BM_Apocalypse(benchmark::State &state) { RunSpellBurst(state, MissileID::Apocalypse); }
+void BM_FireWall(benchmark::State &state) { RunSpellBurst(state, MissileID::FireWallControl); }
+void BM_Inferno(benchmark::State &state) { RunSpellBurst(state, MissileID::InfernoControl); }
+
+BENCHMARK(BM_Nova)->Arg(1)->Arg(8);
+BENCHMARK(BM_ChainLightning)->Arg(1)->Arg(8);
+BENCHMARK(BM_Apocalypse)->Arg(1)->Arg(8);
+BENCHMARK(BM_FireWall)->Arg(1)->Arg(8);
+BENCHMARK(BM_Inferno)->Arg(1)->Arg(8);
+
+/**
+ * @brief The container alone: missiles are added in bursts, walked every tick and removed after a while.
+ */
+template <typename Container>
+void BM_MissileChurn(benchmark::State &state)
+{
+	Container missiles;
+	uint32_t tick = 0;
+	for (auto _ : state) {
+		for (int i = 0; i < 32; i++) {
+			Missile &missile = missiles.emplace_back();
+			missile.duration = 16 + (i % 32);
+		}
+		for (Missile &missile : missiles) {
+			missile.position.traveled += Displacement { 1, 1 };
+			if (--missile.duration <= 0)
+				missile._miDelFlag = true;
+		}
+		missiles.remove_if([](const Missile &missile) { return missile._miDelFlag; });
+		tick++;
+	}
+	benchmark::DoNotOptimize(tick);
+	state.SetItemsProcessed(state.iterations() * 32);
+}
+
+BENCHMARK_TEMPLATE(BM_MissileChurn, std::list<Missile>);
+BENCHMARK_TEMPLATE(BM_MissileChurn, StablePool<Missile>);
+
+} // namespace
+} // namespace devilution
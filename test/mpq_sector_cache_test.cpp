@@ -0,0 +1,143 @@
+#include "mpq/mpq_sector_cache.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+std::vector<std::byte> MakeSector(size_t size, uint8_t fill)
+{
+	return std::vector<std::byte>(size, static_cast<std::byte>(fill));
+}
+
+bool IsCached(MpqSectorCache &cache, const MpqSectorKey &key, size_t size)
+{
+	std::vector<std::byte> out(size);
+	return cache.read(key, out);
+}
+
+TEST(MpqSectorCacheTest, CountsHitsAndMisses)
+{
+	MpqSectorCache cache { 4 * MpqSectorSize };
+	std::vector<std::byte> out(MpqSectorSize);
+	EXPECT_FALSE(cache.read({ 1, 2, 0 }, out));
+
+	const std::vector<std::byte> sector = MakeSector(MpqSectorSize, 0xAB);
+	cache.insert({ 1, 2, 0 }, sector);
+	ASSERT_TRUE(cache.read({ 1, 2, 0 }, out));
+	EXPECT_EQ(out, sector);
+	EXPECT_FALSE(cache.read({ 1, 2, 1 }, out));
+	EXPECT_FALSE(cache.read({ 1, 3, 0 }, out));
+	EXPECT_FALSE(cache.read({ 2, 2, 0 }, out));
+
+	const MpqSectorCacheStats stats = cache.stats();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.misses, 4);
+	EXPECT_EQ(stats.evictions, 0);
+	EXPECT_EQ(stats.size, MpqSectorSize);
+
+	cache.resetStats();
+	EXPECT_EQ(cache.stats().hits, 0);
+	EXPECT_EQ(cache.stats().misses, 0);
+	EXPECT_EQ(cache.stats().size, MpqSectorSize);
+}
+
+TEST(MpqSectorCacheTest, EvictsLeastRecentlyUsed)
+{
+	MpqSectorCache cache { 3 * MpqSectorSize };
+	for (uint32_t sector = 0; sector < 3; sector++)
+		cache.insert({ 1, 1, sector }, MakeSector(MpqSectorSize, static_cast<uint8_t>(sector)));
+
+	// Sector 0 is now used more recently than sector 1
+	EXPECT_TRUE(IsCached(cache, { 1, 1, 0 }, MpqSectorSize));
+	cache.insert({ 1, 1, 3 }, MakeSector(MpqSectorSize, 3));
+
+	EXPECT_EQ(cache.stats().evictions, 1);
+	EXPECT_EQ(cache.stats().size, 3 * MpqSectorSize);
+	EXPECT_FALSE(IsCached(cache, { 1, 1, 1 }, MpqSectorSize));
+	EXPECT_TRUE(IsCached(cache, { 1, 1, 0 }, MpqSectorSize));
+	EXPECT_TRUE(IsCached(cache, { 1, 1, 2 }, MpqSectorSize));
+	EXPECT_TRUE(IsCached(cache, { 1, 1, 3 }, MpqSectorSize));
+}
+
+TEST(MpqSectorCacheTest, LastSectorMayBeShorter)
+{
+	MpqSectorCache cache { 4 * MpqSectorSize };
+	const std::vector<std::byte> sector = MakeSector(100, 0x11);
+	cache.insert({ 1, 1, 5 }, sector);
+	EXPECT_EQ(cache.stats().size, 100);
+
+	std::vector<std::byte> out(100);
+	ASSERT_TRUE(cache.read({ 1, 1, 5 }, out));
+	EXPECT_EQ(out, sector);
+	EXPECT_FALSE(IsCached(cache, { 1, 1, 5 }, MpqSectorSize)) << "Reads must match the cached size";
+}
+
+TEST(MpqSectorCacheTest, SetBudgetEvicts)
+{
+	MpqSectorCache cache { 4 * MpqSectorSize };
+	for (uint32_t sector = 0; sector < 4; sector++)
+		cache.insert({ 1, 1, sector }, MakeSector(MpqSectorSize, 0));
+
+	cache.setBudget(2 * MpqSectorSize);
+	EXPECT_EQ(cache.budget(), 2 * MpqSectorSize);
+	EXPECT_EQ(cache.stats().size, 2 * MpqSectorSize);
+	EXPECT_EQ(cache.stats().evictions, 2);
+	EXPECT_TRUE(IsCached(cache, { 1, 1, 3 }, MpqSectorSize));
+	EXPECT_FALSE(IsCached(cache, { 1, 1, 0 }, MpqSectorSize));
+
+	cache.setBudget(0);
+	EXPECT_EQ(cache.stats().size, 0);
+	cache.insert({ 1, 1, 0 }, MakeSector(MpqSectorSize, 0));
+	EXPECT_FALSE(IsCached(cache, { 1, 1, 0 }, MpqSectorSize)) << "A budget of 0 disables the cache";
+}
+
+TEST(MpqSectorCacheTest, ReusesSlots)
+{
+	MpqSectorCache cache { 16 * MpqSectorSize };
+	for (uint32_t round = 0; round < 2; round++) {
+		for (uint32_t sector = 0; sector < 100; sector++)
+			cache.insert({ 1 + (sector % 3), sector / 3, sector }, MakeSector(MpqSectorSize, static_cast<uint8_t>(sector)));
+
+		EXPECT_EQ(cache.stats().size, 16 * MpqSectorSize);
+		std::vector<std::byte> out(MpqSectorSize);
+		for (uint32_t sector = 0; sector < 100; sector++) {
+			const bool cached = cache.read({ 1 + (sector % 3), sector / 3, sector }, out);
+			EXPECT_EQ(cached, sector >= 84) << sector;
+			if (cached) {
+				EXPECT_EQ(out, MakeSector(MpqSectorSize, static_cast<uint8_t>(sector)));
+			}
+		}
+		cache.eraseArchive(2);
+		cache.eraseArchive(1);
+		cache.eraseArchive(3);
+		EXPECT_EQ(cache.stats().size, 0);
+	}
+}
+
+TEST(MpqSectorCacheTest, EraseArchive)
+{
+	MpqSectorCache cache { 8 * MpqSectorSize };
+	for (uint32_t archive = 1; archive <= 2; archive++) {
+		for (uint32_t sector = 0; sector < 3; sector++)
+			cache.insert({ archive, 7, sector }, MakeSector(MpqSectorSize, 0));
+	}
+
+	cache.eraseArchive(1);
+	EXPECT_EQ(cache.stats().size, 3 * MpqSectorSize);
+	EXPECT_EQ(cache.stats().evictions, 0);
+	EXPECT_FALSE(IsCached(cache, { 1, 7, 0 }, MpqSectorSize));
+	EXPECT_TRUE(IsCached(cache, { 2, 7, 0 }, MpqSectorSize));
+
+	cache.clear();
+	EXPECT_EQ(cache.stats().size, 0);
+	EXPECT_FALSE(IsCached(cache, { 2, 7, 0 }, MpqSectorSize));
+}
+
+} // namespace
+} // namespace devilution
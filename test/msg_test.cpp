@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "msg.h"
+
+namespace devilution {
+namespace {
+
+constexpr uint8_t Level = 5;
+constexpr uint8_t FormatVersion = 1;
+/** Position, enemy, active flag, hit points and who hit it */
+constexpr size_t MonsterSlotSize = 9;
+/** Large enough for any level */
+constexpr size_t ExportBufferSize = 64 * 1024;
+
+class DeltaLevelBuilder {
+public:
+	explicit DeltaLevelBuilder(uint8_t version = FormatVersion)
+	{
+		bytes_ = { static_cast<std::byte>(Level), static_cast<std::byte>(version) };
+	}
+
+	DeltaLevelBuilder &items(uint8_t count)
+	{
+		push(count);
+		return *this;
+	}
+
+	DeltaLevelBuilder &objects(std::initializer_list<uint8_t> positionActionTriples)
+	{
+		push(static_cast<uint8_t>(positionActionTriples.size() / 3));
+		for (const uint8_t value : positionActionTriples)
+			push(value);
+		return *this;
+	}
+
+	DeltaLevelBuilder &monsters(std::initializer_list<uint8_t> indices, uint8_t count)
+	{
+		push(count);
+		for (const uint8_t index : indices) {
+			push(index);
+			push(10);          // x
+			push(index % 100); // y
+			push(0);           // enemy
+			push(1);           // active
+			push(static_cast<uint8_t>(index + 1));
+			push(0);
+			push(0);
+			push(0);
+			push(0xFF); // who hit it
+		}
+		return *this;
+	}
+
+	DeltaLevelBuilder &monsters(std::initializer_list<uint8_t> indices)
+	{
+		return monsters(indices, static_cast<uint8_t>(indices.size()));
+	}
+
+	DeltaLevelBuilder &spawnedMonsters(uint16_t count)
+	{
+		push(static_cast<uint8_t>(count & 0xFF));
+		push(static_cast<uint8_t>(count >> 8));
+		return *this;
+	}
+
+	[[nodiscard]] const std::vector<std::byte> &bytes() const { return bytes_; }
+
+private:
+	void push(uint8_t value) { bytes_.push_back(static_cast<std::byte>(value)); }
+
+	std::vector<std::byte> bytes_;
+};
+
+bool Import(const std::vector<std::byte> &bytes)
+{
+	return TestDeltaImportLevel(bytes.data(), bytes.size());
+}
+
+std::vector<std::byte> Export()
+{
+	const std::unique_ptr<std::byte[]> buffer { new std::byte[ExportBufferSize] };
+	const size_t size = TestDeltaExportLevel(Level, buffer.get());
+	return { buffer.get(), buffer.get() + size };
+}
+
+class MsgDeltaTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		delta_init();
+	}
+};
+
+TEST_F(MsgDeltaTest, RoundTrip)
+{
+	const std::vector<std::byte> delta = DeltaLevelBuilder {}
+	                                         .items(0)
+	                                         .objects({ 20, 30, CMD_OPENDOOR })
+	                                         .monsters({ 0, 3, 150, MaxMonsters - 1 })
+	                                         .spawnedMonsters(0)
+	                                         .bytes();
+	ASSERT_EQ(delta.size(), 2 + 1 + (1 + 3) + (1 + (4 * (1 + MonsterSlotSize))) + 2);
+	ASSERT_TRUE(Import(delta));
+	EXPECT_EQ(Export(), delta);
+}
+
+TEST_F(MsgDeltaTest, UnlistedSlotsAreReset)
+{
+	ASSERT_TRUE(Import(DeltaLevelBuilder {}.items(0).objects({}).monsters({ 3, 4 }).spawnedMonsters(0).bytes()));
+	const std::vector<std::byte> delta = DeltaLevelBuilder {}.items(0).objects({}).monsters({ 7 }).spawnedMonsters(0).bytes();
+	ASSERT_TRUE(Import(delta));
+	EXPECT_EQ(Export(), delta);
+}
+
+TEST_F(MsgDeltaTest, UnchangedLevelIsSmall)
+{
+	const std::vector<std::byte> delta = DeltaLevelBuilder {}.items(0).objects({}).monsters({}).spawnedMonsters(0).bytes();
+	ASSERT_TRUE(Import(delta));
+	EXPECT_EQ(Export(), delta);
+	EXPECT_EQ(delta.size(), 7U);
+}
+
+TEST_F(MsgDeltaTest, RejectsTruncatedInput)
+{
+	const std::vector<std::byte> delta = DeltaLevelBuilder {}
+	                                         .items(0)
+	                                         .objects({ 20, 30, CMD_OPENDOOR })
+	                                         .monsters({ 3, 150 })
+	                                         .spawnedMonsters(0)
+	                                         .bytes();
+	ASSERT_TRUE(Import(delta));
+	for (size_t size = 0; size < delta.size(); size++) {
+		EXPECT_FALSE(TestDeltaImportLevel(delta.data(), size)) << "truncated to " << size << " bytes";
+	}
+}
+
+TEST_F(MsgDeltaTest, RejectsOutOfRangeIndices)
+{
+	EXPECT_FALSE(Import(DeltaLevelBuilder {}.items(0).objects({}).monsters({ MaxMonsters }).spawnedMonsters(0).bytes()));
+	EXPECT_FALSE(Import(DeltaLevelBuilder {}.items(0).objects({}).monsters({ 0xFF }).spawnedMonsters(0).bytes()));
+
+	// Item slots use the same format, an index past the last slot is rejected before the slot is looked at
+	DeltaLevelBuilder items;
+	items.items(1);
+	std::vector<std::byte> delta = items.bytes();
+	delta.push_back(static_cast<std::byte>(MAXITEMS));
+	delta.resize(delta.size() + sizeof(TCmdPItem), std::byte { 0 });
+	const std::vector<std::byte> rest = DeltaLevelBuilder {}.objects({}).monsters({}).spawnedMonsters(0).bytes();
+	delta.insert(delta.end(), rest.begin() + 2, rest.end());
+	EXPECT_FALSE(Import(delta));
+}
+
+TEST_F(MsgDeltaTest, RejectsTooManySlots)
+{
+	EXPECT_FALSE(Import(DeltaLevelBuilder {}.items(MAXITEMS + 1).bytes()));
+	EXPECT_FALSE(Import(DeltaLevelBuilder {}.items(0).objects({}).monsters({}, MaxMonsters + 1).spawnedMonsters(0).bytes()));
+	EXPECT_FALSE(Import(DeltaLevelBuilder {}.items(0).objects({}).monsters({}).spawnedMonsters(MaxMonsters + 1).bytes()));
+}
+
+TEST_F(MsgDeltaTest, RejectsUnknownVersion)
+{
+	for (const uint8_t version : { 0, FormatVersion + 1, 0xFF }) {
+		EXPECT_FALSE(Import(DeltaLevelBuilder { version }.items(0).objects({}).monsters({}).spawnedMonsters(0).bytes()))
+		    << "version " << static_cast<int>(version);
+	}
+}
+
+} // namespace
+} // namespace devilution
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <string>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_pixels.h>
@@ -11,6 +12,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include "utils/file_util.h"
 #include "utils/palette_kd_tree.hpp"
 
 namespace devilution {
@@ -41,6 +43,22 @@ void BM_GenerateBlendedLookupTable(benchmark::State &state)
 	}
 }
 
+/** Loads the table written to the cache by the first call. */
+void BM_GenerateBlendedLookupTableCached(benchmark::State &state)
+{
+	const std::string cacheDir = "palette_blending_benchmark_cache" DIRECTORY_SEPARATOR_STR;
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	SetBlendedLookupTableCacheDir(cacheDir);
+	GenerateBlendedLookupTable(palette.data());
+	for (auto _ : state) {
+		GenerateBlendedLookupTable(palette.data());
+		int result = paletteTransparencyLookup[17][98];
+		benchmark::DoNotOptimize(result);
+	}
+	SetBlendedLookupTableCacheDir("");
+}
+
 void BM_BuildTree(benchmark::State &state)
 {
 	std::array<SDL_Color, 256> palette;
@@ -72,6 +90,7 @@ void BM_FindNearestNeighbor(benchmark::State &state)
 }
 
 BENCHMARK(BM_GenerateBlendedLookupTable);
+BENCHMARK(BM_GenerateBlendedLookupTableCached);
 BENCHMARK(BM_BuildTree);
 BENCHMARK(BM_FindNearestNeighbor);
 
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <iostream>
+#include <string>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_pixels.h>
@@ -13,6 +15,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "utils/file_util.h"
 #include "utils/str_cat.hpp"
 
 void PrintTo(const SDL_Color &color, std::ostream *os)
@@ -85,5 +88,34 @@ TEST(GenerateBlendedLookupTableTest, BasicTest)
 #endif
 }
 
+TEST(GenerateBlendedLookupTableTest, CachedTable)
+{
+	const std::string cacheDir = "palette_blending_test_cache" DIRECTORY_SEPARATOR_STR;
+	for (const std::string &file : ListFiles(cacheDir.c_str()))
+		RemoveFile((cacheDir + file).c_str());
+
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	static uint8_t expected[256][256];
+	GenerateBlendedLookupTable(palette.data(), 1, 31);
+	std::memcpy(expected, paletteTransparencyLookup, sizeof(expected));
+
+	SetBlendedLookupTableCacheDir(cacheDir);
+	GenerateBlendedLookupTable(palette.data(), 1, 31);
+	EXPECT_EQ(ListFiles(cacheDir.c_str()).size(), 1);
+	EXPECT_EQ(std::memcmp(expected, paletteTransparencyLookup, sizeof(expected)), 0);
+
+	std::memset(paletteTransparencyLookup, 0, sizeof(paletteTransparencyLookup));
+	GenerateBlendedLookupTable(palette.data(), 1, 31);
+	EXPECT_EQ(std::memcmp(expected, paletteTransparencyLookup, sizeof(expected)), 0);
+
+	// Another range of skipped colors makes for another table
+	GenerateBlendedLookupTable(palette.data());
+	EXPECT_EQ(ListFiles(cacheDir.c_str()).size(), 2);
+	EXPECT_EQ(paletteTransparencyLookup[0][100], 82);
+
+	SetBlendedLookupTableCacheDir("");
+}
+
 } // namespace
 } // namespace devilution
@@ -1,9 +1,12 @@
 #include <cstddef>
 #include <cstdint>
+#include <random>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <utility>
 
+#include "engine/flow_field.hpp"
 #include "engine/path.h"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
@@ -154,10 +157,131 @@ void BM_NoPathBig(benchmark::State &state)
 	    state);
 }
 
+/**
+ * @brief A pack of monsters in a cave-like level all chasing the same player.
+ *
+ * With `sealed`, the player stands behind a wall none of them can get through, like on the other side of a closed
+ * door.
+ */
+struct MonsterPack {
+	static constexpr Size MapSize { 80, 80 };
+	static constexpr int MonsterCount = 200;
+
+	std::vector<char> map;
+	std::vector<bool> occupied;
+	std::vector<Point> monsters;
+	Point player { 40, 40 };
+
+	explicit MonsterPack(bool sealed)
+	    : map(MapSize.width * MapSize.height, '.')
+	    , occupied(map.size())
+	{
+		std::mt19937 rng(1516);
+		std::uniform_int_distribution<int> coord(1, MapSize.width - 2);
+		for (int x = 0; x < MapSize.width; x++) {
+			map[x] = map[((MapSize.height - 1) * MapSize.width) + x] = '#';
+		}
+		for (int y = 0; y < MapSize.height; y++) {
+			map[y * MapSize.width] = map[(y * MapSize.width) + MapSize.width - 1] = '#';
+		}
+		// Pillars and short walls
+		for (int i = 0; i < 250; i++) {
+			const Point wall { coord(rng), coord(rng) };
+			const int length = 1 + static_cast<int>(rng() % 4);
+			const bool horizontal = rng() % 2 == 0;
+			for (int j = 0; j < length; j++) {
+				const Point tile = wall + (horizontal ? Displacement { j, 0 } : Displacement { 0, j });
+				if (tile.x < MapSize.width - 1 && tile.y < MapSize.height - 1 && tile != player)
+					(*this)[tile] = '#';
+			}
+		}
+		if (sealed) {
+			for (int i = -2; i <= 2; i++) {
+				(*this)[player + Displacement { i, -2 }] = '#';
+				(*this)[player + Displacement { i, 2 }] = '#';
+				(*this)[player + Displacement { -2, i }] = '#';
+				(*this)[player + Displacement { 2, i }] = '#';
+			}
+		}
+		std::uniform_int_distribution<int> nearby(-20, 20);
+		while (monsters.size() < MonsterCount) {
+			const Point monster = player + Displacement { nearby(rng), nearby(rng) };
+			if ((*this)[monster] == '#' || isOccupied(monster) || player.ManhattanDistance(monster) <= 4)
+				continue;
+			occupied[index(monster)] = true;
+			monsters.push_back(monster);
+		}
+	}
+
+	[[nodiscard]] static size_t index(Point p) { return static_cast<size_t>((p.y * MapSize.width) + p.x); }
+	[[nodiscard]] char &operator[](Point p) { return map[index(p)]; }
+	[[nodiscard]] char operator[](Point p) const { return map[index(p)]; }
+	[[nodiscard]] bool isOccupied(Point p) const { return occupied[index(p)]; }
+	[[nodiscard]] bool isWalkable(Point p) const
+	{
+		return p.x >= 0 && p.y >= 0 && p.x < MapSize.width && p.y < MapSize.height && (*this)[p] != '#';
+	}
+	[[nodiscard]] bool canStep(Point a, Point b) const
+	{
+		return a.x == b.x || a.y == b.y || (isWalkable({ a.x, b.y }) && isWalkable({ b.x, a.y }));
+	}
+};
+
+const MonsterPack &GetMonsterPack(bool sealed)
+{
+	static const MonsterPack Pack { false };
+	static const MonsterPack SealedPack { true };
+	return sealed ? SealedPack : Pack;
+}
+
+void BM_MonsterPackFindPath(benchmark::State &state)
+{
+	const MonsterPack &pack = GetMonsterPack(state.range(0) != 0);
+	const auto canStep = [&pack](Point a, Point b) { return pack.canStep(a, b); };
+	const auto posOk = [&pack](Point p) { return pack.isWalkable(p) && !pack.isOccupied(p); };
+	for (auto _ : state) {
+		for (const Point monster : pack.monsters) {
+			int8_t path[MaxPathLengthMonsters];
+			int result = FindPath(canStep, posOk, monster, pack.player, path, MaxPathLengthMonsters);
+			benchmark::DoNotOptimize(result);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * pack.monsters.size());
+}
+
+void BM_MonsterPackFlowField(benchmark::State &state)
+{
+	const MonsterPack &pack = GetMonsterPack(state.range(0) != 0);
+	const auto canStep = [&pack](Point a, Point b) { return pack.canStep(a, b); };
+	const auto posOk = [&pack](Point p) { return pack.isWalkable(p) && !pack.isOccupied(p); };
+	const bool kept = state.range(1) != 0;
+	WalkabilityGrid grid { MonsterPack::MapSize };
+	for (int y = 0; y < MonsterPack::MapSize.height; y++) {
+		for (int x = 0; x < MonsterPack::MapSize.width; x++) {
+			const bool walkable = pack.isWalkable({ x, y });
+			grid.setTile({ x, y }, walkable, walkable);
+		}
+	}
+	FlowFieldCache cache { MaxPathLengthMonsters };
+	for (auto _ : state) {
+		// Without kept fields every tick starts over, as if the map had changed
+		if (!kept)
+			cache.clear();
+		for (const Point monster : pack.monsters) {
+			int8_t step = cache.firstStep(grid, canStep, posOk, monster, pack.player);
+			benchmark::DoNotOptimize(step);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * pack.monsters.size());
+	state.counters["builds"] = static_cast<double>(cache.builds());
+}
+
 BENCHMARK(BM_SinglePath);
 BENCHMARK(BM_Bridges);
 BENCHMARK(BM_NoPath);
 BENCHMARK(BM_NoPathBig);
+BENCHMARK(BM_MonsterPackFindPath)->ArgName("sealed")->Arg(0)->Arg(1);
+BENCHMARK(BM_MonsterPackFlowField)->ArgNames({ "sealed", "kept" })->ArgsProduct({ { 0, 1 }, { 0, 1 } });
 
 } // namespace
 } // namespace devilution
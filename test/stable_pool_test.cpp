@@ -0,0 +1,97 @@
+#include "utils/stable_pool.hpp"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+std::vector<int> Contents(const StablePool<int, 4> &pool)
+{
+	return { pool.begin(), pool.end() };
+}
+
+TEST(StablePoolTest, KeepsInsertionOrder)
+{
+	StablePool<int, 4> pool;
+	for (int i = 0; i < 10; i++)
+		pool.push_back(i);
+	EXPECT_EQ(pool.size(), 10);
+	EXPECT_EQ(Contents(pool), (std::vector<int> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+	EXPECT_EQ(pool.back(), 9);
+}
+
+TEST(StablePoolTest, VisitsElementsAddedWhileIterating)
+{
+	StablePool<int, 4> pool;
+	pool.push_back(3);
+	std::vector<int> visited;
+	for (const int value : pool) {
+		visited.push_back(value);
+		if (value > 0)
+			pool.push_back(value - 1);
+	}
+	EXPECT_EQ(visited, (std::vector<int> { 3, 2, 1, 0 }));
+}
+
+TEST(StablePoolTest, ElementsDontMove)
+{
+	StablePool<int, 4> pool;
+	int &first = pool.emplace_back(42);
+	for (int i = 0; i < 100; i++)
+		pool.push_back(i);
+	pool.remove_if([](int value) { return value < 40; });
+	EXPECT_EQ(&first, &*pool.begin());
+	EXPECT_EQ(first, 42);
+}
+
+TEST(StablePoolTest, RemoveIfKeepsOrder)
+{
+	StablePool<int, 4> pool;
+	for (int i = 0; i < 10; i++)
+		pool.push_back(i);
+	EXPECT_EQ(pool.remove_if([](int value) { return value % 3 == 0; }), 4);
+	EXPECT_EQ(Contents(pool), (std::vector<int> { 1, 2, 4, 5, 7, 8 }));
+	pool.push_back(10);
+	EXPECT_EQ(Contents(pool), (std::vector<int> { 1, 2, 4, 5, 7, 8, 10 }));
+}
+
+TEST(StablePoolTest, HandlesExpireWithTheirElement)
+{
+	StablePool<std::string, 4> pool;
+	pool.push_back("a");
+	const std::string &b = pool.emplace_back("b");
+	const StablePoolHandle handle = pool.handleOf(b);
+	ASSERT_NE(pool.get(handle), nullptr);
+	EXPECT_EQ(*pool.get(handle), "b");
+
+	pool.remove_if([](const std::string &value) { return value == "b"; });
+	EXPECT_EQ(pool.get(handle), nullptr);
+	// The slot is reused, the handle still doesn't match
+	const std::string &c = pool.emplace_back("c");
+	EXPECT_EQ(&c, &b);
+	EXPECT_EQ(pool.get(handle), nullptr);
+	EXPECT_EQ(pool.get(StablePoolHandle {}), nullptr);
+
+	pool.clear();
+	EXPECT_TRUE(pool.empty());
+	EXPECT_NE(pool.get(pool.handleOf(pool.emplace_back("d"))), nullptr);
+}
+
+TEST(StablePoolTest, IteratorsAdvance)
+{
+	StablePool<int, 4> pool;
+	for (int i = 0; i < 6; i++)
+		pool.push_back(i);
+	auto it = pool.cbegin();
+	std::advance(it, 4);
+	EXPECT_EQ(*it, 4);
+	EXPECT_EQ(std::distance(pool.cbegin(), it), 4);
+	EXPECT_EQ(std::distance(it, pool.cend()), 2);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,110 @@
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "tables/itemdat.h"
+#include "tables/monstdat.h"
+#include "tables/objdat.h"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+std::string GetCachePath(std::string_view table)
+{
+	return StrCat(paths::PrefPath(), "cache" DIRECTORY_SEPARATOR_STR "txtdata" DIRECTORY_SEPARATOR_STR, table, ".bin");
+}
+
+class TableCacheTest : public ::testing::Test {
+public:
+	static void SetUpTestSuite()
+	{
+		paths::SetPrefPath(paths::BasePath());
+	}
+
+	/** @brief Removes the cached tables, so that the next load parses them and writes the cache. */
+	static void RemoveCaches(std::initializer_list<std::string_view> tables)
+	{
+		for (const std::string_view table : tables) {
+			const std::string path = GetCachePath(table);
+			if (FileExists(path))
+				RemoveFile(path.c_str());
+		}
+	}
+
+	static void ExpectCached(std::initializer_list<std::string_view> tables)
+	{
+		for (const std::string_view table : tables) {
+			EXPECT_TRUE(FileExists(GetCachePath(table))) << table;
+		}
+	}
+};
+
+TEST_F(TableCacheTest, ItemTablesFromCacheMatchParsed)
+{
+	constexpr std::initializer_list<std::string_view> Tables = {
+		"txtdata_items_itemdat.tsv",
+		"txtdata_items_unique_itemdat.tsv",
+		"txtdata_items_item_prefixes.tsv",
+		"txtdata_items_item_suffixes.tsv",
+	};
+	RemoveCaches(Tables);
+	LoadItemData();
+	ExpectCached(Tables);
+	const std::vector<ItemData> items = AllItemsList;
+	const std::vector<UniqueItem> uniqueItems = UniqueItems;
+	const std::vector<PLStruct> prefixes = ItemPrefixes;
+	const std::vector<PLStruct> suffixes = ItemSuffixes;
+	const auto itemMappingIds = ItemMappingIdsToIndices;
+	const auto uniqueItemMappingIds = UniqueItemMappingIdsToIndices;
+
+	LoadItemData();
+	EXPECT_EQ(AllItemsList, items);
+	EXPECT_EQ(UniqueItems, uniqueItems);
+	EXPECT_EQ(ItemPrefixes, prefixes);
+	EXPECT_EQ(ItemSuffixes, suffixes);
+	EXPECT_EQ(ItemMappingIdsToIndices, itemMappingIds);
+	EXPECT_EQ(UniqueItemMappingIdsToIndices, uniqueItemMappingIds);
+}
+
+TEST_F(TableCacheTest, MonsterTableFromCacheMatchesParsed)
+{
+	constexpr std::initializer_list<std::string_view> Tables = { "txtdata_monsters_monstdat.tsv" };
+	RemoveCaches(Tables);
+	LoadMonsterData();
+	ExpectCached(Tables);
+	const std::vector<MonsterData> monsters = MonstersData;
+	std::vector<std::string> spritePaths;
+	for (const MonsterData &monster : monsters)
+		spritePaths.emplace_back(monster.spritePath());
+
+	LoadMonsterData();
+	EXPECT_EQ(MonstersData, monsters);
+	ASSERT_EQ(MonstersData.size(), spritePaths.size());
+	for (size_t i = 0; i < MonstersData.size(); ++i) {
+		EXPECT_EQ(MonstersData[i].spritePath(), spritePaths[i]) << "for monster " << i;
+	}
+}
+
+TEST_F(TableCacheTest, ObjectTableFromCacheMatchesParsed)
+{
+	constexpr std::initializer_list<std::string_view> Tables = { "txtdata_objects_objdat.tsv" };
+	RemoveCaches(Tables);
+	LoadObjectData();
+	ExpectCached(Tables);
+	const std::vector<ObjectData> objects = AllObjects;
+	const std::vector<std::string> objectFiles = ObjMasterLoadList;
+
+	LoadObjectData();
+	EXPECT_EQ(AllObjects, objects);
+	EXPECT_EQ(ObjMasterLoadList, objectFiles);
+}
+
+} // namespace
+} // namespace devilution
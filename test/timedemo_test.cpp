@@ -74,7 +74,7 @@ void RunTimedemo(std::string timedemoFolderName)
 	gbMusicOn = false;
 	gbSoundOn = false;
 	HeadlessMode = true;
-	demo::InitPlayBack(demoNumber, true);
+	demo::InitPlayBack(demoNumber, true, false);
 
 	LoadSpellData();
 	LoadPlayerDataFiles();
@@ -0,0 +1,88 @@
+#include "utils/trace.hpp"
+
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+std::string ReadFile(const std::string &path)
+{
+	std::string contents;
+	FILE *file = std::fopen(path.c_str(), "rb");
+	if (file == nullptr)
+		return contents;
+	char buffer[4096];
+	size_t read;
+	while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+		contents.append(buffer, read);
+	std::fclose(file);
+	return contents;
+}
+
+size_t CountOccurrences(const std::string &str, const std::string &needle)
+{
+	size_t count = 0;
+	for (size_t pos = str.find(needle); pos != std::string::npos; pos = str.find(needle, pos + 1))
+		++count;
+	return count;
+}
+
+TEST(TraceTest, NothingIsRecordedWhileDisabled)
+{
+	DisableTracing();
+	{
+		const TraceZone zone("Disabled");
+	}
+	RecordTraceZone("Disabled", 0, 1);
+	EXPECT_EQ(GetTraceZoneCount(), 0);
+}
+
+TEST(TraceTest, KeepsTheNewestZones)
+{
+	EnableTracing(4);
+	for (uint64_t i = 0; i < 6; ++i)
+		RecordTraceZone(i < 2 ? "Old" : "New", i * 10, (i * 10) + 5);
+	EXPECT_EQ(GetTraceZoneCount(), 4);
+
+	const std::string path = paths::BasePath() + "trace_test.json";
+	ASSERT_TRUE(WriteTrace(path.c_str()));
+	const std::string json = ReadFile(path);
+	std::remove(path.c_str());
+
+	EXPECT_EQ(CountOccurrences(json, R"("name":"Old")"), 0);
+	EXPECT_EQ(CountOccurrences(json, R"("name":"New")"), 4);
+	// Zones are written oldest first.
+	EXPECT_LT(json.find(R"("ts":20,)"), json.find(R"("ts":50,)"));
+	EXPECT_NE(json.find(R"("ts":50,"dur":5})"), std::string::npos);
+	DisableTracing();
+}
+
+TEST(TraceTest, NestedZones)
+{
+	EnableTracing();
+	{
+		const TraceZone outer("Outer");
+		{
+			const TraceZone inner("In \"quotes\"");
+		}
+	}
+	EXPECT_EQ(GetTraceZoneCount(), 2);
+
+	const std::string path = paths::BasePath() + "trace_test.json";
+	ASSERT_TRUE(WriteTrace(path.c_str()));
+	const std::string json = ReadFile(path);
+	std::remove(path.c_str());
+
+	// The inner zone ends first, so it is recorded first.
+	EXPECT_LT(json.find(R"("name":"In \"quotes\"")"), json.find(R"("name":"Outer")"));
+	EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+	DisableTracing();
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,106 @@
+#include "utils/translation_catalog.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+using namespace std::string_view_literals;
+
+TEST(TranslationCatalogTest, Empty)
+{
+	const TranslationCatalog catalog = TranslationCatalog::build({}, 2);
+	EXPECT_TRUE(catalog.empty());
+	EXPECT_EQ(catalog.find("Gold"), TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.findParticular("spell", "Fire"), TranslationCatalog::NotFound);
+}
+
+TEST(TranslationCatalogTest, FindsEveryKey)
+{
+	std::vector<std::string> keys;
+	std::vector<std::string> values;
+	for (int i = 0; i < 5000; i++) {
+		keys.push_back("key " + std::to_string(i * 7919));
+		values.push_back("value " + std::to_string(i));
+	}
+	std::vector<TranslationCatalog::Entry> entries;
+	for (size_t i = 0; i < keys.size(); i++)
+		entries.push_back({ keys[i], values[i] });
+
+	const TranslationCatalog catalog = TranslationCatalog::build(entries, 1);
+	ASSERT_EQ(catalog.size(), keys.size());
+	std::vector<bool> usedSlots(catalog.size());
+	for (size_t i = 0; i < keys.size(); i++) {
+		const uint32_t slot = catalog.find(keys[i]);
+		ASSERT_NE(slot, TranslationCatalog::NotFound) << keys[i];
+		EXPECT_FALSE(usedSlots[slot]);
+		usedSlots[slot] = true;
+		EXPECT_EQ(catalog.key(slot), keys[i]);
+		EXPECT_EQ(catalog.translation(slot, 0), values[i]);
+	}
+	EXPECT_EQ(catalog.find("key 1"), TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.find("key "), TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.find(""), TranslationCatalog::NotFound);
+}
+
+TEST(TranslationCatalogTest, PluralForms)
+{
+	const TranslationCatalog::Entry entries[] = {
+		{ "{:d} Gold piece", "{:d} sztuka złota\0{:d} sztuki złota\0{:d} sztuk złota"sv },
+		{ "Gold", "Złoto" },
+		{ "Empty", "" },
+	};
+	const TranslationCatalog catalog = TranslationCatalog::build(entries, 3);
+
+	const uint32_t plural = catalog.find("{:d} Gold piece");
+	ASSERT_NE(plural, TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.translation(plural, 0), "{:d} sztuka złota");
+	EXPECT_EQ(catalog.translation(plural, 1), "{:d} sztuki złota");
+	EXPECT_EQ(catalog.translation(plural, 2), "{:d} sztuk złota");
+	EXPECT_EQ(catalog.translation(plural, 3), std::nullopt);
+	EXPECT_EQ(catalog.translation(plural, 2)->data()[catalog.translation(plural, 2)->size()], '\0');
+
+	const uint32_t singular = catalog.find("Gold");
+	ASSERT_NE(singular, TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.translation(singular, 0), "Złoto");
+	EXPECT_EQ(catalog.translation(singular, 1), std::nullopt);
+
+	const uint32_t empty = catalog.find("Empty");
+	ASSERT_NE(empty, TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.translation(empty, 0), "");
+}
+
+TEST(TranslationCatalogTest, Particular)
+{
+	const TranslationCatalog::Entry entries[] = {
+		{ "spell\004Fire", "Feuer (Zauber)" },
+		{ "Fire", "Feuer" },
+	};
+	const TranslationCatalog catalog = TranslationCatalog::build(entries, 2);
+
+	const uint32_t slot = catalog.findParticular("spell", "Fire");
+	ASSERT_NE(slot, TranslationCatalog::NotFound);
+	EXPECT_EQ(slot, catalog.find("spell\004Fire"));
+	EXPECT_EQ(catalog.translation(slot, 0), "Feuer (Zauber)");
+	EXPECT_EQ(catalog.findParticular("spel", "lFire"), TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.findParticular("monster", "Fire"), TranslationCatalog::NotFound);
+	EXPECT_EQ(catalog.findParticular("", "Fire"), TranslationCatalog::NotFound);
+}
+
+TEST(TranslationCatalogTest, FirstOfRepeatedKeysWins)
+{
+	const TranslationCatalog::Entry entries[] = {
+		{ "Gold", "Or" },
+		{ "Armor", "Armure" },
+		{ "Gold", "Oro" },
+	};
+	const TranslationCatalog catalog = TranslationCatalog::build(entries, 2);
+	EXPECT_EQ(catalog.size(), 2);
+	EXPECT_EQ(catalog.translation(catalog.find("Gold"), 0), "Or");
+}
+
+} // namespace
+} // namespace devilution
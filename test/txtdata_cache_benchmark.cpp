@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "data/table_cache.hpp"
+#include "tables/itemdat.h"
+#include "tables/monstdat.h"
+#include "tables/objdat.h"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		paths::SetPrefPath(paths::BasePath());
+		return true;
+	}();
+}
+
+/** Parses the tables from the TSV files, with the cache turned off so that writing it isn't timed. */
+void BenchmarkParsed(benchmark::State &state, void (*loadFn)())
+{
+	InitOnce();
+	SetTableCacheEnabled(false);
+	for (auto _ : state) {
+		loadFn();
+	}
+	SetTableCacheEnabled(true);
+}
+
+/** Loads the tables from the cache written by the first load. */
+void BenchmarkCached(benchmark::State &state, void (*loadFn)())
+{
+	InitOnce();
+	loadFn();
+	for (auto _ : state) {
+		loadFn();
+	}
+}
+
+void BM_LoadItemDataParsed(benchmark::State &state)
+{
+	BenchmarkParsed(state, LoadItemData);
+	benchmark::DoNotOptimize(AllItemsList.data());
+}
+
+void BM_LoadItemDataCached(benchmark::State &state)
+{
+	BenchmarkCached(state, LoadItemData);
+	benchmark::DoNotOptimize(AllItemsList.data());
+}
+
+void BM_LoadMonsterDataParsed(benchmark::State &state)
+{
+	BenchmarkParsed(state, LoadMonsterData);
+	benchmark::DoNotOptimize(MonstersData.data());
+}
+
+void BM_LoadMonsterDataCached(benchmark::State &state)
+{
+	BenchmarkCached(state, LoadMonsterData);
+	benchmark::DoNotOptimize(MonstersData.data());
+}
+
+void BM_LoadObjectDataParsed(benchmark::State &state)
+{
+	BenchmarkParsed(state, LoadObjectData);
+	benchmark::DoNotOptimize(AllObjects.data());
+}
+
+void BM_LoadObjectDataCached(benchmark::State &state)
+{
+	BenchmarkCached(state, LoadObjectData);
+	benchmark::DoNotOptimize(AllObjects.data());
+}
+
+BENCHMARK(BM_LoadItemDataParsed);
+BENCHMARK(BM_LoadItemDataCached);
+BENCHMARK(BM_LoadMonsterDataParsed);
+BENCHMARK(BM_LoadMonsterDataCached);
+BENCHMARK(BM_LoadObjectDataParsed);
+BENCHMARK(BM_LoadObjectDataCached);
+
+} // namespace
+} // namespace devilution
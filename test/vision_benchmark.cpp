@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/displacement.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+constexpr uint8_t VisionRadius = 10;
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		leveltype = DTYPE_CAVES;
+		currlevel = 9;
+		setlevel = false;
+		SOLData[0] = TileProperties::None;
+		SOLData[1] = TileProperties::Solid | TileProperties::BlockLight;
+		std::mt19937 rng(1234);
+		std::uniform_int_distribution<int> percent(0, 99);
+		std::uniform_int_distribution<int> trans(0, 3);
+		for (int x = 0; x < MAXDUNX; x++) {
+			for (int y = 0; y < MAXDUNY; y++) {
+				dPiece[x][y] = percent(rng) < 5 ? 1 : 0;
+				dTransVal[x][y] = static_cast<int8_t>(trans(rng));
+			}
+		}
+
+		Players.resize(MAXVISION);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+		for (Player &player : Players) {
+			player.plractive = true;
+			player.plrlevel = currlevel;
+			player.plrIsOnSetLevel = false;
+			player._pLvlChanging = false;
+			player.friendlyMode = true;
+		}
+		return true;
+	}();
+}
+
+/** @brief Places the visions of all players a few tiles apart, so that their areas overlap. */
+void ActivatePlayerVisions()
+{
+	InitLighting();
+	memset(dFlags, 0, sizeof(dFlags));
+	for (const Player &player : Players)
+		ActivateVision({ 40 + (static_cast<int>(player.getId()) * 6), 56 }, VisionRadius, player.getId());
+	ProcessVisionList();
+}
+
+/** @brief Moves the first visions one tile, back and forth on alternate ticks. */
+void MoveVisions(int moving, int tick)
+{
+	const Displacement step = { tick % 2 == 0 ? 1 : -1, 0 };
+	for (int id = 0; id < moving; id++)
+		ChangeVisionXY(id, VisionList[id].position.tile + step);
+}
+
+/** @brief ProcessVisionList as it was before visions kept the tiles they marked: every vision walks its rays again. */
+void ProcessVisionListFully()
+{
+	for (const Player &player : Players) {
+		Light &vision = VisionList[player.getId()];
+		if (vision.hasChanged) {
+			DoUnVision(vision.position.old, vision.oldRadius);
+			vision.hasChanged = false;
+		}
+	}
+	TransList = {};
+	for (const Player &player : Players) {
+		const Light &vision = VisionList[player.getId()];
+		DoVision(vision.position.tile, vision.radius, &player == MyPlayer ? MAP_EXP_SELF : MAP_EXP_OTHERS, &player == MyPlayer);
+	}
+}
+
+void BM_ProcessVisionList(benchmark::State &state)
+{
+	InitOnce();
+	ActivatePlayerVisions();
+	const int moving = static_cast<int>(state.range(0));
+	int tick = 0;
+	for (auto _ : state) {
+		MoveVisions(moving, tick++);
+		ProcessVisionList();
+	}
+}
+
+void BM_ProcessVisionListFully(benchmark::State &state)
+{
+	InitOnce();
+	ActivatePlayerVisions();
+	const int moving = static_cast<int>(state.range(0));
+	int tick = 0;
+	for (auto _ : state) {
+		MoveVisions(moving, tick++);
+		ProcessVisionListFully();
+	}
+}
+
+// How many of the four players move in a tick
+BENCHMARK(BM_ProcessVisionList)->ArgName("moving")->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK(BM_ProcessVisionListFully)->ArgName("moving")->Arg(1)->Arg(2)->Arg(4);
+
+} // namespace
+} // namespace devilution